@@ -601,6 +601,11 @@ void ComplexGeoData::SaveDocFile(Base::Writer& writer) const
 {
     flushElementMap();
     if (_elementMap) {
+        if (writer.getMode("BinaryElementMap")) {
+            writer.Stream() << "BeginElementMap v2\n";
+            _elementMap->saveBinary(writer.Stream());
+            return;
+        }
         writer.Stream() << "BeginElementMap v1\n";
         _elementMap->save(writer.Stream());
     }
@@ -614,6 +619,13 @@ void ComplexGeoData::RestoreDocFile(Base::Reader& reader)
     if (boost::equals(marker, "BeginElementMap")) {
         resetElementMap();
         reader >> ver;
+        if (ver == "v2") {
+            // skip the line break after the header
+            reader.get();
+            resetElementMap(std::make_shared<ElementMap>());
+            _elementMap = _elementMap->restoreBinary(Hasher, reader);
+            return;
+        }
         if (ver != "v1") {
             FC_WARN("Unknown element map format");  // NOLINT
         }
@@ -1,5 +1,7 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <limits>
+#include <sstream>
 #include <unordered_map>
 #ifndef FC_DEBUG
 #include <random>
@@ -11,6 +13,7 @@
 
 #include "App/Application.h"
 #include "Base/Console.h"
+#include "Base/Stream.h"
 #include "Document.h"
 #include "DocumentObject.h"
 
@@ -232,6 +235,60 @@ void ElementMap::save(std::ostream& stream) const
     }
 }
 
+namespace
+{
+// Tags may be negative, so they are zigzag encoded before being written as
+// variable length integers.
+uint64_t encodeSigned(long value)
+{
+    auto v = static_cast<int64_t>(value);
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);  // NOLINT
+}
+
+long decodeSigned(uint64_t value)
+{
+    return static_cast<long>(static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1));
+}
+
+uint64_t readVarInt(Base::InputStream& str, std::istream& stream)
+{
+    uint64_t value = 0;
+    str.readVarInt(value);
+    if (!stream) {
+        FC_THROWM(Base::RuntimeError, "unexpected end of binary element map");// NOLINT
+    }
+    return value;
+}
+
+void writeBytes(Base::OutputStream& str, const QByteArray& bytes)
+{
+    str.writeVarInt(bytes.size());
+    str.write(bytes.constData(), bytes.size());
+}
+
+QByteArray readBytes(Base::InputStream& str, std::istream& stream)
+{
+    uint64_t size = readVarInt(str, stream);
+    if (size > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        FC_THROWM(Base::RuntimeError, "Invalid binary element map string size");// NOLINT
+    }
+    QByteArray bytes(static_cast<int>(size), Qt::Uninitialized);
+    str.read(bytes.data(), bytes.size());
+    if (!stream) {
+        FC_THROWM(Base::RuntimeError, "unexpected end of binary element map");// NOLINT
+    }
+    return bytes;
+}
+
+/// Element name marker in the binary format, same meaning as ';', ':' and '$' in the text one
+enum class BinaryNameType : uint8_t
+{
+    Plain = 0,
+    Indexed = 1,
+    PrefixID = 2,
+};
+}// namespace
+
 ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef, std::istream& stream)
 {
     const char* msg = "Invalid element map";
@@ -492,6 +549,372 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef, std::istream
     return shared_from_this();
 }
 
+void ElementMap::saveBinary(std::ostream& stream, int index,
+                            const std::map<const ElementMap*, int>& childMapSet,
+                            const std::map<QByteArray, int>& postfixMap) const
+{
+    Base::OutputStream str(stream);
+    str.writeVarInt(index);
+    str.writeVarInt(this->_id);
+    str.writeVarInt(this->indexedNames.size());
+
+    for (auto& indexedName : this->indexedNames) {
+        writeBytes(str,
+                   QByteArray::fromRawData(indexedName.first,
+                                           static_cast<int>(qstrlen(indexedName.first))));
+
+        str.writeVarInt(indexedName.second.children.size());
+        for (auto& vv : indexedName.second.children) {
+            auto& child = vv.second;
+            int mapIndex = 0;
+            if (child.elementMap) {
+                auto it = childMapSet.find(child.elementMap.get());
+                if (it == childMapSet.end() || it->second == 0) {
+                    FC_ERR("Invalid child element map");// NOLINT
+                }
+                else {
+                    mapIndex = it->second;
+                }
+            }
+            str.writeVarInt(child.indexedName.getIndex());
+            str.writeVarInt(child.offset);
+            str.writeVarInt(child.count);
+            str.writeVarInt(encodeSigned(child.tag));
+            str.writeVarInt(mapIndex);
+            writeBytes(str, child.postfix);
+            int sidCount = 0;
+            for (auto& sid : child.sids) {
+                if (sid.isMarked()) {
+                    ++sidCount;
+                }
+            }
+            str.writeVarInt(sidCount);
+            for (auto& sid : child.sids) {
+                if (sid.isMarked()) {
+                    str.writeVarInt(sid.value());
+                }
+            }
+        }
+
+        str.writeVarInt(indexedName.second.names.size());
+        for (auto& dequeueOfMappedNameRef : indexedName.second.names) {
+            int refCount = 0;
+            for (auto ref = &dequeueOfMappedNameRef; ref && ref->name; ref = ref->next.get()) {
+                ++refCount;
+            }
+            str.writeVarInt(refCount);
+            for (auto ref = &dequeueOfMappedNameRef; ref && ref->name; ref = ref->next.get()) {
+                ::App::StringID::IndexID prefixID {};
+                prefixID.id = 0;
+                IndexedName idx(ref->name.dataBytes());
+                bool printName = true;
+                if (idx) {
+                    auto key = QByteArray::fromRawData(idx.getType(),
+                                                       static_cast<int>(qstrlen(idx.getType())));
+                    auto it = postfixMap.find(key);
+                    if (it != postfixMap.end()) {
+                        str << static_cast<uint8_t>(BinaryNameType::Indexed);
+                        str.writeVarInt(it->second);
+                        str.writeVarInt(idx.getIndex());
+                        printName = false;
+                    }
+                }
+                else {
+                    prefixID = ::App::StringID::fromString(ref->name.dataBytes());
+                    if (prefixID.id != 0) {
+                        for (auto& sid : ref->sids) {
+                            if (sid.isMarked() && sid.value() == prefixID.id) {
+                                str << static_cast<uint8_t>(BinaryNameType::PrefixID);
+                                writeBytes(str, ref->name.dataBytes());
+                                printName = false;
+                                break;
+                            }
+                        }
+                        if (printName) {
+                            prefixID.id = 0;
+                        }
+                    }
+                }
+                if (printName) {
+                    str << static_cast<uint8_t>(BinaryNameType::Plain);
+                    writeBytes(str, ref->name.dataBytes());
+                }
+
+                const QByteArray& postfix = ref->name.postfixBytes();
+                if (postfix.isEmpty()) {
+                    str.writeVarInt(0);
+                }
+                else {
+                    auto it = postfixMap.find(postfix);
+                    assert(it != postfixMap.end());
+                    str.writeVarInt(it->second);
+                }
+
+                int sidCount = 0;
+                for (auto& sid : ref->sids) {
+                    if (sid.isMarked() && sid.value() != prefixID.id) {
+                        ++sidCount;
+                    }
+                }
+                str.writeVarInt(sidCount);
+                for (auto& sid : ref->sids) {
+                    if (sid.isMarked() && sid.value() != prefixID.id) {
+                        str.writeVarInt(sid.value());
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ElementMap::saveBinary(std::ostream& stream) const
+{
+    std::map<const ElementMap*, int> childMapSet;
+    std::vector<const ElementMap*> childMaps;
+    std::map<QByteArray, int> postfixMap;
+    std::vector<QByteArray> postfixes;
+
+    collectChildMaps(childMapSet, childMaps, postfixMap, postfixes);
+
+    Base::OutputStream str(stream);
+    str.writeVarInt(this->_id);
+    str.writeVarInt(postfixes.size());
+    for (auto& postfix : postfixes) {
+        writeBytes(str, postfix);
+    }
+    str.writeVarInt(childMaps.size());
+    int index = 0;
+    for (auto& elementMap : childMaps) {
+        // Each map is prefixed with its size, so that a map that is already
+        // restored can be skipped as a whole.
+        std::ostringstream buffer(std::ios::out | std::ios::binary);
+        elementMap->saveBinary(buffer, ++index, childMapSet, postfixMap);
+        std::string data = buffer.str();
+        str.writeVarInt(data.size());
+        str.write(data.c_str(), static_cast<int>(data.size()));
+    }
+}
+
+ElementMapPtr ElementMap::restoreBinary(::App::StringHasherRef hasherRef, std::istream& stream)
+{
+    Base::InputStream str(stream);
+    auto id = static_cast<unsigned>(readVarInt(str, stream));
+
+    auto& map = _idToElementMap[id];
+    if (map) {
+        return map;
+    }
+
+    auto count = readVarInt(str, stream);
+    std::vector<QByteArray> postfixes;
+    postfixes.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        postfixes.push_back(readBytes(str, stream));
+    }
+
+    count = readVarInt(str, stream);
+    if (count == 0) {
+        FC_THROWM(Base::RuntimeError, "Invalid element map");// NOLINT
+    }
+    std::vector<ElementMapPtr> childMaps;
+    childMaps.reserve(count - 1);
+    std::string buffer;
+    for (uint64_t i = 0; i < count; ++i) {
+        auto size = readVarInt(str, stream);
+        buffer.resize(size);
+        str.read(buffer.data(), static_cast<int>(size));
+        if (!stream) {
+            FC_THROWM(Base::RuntimeError, "unexpected end of child element map");// NOLINT
+        }
+        std::istringstream block(buffer, std::ios::in | std::ios::binary);
+        if (i + 1 < count) {
+            childMaps.push_back(std::make_shared<ElementMap>()->restoreBinary(hasherRef,
+                                                                              block,
+                                                                              childMaps,
+                                                                              postfixes));
+        }
+        else {
+            return restoreBinary(hasherRef, block, childMaps, postfixes);
+        }
+    }
+    return shared_from_this();
+}
+
+ElementMapPtr ElementMap::restoreBinary(::App::StringHasherRef hasherRef, std::istream& stream,
+                                        std::vector<ElementMapPtr>& childMaps,
+                                        const std::vector<QByteArray>& postfixes)
+{
+    Base::InputStream str(stream);
+    auto index = static_cast<int>(readVarInt(str, stream));
+    auto id = static_cast<unsigned>(readVarInt(str, stream));
+    auto typeCount = readVarInt(str, stream);
+
+    auto& map = _idToElementMap[id];
+    if (map) {
+        return map;
+    }
+
+    const char* hasherWarn = nullptr;
+    const char* hasherIDWarn = nullptr;
+    const char* postfixWarn = nullptr;
+    const char* childSIDWarn = nullptr;
+
+    for (uint64_t i = 0; i < typeCount; ++i) {
+        QByteArray type = readBytes(str, stream);
+        IndexedName idx(type.constData(), 1);
+        auto& indices = this->indexedNames[idx.getType()];
+
+        auto childCount = readVarInt(str, stream);
+        for (uint64_t j = 0; j < childCount; ++j) {
+            auto cIndex = static_cast<int>(readVarInt(str, stream));
+            auto offset = static_cast<int>(readVarInt(str, stream));
+            auto count = static_cast<int>(readVarInt(str, stream));
+            long tag = decodeSigned(readVarInt(str, stream));
+            auto mapIndex = static_cast<int>(readVarInt(str, stream));
+            if (cIndex < 0) {
+                FC_THROWM(Base::RuntimeError, "Invalid element child index");// NOLINT
+            }
+            if (offset < 0) {
+                FC_THROWM(Base::RuntimeError, "Invalid element child offset");// NOLINT
+            }
+            if (mapIndex >= index || mapIndex < 0 || mapIndex > (int)childMaps.size()) {
+                FC_THROWM(Base::RuntimeError, "Invalid element child map index");// NOLINT
+            }
+            auto& child = indices.children[cIndex + offset + count];
+            child.indexedName = IndexedName::fromConst(idx.getType(), cIndex);
+            child.offset = offset;
+            child.count = count;
+            child.tag = tag;
+            if (mapIndex > 0) {
+                child.elementMap = childMaps[mapIndex - 1];
+            }
+            else {
+                child.elementMap = nullptr;
+            }
+            child.postfix = readBytes(str, stream);
+            this->childElements[child.postfix].childMap = &child;
+            this->childElementSize += child.count;
+
+            auto sidCount = readVarInt(str, stream);
+            child.sids.reserve(static_cast<int>(sidCount));
+            for (uint64_t k = 0; k < sidCount; ++k) {
+                auto childID = static_cast<long>(readVarInt(str, stream));
+                auto sid = hasherRef ? hasherRef->getID(childID) : ::App::StringIDRef();
+                if (!sid) {
+                    childSIDWarn = "Missing element child string id";
+                }
+                else {
+                    child.sids.push_back(sid);
+                }
+            }
+        }
+
+        auto nameCount = readVarInt(str, stream);
+        indices.names.resize(nameCount);
+        for (uint64_t j = 0; j < nameCount; ++j) {
+            idx.setIndex(static_cast<int>(j));
+            auto* ref = &indices.names[j];
+            auto refCount = readVarInt(str, stream);
+            for (uint64_t r = 0; r < refCount; ++r) {
+                if (r != 0) {
+                    ref->next = std::make_unique<MappedNameRef>();
+                    ref = ref->next.get();
+                }
+
+                ::App::StringID::IndexID prefixID {};
+                prefixID.id = 0;
+
+                uint8_t nameType = 0;
+                str >> nameType;
+                switch (static_cast<BinaryNameType>(nameType)) {
+                    case BinaryNameType::Indexed: {
+                        auto typeIndex = readVarInt(str, stream);
+                        auto elementIndex = static_cast<int>(readVarInt(str, stream));
+                        if (typeIndex == 0 || typeIndex > postfixes.size()) {
+                            FC_THROWM(Base::RuntimeError, "Invalid element name index");// NOLINT
+                        }
+                        ref->name = MappedName(
+                            IndexedName::fromConst(postfixes[typeIndex - 1].constData(),
+                                                   elementIndex));
+                        break;
+                    }
+                    case BinaryNameType::PrefixID: {
+                        QByteArray bytes = readBytes(str, stream);
+                        ref->name = MappedName(bytes.constData(), bytes.size());
+                        prefixID = ::App::StringID::fromString(ref->name.dataBytes());
+                        break;
+                    }
+                    case BinaryNameType::Plain: {
+                        QByteArray bytes = readBytes(str, stream);
+                        ref->name = MappedName(bytes.constData(), bytes.size());
+                        break;
+                    }
+                    default:
+                        FC_THROWM(Base::RuntimeError, "Invalid element name marker");// NOLINT
+                }
+
+                auto postfixIndex = readVarInt(str, stream);
+                if (postfixIndex != 0) {
+                    if (postfixIndex > postfixes.size()) {
+                        postfixWarn = "Invalid element postfix index";
+                    }
+                    else {
+                        // Shares the postfix data with the table
+                        ref->name += postfixes[postfixIndex - 1];
+                    }
+                }
+
+                this->mappedNames.emplace(ref->name, idx);
+
+                auto sidCount = readVarInt(str, stream);
+                if (!hasherRef) {
+                    for (uint64_t l = 0; l < sidCount; ++l) {
+                        readVarInt(str, stream);
+                    }
+                    if (sidCount != 0) {
+                        hasherWarn = "No hasherRef";
+                    }
+                    continue;
+                }
+
+                ref->sids.reserve(static_cast<int>(sidCount) + (prefixID.id != 0 ? 1 : 0));
+                if (prefixID.id != 0) {
+                    auto sid = hasherRef->getID(prefixID.id);
+                    if (!sid) {
+                        hasherIDWarn = "Missing element name prefix id";
+                    }
+                    else {
+                        ref->sids.push_back(sid);
+                    }
+                }
+                for (uint64_t l = 0; l < sidCount; ++l) {
+                    auto sid = hasherRef->getID(static_cast<long>(readVarInt(str, stream)));
+                    if (!sid) {
+                        hasherIDWarn = "Invalid element name string id";
+                    }
+                    else {
+                        ref->sids.push_back(sid);
+                    }
+                }
+            }
+        }
+    }
+    if (hasherWarn) {
+        FC_WARN(hasherWarn);// NOLINT
+    }
+    if (hasherIDWarn) {
+        FC_WARN(hasherIDWarn);// NOLINT
+    }
+    if (postfixWarn) {
+        FC_WARN(postfixWarn);// NOLINT
+    }
+    if (childSIDWarn) {
+        FC_WARN(childSIDWarn);// NOLINT
+    }
+
+    return shared_from_this();
+}
+
 MappedName ElementMap::addName(MappedName& name, const IndexedName& idx, const ElementIDRefs& sids,
                                bool overwrite, IndexedName* existing)
 {
@@ -100,6 +100,19 @@ public:
     */
     ElementMapPtr restore(::App::StringHasherRef hasherRef, std::istream& stream);
 
+    /** Serialize this map in the compact binary format. Indices, tags and string IDs are
+     * stored as variable length integers, and names are written as length prefixed raw bytes
+     * sharing the same postfix table as \c save.
+     * @param stream: serialized stream, must be opened in binary mode
+    */
+    void saveBinary(std::ostream& stream) const;
+
+    /** Deserialize and restore this map from the binary format written by \c saveBinary.
+     * @param hasherRef: where all the StringIDs are stored
+     * @param stream: stream to deserialize
+    */
+    ElementMapPtr restoreBinary(::App::StringHasherRef hasherRef, std::istream& stream);
+
 
     /** Add a sub-element name mapping.
      *
@@ -228,6 +241,16 @@ private:
                           std::vector<ElementMapPtr>& childMaps,
                           const std::vector<std::string>& postfixes);
 
+    /// Binary counterpart of the private \c save
+    void saveBinary(std::ostream& stream, int index,
+                    const std::map<const ElementMap*, int>& childMapSet,
+                    const std::map<QByteArray, int>& postfixMap) const;
+
+    /// Binary counterpart of the private \c restore
+    ElementMapPtr restoreBinary(::App::StringHasherRef hasherRef, std::istream& stream,
+                                std::vector<ElementMapPtr>& childMaps,
+                                const std::vector<QByteArray>& postfixes);
+
     /** Associate the MappedName \c name with the IndexedName \c idx.
      * @param name: the name to add
      * @param idx: the indexed name that \c name will be bound to
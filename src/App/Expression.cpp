@@ -34,6 +34,8 @@
 #include <boost/math/special_functions/round.hpp>
 #include <boost/math/special_functions/trunc.hpp>
 
+#include <climits>
+#include <cmath>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -517,6 +519,77 @@ Py::Object pyFromQuantity(const Quantity &quantity) {
     }
 }
 
+using NumericValue = Expression::NumericValue;
+
+// Mirrors pyFromQuantity()
+static NumericValue numericFromQuantity(const Quantity &quantity) {
+    NumericValue res;
+    if(!quantity.getUnit().isEmpty()) {
+        res.type = NumericValue::Type::Quantity;
+        res.quantity = quantity;
+        return res;
+    }
+    int i;
+    switch(essentiallyInteger(quantity.getValue(),res.integer,i)) {
+    case 1:
+    case 2:
+        res.type = NumericValue::Type::Integer;
+        break;
+    default:
+        res.type = NumericValue::Type::Float;
+        res.quantity = quantity;
+    }
+    return res;
+}
+
+static inline bool isNumericInteger(const NumericValue &value) {
+    return value.type == NumericValue::Type::Integer
+        || value.type == NumericValue::Type::Boolean;
+}
+
+static inline double numericToDouble(const NumericValue &value) {
+    if(isNumericInteger(value))
+        return static_cast<double>(value.integer);
+    return value.quantity.getValue();
+}
+
+// Mirrors pyToQuantity()
+static inline Quantity numericToQuantity(const NumericValue &value) {
+    if(isNumericInteger(value))
+        return Quantity(static_cast<double>(value.integer));
+    return value.quantity;
+}
+
+static inline bool numericIsTrue(const NumericValue &value) {
+    if(isNumericInteger(value))
+        return value.integer != 0;
+    return value.quantity.getValue() != 0.0;
+}
+
+// Mirrors pyObjectToAny()
+static App::any numericToAny(const NumericValue &value) {
+    switch(value.type) {
+    case NumericValue::Type::Integer:
+    case NumericValue::Type::Boolean:
+        return App::any(value.integer);
+    case NumericValue::Type::Quantity:
+        return App::any(value.quantity);
+    default:
+        return App::any(value.quantity.getValue());
+    }
+}
+
+// Mirrors expressionFromPy()
+Expression *expressionFromNumeric(const DocumentObject *owner, const NumericValue &value) {
+    if(value.type == NumericValue::Type::Boolean) {
+        if(value.integer)
+            return new ConstantExpression(owner,"True",Quantity(1.0));
+        else
+            return new ConstantExpression(owner,"False",Quantity(0.0));
+    }
+    return new NumberExpression(owner,numericToQuantity(value));
+}
+
 Quantity anyToQuantity(const App::any &value, const char *msg) {
     if (is_type(value,typeid(Quantity))) {
         return cast<Quantity>(value);
@@ -1107,6 +1180,9 @@ ExpressionPtr Expression::replaceObject(const DocumentObject *parent,
 }
 
 App::any Expression::getValueAsAny() const {
+    NumericValue value;
+    if(getNumericValue(value))
+        return numericToAny(value);
     Base::PyGILStateLocker lock;
     return pyObjectToAny(getPyValue());
 }
@@ -1125,6 +1201,17 @@ Py::Object Expression::getPyValue() const {
     return Py::Object();
 }
 
+bool Expression::getNumericValue(NumericValue &value) const {
+    if(!components.empty())
+        return false;
+    try {
+        return _getNumericValue(value);
+    }catch(Base::Exception &) {
+        // leave the error to the Python evaluation
+        return false;
+    }
+}
+
 void Expression::addComponent(Component *component) {
     assert(component);
     components.push_back(component);
@@ -1138,6 +1225,9 @@ void Expression::visit(ExpressionVisitor &v) {
 }
 
 Expression* Expression::eval() const {
+    NumericValue value;
+    if(getNumericValue(value))
+        return expressionFromNumeric(owner,value);
     Base::PyGILStateLocker lock;
     return expressionFromPy(owner,getPyValue());
 }
@@ -1271,6 +1361,11 @@ Py::Object UnitExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+bool UnitExpression::_getNumericValue(NumericValue &value) const {
+    value = numericFromQuantity(quantity);
+    return true;
+}
+
 //
 // NumberExpression class
 //
@@ -1480,6 +1575,274 @@ Py::Object OperatorExpression::_getPyValue() const {
     return calc(this,op,left,right,false);
 }
 
+// Integer arithmetic as in Python, false if the result does not fit into a long
+
+static bool addLong(long a, long b, long &res) {
+    if((b > 0 && a > LONG_MAX - b) || (b < 0 && a < LONG_MIN - b))
+        return false;
+    res = a + b;
+    return true;
+}
+
+static bool subLong(long a, long b, long &res) {
+    if((b < 0 && a > LONG_MAX + b) || (b > 0 && a < LONG_MIN + b))
+        return false;
+    res = a - b;
+    return true;
+}
+
+static bool mulLong(long a, long b, long &res) {
+    if(a > 0) {
+        if((b > 0 && a > LONG_MAX / b) || (b < 0 && b < LONG_MIN / a))
+            return false;
+    }
+    else if(a < 0) {
+        if((b > 0 && a < LONG_MIN / b) || (b < 0 && b < LONG_MAX / a))
+            return false;
+    }
+    res = a * b;
+    return true;
+}
+
+static bool powLong(long a, long b, long &res) {
+    res = 1;
+    while(b > 0) {
+        if((b & 1) && !mulLong(res, a, res))
+            return false;
+        b >>= 1;
+        if(b > 0 && !mulLong(a, a, a))
+            return false;
+    }
+    return true;
+}
+
+static double modDouble(double a, double b) {
+    double res = std::fmod(a, b);
+    if(res != 0.0) {
+        if((b < 0.0) != (res < 0.0))
+            res += b;
+    }
+    else
+        res = std::copysign(0.0, b);
+    return res;
+}
+
+/**
+  * Compute a binary operator like calc(), but without Python. Returns false
+  * where Python would raise an error, or give a type not handled here.
+  */
+
+static bool calcNumeric(int op, const NumericValue &l, const NumericValue &r, NumericValue &res)
+{
+    using Type = NumericValue::Type;
+
+    switch(op) {
+    case OperatorExpression::LT:
+    case OperatorExpression::LTE:
+    case OperatorExpression::GT:
+    case OperatorExpression::GTE:
+    case OperatorExpression::EQ:
+    case OperatorExpression::NEQ: {
+        bool cmp;
+        if(l.type == Type::Quantity && r.type == Type::Quantity) {
+            // as QuantityPy::richCompare()
+            const Quantity &a = l.quantity;
+            const Quantity &b = r.quantity;
+            switch(op) {
+            case OperatorExpression::LT: cmp = a < b; break;
+            case OperatorExpression::LTE: cmp = a < b || a == b; break;
+            case OperatorExpression::GT: cmp = !(a < b) && !(a == b); break;
+            case OperatorExpression::GTE: cmp = !(a < b); break;
+            case OperatorExpression::EQ: cmp = a == b; break;
+            default: cmp = !(a == b); break;
+            }
+        }
+        else if(isNumericInteger(l) && isNumericInteger(r)) {
+            long a = l.integer;
+            long b = r.integer;
+            switch(op) {
+            case OperatorExpression::LT: cmp = a < b; break;
+            case OperatorExpression::LTE: cmp = a <= b; break;
+            case OperatorExpression::GT: cmp = a > b; break;
+            case OperatorExpression::GTE: cmp = a >= b; break;
+            case OperatorExpression::EQ: cmp = a == b; break;
+            default: cmp = a != b; break;
+            }
+        }
+        else {
+            double a = numericToDouble(l);
+            double b = numericToDouble(r);
+            switch(op) {
+            case OperatorExpression::LT: cmp = a < b; break;
+            case OperatorExpression::LTE: cmp = a <= b; break;
+            case OperatorExpression::GT: cmp = a > b; break;
+            case OperatorExpression::GTE: cmp = a >= b; break;
+            case OperatorExpression::EQ: cmp = a == b; break;
+            default: cmp = a != b; break;
+            }
+        }
+        res.type = Type::Boolean;
+        res.integer = cmp ? 1 : 0;
+        return true;
+    }
+    default:
+        break;
+    }
+
+    if(l.type == Type::Quantity || r.type == Type::Quantity) {
+        // as the number handlers of QuantityPy
+        Quantity a = numericToQuantity(l);
+        Quantity b = numericToQuantity(r);
+        res.type = Type::Quantity;
+        switch(op) {
+        case OperatorExpression::ADD:
+            if(a.getUnit() != b.getUnit())
+                return false;
+            res.quantity = a + b;
+            return true;
+        case OperatorExpression::SUB:
+            if(a.getUnit() != b.getUnit())
+                return false;
+            res.quantity = a - b;
+            return true;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            res.quantity = a * b;
+            return true;
+        case OperatorExpression::DIV:
+            res.quantity = a / b;
+            return true;
+        case OperatorExpression::MOD:
+            if(l.type != Type::Quantity || b.getValue() == 0.0)
+                return false;
+            res.quantity = Quantity(modDouble(a.getValue(), b.getValue()), a.getUnit());
+            return true;
+        case OperatorExpression::POW:
+            if(l.type != Type::Quantity)
+                return false;
+            if(r.type == Type::Quantity)
+                res.quantity = a.pow(b);
+            else
+                res.quantity = a.pow(b.getValue());
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    if(isNumericInteger(l) && isNumericInteger(r)) {
+        long a = l.integer;
+        long b = r.integer;
+        res.type = Type::Integer;
+        switch(op) {
+        case OperatorExpression::ADD:
+            return addLong(a, b, res.integer);
+        case OperatorExpression::SUB:
+            return subLong(a, b, res.integer);
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            return mulLong(a, b, res.integer);
+        case OperatorExpression::DIV:
+            if(b == 0)
+                return false;
+            res.type = Type::Float;
+            res.quantity = Quantity(static_cast<double>(a) / static_cast<double>(b));
+            return true;
+        case OperatorExpression::MOD:
+            if(b == 0)
+                return false;
+            if(b == -1) {
+                res.integer = 0;
+                return true;
+            }
+            res.integer = a % b;
+            if(res.integer != 0 && ((res.integer < 0) != (b < 0)))
+                res.integer += b;
+            return true;
+        case OperatorExpression::POW:
+            if(b >= 0)
+                return powLong(a, b, res.integer);
+            if(a == 0)
+                return false;
+            res.type = Type::Float;
+            res.quantity = Quantity(std::pow(static_cast<double>(a), static_cast<double>(b)));
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    double a = numericToDouble(l);
+    double b = numericToDouble(r);
+    double v;
+    switch(op) {
+    case OperatorExpression::ADD:
+        v = a + b;
+        break;
+    case OperatorExpression::SUB:
+        v = a - b;
+        break;
+    case OperatorExpression::MUL:
+    case OperatorExpression::UNIT:
+        v = a * b;
+        break;
+    case OperatorExpression::DIV:
+        if(b == 0.0)
+            return false;
+        v = a / b;
+        break;
+    case OperatorExpression::MOD:
+        if(b == 0.0)
+            return false;
+        v = modDouble(a, b);
+        break;
+    case OperatorExpression::POW:
+        // Python raises for these, or gives a complex number
+        if((a == 0.0 && b < 0.0) || (a < 0.0 && std::isfinite(b) && b != std::floor(b)))
+            return false;
+        v = std::pow(a, b);
+        if(!std::isfinite(v) && std::isfinite(a) && std::isfinite(b))
+            return false;
+        break;
+    default:
+        return false;
+    }
+    res.type = Type::Float;
+    res.quantity = Quantity(v);
+    return true;
+}
+
+bool OperatorExpression::_getNumericValue(NumericValue &value) const {
+    NumericValue l;
+    if(!left->getNumericValue(l))
+        return false;
+
+    switch(op) {
+    case POS:
+    case NEG:
+        value = l;
+        if(l.type == NumericValue::Type::Boolean)
+            value.type = NumericValue::Type::Integer;
+        if(op == POS)
+            return true;
+        if(isNumericInteger(l)) {
+            if(l.integer == LONG_MIN)
+                return false;
+            value.integer = -l.integer;
+        }
+        else
+            value.quantity = -l.quantity;
+        return true;
+    default:
+        break;
+    }
+
+    NumericValue r;
+    if(!right->getNumericValue(r))
+        return false;
+    return calcNumeric(op,l,r,value);
+}
+
 /**
   * Simplify the expression. For OperatorExpressions, we return a NumberExpression if
   * both the left and right side can be simplified to NumberExpressions. In this case
@@ -2407,6 +2770,36 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         v3 = pyToQuantity(e3,expr,"Invalid third argument.");
     }
 
+    switch (f) {
+    case ROTATIONX:
+    case ROTATIONY:
+    case ROTATIONZ:
+        if (!(v1.isDimensionlessOrUnit(Unit::Angle)))
+            _EXPR_THROW("Unit must be either empty or an angle.", expr);
+
+        return Py::asObject(new Base::RotationPy(Base::Rotation(
+            Vector3d(static_cast<double>(f == ROTATIONX), static_cast<double>(f == ROTATIONY), static_cast<double>(f == ROTATIONZ)),
+            v1.getValue() * M_PI / 180.0)));
+    case TRANSLATIONM:
+        if (v1.isDimensionlessOrUnit(Unit::Length) && v2.isDimensionlessOrUnit(Unit::Length) && v3.isDimensionlessOrUnit(Unit::Length))
+            return translationMatrix(v1.getValue(), v2.getValue(), v3.getValue());
+        _EXPR_THROW("Translation units must be a length or dimensionless.", expr);
+    default:
+        break;
+    }
+
+    return Py::asObject(new QuantityPy(new Quantity(evaluateScalar(expr, f, v1, v2, v3, args.size()))));
+}
+
+/**
+  * Evaluate one of the functions working on numbers and quantities, i.e. those
+  * from ABS to TRUNC. \a argc is the number of arguments given, at most the
+  * first three of them are used.
+  */
+
+Quantity FunctionExpression::evaluateScalar(const Expression *expr, int f,
+        const Quantity &v1, const Quantity &v2, const Quantity &v3, std::size_t argc)
+{
     double output;
     Unit unit;
     double scaler = 1;
@@ -2418,9 +2811,6 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     case COS:
     case SIN:
     case TAN:
-    case ROTATIONX:
-    case ROTATIONY:
-    case ROTATIONZ:
         if (!(v1.isDimensionlessOrUnit(Unit::Angle)))
             _EXPR_THROW("Unit must be either empty or an angle.", expr);
 
@@ -2504,7 +2894,7 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case ATAN2:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (v1.getUnit() != v2.getUnit())
@@ -2513,12 +2903,12 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         scaler = 180.0 / M_PI;
         break;
     case MOD:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         unit = v1.getUnit() / v2.getUnit();
         break;
     case POW: {
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (!v2.isDimensionless())
@@ -2536,23 +2926,15 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     }
     case HYPOT:
     case CATH:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         if (v1.getUnit() != v2.getUnit())
             _EXPR_THROW("Units must be equal.",expr);
 
-        if (args.size() > 2) {
-            if (e3.isNone())
-                _EXPR_THROW("Invalid second argument.",expr);
-            if (v2.getUnit() != v3.getUnit())
-                _EXPR_THROW("Units must be equal.",expr);
-        }
+        if (argc > 2 && v2.getUnit() != v3.getUnit())
+            _EXPR_THROW("Units must be equal.",expr);
         unit = v1.getUnit();
         break;
-    case TRANSLATIONM:
-        if (v1.isDimensionlessOrUnit(Unit::Length) && v2.isDimensionlessOrUnit(Unit::Length) && v3.isDimensionlessOrUnit(Unit::Length))
-            break;
-        _EXPR_THROW("Translation units must be a length or dimensionless.", expr);
     default:
         _EXPR_THROW("Unknown function: " << f,0);
     }
@@ -2617,11 +2999,11 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case HYPOT: {
-        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (argc > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case CATH: {
-        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (argc > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case ROUND:
@@ -2636,25 +3018,34 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     case FLOOR:
         output = floor(value);
         break;
-    case ROTATIONX:
-    case ROTATIONY:
-    case ROTATIONZ:
-        return Py::asObject(new Base::RotationPy(Base::Rotation(
-            Vector3d(static_cast<double>(f == ROTATIONX), static_cast<double>(f == ROTATIONY), static_cast<double>(f == ROTATIONZ)),
-            value)));
-    case TRANSLATIONM:
-        return translationMatrix(v1.getValue(), v2.getValue(), v3.getValue());
     default:
         _EXPR_THROW("Unknown function: " << f,0);
     }
 
-    return Py::asObject(new QuantityPy(new Quantity(scaler * output, unit)));
+    return Quantity(scaler * output, unit);
 }
 
 Py::Object FunctionExpression::_getPyValue() const {
     return evaluate(this,f,args);
 }
 
+bool FunctionExpression::_getNumericValue(NumericValue &value) const {
+    // only the functions handled by evaluateScalar()
+    if(!owner || f <= NONE || f >= VANGLE || args.empty())
+        return false;
+
+    Quantity v[3];
+    for (std::size_t i = 0; i < args.size() && i < 3; ++i) {
+        NumericValue arg;
+        if(!args[i]->getNumericValue(arg))
+            return false;
+        v[i] = numericToQuantity(arg);
+    }
+    value.type = NumericValue::Type::Quantity;
+    value.quantity = evaluateScalar(this, f, v[0], v[1], v[2], args.size());
+    return true;
+}
+
 /**
   * Try to simplify the expression, i.e calculate all constant expressions.
   *
@@ -2969,6 +3360,39 @@ Py::Object VariableExpression::_getPyValue() const {
     return var.getPyValue(true);
 }
 
+bool VariableExpression::_getNumericValue(NumericValue &value) const {
+    auto prop = var.getPlainProperty();
+    if(!prop) {
+        // sub-paths, e.g. the named constraints of a sketch
+        int ptype;
+        prop = var.getProperty(&ptype);
+        if(!prop || ptype || !prop->getQuantityPathValue(var,value.quantity))
+            return false;
+        value.type = NumericValue::Type::Quantity;
+        return true;
+    }
+    // the values as given by getPyObject() of these properties
+    if(auto qprop = freecad_dynamic_cast<PropertyQuantity>(prop)) {
+        value.type = NumericValue::Type::Quantity;
+        value.quantity = qprop->getQuantityValue();
+    }
+    else if(auto fprop = freecad_dynamic_cast<PropertyFloat>(prop)) {
+        value.type = NumericValue::Type::Float;
+        value.quantity = Quantity(fprop->getValue());
+    }
+    else if(auto iprop = freecad_dynamic_cast<PropertyInteger>(prop)) {
+        value.type = NumericValue::Type::Integer;
+        value.integer = iprop->getValue();
+    }
+    else if(auto bprop = freecad_dynamic_cast<PropertyBool>(prop)) {
+        value.type = NumericValue::Type::Boolean;
+        value.integer = bprop->getValue() ? 1 : 0;
+    }
+    else
+        return false;
+    return true;
+}
+
 void VariableExpression::_toString(std::ostream &ss, bool persistent,int) const {
     if(persistent)
         ss << var.toPersistentString();
@@ -3248,6 +3672,16 @@ Py::Object ConditionalExpression::_getPyValue() const {
         return falseExpr->getPyValue();
 }
 
+bool ConditionalExpression::_getNumericValue(NumericValue &value) const {
+    NumericValue cond;
+    if(!condition->getNumericValue(cond))
+        return false;
+    if(numericIsTrue(cond))
+        return trueExpr->getNumericValue(value);
+    else
+        return falseExpr->getNumericValue(value);
+}
+
 Expression *ConditionalExpression::simplify() const
 {
     std::unique_ptr<Expression> e(condition->simplify());
@@ -3334,6 +3768,17 @@ Py::Object ConstantExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+bool ConstantExpression::_getNumericValue(NumericValue &value) const {
+    if(strcmp(name,"None")==0)
+        return false;
+    if(strcmp(name,"True")==0 || strcmp(name,"False")==0) {
+        value.type = NumericValue::Type::Boolean;
+        value.integer = strcmp(name,"True")==0 ? 1 : 0;
+        return true;
+    }
+    return NumberExpression::_getNumericValue(value);
+}
+
 bool ConstantExpression::isNumber() const {
     return strcmp(name,"None")
         && strcmp(name,"True")
@@ -32,13 +32,9 @@
 #include <App/Range.h>
 #include <Base/Exception.h>
 #include <Base/BaseClass.h>
+#include <Base/Quantity.h>
 
 
-namespace Base
-{
-class Quantity;
-}
-
 namespace App  {
 
 class DocumentObject;
@@ -183,6 +179,35 @@ public:
 
     Py::Object getPyValue() const;
 
+    /** A number, boolean or quantity computed without Python
+     *
+     * The type is the one of the Python object the expression would give,
+     * so that both ways of evaluating lead to the same result.
+     */
+    struct NumericValue {
+        enum class Type {
+            Integer,
+            Float,
+            Boolean,
+            Quantity,
+        };
+        Type type = Type::Float;
+        /// the value of an Integer or Boolean
+        long integer = 0;
+        /// the value of a Float or Quantity
+        Base::Quantity quantity;
+    };
+
+    /** Evaluate the expression without Python
+     *
+     * Works for expressions made of numbers, quantities and numeric properties,
+     * and does not need the Python global lock.
+     *
+     * @return false if the expression needs Python or fails, the caller then
+     * has to use getPyValue(), which also reports the error.
+     */
+    bool getNumericValue(NumericValue &value) const;
+
     bool isSame(const Expression &other, bool checkComment=true) const;
 
     friend class ExpressionVisitor;
@@ -209,6 +234,7 @@ protected:
     virtual void _moveCells(const CellAddress &, int, int, ExpressionVisitor &) {}
     virtual void _offsetCells(int, int, ExpressionVisitor &) {}
     virtual Py::Object _getPyValue() const = 0;
+    virtual bool _getNumericValue(NumericValue &) const {return false;}
     virtual void _visit(ExpressionVisitor &) {}
 
 protected:
@@ -220,6 +246,10 @@ public:
     std::string comment;
 };
 
+/// Returns the expression eval() gives for a value of Expression::getNumericValue()
+AppExport Expression *expressionFromNumeric(const App::DocumentObject *owner,
+        const Expression::NumericValue &value);
+
 }
 
 #endif // EXPRESSION_H
@@ -1267,6 +1267,18 @@ Property *ObjectIdentifier::getProperty(int *ptype) const
     return result.resolvedProperty;
 }
 
+Property *ObjectIdentifier::getPlainProperty() const
+{
+    if(!subObjectName.getString().empty())
+        return nullptr;
+    ResolveResults result(*this);
+    if(result.propertyType != PseudoNone
+            || components.size() - result.propertyIndex != 1
+            || !components[result.propertyIndex].isSimple())
+        return nullptr;
+    return result.resolvedProperty;
+}
+
 Property *ObjectIdentifier::resolveProperty(const App::DocumentObject *obj,
         const char *propertyName, App::DocumentObject *&sobj, int &ptype) const
 {
@@ -323,6 +323,9 @@ public:
 
     App::Property *getProperty(int *ptype=nullptr) const;
 
+    /// Returns the property if the path refers to the whole of a real property, else null
+    App::Property *getPlainProperty() const;
+
     App::ObjectIdentifier canonicalPath() const;
 
     // Document-centric functions
@@ -36,6 +36,10 @@ namespace Py {
 class Object;
 }
 
+namespace Base {
+class Quantity;
+}
+
 namespace App
 {
 
@@ -163,6 +167,11 @@ public:
         return false;
     }
 
+    /// Get the quantity the path gives without Python, false if it is not a quantity
+    virtual bool getQuantityPathValue(const App::ObjectIdentifier &, Base::Quantity &) const {
+        return false;
+    }
+
     /// Convert p to a canonical representation of it
     virtual App::ObjectIdentifier canonicalPath(const App::ObjectIdentifier & p) const;
 
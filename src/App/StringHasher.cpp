@@ -25,6 +25,7 @@
 #include <QCryptographicHash>
 #include <QHash>
 #include <deque>
+#include <limits>
 
 #include <Base/Console.h>
 #include <Base/Reader.h>
@@ -501,6 +502,11 @@ void StringHasher::Save(Base::Writer& writer) const
 void StringHasher::SaveDocFile(Base::Writer& writer) const
 {
     std::size_t count = _hashes->SaveAll ? this->size() : this->count();
+    if (writer.getMode("BinaryElementMap")) {
+        writer.Stream() << "StringTableStart v2 " << count << '\n';
+        saveStreamBinary(writer.Stream());
+        return;
+    }
     writer.Stream() << "StringTableStart v1 " << count << '\n';
     saveStream(writer.Stream());
 }
@@ -611,6 +617,12 @@ void StringHasher::RestoreDocFile(Base::Reader& reader)
     _hashes->clear();
     if (marker == "StringTableStart") {
         reader >> ver >> count;
+        if (ver == "v2") {
+            // skip the line break after the header
+            reader.get();
+            restoreStreamBinary(reader, count);
+            return;
+        }
         if (ver != "v1") {
             FC_WARN("Unknown string table format");
         }
@@ -736,6 +748,154 @@ void StringHasher::restoreStreamNew(std::istream& stream, std::size_t count)
     }
 }
 
+namespace
+{
+// String IDs are stored relative to the ID of the string referencing them,
+// which is normally larger, but zigzag encoded in case it is not.
+uint64_t encodeOffset(long offset)
+{
+    auto v = static_cast<int64_t>(offset);
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);  // NOLINT
+}
+
+long decodeOffset(uint64_t value)
+{
+    return static_cast<long>(static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1));
+}
+
+void writeBytes(Base::OutputStream& str, const QByteArray& bytes)
+{
+    str.writeVarInt(bytes.size());
+    str.write(bytes.constData(), bytes.size());
+}
+
+QByteArray readBytes(Base::InputStream& str, std::istream& stream)
+{
+    uint64_t size = 0;
+    str.readVarInt(size);
+    if (!stream || size > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        FC_THROWM(Base::RuntimeError, "Invalid string table");
+    }
+    QByteArray bytes(static_cast<int>(size), Qt::Uninitialized);
+    str.read(bytes.data(), bytes.size());
+    if (!stream) {
+        FC_THROWM(Base::RuntimeError, "Invalid string table");
+    }
+    return bytes;
+}
+}  // namespace
+
+void StringHasher::saveStreamBinary(std::ostream& stream) const
+{
+    Base::OutputStream str(stream);
+    long lastID = 0;
+
+    for (auto& hasher : _hashes->right) {
+        auto& d = *hasher.second;
+        long id = d._id;
+        if (!_hashes->SaveAll && !d.isMarked() && !d.isPersistent()) {
+            continue;
+        }
+
+        // The table is ordered by ID, so only the (positive) difference to
+        // the previous entry is written.
+        str.writeVarInt(id - lastID);
+        lastID = id;
+
+        auto flags = d._flags;
+        flags.setFlag(StringID::Flag::Marked, false);
+        str.writeVarInt(flags.toUnderlyingType());
+
+        str.writeVarInt(d._sids.size());
+        for (auto& sid : d._sids) {
+            str.writeVarInt(encodeOffset(id - sid.value()));
+        }
+
+        if (d.isPostfixed()) {
+            if (!d.isPrefixIDIndex() && !d.isIndexed() && !d.isPrefixID()) {
+                writeBytes(str, d._data);
+            }
+            if (!d.isPostfixEncoded()) {
+                writeBytes(str, d._postfix);
+            }
+        }
+        else {
+            // No base64 encoding needed for hashed or binary data here
+            writeBytes(str, d._data);
+        }
+    }
+}
+
+void StringHasher::restoreStreamBinary(std::istream& stream, std::size_t count)
+{
+    Base::InputStream str(stream);
+    _hashes->clear();
+    long lastID = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        uint64_t value = 0;
+        str.readVarInt(value);
+        long id = lastID + static_cast<long>(value);
+        lastID = id;
+
+        str.readVarInt(value);
+        StringIDRef sid(new StringID(id, QByteArray(), static_cast<StringID::Flag>(value)));
+        StringID& d = *sid._sid;
+
+        uint64_t sidCount = 0;
+        str.readVarInt(sidCount);
+        if (!stream) {
+            FC_THROWM(Base::RuntimeError, "Invalid string table");
+        }
+        d._sids.reserve(static_cast<int>(sidCount));
+        for (uint64_t j = 0; j < sidCount; ++j) {
+            str.readVarInt(value);
+            StringIDRef ref = getID(id - decodeOffset(value));
+            if (!ref) {
+                FC_THROWM(Base::RuntimeError, "Invalid string id reference");
+            }
+            d._sids.push_back(ref);
+        }
+
+        if (!d.isPostfixed()) {
+            d._data = readBytes(str, stream);
+        }
+        else {
+            int offset = 0;
+            if (d.isPostfixEncoded()) {
+                offset = 1;
+                if (d._sids.empty()) {
+                    FC_THROWM(Base::RuntimeError, "Missing string postfix");
+                }
+                d._postfix = d._sids[0]._sid->_data;
+            }
+            if (d.isIndexed()) {
+                if (d._sids.size() <= offset) {
+                    FC_THROWM(Base::RuntimeError, "Missing string prefix");
+                }
+                d._data = d._sids[offset]._sid->_data;
+            }
+            else if (d.isPrefixID() || d.isPrefixIDIndex()) {
+                if (d._sids.size() <= offset) {
+                    FC_THROWM(Base::RuntimeError, "Missing string prefix id");
+                }
+                d._data = d._sids[offset]._sid->toString(0).c_str();
+                if (d.isPrefixIDIndex()) {
+                    d._data += ":";
+                }
+            }
+            else {
+                d._data = readBytes(str, stream);
+            }
+            if (!d.isPostfixEncoded()) {
+                d._postfix = readBytes(str, stream);
+            }
+        }
+
+        insert(sid);
+    }
+}
+
 StringID* StringHasher::insert(const StringIDRef& sid)
 {
     assert(sid && sid._sid->_hasher == nullptr);
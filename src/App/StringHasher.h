@@ -776,6 +776,8 @@ protected:
     void saveStream(std::ostream& stream) const;
     void restoreStream(std::istream& stream, std::size_t count);
     void restoreStreamNew(std::istream& stream, std::size_t count);
+    void saveStreamBinary(std::ostream& stream) const;
+    void restoreStreamBinary(std::istream& stream, std::size_t count);
 
 private:
     std::unique_ptr<HashMap> _hashes;///< Bidirectional map of StringID and its index (a long int).
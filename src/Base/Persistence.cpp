@@ -120,6 +120,7 @@ void Persistence::dumpToStream(std::ostream& stream, int compression)
         writer.setLevel(compression);
         writer.putNextEntry("Persistence.xml");
         writer.setMode("BinaryBrep");
+        writer.setMode("BinaryElementMap");
 
         // save the content (we need to encapsulate it with xml tags to be able to read single
         // element xmls like happen for properties)
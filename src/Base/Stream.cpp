@@ -156,6 +156,16 @@ OutputStream& OutputStream::write(const char* s, int n)
     return *this;
 }
 
+OutputStream& OutputStream::writeVarInt(uint64_t ul)
+{
+    while (ul >= 0x80) {
+        _out.put(static_cast<char>((ul & 0x7f) | 0x80));
+        ul >>= 7;
+    }
+    _out.put(static_cast<char>(ul));
+    return *this;
+}
+
 InputStream::InputStream(std::istream& rin)
     : _in(rin)
 {}
@@ -258,6 +268,22 @@ InputStream& InputStream::read(char* s, int n)
     return *this;
 }
 
+InputStream& InputStream::readVarInt(uint64_t& ul)
+{
+    ul = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int ch = _in.get();
+        if (ch == std::char_traits<char>::eof()) {
+            break;
+        }
+        ul |= static_cast<uint64_t>(ch & 0x7f) << shift;
+        if ((ch & 0x80) == 0) {
+            break;
+        }
+    }
+    return *this;
+}
+
 // ----------------------------------------------------------------------
 
 ByteArrayOStreambuf::ByteArrayOStreambuf(QByteArray& ba)
@@ -97,6 +97,12 @@ public:
 
     OutputStream& write(const char* s, int n);
 
+    /** Writes an unsigned integer as a variable length quantity: seven bits
+     * per byte, least significant group first, the high bit marking that
+     * more bytes follow. Small values thus take only one or two bytes.
+     */
+    OutputStream& writeVarInt(uint64_t ul);
+
     OutputStream(const OutputStream&) = delete;
     OutputStream(OutputStream&&) = delete;
     void operator=(const OutputStream&) = delete;
@@ -130,6 +136,9 @@ public:
 
     InputStream& read(char* s, int n);
 
+    /// Reads an unsigned integer written by OutputStream::writeVarInt()
+    InputStream& readVarInt(uint64_t& ul);
+
     explicit operator bool() const
     {
         // test if _Ipfx succeeded
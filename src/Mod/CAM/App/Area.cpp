@@ -26,7 +26,11 @@
 #define BOOST_GEOMETRY_DISABLE_DEPRECATED_03_WARNING
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
 # include <cfloat>
+# include <future>
+# include <thread>
 
 # include <boost_geometry.hpp>
 # include <boost/geometry/geometries/register/point.hpp>
@@ -39,6 +43,7 @@
 # include <BRepAdaptor_Curve.hxx>
 # include <BRepAdaptor_Surface.hxx>
 # include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBuilderAPI_MakeEdge.hxx>
 # include <BRepBuilderAPI_MakeFace.hxx>
 # include <BRepBuilderAPI_MakeVertex.hxx>
@@ -1520,6 +1525,44 @@ int Area::project(TopoDS_Shape& shape_out,
     return skips;
 }
 
+// A face or edge whose section by a horizontal plane is the same at any height
+static bool isVertical(const TopoDS_Shape& shape) {
+    const gp_Dir dir(0, 0, 1);
+    if (shape.ShapeType() == TopAbs_EDGE) {
+        BRepAdaptor_Curve curve(TopoDS::Edge(shape));
+        return curve.GetType() == GeomAbs_Line
+            && curve.Line().Direction().IsParallel(dir, Precision::Angular());
+    }
+    BRepAdaptor_Surface surface(TopoDS::Face(shape));
+    switch (surface.GetType()) {
+    case GeomAbs_Plane:
+        return surface.Plane().Axis().Direction().IsNormal(dir, Precision::Angular());
+    case GeomAbs_Cylinder:
+        return surface.Cylinder().Axis().Direction().IsParallel(dir, Precision::Angular());
+    case GeomAbs_SurfaceOfExtrusion:
+        return surface.Direction().IsParallel(dir, Precision::Angular());
+    default:
+        return false;
+    }
+}
+
+// Collect the Z range of all non vertical faces and edges of the given solid
+static void getSlopedRanges(const TopoDS_Shape& solid, std::vector<std::pair<double, double> >& ranges) {
+    for (auto type : {TopAbs_FACE, TopAbs_EDGE}) {
+        for (TopExp_Explorer xp(solid, type); xp.More(); xp.Next()) {
+            if (isVertical(xp.Current()))
+                continue;
+            Bnd_Box box;
+            BRepBndLib::Add(xp.Current(), box, Standard_False);
+            if (box.IsVoid())
+                continue;
+            Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+            box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+            ranges.emplace_back(zMin, zMax);
+        }
+    }
+}
+
 std::vector<shared_ptr<Area> > Area::makeSections(
     PARAM_ARGS(PARAM_FARG, AREA_PARAMS_SECTION_EXTRA),
     const std::vector<double>& _heights,
@@ -1673,19 +1716,44 @@ std::vector<shared_ptr<Area> > Area::makeSections(
     bool can_retry = fabs(tolerance) > Precision::Confusion();
     TopLoc_Location locInverse(loc.Inverted());
 
-    for (size_t i = 0; i < heights.size(); ++i) {
+    // The solids of each shape in section coordinate, explored once for all levels
+    std::vector<std::vector<TopoDS_Shape> > solids;
+    if (!project) {
+        solids.reserve(myShapes.size());
+        for (const Shape& s : myShapes) {
+            solids.emplace_back();
+            for (TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next())
+                solids.back().push_back(xp.Current());
+        }
+    }
+
+    struct Level {
+        shared_ptr<Area> area;
+        double z = 0.0;
+        std::vector<std::string> warnings;
+    };
+    std::vector<Level> levels(heights.size());
+
+    auto makeArea = [&](const gp_Pln& pln) {
+        BRepLib_MakeFace mkFace(pln, xMin, xMax, yMin, yMax);
+        shared_ptr<Area> area(std::make_shared<Area>(&myParams));
+        area->myParams.Outline = false;
+        area->setPlane(mkFace.Face().Moved(locInverse));
+        return area;
+    };
+
+    // Slice all shapes at the height of the given level. This may run concurrently
+    // for different levels, so the warnings are kept with the level to be reported
+    // in order afterwards.
+    auto makeLevel = [&](size_t i, const std::vector<std::vector<TopoDS_Shape> >& levelSolids) {
+        Level& level = levels[i];
         double z = heights[i];
         bool retried = !can_retry;
         while (true) {
             gp_Pln pln(gp_Pnt(0, 0, z), gp_Dir(0, 0, 1));
             Standard_Real a, b, c, d;
             pln.Coefficients(a, b, c, d);
-            BRepLib_MakeFace mkFace(pln, xMin, xMax, yMin, yMax);
-            const TopoDS_Shape& face = mkFace.Face();
-
-            shared_ptr<Area> area(std::make_shared<Area>(&myParams));
-            area->myParams.Outline = false;
-            area->setPlane(face.Moved(locInverse));
+            shared_ptr<Area> area = makeArea(pln);
 
             if (project) {
                 for (const auto& s : projectedShapes) {
@@ -1694,20 +1762,22 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                     TopLoc_Location wloc(t);
                     area->add(s.shape.Moved(wloc).Moved(locInverse), s.op);
                 }
-                sections.push_back(area);
-                break;
+                level.area = area;
+                level.z = z;
+                return;
             }
 
-            for (auto it = myShapes.begin(); it != myShapes.end(); ++it) {
+            auto itSolids = levelSolids.begin();
+            for (auto it = myShapes.begin(); it != myShapes.end(); ++it, ++itSolids) {
                 const auto& s = *it;
                 BRep_Builder builder;
                 TopoDS_Compound comp;
                 builder.MakeCompound(comp);
 
-                for (TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next()) {
-                    showShape(xp.Current(), nullptr, "section_%u_shape", i);
+                for (const TopoDS_Shape& solid : *itSolids) {
+                    showShape(solid, nullptr, "section_%u_shape", i);
                     std::list<TopoDS_Wire> wires;
-                    Part::CrossSection section(a, b, c, xp.Current());
+                    Part::CrossSection section(a, b, c, solid);
                     wires = section.slice(-d);
                     showShapes(wires, nullptr, "section_%u_wire", i);
                     if (wires.empty()) {
@@ -1726,7 +1796,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                         mkFace.Build();
                         const TopoDS_Shape& shape = mkFace.Shape();
                         if (shape.IsNull())
-                            AREA_WARN("FaceMakerBullseye return null shape on section");
+                            level.warnings.emplace_back("FaceMakerBullseye return null shape on section");
                         else {
                             showShape(shape, nullptr, "section_%u_face", i);
                             for (auto it = wires.begin(), itNext = it; it != wires.end(); it = itNext) {
@@ -1742,7 +1812,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                         }
                     }
                     catch (Base::Exception& e) {
-                        AREA_WARN("FaceMakerBullseye failed on section: " << e.what());
+                        level.warnings.push_back(std::string("FaceMakerBullseye failed on section: ") + e.what());
                     }
                     for (const TopoDS_Wire& wire : wires)
                         builder.Add(comp, wire);
@@ -1765,21 +1835,124 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                 }
             }
             if (!area->myShapes.empty()) {
-                sections.push_back(area);
+                level.area = area;
+                level.z = z;
                 FC_TIME_LOG(t1, "makeSection " << z);
                 showShape(area->getShape(), nullptr, "section_%u_final", i);
-                break;
+                return;
             }
             if (retried) {
-                AREA_WARN("Discard empty section");
-                break;
+                level.warnings.emplace_back("Discard empty section");
+                return;
             }
-            else {
-                AREA_TRACE("retry section " << z << "->" << z + tolerance);
-                z += tolerance;
-                retried = true;
+            AREA_TRACE("retry section " << z << "->" << z + tolerance);
+            z += tolerance;
+            retried = true;
+        }
+    };
+
+    // Slice the given levels. The levels are independent, so they are shared
+    // among concurrent workers, unless debug output is requested, which adds
+    // document objects and is only readable in level order.
+    auto sliceLevels = [&](const std::vector<size_t>& indices) {
+        // OCC booleans may update the tolerance of their arguments, so each
+        // worker needs solids of its own. The first worker slices the original
+        // ones, the others a copy, and each worker gets a few levels at least
+        // to make up for the copy.
+        const size_t levelsPerWorker = 4;
+        size_t count = std::min<size_t>(std::thread::hardware_concurrency(),
+                                        (indices.size() + levelsPerWorker - 1) / levelsPerWorker);
+        if (count <= 1 || FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG)) {
+            for (size_t i : indices)
+                makeLevel(i, solids);
+            return;
+        }
+        // the copies are made before any worker modifies the original solids
+        std::vector<std::vector<std::vector<TopoDS_Shape> > > copies(count - 1, solids);
+        for (auto& workerSolids : copies) {
+            for (auto& shapeSolids : workerSolids) {
+                for (auto& solid : shapeSolids)
+                    solid = BRepBuilderAPI_Copy(solid).Shape();
             }
         }
+        std::atomic<size_t> next(0);
+        std::vector<std::future<void> > workers;
+        workers.reserve(count);
+        for (size_t n = 0; n < count; ++n) {
+            const auto* workerSolids = n == 0 ? &solids : &copies[n - 1];
+            workers.push_back(std::async(std::launch::async, [&, workerSolids]() {
+                try {
+                    for (size_t k = next++; k < indices.size(); k = next++)
+                        makeLevel(indices[k], *workerSolids);
+                }
+                catch (...) {
+                    next = indices.size();
+                    throw;
+                }
+            }));
+        }
+        for (auto& worker : workers)
+            worker.get();
+    };
+
+    // With SectionReuse, a level whose slab to the previous level contains no
+    // sloped face or edge has the same section as that level, only moved
+    // vertically. reuse[i] is the sliced level it is moved from.
+    std::vector<int> reuse(heights.size(), -1);
+    if (myParams.SectionReuse && !project) {
+        std::vector<std::pair<double, double> > ranges;
+        for (const auto& shapeSolids : solids) {
+            for (const auto& solid : shapeSolids)
+                getSlopedRanges(solid, ranges);
+        }
+        for (size_t i = 1; i < heights.size(); ++i) {
+            double zLow = std::min(heights[i - 1], heights[i]) + Precision::Confusion();
+            double zHigh = std::max(heights[i - 1], heights[i]) - Precision::Confusion();
+            bool prismatic = std::none_of(ranges.begin(), ranges.end(),
+                [=](const std::pair<double, double>& range) {
+                    return range.second > zLow && range.first < zHigh;
+                });
+            if (prismatic)
+                reuse[i] = reuse[i - 1] >= 0 ? reuse[i - 1] : static_cast<int>(i - 1);
+        }
+    }
+
+    std::vector<size_t> indices;
+    indices.reserve(heights.size());
+    for (size_t i = 0; i < heights.size(); ++i) {
+        if (reuse[i] < 0)
+            indices.push_back(i);
+    }
+    sliceLevels(indices);
+
+    indices.clear();
+    for (size_t i = 0; i < heights.size(); ++i) {
+        if (reuse[i] < 0)
+            continue;
+        const Level& source = levels[reuse[i]];
+        // A retried level is off its nominal height, slice again instead
+        if (!source.area || source.z != heights[reuse[i]]) {
+            indices.push_back(i);
+            continue;
+        }
+        double z = heights[i];
+        AREA_TRACE("reuse section " << source.z << "->" << z);
+        shared_ptr<Area> area = makeArea(gp_Pln(gp_Pnt(0, 0, z), gp_Dir(0, 0, 1)));
+        gp_Trsf t;
+        t.SetTranslation(gp_Vec(0, 0, z - source.z));
+        TopLoc_Location wloc(t);
+        for (const auto& s : source.area->myShapes)
+            area->add(s.shape.Moved(loc).Moved(wloc).Moved(locInverse), s.op);
+        levels[i].area = area;
+        levels[i].z = z;
+    }
+    sliceLevels(indices);
+
+    for (const Level& level : levels) {
+        for (const std::string& msg : level.warnings)
+            AREA_WARN(msg);
+        if (level.area)
+            sections.push_back(level.area);
     }
     FC_TIME_LOG(t, "makeSection count: " << sections.size() << ", total");
     return sections;
@@ -3411,7 +3584,7 @@ static inline void addParameter(bool verbose, Command& cmd, const char* name,
         cmd.Parameters[name] = relative ? d : next;
 }
 
-static inline void addGCode(bool verbose, Toolpath& path, const gp_Pnt& last,
+static inline Command makeGCode(bool verbose, const gp_Pnt& last,
     const gp_Pnt& next, const char* name)
 {
     Command cmd;
@@ -3419,19 +3592,25 @@ static inline void addGCode(bool verbose, Toolpath& path, const gp_Pnt& last,
     addParameter(verbose, cmd, "X", last.X(), next.X());
     addParameter(verbose, cmd, "Y", last.Y(), next.Y());
     addParameter(verbose, cmd, "Z", last.Z(), next.Z());
-    path.addCommand(cmd);
+    return cmd;
+}
+
+static inline void addGCode(bool verbose, Toolpath& path, const gp_Pnt& last,
+    const gp_Pnt& next, const char* name)
+{
+    path.addCommand(makeGCode(verbose, last, next, name));
     return;
 }
 
 static inline void addG1(bool verbose, Toolpath& path, const gp_Pnt& last,
     const gp_Pnt& next, double f, double& last_f)
 {
-    addGCode(verbose, path, last, next, "G1");
+    Command cmd = makeGCode(verbose, last, next, "G1");
     if (f > Precision::Confusion()) {
-        Command* cmd = path.getCommands().back();
-        addParameter(verbose, *cmd, "F", last_f, f);
+        addParameter(verbose, cmd, "F", last_f, f);
         last_f = f;
     }
+    path.addCommand(cmd);
     return;
 }
 
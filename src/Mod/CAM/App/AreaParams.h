@@ -160,6 +160,9 @@
         "When the section hits or over the shape boundary, a section with the height of that boundary\n"\
         "will be created. A small offset is usually required to avoid the tangential cut.",\
         App::PropertyPrecision))\
+    ((bool,reuse,SectionReuse,false,"Reuse the previous section, moved to the new height, when the shapes\n"\
+        "are prismatic in between, i.e. only have vertical faces and edges there.\n"\
+        "This saves the slicing of each step down of extruded shapes."))\
      AREA_PARAMS_SECTION_EXTRA
 
 #ifdef AREA_OFFSET_ALGO
@@ -23,7 +23,7 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <cinttypes>
-# include <iomanip>
+# include <cmath>
 # include <boost/algorithm/string.hpp>
 #endif
 
@@ -97,42 +97,52 @@ bool Command::has(const std::string& attr) const
     return Parameters.count(a) > 0;
 }
 
-std::string Command::toGCode (int precision, bool padzero) const
+void Command::appendValue(std::string &out, double value, int precision, bool padzero)
 {
-    std::stringstream str;
-    str.fill('0');
-    str << Name;
+    static const double powers[] = {1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12};
     if(precision<0)
         precision = 0;
-    double scale = std::pow(10.0,precision+1);
+    double scale = precision < 12 ? powers[precision] : std::pow(10.0,precision+1);
     std::int64_t iscale = static_cast<std::int64_t>(scale)/10;
-    for(std::map<std::string,double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
-        if(i->first == "N") continue;
-
-        str << " " << i->first;
+    std::int64_t v = static_cast<std::int64_t>(value*scale);
+    if(v<0) {
+        v = -v;
+        out += '-'; //shall we allow -0 ?
+    }
+    v+=5;
+    v /= 10;
+    out += std::to_string(v/iscale);
+    if(!precision)
+        return;
 
-        std::int64_t v = static_cast<std::int64_t>(i->second*scale);
-        if(v<0) {
-            v = -v;
-            str << '-'; //shall we allow -0 ?
+    std::size_t width = precision;
+    std::int64_t digits = v%iscale;
+    if(!padzero) {
+        if(!digits)
+            return;
+        while(digits%10 == 0) {
+            digits/=10;
+            --width;
         }
-        v+=5;
-        v /= 10;
-        str << (v/iscale);
-        if(!precision) continue;
+    }
+    std::string fraction = std::to_string(digits);
+    out += '.';
+    if (fraction.size() < width)
+        out.append(width - fraction.size(), '0');
+    out += fraction;
+}
 
-        int width = precision;
-        std::int64_t digits = v%iscale;
-        if(!padzero) {
-            if(!digits) continue;
-            while(digits%10 == 0) {
-                digits/=10;
-                --width;
-            }
-        }
-        str << '.' << std::setw(width) << std::right << digits;
+std::string Command::toGCode (int precision, bool padzero) const
+{
+    std::string str(Name);
+    for(std::map<std::string,double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
+        if(i->first == "N") continue;
+
+        str += ' ';
+        str += i->first;
+        appendValue(str, i->second, precision, padzero);
     }
-    return str.str();
+    return str;
 }
 
 void Command::setFromGCode (const std::string& str)
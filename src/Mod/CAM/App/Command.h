@@ -61,6 +61,9 @@ namespace Path
         double getValue(const std::string &name) const; // returns the value of a given parameter
         void scaleBy(double factor); // scales the receiver - use for imperial/metric conversions
 
+        // appends the GCode representation of a parameter value, as used by toGCode()
+        static void appendValue(std::string &out, double value, int precision=6, bool padzero=true);
+
         // this assumes the name is upper case
         inline double getParam(const std::string &name, double fallback = 0.0) const {
             auto it = Parameters.find(name);
@@ -50,14 +50,13 @@ App::DocumentObjectExecReturn *FeatureCompound::execute()
 
     for (std::vector<DocumentObject*>::const_iterator it= Paths.begin();it!=Paths.end();++it) {
         if ((*it)->isDerivedFrom<Path::Feature>()){
-            const std::vector<Command*> &cmds = static_cast<Path::Feature*>(*it)->Path.getValue().getCommands();
-            const Base::Placement pl = static_cast<Path::Feature*>(*it)->Placement.getValue();
-            for (std::vector<Command*>::const_iterator it2= cmds.begin();it2!=cmds.end();++it2) {
-                if (UsePlacements.getValue()) {
-                    result.addCommand((*it2)->transform(pl));
-                } else {
-                    result.addCommand(**it2);
-                }
+            const Path::Toolpath &path = static_cast<Path::Feature*>(*it)->Path.getValue();
+            if (UsePlacements.getValue()) {
+                Path::Toolpath transformed(path);
+                transformed.transform(static_cast<Path::Feature*>(*it)->Placement.getValue());
+                result.addCommands(transformed);
+            } else {
+                result.addCommands(path);
             }
         } else {
             return new App::DocumentObjectExecReturn("Not all objects in group are paths!");
@@ -21,9 +21,19 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cctype>
+# include <cstdint>
+# include <cstdlib>
+# include <future>
+# include <iterator>
+# include <thread>
+#endif
 
 #include <App/Application.h>
 #include <Base/Console.h>
+#include <Base/Exception.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
@@ -37,51 +47,178 @@ using namespace Base;
 
 TYPESYSTEM_SOURCE(Path::Toolpath , Base::Persistence)
 
+namespace {
+
+const std::string ColumnNames[Toolpath::ColumnCount] = {"X", "Y", "Z", "I", "J", "K", "F"};
+
+// the columns in the alphabetical order of their names, as written by Command::toGCode()
+const Toolpath::Column SortedColumns[Toolpath::ColumnCount] = {
+    Toolpath::ColumnF, Toolpath::ColumnI, Toolpath::ColumnJ, Toolpath::ColumnK,
+    Toolpath::ColumnX, Toolpath::ColumnY, Toolpath::ColumnZ,
+};
+
+// the column of each upper case letter, -1 for the extras
+const std::array<int, 26> LetterColumns = [] {
+    std::array<int, 26> columns;
+    columns.fill(-1);
+    for (int col = 0; col < Toolpath::ColumnCount; ++col)
+        columns[ColumnNames[col][0] - 'A'] = col;
+    return columns;
+}();
+
+int columnOf(const std::string &name)
+{
+    if (name.size() != 1)
+        return -1;
+    switch (name[0]) {
+    case 'X': return Toolpath::ColumnX;
+    case 'Y': return Toolpath::ColumnY;
+    case 'Z': return Toolpath::ColumnZ;
+    case 'I': return Toolpath::ColumnI;
+    case 'J': return Toolpath::ColumnJ;
+    case 'K': return Toolpath::ColumnK;
+    case 'F': return Toolpath::ColumnF;
+    default: return -1;
+    }
+}
+
+Toolpath::Opcode opcodeOf(const std::string &name)
+{
+    using Opcode = Toolpath::Opcode;
+    static const std::unordered_map<std::string, Opcode> opcodes = {
+        {"G0", Opcode::Rapid}, {"G00", Opcode::Rapid},
+        {"G1", Opcode::Linear}, {"G01", Opcode::Linear},
+        {"G2", Opcode::ArcCW}, {"G02", Opcode::ArcCW},
+        {"G3", Opcode::ArcCCW}, {"G03", Opcode::ArcCCW},
+        {"G73", Opcode::Cycle}, {"G81", Opcode::Cycle}, {"G82", Opcode::Cycle},
+        {"G83", Opcode::Cycle}, {"G84", Opcode::Cycle}, {"G85", Opcode::Cycle},
+        {"G86", Opcode::Cycle}, {"G89", Opcode::Cycle},
+        {"G38.2", Opcode::Probe}, {"G38.3", Opcode::Probe},
+        {"G38.4", Opcode::Probe}, {"G38.5", Opcode::Probe},
+    };
+    auto it = opcodes.find(name);
+    return it == opcodes.end() ? Opcode::Other : it->second;
+}
+
+void appendParameter(std::string &out, const std::string &name, double value)
+{
+    if (name == "N")
+        return;
+    out += ' ';
+    out += name;
+    Command::appendValue(out, value);
+}
+
+} // namespace
+
 Toolpath::Toolpath()
+    : extraOffsets(1, 0)
 {
 }
 
-Toolpath::Toolpath(const Toolpath& otherPath)
-    : vpcCommands(otherPath.vpcCommands.size())
-    , center(otherPath.center)
+Toolpath::Toolpath(const Toolpath& otherPath) = default;
+
+Toolpath::~Toolpath() = default;
+
+Toolpath &Toolpath::operator=(const Toolpath& otherPath) = default;
+
+void Toolpath::clear()
 {
-    *this = otherPath;
+    names.clear();
+    for (auto &column : columns)
+        column.clear();
+    present.clear();
+    extraOffsets.assign(1, 0);
+    extras.clear();
+    nameTable.clear();
+    nameOpcodes.clear();
+    nameIndex.clear();
+    extraKeyTable.clear();
+    extraKeyIndex.clear();
     recalculate();
 }
 
-Toolpath::~Toolpath()
+unsigned int Toolpath::internName(const std::string &name)
 {
-    clear();
+    auto res = nameIndex.emplace(name, static_cast<unsigned int>(nameTable.size()));
+    if (res.second) {
+        nameTable.push_back(name);
+        nameOpcodes.push_back(opcodeOf(name));
+    }
+    return res.first->second;
 }
 
-Toolpath &Toolpath::operator=(const Toolpath& otherPath)
+unsigned int Toolpath::internExtraKey(const std::string &name)
 {
-    if (this == &otherPath)
-        return *this;
+    auto res = extraKeyIndex.emplace(name, static_cast<unsigned int>(extraKeyTable.size()));
+    if (res.second)
+        extraKeyTable.push_back(name);
+    return res.first->second;
+}
 
-    clear();
-    vpcCommands.resize(otherPath.vpcCommands.size());
-    int i = 0;
-    for (std::vector<Command*>::const_iterator it=otherPath.vpcCommands.begin();it!=otherPath.vpcCommands.end();++it,i++) {
-        vpcCommands[i] = new Command(**it);
+void Toolpath::storeCommand(const Command &cmd, std::size_t pos)
+{
+    std::array<double, ColumnCount> values {};
+    unsigned char mask = 0;
+    const unsigned int begin = extraOffsets[pos];
+    unsigned int count = 0;
+    // Parameters is sorted, so are the extras of each command
+    for (const auto &param : cmd.Parameters) {
+        int col = columnOf(param.first);
+        if (col >= 0) {
+            values[col] = param.second;
+            mask |= 1u << col;
+        } else {
+            extras.insert(extras.begin() + begin + count, Extra {internExtraKey(param.first), param.second});
+            ++count;
+        }
     }
-    center = otherPath.center;
-    recalculate();
-    return *this;
+
+    names.insert(names.begin() + pos, internName(cmd.Name));
+    present.insert(present.begin() + pos, mask);
+    for (int col = 0; col < ColumnCount; ++col)
+        columns[col].insert(columns[col].begin() + pos, values[col]);
+    extraOffsets.insert(extraOffsets.begin() + pos + 1, begin + count);
+    for (std::size_t i = pos + 2; i < extraOffsets.size(); ++i)
+        extraOffsets[i] += count;
 }
 
-void Toolpath::clear()
+void Toolpath::addCommand(const Command &Cmd)
 {
-    for(std::vector<Command*>::iterator it = vpcCommands.begin();it!=vpcCommands.end();++it)
-        delete ( *it );
-    vpcCommands.clear();
+    storeCommand(Cmd, names.size());
     recalculate();
 }
 
-void Toolpath::addCommand(const Command &Cmd)
+void Toolpath::addCommands(const Toolpath &other)
 {
-    Command *tmp = new Command(Cmd);
-    vpcCommands.push_back(tmp);
+    if (&other == this) {
+        Toolpath copy(other);
+        addCommands(copy);
+        return;
+    }
+
+    std::vector<unsigned int> nameMap;
+    nameMap.reserve(other.nameTable.size());
+    for (const auto &name : other.nameTable)
+        nameMap.push_back(internName(name));
+    std::vector<unsigned int> keyMap;
+    keyMap.reserve(other.extraKeyTable.size());
+    for (const auto &key : other.extraKeyTable)
+        keyMap.push_back(internExtraKey(key));
+
+    names.reserve(names.size() + other.names.size());
+    for (unsigned int id : other.names)
+        names.push_back(nameMap[id]);
+    for (int col = 0; col < ColumnCount; ++col)
+        columns[col].insert(columns[col].end(), other.columns[col].begin(), other.columns[col].end());
+    present.insert(present.end(), other.present.begin(), other.present.end());
+
+    const unsigned int base = static_cast<unsigned int>(extras.size());
+    extras.reserve(extras.size() + other.extras.size());
+    for (const Extra &extra : other.extras)
+        extras.push_back(Extra {keyMap[extra.key], extra.value});
+    for (std::size_t i = 1; i < other.extraOffsets.size(); ++i)
+        extraOffsets.push_back(base + other.extraOffsets[i]);
     recalculate();
 }
 
@@ -89,9 +226,8 @@ void Toolpath::insertCommand(const Command &Cmd, int pos)
 {
     if (pos == -1) {
         addCommand(Cmd);
-    } else if (pos <= static_cast<int>(vpcCommands.size())) {
-        Command *tmp = new Command(Cmd);
-        vpcCommands.insert(vpcCommands.begin()+pos,tmp);
+    } else if (pos >= 0 && pos <= static_cast<int>(getSize())) {
+        storeCommand(Cmd, pos);
     } else {
         throw Base::IndexError("Index not in range");
     }
@@ -100,34 +236,143 @@ void Toolpath::insertCommand(const Command &Cmd, int pos)
 
 void Toolpath::deleteCommand(int pos)
 {
-    if (pos == -1) {
-        //delete(*vpcCommands.rbegin()); // causes crash
-        vpcCommands.pop_back();
-    } else if (pos <= static_cast<int>(vpcCommands.size())) {
-        vpcCommands.erase (vpcCommands.begin()+pos);
-    } else {
+    if (pos == -1)
+        pos = static_cast<int>(getSize()) - 1;
+    if (pos < 0 || pos >= static_cast<int>(getSize()))
         throw Base::IndexError("Index not in range");
+
+    const unsigned int begin = extraOffsets[pos];
+    const unsigned int count = extraOffsets[pos + 1] - begin;
+    extras.erase(extras.begin() + begin, extras.begin() + begin + count);
+    extraOffsets.erase(extraOffsets.begin() + pos + 1);
+    for (std::size_t i = pos + 1; i < extraOffsets.size(); ++i)
+        extraOffsets[i] -= count;
+
+    names.erase(names.begin() + pos);
+    present.erase(present.begin() + pos);
+    for (auto &column : columns)
+        column.erase(column.begin() + pos);
+    recalculate();
+}
+
+Command Toolpath::getCommand(unsigned int pos) const
+{
+    if (pos >= getSize())
+        throw Base::IndexError("Index not in range");
+
+    Command cmd;
+    cmd.Name = getName(pos);
+    for (int col = 0; col < ColumnCount; ++col) {
+        if (has(pos, static_cast<Column>(col)))
+            cmd.Parameters[ColumnNames[col]] = columns[col][pos];
+    }
+    for (unsigned int i = extraOffsets[pos]; i < extraOffsets[pos + 1]; ++i)
+        cmd.Parameters[extraKeyTable[extras[i].key]] = extras[i].value;
+    return cmd;
+}
+
+int Toolpath::getExtraKey(const std::string &name) const
+{
+    auto it = extraKeyIndex.find(name);
+    return it == extraKeyIndex.end() ? -1 : static_cast<int>(it->second);
+}
+
+bool Toolpath::hasExtra(unsigned int pos, int key) const
+{
+    if (key < 0)
+        return false;
+    for (unsigned int i = extraOffsets[pos]; i < extraOffsets[pos + 1]; ++i) {
+        if (extras[i].key == static_cast<unsigned int>(key))
+            return true;
+    }
+    return false;
+}
+
+double Toolpath::getExtra(unsigned int pos, int key, double fallback) const
+{
+    if (key < 0)
+        return fallback;
+    for (unsigned int i = extraOffsets[pos]; i < extraOffsets[pos + 1]; ++i) {
+        if (extras[i].key == static_cast<unsigned int>(key))
+            return extras[i].value;
+    }
+    return fallback;
+}
+
+bool Toolpath::has(unsigned int pos, const std::string &name) const
+{
+    int col = columnOf(name);
+    if (col >= 0)
+        return has(pos, static_cast<Column>(col));
+    return hasExtra(pos, getExtraKey(name));
+}
+
+double Toolpath::getParam(unsigned int pos, const std::string &name, double fallback) const
+{
+    int col = columnOf(name);
+    if (col >= 0)
+        return getValue(pos, static_cast<Column>(col), fallback);
+    return getExtra(pos, getExtraKey(name), fallback);
+}
+
+Base::Placement Toolpath::getPlacement(unsigned int pos, const Base::Vector3d &base) const
+{
+    Vector3d vec(getValue(pos, ColumnX, base.x), getValue(pos, ColumnY, base.y), getValue(pos, ColumnZ, base.z));
+    Rotation rot;
+    rot.setYawPitchRoll(getParam(pos, "A"), getParam(pos, "B"), getParam(pos, "C"));
+    return Placement(vec, rot);
+}
+
+Base::Vector3d Toolpath::getArcCenter(unsigned int pos) const
+{
+    return Vector3d(getValue(pos, ColumnI), getValue(pos, ColumnJ), getValue(pos, ColumnK));
+}
+
+void Toolpath::transform(const Base::Placement &plac)
+{
+    const int keys[3] = {getExtraKey("A"), getExtraKey("B"), getExtraKey("C")};
+    for (unsigned int pos = 0; pos < getSize(); ++pos) {
+        Rotation rot;
+        rot.setYawPitchRoll(getExtra(pos, keys[0]), getExtra(pos, keys[1]), getExtra(pos, keys[2]));
+        Placement p(Vector3d(getValue(pos, ColumnX), getValue(pos, ColumnY), getValue(pos, ColumnZ)), rot);
+        p *= plac;
+
+        const Vector3d &vec = p.getPosition();
+        const double xyz[3] = {vec.x, vec.y, vec.z};
+        for (int col = ColumnX; col <= ColumnZ; ++col) {
+            if (has(pos, static_cast<Column>(col)))
+                columns[col][pos] = xyz[col];
+        }
+
+        double abc[3];
+        p.getRotation().getYawPitchRoll(abc[0], abc[1], abc[2]);
+        for (unsigned int i = extraOffsets[pos]; i < extraOffsets[pos + 1]; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                if (keys[k] >= 0 && extras[i].key == static_cast<unsigned int>(keys[k]))
+                    extras[i].value = abc[k];
+            }
+        }
     }
     recalculate();
 }
 
 double Toolpath::getLength()
 {
-    if(vpcCommands.empty())
+    if(names.empty())
         return 0;
     double l = 0;
     Vector3d last(0,0,0);
     Vector3d next;
-    for(std::vector<Command*>::const_iterator it = vpcCommands.begin();it!=vpcCommands.end();++it) {
-        std::string name = (*it)->Name;
-        next = (*it)->getPlacement(last).getPosition();
-        if ( (name == "G0") || (name == "G00") || (name == "G1") || (name == "G01") ) {
+    for (unsigned int pos = 0; pos < getSize(); ++pos) {
+        Opcode op = getOpcode(pos);
+        next = Vector3d(getValue(pos, ColumnX, last.x), getValue(pos, ColumnY, last.y), getValue(pos, ColumnZ, last.z));
+        if ( (op == Opcode::Rapid) || (op == Opcode::Linear) ) {
             // straight line
             l += (next - last).Length();
             last = next;
-        } else if ( (name == "G2") || (name == "G02") || (name == "G3") || (name == "G03") ) {
+        } else if ( (op == Opcode::ArcCW) || (op == Opcode::ArcCCW) ) {
             // arc
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = getArcCenter(pos);
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -156,7 +401,7 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
         vRapid = vFeed;
     }
 
-    if (vpcCommands.empty()) {
+    if (names.empty()) {
         return 0;
     }
     double l = 0;
@@ -164,33 +409,33 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
     bool verticalMove = false;
     Vector3d last(0,0,0);
     Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin();it!=vpcCommands.end();++it) {
-        std::string name = (*it)->Name;
-        float feedrate = (*it)->getParam("F");
+    for (unsigned int pos = 0; pos < getSize(); ++pos) {
+        Opcode op = getOpcode(pos);
+        float feedrate;
 
         l = 0;
         verticalMove = false;
         feedrate = hFeed;
-        next = (*it)->getPlacement(last).getPosition();
+        next = Vector3d(getValue(pos, ColumnX, last.x), getValue(pos, ColumnY, last.y), getValue(pos, ColumnZ, last.z));
 
         if (last.z != next.z){
             verticalMove = true;
             feedrate = vFeed;
         }
 
-        if ((name == "G0") || (name == "G00")){
+        if (op == Opcode::Rapid){
             // Rapid Move
             l += (next - last).Length();
             feedrate = hRapid;
             if(verticalMove){
                 feedrate = vRapid;
             }
-        }else if ((name == "G1") || (name == "G01")) {
+        }else if (op == Opcode::Linear) {
             // Feed Move
             l += (next - last).Length();
-        }else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03") ) {
+        }else if ((op == Opcode::ArcCW) || (op == Opcode::ArcCCW)) {
             // Arc Move
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = getArcCenter(pos);
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -274,91 +519,355 @@ Base::BoundBox3d Toolpath::getBoundBox() const
     return visitor.bb;
 }
 
-static void bulkAddCommand(const std::string &gcodestr, std::vector<Command*> &commands, bool &inches)
+namespace {
+
+// paths with fewer commands, or gcode strings of fewer bytes, are handled by a single thread
+constexpr std::size_t ParallelGCodeMinCommands = 100000;
+constexpr std::size_t ParallelGCodeMinBytes = 4 * 1024 * 1024;
+
+std::size_t gcodeChunkCount(std::size_t size, std::size_t minSize)
 {
-    Command *cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
-    } else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
-    } else {
-        if (inches) {
-            cmd->scaleBy(25.4);
+    if (size < minSize)
+        return 1;
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::min(threads, size / (minSize / 4));
+}
+
+// runs task(i) for each chunk i, chunk 0 in the calling thread
+template<typename Task>
+void runGCodeChunks(std::size_t count, Task &&task)
+{
+    std::vector<std::future<void>> futures;
+    futures.reserve(count);
+    for (std::size_t i = 1; i < count; ++i)
+        futures.push_back(std::async(std::launch::async, task, i));
+    task(0);
+    for (auto &future : futures)
+        future.get();
+}
+
+inline bool isGCodeStart(char c)
+{
+    return c == '(' || c == 'g' || c == 'G' || c == 'm' || c == 'M';
+}
+
+// calls visit(begin, end) for every command or comment of str in [begin, end), with the same
+// splitting rules as the original find_first_of("(gGmM") based loop
+template<typename Visitor>
+void forEachGCodeSegment(const std::string &str, std::size_t begin, std::size_t end, Visitor &&visit)
+{
+    bool comment = false;
+    std::size_t last = std::string::npos;
+    for (std::size_t i = begin; i < end; ++i) {
+        const char c = str[i];
+        if (comment) {
+            if (c == ')') {
+                visit(last, i + 1);
+                last = std::string::npos;
+                comment = false;
+            }
+        } else if (isGCodeStart(c)) {
+            if (last != std::string::npos)
+                visit(last, i);
+            comment = c == '(';
+            last = i;
         }
-        commands.push_back(cmd);
     }
+    // an unterminated comment is dropped
+    if (last != std::string::npos && !comment)
+        visit(last, end);
 }
 
-void Toolpath::setFromGCode(const std::string instr)
+// returns the begin of count chunks of str, each starting at a command outside of any comment
+std::vector<std::size_t> splitGCode(const std::string &str, std::size_t count)
 {
-    clear();
+    std::vector<std::size_t> splits(1, 0);
+    std::size_t target = str.size() / count;
+    bool comment = false;
+    for (std::size_t i = 0; i < str.size() && splits.size() < count; ++i) {
+        const char c = str[i];
+        if (comment) {
+            comment = c != ')';
+        } else if (isGCodeStart(c)) {
+            if (i >= target) {
+                splits.push_back(i);
+                target = str.size() / count * splits.size();
+            }
+            comment = c == '(';
+        }
+    }
+    splits.push_back(str.size());
+    return splits;
+}
 
-    // remove comments
-    //boost::regex e("\\(.*?\\)");
-    //std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
+// std::atof() of a value made of digits, '-' and '.', exact without going through strtod when the
+// value is a plain decimal number whose significant digits fit in a double
+double parseGCodeValue(const std::string &value)
+{
+    static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    std::size_t i = 0;
+    const bool negative = !value.empty() && value[0] == '-';
+    if (negative)
+        ++i;
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    bool point = false;
+    bool any = false;
+    for (; i < value.size(); ++i) {
+        const char c = value[i];
+        if (c == '.' && !point) {
+            point = true;
+        } else if (c >= '0' && c <= '9') {
+            any = true;
+            mantissa = mantissa * 10 + (c - '0');
+            if (mantissa)
+                ++digits;
+            if (point)
+                ++decimals;
+        } else {
+            break;
+        }
+    }
+    if (i != value.size() || !any || digits > 15 || decimals > 22)
+        return std::atof(value.c_str());
+    const double result = static_cast<double>(mantissa) / powers[decimals];
+    return negative ? -result : result;
+}
 
-    // split input string by () or G or M commands
-    std::string mode = "command";
-    std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
-    bool inches = false;
-    while (found != std::string::npos)
-    {
-        if (str[found] == '(') {
-            // start of comment
-            if ( (last > -1) && (mode == "command") ) {
-                // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+// a command as parsed by Command::setFromGCode(), with single letter parameters
+struct ParsedCommand
+{
+    std::string name;
+    double values[26];
+    std::uint32_t mask = 0;
+    std::string key;
+    std::string value;
+};
+
+inline bool isGCodeLetter(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+inline char toUpperLetter(char c)
+{
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+// Command::setFromGCode() for segments made of letters, digits, '-', '.' and white space only;
+// returns false for any other segment, which is then left to Command::setFromGCode().
+bool parseGCodeCommand(const std::string &str, std::size_t begin, std::size_t end, ParsedCommand &cmd)
+{
+    enum { None, Name, Argument } mode = None;
+    cmd.name.clear();
+    cmd.mask = 0;
+    cmd.key.clear();
+    cmd.value.clear();
+    auto storeArgument = [&]() {
+        const int letter = toUpperLetter(cmd.key[0]) - 'A';
+        cmd.values[letter] = parseGCodeValue(cmd.value);
+        cmd.mask |= 1u << letter;
+    };
+    for (std::size_t i = begin; i < end; ++i) {
+        const char c = str[i];
+        if ((c >= '0' && c <= '9') || c == '-' || c == '.') {
+            cmd.value += c;
+        } else if (isGCodeLetter(c)) {
+            if (mode == Name) {
+                if (cmd.key.empty() || cmd.value.empty())
+                    throw Base::BadFormatError("Badly formatted GCode command");
+                for (char n : cmd.key)
+                    cmd.name += toUpperLetter(n);
+                cmd.name += cmd.value;
+                cmd.value.clear();
+                mode = Argument;
+            } else if (mode == None) {
+                mode = Name;
+            } else {
+                if (cmd.key.empty() || cmd.value.empty())
+                    throw Base::BadFormatError("Badly formatted GCode argument");
+                storeArgument();
+                cmd.value.clear();
             }
-            mode = "comment";
-            last = found;
-            found = str.find_first_of(')', found+1);
-        } else if (str[found] == ')') {
-            // end of comment
-            std::string gcodestr = str.substr(last, found-last+1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
-            found = str.find_first_of("(gGmM", found+1);
-            mode = "command";
-        } else if (mode == "command") {
-            // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+            cmd.key.assign(1, c);
+        } else if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return false;
+        }
+    }
+    if (cmd.key.empty() || cmd.value.empty())
+        throw Base::BadFormatError("Badly formatted GCode argument");
+    if (mode == Name) {
+        for (char n : cmd.key)
+            cmd.name += toUpperLetter(n);
+        cmd.name += cmd.value;
+    } else {
+        storeArgument();
+    }
+    return true;
+}
+
+} // namespace
+
+void Toolpath::parseGCode(const std::string &str, std::size_t begin, std::size_t end,
+                          std::vector<std::pair<unsigned int, bool>> &units)
+{
+    ParsedCommand parsed;
+    Command cmd;
+    std::array<int, 26> letterKeys;
+    letterKeys.fill(-1);
+
+    forEachGCodeSegment(str, begin, end, [&](std::size_t first, std::size_t last) {
+        if (str[first] == '(' || !parseGCodeCommand(str, first, last, parsed)) {
+            cmd.setFromGCode(str.substr(first, last - first));
+            if ("G20" == cmd.Name || "G21" == cmd.Name)
+                units.emplace_back(getSize(), "G20" == cmd.Name);
+            else
+                storeCommand(cmd, names.size());
+            return;
+        }
+        if ("G20" == parsed.name || "G21" == parsed.name) {
+            units.emplace_back(getSize(), "G20" == parsed.name);
+            return;
+        }
+
+        names.push_back(internName(parsed.name));
+        for (auto &column : columns)
+            column.push_back(0.0);
+        unsigned char mask = 0;
+        for (int letter = 0; letter < 26; ++letter) {
+            if (!(parsed.mask & (1u << letter)))
+                continue;
+            const int col = LetterColumns[letter];
+            if (col >= 0) {
+                columns[col].back() = parsed.values[letter];
+                mask |= 1u << col;
+                continue;
             }
-            last = found;
-            found = str.find_first_of("(gGmM", found+1);
+            if (letterKeys[letter] < 0)
+                letterKeys[letter] = static_cast<int>(internExtraKey(std::string(1, char('A' + letter))));
+            extras.push_back(Extra {static_cast<unsigned int>(letterKeys[letter]), parsed.values[letter]});
         }
+        present.push_back(mask);
+        extraOffsets.push_back(static_cast<unsigned int>(extras.size()));
+    });
+}
+
+void Toolpath::scaleBy(unsigned int begin, unsigned int end, double factor)
+{
+    // same parameters as Command::scaleBy()
+    for (Column col : {ColumnX, ColumnY, ColumnZ, ColumnI, ColumnJ, ColumnF}) {
+        for (unsigned int pos = begin; pos < end; ++pos)
+            columns[col][pos] *= factor;
     }
-    // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last,std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
+    for (unsigned int i = extraOffsets[begin]; i < extraOffsets[end]; ++i) {
+        switch (extraKeyTable[extras[i].key][0]) {
+            case 'X':
+            case 'Y':
+            case 'Z':
+            case 'I':
+            case 'J':
+            case 'R':
+            case 'Q':
+            case 'F':
+                extras[i].value *= factor;
+                break;
         }
     }
+}
+
+void Toolpath::setFromGCode(const std::string instr)
+{
+    clear();
+
+    // split the input string by () or G or M commands, large inputs are parsed in chunks
+    // concurrently and appended in order
+    const std::size_t count = gcodeChunkCount(instr.size(), ParallelGCodeMinBytes);
+    std::vector<std::pair<unsigned int, bool>> units;
+    if (count == 1) {
+        parseGCode(instr, 0, instr.size(), units);
+    } else {
+        const std::vector<std::size_t> splits = splitGCode(instr, count);
+        const std::size_t chunks = splits.size() - 1;
+        std::vector<Toolpath> parts(chunks);
+        std::vector<std::vector<std::pair<unsigned int, bool>>> partUnits(chunks);
+        runGCodeChunks(chunks, [&](std::size_t i) {
+            parts[i].parseGCode(instr, splits[i], splits[i + 1], partUnits[i]);
+        });
+        for (std::size_t i = 0; i < chunks; ++i) {
+            for (const auto &unit : partUnits[i])
+                units.emplace_back(getSize() + unit.first, unit.second);
+            addCommands(parts[i]);
+        }
+    }
+
+    // G20/G21 switch the unit of the commands that follow them
+    bool inches = false;
+    unsigned int begin = 0;
+    for (const auto &unit : units) {
+        if (inches)
+            scaleBy(begin, unit.first, 25.4);
+        begin = unit.first;
+        inches = unit.second;
+    }
+    if (inches)
+        scaleBy(begin, getSize(), 25.4);
     recalculate();
 }
 
+void Toolpath::appendGCode(std::string &out, unsigned int pos) const
+{
+    out += getName(pos);
+    // merge the columns and the extras in the order of Command::Parameters
+    unsigned int extra = extraOffsets[pos];
+    const unsigned int extraEnd = extraOffsets[pos + 1];
+    for (Column col : SortedColumns) {
+        if (!has(pos, col))
+            continue;
+        for (; extra < extraEnd && extraKeyTable[extras[extra].key] < ColumnNames[col]; ++extra)
+            appendParameter(out, extraKeyTable[extras[extra].key], extras[extra].value);
+        appendParameter(out, ColumnNames[col], columns[col][pos]);
+    }
+    for (; extra < extraEnd; ++extra)
+        appendParameter(out, extraKeyTable[extras[extra].key], extras[extra].value);
+    out += '\n';
+}
+
 std::string Toolpath::toGCode() const
 {
-    std::string result;
-    for (std::vector<Command*>::const_iterator it=vpcCommands.begin();it!=vpcCommands.end();++it) {
-        result += (*it)->toGCode();
-        result += "\n";
+    const std::size_t count = gcodeChunkCount(getSize(), ParallelGCodeMinCommands);
+    if (count == 1) {
+        std::string result;
+        result.reserve(getSize() * 32);
+        for (unsigned int pos = 0; pos < getSize(); ++pos)
+            appendGCode(result, pos);
+        return result;
     }
+
+    // format chunks of commands concurrently, then join them in order
+    std::vector<std::string> parts(count);
+    runGCodeChunks(count, [&](std::size_t i) {
+        const unsigned int begin = static_cast<unsigned int>(getSize() * i / count);
+        const unsigned int end = static_cast<unsigned int>(getSize() * (i + 1) / count);
+        parts[i].reserve((end - begin) * 32);
+        for (unsigned int pos = begin; pos < end; ++pos)
+            appendGCode(parts[i], pos);
+    });
+    std::size_t size = 0;
+    for (const auto &part : parts)
+        size += part.size();
+    std::string result;
+    result.reserve(size);
+    for (const auto &part : parts)
+        result += part;
     return result;
 }
 
 void Toolpath::recalculate() // recalculates the path cache
 {
 
-    if(vpcCommands.empty())
+    if(names.empty())
         return;
 
     // TODO recalculate the KDL stuff. At the moment, this is unused.
@@ -422,7 +931,17 @@ void Toolpath::recalculate() // recalculates the path cache
 
 unsigned int Toolpath::getMemSize () const
 {
-    return toGCode().size();
+    std::size_t size = names.capacity() * sizeof(unsigned int)
+        + present.capacity() * sizeof(unsigned char)
+        + extraOffsets.capacity() * sizeof(unsigned int)
+        + extras.capacity() * sizeof(Extra);
+    for (const auto &column : columns)
+        size += column.capacity() * sizeof(double);
+    for (const auto &name : nameTable)
+        size += sizeof(std::string) + name.capacity() + sizeof(Opcode);
+    for (const auto &key : extraKeyTable)
+        size += sizeof(std::string) + key.capacity();
+    return static_cast<unsigned int>(size);
 }
 
 void Toolpath::setCenter(const Base::Vector3d &c)
@@ -443,7 +962,7 @@ void Toolpath::Save (Writer &writer) const
         writer.incInd();
         saveCenter(writer, center);
         for(unsigned int i = 0; i < getSize(); i++) {
-            vpcCommands[i]->Save(writer);
+            getCommand(i).Save(writer);
         }
         writer.decInd();
     } else {
@@ -458,9 +977,10 @@ void Toolpath::Save (Writer &writer) const
 
 void Toolpath::SaveDocFile (Base::Writer &writer) const
 {
-    if (toGCode().empty())
+    std::string gcode = toGCode();
+    if (gcode.empty())
         return;
-    writer.Stream() << toGCode();
+    writer.Stream() << gcode;
 }
 
 void Toolpath::Restore(XMLReader &reader)
@@ -476,17 +996,23 @@ void Toolpath::Restore(XMLReader &reader)
 
 void Toolpath::RestoreDocFile(Base::Reader &reader)
 {
-    std::string gcode;
-    std::string line;
-    while (reader >> line) {
-        gcode += line;
-        gcode += " ";
+    // the gcode used to be read word by word and joined with single spaces, keep that
+    // normalization of white space (which shows in comments) while reading in one go
+    std::string gcode((std::istreambuf_iterator<char>(reader)), std::istreambuf_iterator<char>());
+    std::size_t size = 0;
+    bool space = true;
+    for (char c : gcode) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            if (!space)
+                gcode[size++] = ' ';
+            space = true;
+        } else {
+            gcode[size++] = c;
+            space = false;
+        }
     }
+    gcode.resize(size);
+    if (!space)
+        gcode += ' ';
     setFromGCode(gcode);
-
 }
-
-
-
-
-
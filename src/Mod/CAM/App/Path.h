@@ -23,6 +23,11 @@
 #ifndef PATH_Path_H
 #define PATH_Path_H
 
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <Base/BoundBox.h>
 #include <Base/Persistence.h>
 #include <Base/Vector3D.h>
@@ -33,13 +38,44 @@
 namespace Path
 {
 
-    /** The representation of a CNC Toolpath */
+    /** The representation of a CNC Toolpath
+     *
+     * The commands are stored column wise rather than as a list of Command
+     * objects: each command keeps the index of its name in a table of the
+     * distinct names of the path, the X, Y, Z, I, J, K and F parameters have
+     * a column each, and all other parameters are kept in a sparse list of
+     * extra parameters. getCommand() returns a Command copy of a single entry,
+     * the column accessors avoid building one.
+     */
 
     class PathExport Toolpath : public Base::Persistence
     {
         TYPESYSTEM_HEADER_WITH_OVERRIDE();
 
         public:
+            /// classification of the command names handled by the path walkers
+            enum class Opcode : unsigned char {
+                Other,
+                Rapid,      // G0
+                Linear,     // G1
+                ArcCW,      // G2
+                ArcCCW,     // G3
+                Cycle,      // G73, G81-G86, G89
+                Probe,      // G38.2-G38.5
+            };
+
+            /// parameters stored in their own column
+            enum Column {
+                ColumnX,
+                ColumnY,
+                ColumnZ,
+                ColumnI,
+                ColumnJ,
+                ColumnK,
+                ColumnF,
+                ColumnCount
+            };
+
             Toolpath();
             Toolpath(const Toolpath&);
             ~Toolpath() override;
@@ -56,6 +92,7 @@ namespace Path
             // interface
             void clear(); // clears the internal data
             void addCommand(const Command &Cmd); // adds a command at the end
+            void addCommands(const Toolpath &other); // adds all commands of another path at the end
             void insertCommand(const Command &Cmd, int); // inserts a command
             void deleteCommand(int); // deletes a command
             double getLength(); // return the Length (mm) of the Path
@@ -64,11 +101,26 @@ namespace Path
             void setFromGCode(const std::string); // sets the path from the contents of the given GCode string
             std::string toGCode() const; // gets a gcode string representation from the Path
             Base::BoundBox3d getBoundBox() const;
+            void transform(const Base::Placement &plac); // transforms all commands, see Command::transform()
 
             // shortcut functions
-            unsigned int getSize() const { return vpcCommands.size(); }
-            const std::vector<Command*> &getCommands() const { return vpcCommands; }
-            const Command &getCommand(unsigned int pos)    const { return *vpcCommands[pos]; }
+            unsigned int getSize() const { return static_cast<unsigned int>(names.size()); }
+            Command getCommand(unsigned int pos) const; // returns a copy of the command at the given position
+
+            // column access, the position is not range checked
+            const std::string &getName(unsigned int pos) const { return nameTable[names[pos]]; }
+            Opcode getOpcode(unsigned int pos) const { return nameOpcodes[names[pos]]; }
+            bool has(unsigned int pos, Column col) const { return (present[pos] & (1u << col)) != 0; }
+            double getValue(unsigned int pos, Column col, double fallback = 0.0) const {
+                return has(pos, col) ? columns[col][pos] : fallback;
+            }
+            int getExtraKey(const std::string &name) const; // returns -1 if no command has the upper case parameter
+            bool hasExtra(unsigned int pos, int key) const;
+            double getExtra(unsigned int pos, int key, double fallback = 0.0) const;
+            bool has(unsigned int pos, const std::string &name) const; // this assumes the name is upper case
+            double getParam(unsigned int pos, const std::string &name, double fallback = 0.0) const;
+            Base::Placement getPlacement(unsigned int pos, const Base::Vector3d &base = Base::Vector3d()) const;
+            Base::Vector3d getArcCenter(unsigned int pos) const; // returns the i,j,k parameters of the command
 
             // support for rotation
             const Base::Vector3d& getCenter() const { return center; }
@@ -77,7 +129,31 @@ namespace Path
             static const int SchemaVersion = 2;
 
         protected:
-            std::vector<Command*> vpcCommands;
+            struct Extra {
+                unsigned int key;
+                double value;
+            };
+
+            void storeCommand(const Command &cmd, std::size_t pos);
+            void parseGCode(const std::string &str, std::size_t begin, std::size_t end,
+                            std::vector<std::pair<unsigned int, bool>> &units);
+            void appendGCode(std::string &out, unsigned int pos) const;
+            void scaleBy(unsigned int begin, unsigned int end, double factor);
+            unsigned int internName(const std::string &name);
+            unsigned int internExtraKey(const std::string &name);
+
+            std::vector<unsigned int> names;                        // index in nameTable of each command
+            std::array<std::vector<double>, ColumnCount> columns;   // 0 where the parameter is not present
+            std::vector<unsigned char> present;                     // bit per column
+            std::vector<unsigned int> extraOffsets;                 // extras of command i are [extraOffsets[i], extraOffsets[i+1])
+            std::vector<Extra> extras;
+
+            std::vector<std::string> nameTable;
+            std::vector<Opcode> nameOpcodes;
+            std::unordered_map<std::string, unsigned int> nameIndex;
+            std::vector<std::string> extraKeyTable;
+            std::unordered_map<std::string, unsigned int> extraKeyIndex;
+
             Base::Vector3d center;
             //KDL::Path_Composite *pcPath;
 
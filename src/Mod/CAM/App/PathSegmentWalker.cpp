@@ -138,30 +138,35 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
 
     cb.setup(last);
 
+    const int keyA = tp.getExtraKey("A");
+    const int keyB = tp.getExtraKey("B");
+    const int keyC = tp.getExtraKey("C");
+    const int keyR = tp.getExtraKey("R");
+    const int keyQ = tp.getExtraKey("Q");
+
     for (unsigned int  i = 0; i < tp.getSize(); i++) {
         std::deque<Base::Vector3d> points;
 
-        const Path::Command &cmd = tp.getCommand(i);
-        const std::string &name = cmd.Name;
-        Base::Vector3d next = cmd.getPlacement().getPosition();
-        double a = A;
-        double b = B;
-        double c = C;
+        const Toolpath::Opcode op = tp.getOpcode(i);
+        const std::string &name = tp.getName(i);
+        Base::Vector3d next(tp.getValue(i, Toolpath::ColumnX),
+                            tp.getValue(i, Toolpath::ColumnY),
+                            tp.getValue(i, Toolpath::ColumnZ));
+        double a = tp.getExtra(i, keyA, A);
+        double b = tp.getExtra(i, keyB, B);
+        double c = tp.getExtra(i, keyC, C);
 
         if (!absolute)
             next = last + next;
-        if (!cmd.has("X")) next.x = last.x;
-        if (!cmd.has("Y")) next.y = last.y;
-        if (!cmd.has("Z")) next.z = last.z;
-        if ( cmd.has("A")) a = cmd.getValue("A");
-        if ( cmd.has("B")) b = cmd.getValue("B");
-        if ( cmd.has("C")) c = cmd.getValue("C");
+        if (!tp.has(i, Toolpath::ColumnX)) next.x = last.x;
+        if (!tp.has(i, Toolpath::ColumnY)) next.y = last.y;
+        if (!tp.has(i, Toolpath::ColumnZ)) next.z = last.z;
 
         Base::Rotation nrot = yawPitchRoll(a, b, c);
 
         Base::Vector3d rnext = compensateRotation(next, nrot, rotCenter);
 
-        if ( (name == "G0") || (name == "G00") || (name == "G1") || (name == "G01") ) {
+        if ( (op == Toolpath::Opcode::Rapid) || (op == Toolpath::Opcode::Linear) ) {
             // straight line
             if (nrot != lrot) {
                 double amax = std::max(fmod(fabs(a - A), 360), std::max(fmod(fabs(b - B), 360), fmod(fabs(c - C), 360)));
@@ -184,7 +189,7 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
                 }
             }
 
-            if ("G0" == name || "G00" == name) {
+            if (op == Toolpath::Opcode::Rapid) {
                 cb.g0(i, last, rnext, points);
             } else {
                 cb.g1(i, last, rnext, points);
@@ -196,20 +201,20 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             C = c;
             lrot = nrot;
 
-        } else if ( (name == "G2") || (name == "G02") || (name == "G3") || (name == "G03") ) {
+        } else if ( (op == Toolpath::Opcode::ArcCW) || (op == Toolpath::Opcode::ArcCCW) ) {
             // arc
             Base::Vector3d norm;
             Base::Vector3d center;
 
-            if ( (name == "G2") || (name == "G02") )
+            if (op == Toolpath::Opcode::ArcCW)
                 norm.*pz = -1.0;
             else
                 norm.*pz = 1.0;
 
             if (absolutecenter)
-                center = cmd.getCenter();
+                center = tp.getArcCenter(i);
             else
-                center = (last + cmd.getCenter());
+                center = (last + tp.getArcCenter(i));
             Base::Vector3d next0(next);
             next0.*pz = 0.0;
             Base::Vector3d last0(last);
@@ -221,10 +226,10 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             // GetAngle will always return the minor angle. Switch if needed
             Base::Vector3d anorm = (last0 - center0) % (next0 - center0);
             if (anorm.*pz < 0) {
-                if(name == "G3" || name == "G03")
+                if(op == Toolpath::Opcode::ArcCCW)
                     angle = M_PI * 2 - angle;
             } else if(anorm.*pz > 0) {
-                if(name == "G2" || name == "G02")
+                if(op == Toolpath::Opcode::ArcCW)
                     angle = M_PI * 2 - angle;
             } else if (angle == 0)
                 angle = M_PI * 2;
@@ -275,11 +280,9 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             // relative mode
             absolutecenter = false;
 
-        } else if ((name=="G73")||(name=="G81")||(name=="G82")||(name=="G83")||(name=="G84")||(name=="G85")||(name=="G86")||(name=="G89")){
+        } else if (op == Toolpath::Opcode::Cycle) {
             // drill,tap,bore
-            double r = 0;
-            if (cmd.has("R"))
-                r = cmd.getValue("R");
+            double r = tp.getExtra(i, keyR);
 
             std::deque<Base::Vector3d> plist;
             std::deque<Base::Vector3d> qlist;
@@ -314,8 +317,8 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             Base::Vector3d p2r = compensateRotation(p2, nrot, rotCenter);
 
             double q;
-            if (cmd.has("Q")) {
-                q = cmd.getValue("Q");
+            if (tp.hasExtra(i, keyQ)) {
+                q = tp.getExtra(i, keyQ);
                 if (q>0) {
                     Base::Vector3d temp(next);
                     for(temp.*pz=r;temp.*pz>next.*pz;temp.*pz-=q) {
@@ -347,7 +350,7 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             lrot = nrot;
 
 
-        } else if ((name=="G38.2")||(name=="G38.3")||(name=="G38.4")||(name=="G38.5")){
+        } else if (op == Toolpath::Opcode::Probe) {
             // Straight probe
             cb.g38(i, last, next);
             last = next;
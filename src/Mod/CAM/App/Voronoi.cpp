@@ -23,7 +23,11 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #define _USE_MATH_DEFINES
+# include <algorithm>
+# include <atomic>
+# include <future>
 # include <math.h>
+# include <thread>
 #endif
 
 #include <Base/Vector3D.h>
@@ -38,10 +42,24 @@ TYPESYSTEM_SOURCE(Path::Voronoi , Base::BaseClass)
 
 // Helpers
 
+// boost stores cells, edges and vertices in vectors, so their index is their offset
+template<typename T>
+static int indexOf(const std::vector<T> &elements, const T *element) {
+  if (!element || elements.empty()) {
+    return Voronoi::InvalidIndex;
+  }
+  std::size_t offset = uintptr_t(element) - uintptr_t(elements.data());
+  if (offset >= elements.size() * sizeof(T)) {
+    return Voronoi::InvalidIndex;
+  }
+  return int(offset / sizeof(T));
+}
+
 // Voronoi::diagram_type
 
 Voronoi::diagram_type::diagram_type()
   :scale(1000)
+  ,constructed(false)
 {
 }
 
@@ -67,45 +85,23 @@ Base::Vector3d Voronoi::diagram_type::scaledVector(const vertex_type &v, double
 
 
 int Voronoi::diagram_type::index(const Voronoi::diagram_type::cell_type   *cell)   const {
-  auto it = cell_index.find(intptr_t(cell));
-  if (it == cell_index.end()) {
-    return Voronoi::InvalidIndex;
-  }
-  return it->second;
+  return indexOf(cells(), cell);
 }
 int Voronoi::diagram_type::index(const Voronoi::diagram_type::edge_type   *edge)   const {
-  auto it = edge_index.find(intptr_t(edge));
-  if (it == edge_index.end()) {
-    return Voronoi::InvalidIndex;
-  }
-  return it->second;
+  return indexOf(edges(), edge);
 }
 int Voronoi::diagram_type::index(const Voronoi::diagram_type::vertex_type *vertex) const {
-  auto it = vertex_index.find(intptr_t(vertex));
-  if (it == vertex_index.end()) {
-    return Voronoi::InvalidIndex;
-  }
-  return it->second;
+  return indexOf(vertices(), vertex);
 }
 
-void Voronoi::diagram_type::reIndex() {
-  int idx = 0;
-  cell_index.clear();
-  edge_index.clear();
-  vertex_index.clear();
+bool Voronoi::diagram_type::isConstructed() const {
+  return constructed && constructedPoints == points && constructedSegments == segments;
+}
 
-  idx = 0;
-  for (auto it = cells().begin(); it != cells().end(); ++it, ++idx) {
-    cell_index[intptr_t(&(*it))] = idx;
-  }
-  idx = 0;
-  for (auto it = edges().begin(); it != edges().end(); ++it, ++idx) {
-    edge_index[intptr_t(&(*it))] = idx;
-  }
-  idx = 0;
-  for (auto it = vertices().begin(); it != vertices().end(); ++it, ++idx) {
-    vertex_index[intptr_t(&(*it))] = idx;
-  }
+void Voronoi::diagram_type::setConstructed() {
+  constructedPoints = points;
+  constructedSegments = segments;
+  constructed = true;
 }
 
 Voronoi::point_type Voronoi::diagram_type::retrievePoint(const Voronoi::diagram_type::cell_type *cell) const {
@@ -179,9 +175,49 @@ long Voronoi::numVertices() const {
 
 void Voronoi::construct()
 {
+  if (vd->isConstructed()) {
+    // same input as before, only the colors have to be reset
+    for (auto it = vd->cells().begin(); it != vd->cells().end(); ++it) {
+      it->color(0);
+    }
+    for (auto it = vd->edges().begin(); it != vd->edges().end(); ++it) {
+      it->color(0);
+    }
+    for (auto it = vd->vertices().begin(); it != vd->vertices().end(); ++it) {
+      it->color(0);
+    }
+    return;
+  }
   vd->clear();
   construct_voronoi(vd->points.begin(), vd->points.end(), vd->segments.begin(), vd->segments.end(), static_cast<voronoi_diagram_type*>(vd));
-  vd->reIndex();
+  vd->setConstructed();
+}
+
+void Voronoi::constructAll(const std::vector<Voronoi*> &diagrams)
+{
+  // the diagrams are independent, e.g. one for each face to be carved
+  std::vector<Voronoi*> todo(diagrams);
+  std::sort(todo.begin(), todo.end());
+  todo.erase(std::unique(todo.begin(), todo.end()), todo.end());
+
+  std::atomic<std::size_t> next(0);
+  auto worker = [&]() {
+    for (std::size_t i = next++; i < todo.size(); i = next++) {
+      todo[i]->construct();
+    }
+  };
+  std::size_t count = std::min<std::size_t>(std::thread::hardware_concurrency(), todo.size());
+  if (count <= 1) {
+    worker();
+    return;
+  }
+  std::vector<std::future<void>> workers;
+  for (std::size_t i = 0; i < count; ++i) {
+    workers.push_back(std::async(std::launch::async, worker));
+  }
+  for (auto &w : workers) {
+    w.get();
+  }
 }
 
 void Voronoi::colorExterior(const Voronoi::diagram_type::edge_type *edge, std::size_t colorValue) {
@@ -76,19 +76,16 @@ namespace Path
       Base::Vector3d scaledVector(const point_type &p, double z) const;
       Base::Vector3d scaledVector(const vertex_type &v, double z) const;
 
-      using cell_map_type = std::map<intptr_t, int>;
-      using edge_map_type = std::map<intptr_t, int>;
-      using vertex_map_type = std::map<intptr_t, int>;
-
       int index(const cell_type   *cell)   const;
       int index(const edge_type   *edge)   const;
       int index(const vertex_type *vertex) const;
 
-      void reIndex();
-
       std::vector<point_type>       points;
       std::vector<segment_type>     segments;
 
+      bool isConstructed() const;
+      void setConstructed();
+
       point_type    retrievePoint(const cell_type *cell) const;
       segment_type  retrieveSegment(const cell_type *cell) const;
 
@@ -98,9 +95,10 @@ namespace Path
 
     private:
       double          scale;
-      cell_map_type   cell_index;
-      edge_map_type   edge_index;
-      vertex_map_type vertex_index;
+      // the input the diagram was last constructed from
+      std::vector<point_type>   constructedPoints;
+      std::vector<segment_type> constructedSegments;
+      bool                      constructed;
     };
 
     void addPoint(const point_type &p);
@@ -109,6 +107,7 @@ namespace Path
     long numSegments() const;
 
     void construct();
+    static void constructAll(const std::vector<Voronoi*> &diagrams);
     long numCells() const;
     long numEdges() const;
     long numVertices() const;
@@ -114,6 +114,26 @@ PyObject* VoronoiPy::construct(PyObject *args) {
   return Py_None;
 }
 
+PyObject* VoronoiPy::constructAll(PyObject *args) {
+  PyObject *list = nullptr;
+  if (!PyArg_ParseTuple(args, "O", &list)) {
+    throw  Py::RuntimeError("constructAll requires a list of diagrams");
+  }
+  std::vector<Voronoi*> diagrams;
+  Py::Sequence seq(list);
+  for (auto it = seq.begin(); it != seq.end(); ++it) {
+    PyObject *item = (*it).ptr();
+    if (!PyObject_TypeCheck(item, &VoronoiPy::Type)) {
+      throw Py::TypeError("constructAll requires a list of diagrams");
+    }
+    diagrams.push_back(static_cast<VoronoiPy*>(item)->getVoronoiPtr());
+  }
+  Voronoi::constructAll(diagrams);
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
 PyObject* VoronoiPy::numCells(PyObject *args)
 {
   if (!PyArg_ParseTuple(args, "")) {
@@ -324,6 +344,62 @@ PyObject* VoronoiPy::numSegments(PyObject *args)
   return PyLong_FromLong(getVoronoiPtr()->vd->segments.size());
 }
 
+static long arrayIndex(int index) {
+  return index == Voronoi::InvalidIndex ? -1 : index;
+}
+
+PyObject* VoronoiPy::getVertexArray(PyObject *args) {
+  double z = 0;
+  if (!PyArg_ParseTuple(args, "|d", &z)) {
+    throw Py::RuntimeError("Optional z argument (double) accepted");
+  }
+  Voronoi::diagram_type *dia = getVoronoiPtr()->vd;
+  Py::List list(dia->num_vertices());
+  Py::List::size_type i = 0;
+  for (auto it = dia->vertices().begin(); it != dia->vertices().end(); ++it, ++i) {
+    Base::Vector3d v = dia->scaledVector(*it, z);
+    list[i] = Py::TupleN(Py::Float(v.x), Py::Float(v.y), Py::Float(v.z));
+  }
+  return Py::new_reference_to(list);
+}
+
+PyObject* VoronoiPy::getEdgeArray(PyObject *args) {
+  if (!PyArg_ParseTuple(args, "")) {
+    throw  Py::RuntimeError("no arguments accepted");
+  }
+  Voronoi::diagram_type *dia = getVoronoiPtr()->vd;
+  Py::List list(dia->num_edges());
+  Py::List::size_type i = 0;
+  for (auto it = dia->edges().begin(); it != dia->edges().end(); ++it, ++i) {
+    Py::Tuple tuple(7);
+    tuple[0] = Py::Long(arrayIndex(dia->index(it->vertex0())));
+    tuple[1] = Py::Long(arrayIndex(dia->index(it->vertex1())));
+    tuple[2] = Py::Long(arrayIndex(dia->index(it->twin())));
+    tuple[3] = Py::Long(arrayIndex(dia->index(it->cell())));
+    tuple[4] = Py::Long(static_cast<unsigned long>(it->color()));
+    tuple[5] = Py::Boolean(it->is_primary());
+    tuple[6] = Py::Boolean(it->is_linear());
+    list[i] = tuple;
+  }
+  return Py::new_reference_to(list);
+}
+
+PyObject* VoronoiPy::getCellArray(PyObject *args) {
+  if (!PyArg_ParseTuple(args, "")) {
+    throw  Py::RuntimeError("no arguments accepted");
+  }
+  Voronoi::diagram_type *dia = getVoronoiPtr()->vd;
+  Py::List list(dia->num_cells());
+  Py::List::size_type i = 0;
+  for (auto it = dia->cells().begin(); it != dia->cells().end(); ++it, ++i) {
+    list[i] = Py::TupleN(Py::Long(static_cast<long>(it->source_index())),
+                         Py::Long(static_cast<long>(it->source_category())),
+                         Py::Long(static_cast<unsigned long>(it->color())),
+                         Py::Long(arrayIndex(dia->index(it->incident_edge()))));
+  }
+  return Py::new_reference_to(list);
+}
+
 
 // custom attributes get/set
 
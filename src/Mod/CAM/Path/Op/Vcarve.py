@@ -381,12 +381,17 @@ class ObjectVcarve(PathEngraveBase.ObjectOp):
                 for i in range(len(ptv) - 1):
                     vd.addSegment(ptv[i], ptv[i + 1])
 
+        diagrams = []
         for f in faces:
-            voronoiWires = []
             vd = Path.Voronoi.Diagram()
             insert_many_wires(vd, f.Wires)
+            diagrams.append(vd)
+
+        # the faces are independent, construct their diagrams concurrently
+        Path.Voronoi.Diagram.constructAll(diagrams)
 
-            vd.construct()
+        for f, vd in zip(faces, diagrams):
+            voronoiWires = []
 
             for e in vd.Edges:
                 if e.isPrimary():
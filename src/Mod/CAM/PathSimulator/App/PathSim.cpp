@@ -22,6 +22,10 @@
 
 #include "PreCompiled.h"
 
+#include <Base/Converter.h>
+#include <Base/Exception.h>
+#include <Mod/CAM/App/PathSegmentWalker.h>
+
 #include "PathSim.h"
 
 
@@ -49,6 +53,33 @@ void PathSim::SetToolShape(const TopoDS_Shape& toolShape, float resolution)
 	m_tool = std::make_unique<cSimTool>(toolShape, resolution);
 }
 
+void PathSim::SetToolProfile(cSimTool::ToolType type, float diameter, float cornerRadius, float angle, float resolution)
+{
+	m_tool = std::make_unique<cSimTool>(type, diameter, cornerRadius, angle, resolution);
+}
+
+void PathSim::SetModel(const Data::ComplexGeoData & model, double accuracy)
+{
+	if (!m_stock)
+		throw Base::RuntimeError("Simulation has no stock object");
+
+	std::vector<Base::Vector3d> points;
+	std::vector<Data::ComplexGeoData::Facet> facets;
+	model.getFaces(points, facets, accuracy);
+
+	std::vector<MeshCore::MeshGeomFacet> meshFacets;
+	meshFacets.reserve(facets.size());
+	for (const auto & facet : facets)
+	{
+		MeshCore::MeshGeomFacet meshFacet;
+		meshFacet._aclPoints[0] = Base::convertTo<Base::Vector3f>(points[facet.I1]);
+		meshFacet._aclPoints[1] = Base::convertTo<Base::Vector3f>(points[facet.I2]);
+		meshFacet._aclPoints[2] = Base::convertTo<Base::Vector3f>(points[facet.I3]);
+		meshFacets.push_back(meshFacet);
+	}
+	m_stock->SetModel(meshFacets);
+}
+
 Base::Placement * PathSim::ApplyCommand(Base::Placement * pos, Command * cmd)
 {
 	Point3D fromPos(*pos);
@@ -80,6 +111,85 @@ Base::Placement * PathSim::ApplyCommand(Base::Placement * pos, Command * cmd)
 	return plc;
 }
 
+namespace {
+
+// collects the straight moves of a path, arcs are already split by the walker
+class MoveCollector : public Path::PathSegmentVisitor
+{
+public:
+	explicit MoveCollector(std::vector<cSimMove> & moves) : moves(moves) {}
+
+	void g0(int id, const Vector3d & last, const Vector3d & next, const std::deque<Vector3d> & pts) override
+	{
+		addPolyline(id, last, pts, next, true);
+	}
+
+	void g1(int id, const Vector3d & last, const Vector3d & next, const std::deque<Vector3d> & pts) override
+	{
+		addPolyline(id, last, pts, next, false);
+	}
+
+	void g23(int id, const Vector3d & last, const Vector3d & next, const std::deque<Vector3d> & pts,
+		const Vector3d & /*center*/) override
+	{
+		addPolyline(id, last, pts, next, false);
+	}
+
+	void g8x(int id, const Vector3d & last, const Vector3d & next, const std::deque<Vector3d> & pts,
+		const std::deque<Vector3d> & p, const std::deque<Vector3d> & /*q*/) override
+	{
+		// p holds the position above the hole, the retract plane and the final retract position
+		addPolyline(id, last, pts, p[0], true);
+		addMove(id, p[0], p[1], true);
+		addMove(id, p[1], next, false);
+		addMove(id, next, p[2], true);
+	}
+
+	void g38(int id, const Vector3d & last, const Vector3d & next) override
+	{
+		addMove(id, last, next, false);
+	}
+
+private:
+	void addMove(int id, const Vector3d & from, const Vector3d & to, bool rapid)
+	{
+		moves.emplace_back(Point3D(from.x, from.y, from.z), Point3D(to.x, to.y, to.z), id, rapid);
+	}
+
+	void addPolyline(int id, Vector3d last, const std::deque<Vector3d> & pts, const Vector3d & next, bool rapid)
+	{
+		for (const Vector3d & pt : pts)
+		{
+			addMove(id, last, pt, rapid);
+			last = pt;
+		}
+		addMove(id, last, next, rapid);
+	}
+
+	std::vector<cSimMove> & moves;
+};
+
+}
+
+std::vector<cSimGouge> PathSim::ApplyToolpath(const Toolpath & path, const Base::Vector3d & start, float tolerance,
+	int threads)
+{
+	if (!m_stock)
+		throw Base::RuntimeError("Simulation has no stock object");
+	if (!m_tool)
+		throw Base::RuntimeError("Simulation has no tool");
+
+	std::vector<cSimMove> moves;
+	moves.reserve(path.getSize());
+	MoveCollector collector(moves);
+	PathSegmentWalker walker(path);
+	walker.walk(collector, start);
+
+	std::vector<cSimGouge> gouges;
+	m_stock->ApplyMoves(moves, *m_tool, gouges, tolerance, threads);
+	return gouges;
+}
+
 
 
 
@@ -26,7 +26,9 @@
 #include <memory>
 #include <TopoDS_Shape.hxx>
 
+#include <App/ComplexGeoData.h>
 #include <Mod/CAM/App/Command.h>
+#include <Mod/CAM/App/Path.h>
 #include <Mod/Part/App/TopoShape.h>
 #include <Mod/CAM/PathGlobal.h>
 
@@ -50,7 +52,14 @@ namespace PathSimulator
 
 			void BeginSimulation(Part::TopoShape * stock, float resolution);
 			void SetToolShape(const TopoDS_Shape& toolShape, float resolution);
+			void SetToolProfile(cSimTool::ToolType type, float diameter, float cornerRadius, float angle, float resolution);
+			void SetModel(const Data::ComplexGeoData & model, double accuracy);
 			Base::Placement * ApplyCommand(Base::Placement * pos, Command * cmd);
+			/// Simulate a whole path starting at the given position, returns the commands that
+			/// rapid into the stock or cut into the model deeper than tolerance. threads is the
+			/// number of stock bands simulated at once, 0 for the number of cores
+			std::vector<cSimGouge> ApplyToolpath(const Toolpath & path, const Base::Vector3d & start, float tolerance,
+				int threads = 0);
 
 		public:
 			std::unique_ptr<cStock> m_stock;
@@ -22,11 +22,14 @@
 
 #include "PreCompiled.h"
 
+#include <App/ComplexGeoDataPy.h>
 #include <Base/PlacementPy.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
+#include <Base/VectorPy.h>
 
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/CAM/App/CommandPy.h>
+#include <Mod/CAM/App/PathPy.h>
 #include <Mod/Part/App/TopoShapePy.h>
 
 #include "PathSim.h"
@@ -83,6 +86,50 @@ PyObject* PathSimPy::SetToolShape(PyObject * args)
 	return Py_None;
 }
 
+PyObject* PathSimPy::SetToolProfile(PyObject * args, PyObject * kwds)
+{
+	static const std::array<const char *, 6> kwlist { "type", "diameter", "resolution", "cornerRadius", "angle", nullptr };
+	const char *type;
+	float diameter, resolution;
+	float cornerRadius = 0;
+	float angle = 0;
+	if (!Base::Wrapped_ParseTupleAndKeywords(args, kwds, "sff|ff", kwlist, &type, &diameter, &resolution, &cornerRadius, &angle))
+		return nullptr;
+
+	cSimTool::ToolType toolType;
+	if (strcmp(type, "Flat") == 0)
+		toolType = cSimTool::Flat;
+	else if (strcmp(type, "Ball") == 0)
+		toolType = cSimTool::Ball;
+	else if (strcmp(type, "Bull") == 0)
+		toolType = cSimTool::Bull;
+	else if (strcmp(type, "V") == 0)
+		toolType = cSimTool::VBit;
+	else
+	{
+		PyErr_SetString(PyExc_ValueError, "Tool type must be one of 'Flat', 'Ball', 'Bull' or 'V'");
+		return nullptr;
+	}
+	PY_TRY {
+		getPathSimPtr()->SetToolProfile(toolType, diameter, cornerRadius, angle, resolution);
+	} PY_CATCH
+	Py_Return;
+}
+
+PyObject* PathSimPy::SetModel(PyObject * args, PyObject * kwds)
+{
+	static const std::array<const char *, 3> kwlist { "model", "accuracy", nullptr };
+	PyObject *pObjModel;
+	double accuracy = 0.01;
+	if (!Base::Wrapped_ParseTupleAndKeywords(args, kwds, "O!|d", kwlist, &(Data::ComplexGeoDataPy::Type), &pObjModel, &accuracy))
+		return nullptr;
+	PY_TRY {
+		const Data::ComplexGeoData *model = static_cast<Data::ComplexGeoDataPy*>(pObjModel)->getComplexGeoDataPtr();
+		getPathSimPtr()->SetModel(*model, accuracy);
+	} PY_CATCH
+	Py_Return;
+}
+
 PyObject* PathSimPy::GetResultMesh(PyObject * args)
 {
 	if (!PyArg_ParseTuple(args, ""))
@@ -125,6 +172,31 @@ PyObject* PathSimPy::ApplyCommand(PyObject * args, PyObject * kwds)
 	return newposPy;
 }
 
+PyObject* PathSimPy::ApplyToolpath(PyObject * args, PyObject * kwds)
+{
+	static const std::array<const char *, 5> kwlist { "path", "position", "tolerance", "threads", nullptr };
+	PyObject *pObjPath;
+	PyObject *pObjPos;
+	float tolerance = 0.01f;
+	int threads = 0;
+	if (!Base::Wrapped_ParseTupleAndKeywords(args, kwds, "O!O!|fi", kwlist, &(Path::PathPy::Type), &pObjPath,
+											 &(Base::VectorPy::Type), &pObjPos, &tolerance, &threads))
+		return nullptr;
+	PY_TRY {
+		const Path::Toolpath *path = static_cast<Path::PathPy*>(pObjPath)->getToolpathPtr();
+		Base::Vector3d pos = *static_cast<Base::VectorPy*>(pObjPos)->getVectorPtr();
+		std::vector<cSimGouge> gouges = getPathSimPtr()->ApplyToolpath(*path, pos, tolerance, threads);
+		Py::List ret;
+		for (const cSimGouge & gouge : gouges)
+		{
+			ret.append(Py::TupleN(Py::Long(gouge.id),
+								  Py::String(gouge.type == SIM_GOUGE_RAPID ? "Rapid" : "Model"),
+								  Py::Float(gouge.depth)));
+		}
+		return Py::new_reference_to(ret);
+	} PY_CATCH
+}
+
 Py::Object PathSimPy::getTool() const
 {
     //return Py::Object();
@@ -23,6 +23,11 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <future>
+#include <map>
+#include <thread>
 #endif
 
 #include <BRepBndLib.hxx>
@@ -37,7 +42,7 @@
 // stock
 //************************************************************************************************************
 cStock::cStock(float px, float py, float pz, float lx, float ly, float lz, float res)
-	: m_px(px), m_py(py), m_pz(pz), m_lx(lx), m_ly(ly), m_lz(lz), m_res(res)
+	: m_hasModel(false), m_px(px), m_py(py), m_pz(pz), m_lx(lx), m_ly(ly), m_lz(lz), m_res(res)
 {
 	m_x = (int)(m_lx / res) + 1;
 	m_y = (int)(m_ly / res) + 1;
@@ -666,6 +671,212 @@ void cStock::ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimT
 	}
 }
 
+void cStock::SetModel(const std::vector<MeshCore::MeshGeomFacet> & facets)
+{
+	m_model.Init(m_x, m_y);
+	for (int y = 0; y < m_y; y++)
+		for (int x = 0; x < m_x; x++)
+			m_model[x][y] = -FLT_MAX;
+	m_hasModel = true;
+
+	// keep the top most model surface above the center of each stock pixel
+	for (const MeshCore::MeshGeomFacet & facet : facets)
+	{
+		float px[3], py[3], pz[3];
+		for (int i = 0; i < 3; i++)
+		{
+			px[i] = (facet._aclPoints[i][0] - m_px) / m_res;
+			py[i] = (facet._aclPoints[i][1] - m_py) / m_res;
+			pz[i] = facet._aclPoints[i][2];
+		}
+		float area = (px[1] - px[0]) * (py[2] - py[0]) - (px[2] - px[0]) * (py[1] - py[0]);
+		if (fabs(area) < SIM_EPSILON)
+			continue;   // vertical facets are covered by their neighbours
+		int xs = std::max(0, (int)ceil(std::min({px[0], px[1], px[2]}) - 0.5f));
+		int xe = std::min(m_x - 1, (int)floor(std::max({px[0], px[1], px[2]}) - 0.5f));
+		int ys = std::max(0, (int)ceil(std::min({py[0], py[1], py[2]}) - 0.5f));
+		int ye = std::min(m_y - 1, (int)floor(std::max({py[0], py[1], py[2]}) - 0.5f));
+		for (int y = ys; y <= ye; y++)
+		{
+			float cy = y + 0.5f;
+			for (int x = xs; x <= xe; x++)
+			{
+				float cx = x + 0.5f;
+				float w0 = ((px[1] - cx) * (py[2] - cy) - (px[2] - cx) * (py[1] - cy)) / area;
+				float w1 = ((px[2] - cx) * (py[0] - cy) - (px[0] - cx) * (py[2] - cy)) / area;
+				float w2 = 1.0f - w0 - w1;
+				if (w0 < 0 || w1 < 0 || w2 < 0)
+					continue;
+				float z = w0 * pz[0] + w1 * pz[1] + w2 * pz[2];
+				if (m_model[x][y] < z)
+					m_model[x][y] = z;
+			}
+		}
+	}
+}
+
+void cStock::ApplyMoves(const std::vector<cSimMove> & moves, cSimTool & tool, std::vector<cSimGouge> & gouges, float tolerance,
+	int threads)
+{
+	// Every stock column only depends on the moves passing over it, in their order. So the
+	// rows are split into bands that are simulated concurrently, each one walking all moves.
+	// threads is the number of bands simulated at once, 0 for the number of cores.
+	if (threads <= 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	threads = std::min(threads, m_y);
+	int bandCount = threads > 1 ? std::min(m_y, threads * 4) : 1;
+	std::vector<std::vector<cSimGouge> > bandGouges(bandCount);
+	std::atomic<int> next(0);
+	auto worker = [&]() {
+		for (int band = next++; band < bandCount; band = next++)
+			ApplyMovesToRows(moves, tool, band * m_y / bandCount, (band + 1) * m_y / bandCount,
+				tolerance, bandGouges[band]);
+	};
+	if (threads > 1)
+	{
+		std::vector<std::future<void> > workers;
+		for (int i = 0; i < threads; i++)
+			workers.push_back(std::async(std::launch::async, worker));
+		for (auto & w : workers)
+			w.get();
+	}
+	else
+		worker();
+
+	// report each violating command once, with its deepest violation over all bands
+	std::map<std::pair<int, int>, float> merged;
+	for (const auto & list : bandGouges)
+	{
+		for (const cSimGouge & gouge : list)
+		{
+			float & depth = merged[std::make_pair(gouge.id, gouge.type)];
+			depth = std::max(depth, gouge.depth);
+		}
+	}
+	gouges.clear();
+	gouges.reserve(merged.size());
+	for (const auto & it : merged)
+		gouges.push_back(cSimGouge{it.first.first, it.first.second, it.second});
+}
+
+void cStock::ApplyMovesToRows(const std::vector<cSimMove> & moves, cSimTool & tool, int y0, int y1,
+	float tolerance, std::vector<cSimGouge> & gouges)
+{
+	float rad = tool.radius / m_res;
+	if (rad < SIM_EPSILON)
+		return;
+
+	for (const cSimMove & move : moves)
+	{
+		// move in pixel units, the tool covers the capsule of radius rad around it
+		float ax = (move.from.x - m_px) / m_res;
+		float ay = (move.from.y - m_py) / m_res;
+		float az = move.from.z;
+		float ux = (move.to.x - m_px) / m_res - ax;
+		float uy = (move.to.y - m_py) / m_res - ay;
+		float dz = move.to.z - az;
+		int ys = std::max(y0, (int)ceil(std::min(ay, ay + uy) - rad - 0.5f));
+		int ye = std::min(y1 - 1, (int)floor(std::max(ay, ay + uy) + rad - 0.5f));
+		if (ys > ye)
+			continue;
+
+		float uu = ux * ux + uy * uy;
+		float len = sqrtf(uu);
+		float nx = 0, ny = 0;
+		if (len > SIM_EPSILON)
+		{
+			nx = -uy / len * rad;
+			ny = ux / len * rad;
+		}
+
+		// the tool profile at a given distance in pixels from its axis
+		auto profile = [&](float dx, float dy) {
+			return tool.GetToolProfileAt(std::min(1.0f, sqrtf(dx * dx + dy * dy) / rad));
+		};
+
+		// lowest tool tip over the pixel center at (wx, wy) relative to the move start,
+		// FLT_MAX if the tool does not pass over it
+		auto lowest = [&](float wx, float wy) {
+			float ww = wx * wx + wy * wy;
+			if (len <= SIM_EPSILON)   // plunge
+				return ww > rad * rad ? FLT_MAX : std::min(az, az + dz) + profile(wx, wy);
+			float wu = wx * ux + wy * uy;
+			float disc = wu * wu - uu * (ww - rad * rad);
+			if (disc < 0)
+				return FLT_MAX;
+			disc = sqrtf(disc);
+			float t0 = std::max(0.0f, (wu - disc) / uu);
+			float t1 = std::min(1.0f, (wu + disc) / uu);
+			if (t0 > t1)
+				return FLT_MAX;
+			auto height = [&](float t) { return az + t * dz + profile(wx - t * ux, wy - t * uy); };
+			if (fabs(dz) < SIM_EPSILON)
+				return height(std::max(t0, std::min(t1, wu / uu)));
+			// the height is convex along the move for the usual tool profiles
+			float best = std::min(height(t0), height(t1));
+			for (int i = 0; i < 16; i++)
+			{
+				float m1 = t0 + (t1 - t0) * 0.382f;
+				float m2 = t0 + (t1 - t0) * 0.618f;
+				if (height(m1) < height(m2))
+					t1 = m2;
+				else
+					t0 = m1;
+			}
+			return std::min(best, height((t0 + t1) / 2));
+		};
+
+		float rapidDepth = 0;
+		float modelDepth = 0;
+		for (int y = ys; y <= ye; y++)
+		{
+			// the x range of the capsule on this row: its end circles and its two sides
+			float cy = y + 0.5f;
+			float xl = FLT_MAX, xr = -FLT_MAX;
+			for (int end = 0; end < 2; end++)
+			{
+				float d = cy - (ay + uy * end);
+				float h = rad * rad - d * d;
+				if (h >= 0)
+				{
+					h = sqrtf(h);
+					xl = std::min(xl, ax + ux * end - h);
+					xr = std::max(xr, ax + ux * end + h);
+				}
+			}
+			for (int side = -1; side <= 1 && fabs(uy) > SIM_EPSILON; side += 2)
+			{
+				float sy = ay + ny * side;
+				if ((cy - sy) * (cy - sy - uy) > 0)
+					continue;
+				float x = ax + nx * side + ux * (cy - sy) / uy;
+				xl = std::min(xl, x);
+				xr = std::max(xr, x);
+			}
+			int xs = std::max(0, (int)ceil(xl - 0.5f));
+			int xe = std::min(m_x - 1, (int)floor(xr - 0.5f));
+			for (int x = xs; x <= xe; x++)
+			{
+				float z = lowest(x + 0.5f - ax, cy - ay);
+				if (z == FLT_MAX)
+					continue;
+				float & stock = m_stock[x][y];
+				if (stock > z)
+				{
+					if (move.rapid)
+						rapidDepth = std::max(rapidDepth, stock - z);
+					stock = z;
+				}
+				if (m_hasModel)
+					modelDepth = std::max(modelDepth, m_model[x][y] - z);
+			}
+		}
+		if (rapidDepth > tolerance)
+			gouges.push_back(cSimGouge{move.id, SIM_GOUGE_RAPID, rapidDepth});
+		if (modelDepth > tolerance)
+			gouges.push_back(cSimGouge{move.id, SIM_GOUGE_MODEL, modelDepth});
+	}
+}
 
 //************************************************************************************************************
 // Line Segment
@@ -781,13 +992,49 @@ cSimTool::cSimTool(const TopoDS_Shape& toolShape, float res){
 
 }
 
+cSimTool::cSimTool(ToolType type, float diameter, float cornerRadius, float angle, float res)
+{
+	if (diameter <= 0 || res <= 0)
+		throw Base::ValueError("Path Simulation: Invalid tool diameter or resolution");
+	if (type == VBit && (angle <= 0 || angle >= 180))
+		throw Base::ValueError("Path Simulation: Invalid v-bit angle");
+
+	radius = diameter / 2;
+	float corner = std::max(0.0f, std::min(cornerRadius, radius));
+	if (type == Ball)
+		corner = radius;
+	float slope = type == VBit ? 1.0f / tan(angle * 3.1415926535f / 360) : 0;
+
+	// sample the profile up to and including the tool radius
+	int steps = (int)ceil(radius / res * 2);
+	for (int i = 0; i <= steps; i++)
+	{
+		toolShapePoint shapePoint;
+		shapePoint.radiusPos = radius * i / steps;
+		shapePoint.heightPos = 0;
+		if (type == VBit)
+			shapePoint.heightPos = shapePoint.radiusPos * slope;
+		else if (type != Flat)
+		{
+			float r = shapePoint.radiusPos - (radius - corner);
+			if (r > 0)
+				shapePoint.heightPos = corner - sqrtf(std::max(0.0f, corner * corner - r * r));
+		}
+		m_toolShape.push_back(shapePoint);
+	}
+	length = m_toolShape.back().heightPos;
+}
+
 float cSimTool::GetToolProfileAt(float pos)  // pos is -1..1 location along the radius of the tool (0 is center)
 {
     toolShapePoint test;
     test.radiusPos = std::abs(pos) * radius;
 
     auto it = std::lower_bound(m_toolShape.begin(), m_toolShape.end(), test, toolShapePoint::less_than());
-    return it != m_toolShape.end() ? it->heightPos : 0.0f;
+    if (it != m_toolShape.end())
+        return it->heightPos;
+    // the rim of the tool, beyond the last sampled position
+    return m_toolShape.empty() ? 0.0f : m_toolShape.back().heightPos;
 }
 
 bool cSimTool::isInside(const TopoDS_Shape& toolShape, Base::Vector3d pnt, float res)
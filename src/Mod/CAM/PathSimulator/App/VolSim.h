@@ -35,6 +35,8 @@
 #define SIM_TESSEL_TOP		1
 #define SIM_TESSEL_BOT		2
 #define SIM_WALK_RES		0.6   // step size in pixel units (to make sure all pixels in the path are visited)
+#define SIM_GOUGE_RAPID		1     // a rapid move removes material
+#define SIM_GOUGE_MODEL		2     // a move cuts below the model surface
 
 struct toolShapePoint {
   float radiusPos;
@@ -98,10 +100,31 @@ struct cLineSegment
 	float lenXY;
 };
 
+// a straight tool move, arcs and cycles are split into those by the path segment walker
+struct cSimMove
+{
+	cSimMove(const Point3D & p1, const Point3D & p2, int id, bool rapid) : from(p1), to(p2), id(id), rapid(rapid) {}
+	Point3D from;
+	Point3D to;
+	int id;         // index of the command in the path
+	bool rapid;
+};
+
+struct cSimGouge
+{
+	int id;         // index of the command in the path
+	int type;       // SIM_GOUGE_RAPID or SIM_GOUGE_MODEL
+	float depth;    // deepest violation of the command
+};
+
 class cSimTool
 {
 public:
+	enum ToolType { Flat, Ball, Bull, VBit };
+
     cSimTool(const TopoDS_Shape& toolShape, float res);
+	// analytic profile of a flat, ball, bull nose (cornerRadius) or v-bit (included angle in degrees) end mill
+	cSimTool(ToolType type, float diameter, float cornerRadius, float angle, float res);
 	~cSimTool() {}
 
 	float GetToolProfileAt(float pos);
@@ -128,6 +151,8 @@ public:
 
 	void Init(int x, int y)
 	{
+		if (data)
+			delete[] data;
 		data = new T[x * y];
 		height = y;
 	}
@@ -148,6 +173,9 @@ public:
     void CreatePocket(float x, float y, float rad, float height);
     void ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool &tool);
     void ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimTool &tool, bool isCCW);
+	void SetModel(const std::vector<MeshCore::MeshGeomFacet> & facets);
+	void ApplyMoves(const std::vector<cSimMove> & moves, cSimTool & tool, std::vector<cSimGouge> & gouges, float tolerance,
+		int threads = 0);
     inline Point3D ToInner(Point3D & p) {
 		return Point3D((p.x - m_px) / m_res, (p.y - m_py) / m_res, p.z);
 	}
@@ -161,7 +189,11 @@ private:
 	int TesselBot(int x, int y);
 	int TesselSidesX(int yp);
 	int TesselSidesY(int xp);
+	void ApplyMovesToRows(const std::vector<cSimMove> & moves, cSimTool & tool, int y0, int y1,
+		float tolerance, std::vector<cSimGouge> & gouges);
 	Array2D<float>  m_stock;
+	Array2D<float>  m_model;	// top of the model, below m_pz where there is none
+	bool m_hasModel;
 	Array2D<char> m_attr;
 	float m_px, m_py, m_pz;  // stock zero position
 	float m_lx, m_ly, m_lz;  // stock dimensions
@@ -26,6 +26,7 @@ from Tests.TestCAMSanity import TestCAMSanity
 from Tests.TestPathProfile import TestPathProfile
 
 from Tests.TestPathAdaptive import TestPathAdaptive
+from Tests.TestPathArea import TestPathArea
 from Tests.TestPathCore import TestPathCore
 from Tests.TestPathDepthParams import depthTestCases
 from Tests.TestPathDressupDogbone import TestDressupDogbone
@@ -57,6 +58,7 @@ from Tests.TestPathProfile import TestPathProfile
 from Tests.TestPathPropertyBag import TestPathPropertyBag
 from Tests.TestPathRotationGenerator import TestPathRotationGenerator
 from Tests.TestPathSetupSheet import TestPathSetupSheet
+from Tests.TestPathSimulator import TestPathSimulator
 from Tests.TestPathStock import TestPathStock
 from Tests.TestPathThreadMilling import TestPathThreadMilling
 from Tests.TestPathThreadMillingGenerator import TestPathThreadMillingGenerator
@@ -92,6 +94,7 @@ False if TestHoldingTags.__name__ else True
 False if TestPathLanguage.__name__ else True
 # False if TestOutputNameSubstitution.__name__ else True
 False if TestPathAdaptive.__name__ else True
+False if TestPathArea.__name__ else True
 False if TestPathCore.__name__ else True
 False if TestPathOpDeburr.__name__ else True
 False if TestPathDrillable.__name__ else True
@@ -109,6 +112,7 @@ False if TestPathProfile.__name__ else True
 False if TestPathPropertyBag.__name__ else True
 False if TestPathRotationGenerator.__name__ else True
 False if TestPathSetupSheet.__name__ else True
+False if TestPathSimulator.__name__ else True
 False if TestPathStock.__name__ else True
 False if TestPathThreadMilling.__name__ else True
 False if TestPathThreadMillingGenerator.__name__ else True
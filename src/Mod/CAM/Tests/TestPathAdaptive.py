@@ -22,8 +22,11 @@
 # *                                                                         *
 # ***************************************************************************
 
+import threading
+
 import FreeCAD
 import Part
+import area
 import Path.Op.Adaptive as PathAdaptive
 import Path.Main.Job as PathJob
 from Tests.PathTestUtils import PathTestBase
@@ -414,6 +417,32 @@ class TestPathAdaptive(PathTestBase):
                 break
         self.assertTrue(isInBox, "No paths originating within the inner hole.")
 
+    def test08(self):
+        """test08() Verify separate regions give the same paths when processed together."""
+
+        # three squares far enough apart to be cleared as separate regions, which are
+        # processed concurrently when they are passed together
+        squares = [_square(x, 0.0, 10.0) for x in (0.0, 20.0, 40.0)]
+        stock = [_square(-10.0, -10.0, 70.0)]
+
+        callbackThreads = set()
+
+        def progressFn(tpaths):
+            callbackThreads.add(threading.get_ident())
+            return False
+
+        together = _runAdaptive2d(stock, squares, progressFn)
+        self.assertEqual(len(together), len(squares))
+        self.assertEqual(together, _runAdaptive2d(stock, squares, progressFn))
+
+        # the progress callback calls into python, it must only run in this thread
+        self.assertEqual(callbackThreads, {threading.get_ident()})
+
+        alone = []
+        for square in squares:
+            alone.extend(_runAdaptive2d(stock, [square], progressFn))
+        self.assertEqual(sorted(together), sorted(alone))
+
 
 # Eclass
 
@@ -527,6 +556,36 @@ def pathOriginatesInBox(cmd, minPoint, maxPoint):
     return False
 
 
+def _square(x, y, size):
+    return [(x, y), (x + size, y), (x + size, y + size), (x, y + size)]
+
+
+def _runAdaptive2d(stockPaths, paths, progressFn):
+    """_runAdaptive2d(stockPaths, paths, progressFn)...
+    Clear the inside of the paths with a 2 mm tool, the results are returned as tuples
+    of plain values that can be compared and sorted."""
+    a2d = area.Adaptive2d()
+    a2d.stepOverFactor = 0.2
+    a2d.toolDiameter = 2.0
+    a2d.helixRampDiameter = 1.0
+    a2d.tolerance = 0.1
+    a2d.opType = area.AdaptiveOperationType.ClearingInside
+    results = []
+    for result in a2d.Execute(stockPaths, paths, progressFn):
+        adaptivePaths = tuple(
+            (int(motionType), tuple(points)) for motionType, points in result.AdaptivePaths
+        )
+        results.append(
+            (
+                tuple(result.HelixCenterPoint),
+                tuple(result.StartPoint),
+                adaptivePaths,
+                int(result.ReturnMotionType),
+            )
+        )
+    return results
+
+
 def _addViewProvider(adaptiveOp):
     if FreeCAD.GuiUp:
         PathOpGui = PathAdaptiveGui.PathOpGui
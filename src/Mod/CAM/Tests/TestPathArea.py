@@ -0,0 +1,83 @@
+# -*- coding: utf-8 -*-
+# ***************************************************************************
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+import FreeCAD
+import Part
+import Path
+from Tests.PathTestUtils import PathTestBase
+
+
+def _makeSections(shape, heights, **params):
+    area = Path.Area(**params)
+    area.setPlane(Part.makeCircle(10, FreeCAD.Vector(0, 0, shape.BoundBox.ZMin)))
+    area.add(shape)
+    return area.makeSections(mode=0, project=False, heights=heights)
+
+
+def _sectionData(section):
+    """Values describing a section, rounded to be compared between slicing methods."""
+    shape = section.getShape()
+    box = shape.BoundBox
+    values = (box.XMin, box.YMin, box.ZMin, box.XMax, box.YMax, box.ZMax, shape.Length)
+    return tuple(round(v, 6) for v in values)
+
+
+class TestPathArea(PathTestBase):
+    """Unit tests for the slicing of Path.Area sections."""
+
+    def setUp(self):
+        # a box, prismatic along Z, with a cone on top whose faces are sloped
+        box = Part.makeBox(10, 10, 10)
+        cone = Part.makeCone(5, 1, 10, FreeCAD.Vector(5, 5, 10))
+        self.shape = box.fuse(cone).removeSplitter()
+        self.heights = [0.5 + i for i in range(20)]
+
+    def test00(self):
+        """Verify sections sliced together are the same as those sliced one at a time."""
+        sections = _makeSections(self.shape, self.heights)
+        self.assertEqual(len(sections), len(self.heights))
+
+        for height, section in zip(self.heights, sections):
+            single = _makeSections(self.shape, [height])
+            self.assertEqual(len(single), 1)
+            self.assertEqual(_sectionData(section), _sectionData(single[0]))
+
+    def test01(self):
+        """Verify SectionReuse gives the same sections as slicing every level."""
+        sliced = _makeSections(self.shape, self.heights)
+        reused = _makeSections(self.shape, self.heights, SectionReuse=True)
+        self.assertEqual(len(reused), len(sliced))
+
+        for height, a, b in zip(self.heights, sliced, reused):
+            self.assertEqual(_sectionData(a), _sectionData(b))
+            self.assertRoughly(b.getShape().BoundBox.ZMin, height)
+
+    def test02(self):
+        """Verify SectionReuse slices again where the shape is sloped."""
+        reused = _makeSections(self.shape, self.heights, SectionReuse=True)
+
+        # the cone gets narrower with the height
+        lengths = [s.getShape().Length for s in reused[10:]]
+        for lower, upper in zip(lengths, lengths[1:]):
+            self.assertLess(upper, lower)
+        # the box keeps its outline
+        for section in reused[:10]:
+            self.assertRoughly(section.getShape().Length, 40.0)
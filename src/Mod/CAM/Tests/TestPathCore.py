@@ -25,6 +25,47 @@ import Path
 from Tests.PathTestUtils import PathTestBase
 
 
+# one command per line, each parsed on its own by Path.Command as reference
+_GCODE = """
+(start G0 X1)
+G90
+M3 S12000
+M6 T1
+G0 X0 Y0 Z5
+G1 Z-1.5 F120
+g1x10.25y-3.125
+G2 X20 Y0 I5 J3.125 F300
+G3 X10 Y10 R7.5
+G91
+G1 X1.5 Y-0.75
+G1	Z-0.1
+G90
+G81 X5 Y5 Z-3 R2 F80
+G82 X10 Y5 Z-3 R2 P0.5
+G83 X15 Y5 Z-6 R2 Q1.5
+G73 X20 Y5 Z-6 R2 Q0.75
+G80
+G1 X123456.654321 Y-0.000001 Z.5
+M5
+"""
+
+
+def _parseLines(gcode):
+    return [Path.Command(line) for line in gcode.splitlines() if line.strip()]
+
+
+def _commandData(commands):
+    return [(c.Name, c.Parameters) for c in commands]
+
+
+def _scale(command, factor):
+    params = command.Parameters
+    for key in params:
+        if key[0] in "XYZIJRQF":
+            params[key] *= factor
+    return Path.Command(command.Name, params)
+
+
 class TestPathCore(PathTestBase):
     def test00(self):
         """Test Path command core functionality"""
@@ -130,6 +171,113 @@ G0 Z0.500000
         p.setFromGCode(lines)
         self.assertEqual(p.toGCode(), output)
 
+    def test20(self):
+        """Test parsing and emitting gcode with modes, arcs and canned cycles"""
+        path = Path.Path()
+        path.setFromGCode(_GCODE)
+        expected = _parseLines(_GCODE)
+
+        self.assertEqual(_commandData(path.Commands), _commandData(expected))
+        self.assertEqual(path.toGCode(), "".join(c.toGCode() + "\n" for c in expected))
+
+        # the emitted gcode parses back to the same commands
+        copy = Path.Path()
+        copy.setFromGCode(path.toGCode())
+        self.assertEqual(_commandData(copy.Commands), _commandData(path.Commands))
+        self.assertEqual(copy.toGCode(), path.toGCode())
+
+    def test21(self):
+        """Test G20 and G21 switching the unit of the following commands"""
+        path = Path.Path()
+        path.setFromGCode(
+            "G1 X1 Y2 F10\nG20\nG2 X1 Y2 I0.5 J-1 F10 S500\nG81 Z-1 R0.5 Q0.1\nG21\nG1 X1"
+        )
+        self.assertEqual(
+            _commandData(path.Commands),
+            [
+                ("G1", {"X": 1, "Y": 2, "F": 10}),
+                (
+                    "G2",
+                    {
+                        "X": 25.4,
+                        "Y": 2 * 25.4,
+                        "I": 0.5 * 25.4,
+                        "J": -25.4,
+                        "F": 10 * 25.4,
+                        "S": 500,
+                    },
+                ),
+                ("G81", {"Z": -25.4, "R": 0.5 * 25.4, "Q": 0.1 * 25.4}),
+                ("G1", {"X": 1}),
+            ],
+        )
+
+    def test22(self):
+        """Test parsing and emitting gcode large enough to be processed in chunks"""
+        lines = []
+        for i in range(14000):
+            lines.append(_GCODE.replace("X", "X%d" % i if i % 2 else "X-%d" % i))
+        # the unit switches apply across the chunks
+        lines.insert(2000, "G20\n")
+        lines.insert(11000, "G21\n")
+        gcode = "".join(lines)
+        self.assertGreater(len(gcode), 4 * 1024 * 1024)
+
+        expected = []
+        inches = False
+        for line in gcode.splitlines():
+            if line.strip() in ("G20", "G21"):
+                inches = line.strip() == "G20"
+                continue
+            expected.extend(_scale(c, 25.4) if inches else c for c in _parseLines(line))
+        self.assertGreater(len(expected), 100000)
+
+        path = Path.Path()
+        path.setFromGCode(gcode)
+        self.assertEqual(path.Size, len(expected))
+        self.assertEqual(_commandData(path.Commands), _commandData(expected))
+        self.assertEqual(path.toGCode(), "".join(c.toGCode() + "\n" for c in expected))
+
+    def test23(self):
+        """Test storing, inserting and deleting commands with any parameters"""
+        commands = [
+            Path.Command("G0", {"X": 1, "Y": 2, "Z": 3}),
+            Path.Command("G2", {"X": 4, "Y": 5, "I": 1, "J": -1, "K": 0, "F": 100}),
+            Path.Command("G83", {"X": 1, "Z": -5, "R": 2, "Q": 0.5, "P": 1}),
+            Path.Command("M3", {"S": 12000}),
+            Path.Command("M6", {"T": 2, "H": 2}),
+            Path.Command("G1", {"X": 0, "A": 90, "B": -45, "C": 10}),
+            Path.Command("(comment)"),
+        ]
+        path = Path.Path(commands)
+        self.assertEqual(_commandData(path.Commands), _commandData(commands))
+        self.assertEqual(path.toGCode(), "".join(c.toGCode() + "\n" for c in commands))
+
+        extra = Path.Command("G1", {"Y": 7, "E": 0.25, "U": 1})
+        for pos in [0, 3, len(commands)]:
+            path.insertCommand(extra, pos)
+            commands.insert(pos, extra)
+            self.assertEqual(_commandData(path.Commands), _commandData(commands))
+        path.insertCommand(extra)
+        commands.append(extra)
+        self.assertEqual(_commandData(path.Commands), _commandData(commands))
+
+        for pos in [0, 4, len(commands) - 1]:
+            path.deleteCommand(pos)
+            del commands[pos]
+            self.assertEqual(_commandData(path.Commands), _commandData(commands))
+        path.deleteCommand()
+        commands.pop()
+        self.assertEqual(_commandData(path.Commands), _commandData(commands))
+        self.assertEqual(path.toGCode(), "".join(c.toGCode() + "\n" for c in commands))
+
+        # positions out of range are rejected and leave the path unchanged
+        with self.assertRaises(Exception):
+            path.insertCommand(extra, len(commands) + 1)
+        with self.assertRaises(Exception):
+            path.deleteCommand(len(commands))
+        self.assertEqual(_commandData(path.Commands), _commandData(commands))
+
     def test50(self):
         """Test Path.Length calculation"""
         commands = []
@@ -0,0 +1,133 @@
+# -*- coding: utf-8 -*-
+# ***************************************************************************
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+
+import FreeCAD
+import Part
+import Path
+import PathSimulator
+from Tests.PathTestUtils import PathTestBase
+
+
+def _makePath(gcode):
+    return Path.Path([Path.Command(line) for line in gcode.strip().splitlines()])
+
+
+# zig zag over the stock with ramps, arcs and a drilling cycle
+_TOOLPATH = """
+G0 X-3 Y-3 Z15
+G1 Z8
+G1 X23 Y-3 Z7
+G1 X23 Y4
+G1 X-3 Y4 Z6.5
+G2 X-3 Y12 I0 J4 Z6
+G1 X23 Y12
+G3 X23 Y18 I0 J3
+G1 X10 Y10 Z5
+G0 Z15
+G0 X5 Y15
+G81 X5 Y15 Z2 R12
+G80
+G0 Z15
+"""
+
+
+class TestPathSimulator(PathTestBase):
+    """Unit tests for the headless simulation of toolpaths on the stock height field."""
+
+    def setUp(self):
+        self.stock = Part.makeBox(20, 20, 10)
+        self.start = FreeCAD.Vector(0, 0, 15)
+
+    def simulate(self, path, threads, tool="Ball", **toolArgs):
+        sim = PathSimulator.PathSim()
+        sim.BeginSimulation(self.stock, 0.25)
+        sim.SetToolProfile(tool, 3, 0.25, **toolArgs)
+        gouges = sim.ApplyToolpath(path, self.start, threads=threads)
+        mesh = sim.GetResultMesh()[0]
+        return [tuple(p) for p in mesh.Topology[0]], gouges
+
+    def test00(self):
+        """Verify the stock simulated in bands is the same as simulated in a single pass."""
+        path = _makePath(_TOOLPATH)
+        for tool, args in [
+            ("Flat", {}),
+            ("Ball", {}),
+            ("Bull", {"cornerRadius": 0.5}),
+            ("V", {"angle": 90}),
+        ]:
+            serial, serialGouges = self.simulate(path, 1, tool, **args)
+            banded, bandedGouges = self.simulate(path, 4, tool, **args)
+            self.assertTrue(serial, tool)
+            self.assertEqual(serial, banded, tool)
+            self.assertEqual(serialGouges, bandedGouges, tool)
+            # the default uses all cores
+            self.assertEqual(self.simulate(path, 0, tool, **args)[0], serial, tool)
+
+    def test01(self):
+        """Verify the material removed by a path."""
+        path = _makePath(_TOOLPATH)
+        untouched, _ = self.simulate(Path.Path(), 1)
+        cut, gouges = self.simulate(path, 1)
+        self.assertNotEqual(untouched, cut)
+        self.assertEqual(gouges, [])
+
+        # the drilled hole is the deepest cut, the bottom of the stock is at 0
+        zMin = min(p[2] for p in cut if p[2] > 1)
+        self.assertLess(zMin, 2.5)
+        self.assertGreaterEqual(zMin, 2 - 0.001)
+
+    def test02(self):
+        """Verify rapid moves into the stock and cuts into the model are reported."""
+        path = _makePath(
+            """
+G0 X10 Y10 Z15
+G0 Z5
+G0 Z15
+G0 X2 Y2
+G1 Z3
+G1 X18
+G0 Z15
+"""
+        )
+        sim = PathSimulator.PathSim()
+        sim.BeginSimulation(self.stock, 0.25)
+        sim.SetToolProfile("Flat", 3, 0.25)
+        sim.SetModel(Part.makeBox(20, 20, 5))
+        gouges = sim.ApplyToolpath(path, self.start, threads=1)
+
+        self.assertEqual([(g[0], g[1]) for g in gouges], [(1, "Rapid"), (4, "Model"), (5, "Model")])
+        self.assertRoughly(gouges[0][2], 5, 0.001)
+        self.assertRoughly(gouges[1][2], 2, 0.001)
+        self.assertRoughly(gouges[2][2], 2, 0.001)
+
+    def test03(self):
+        """Verify invalid simulation setups are rejected."""
+        sim = PathSimulator.PathSim()
+        with self.assertRaises(RuntimeError):
+            sim.ApplyToolpath(Path.Path(), self.start)
+        sim.BeginSimulation(self.stock, 0.25)
+        with self.assertRaises(RuntimeError):
+            sim.ApplyToolpath(Path.Path(), self.start)
+        with self.assertRaises(ValueError):
+            sim.SetToolProfile("Drill", 3, 0.25)
+        with self.assertRaises(Exception):
+            sim.SetToolProfile("V", 3, 0.25, angle=180)
@@ -206,3 +206,57 @@ class TestPathVoronoi(PathTestUtils.PathTestBase):
         )
         self.assertRoughly(e.valueAt(e.FirstParameter).z, 2.37)
         self.assertRoughly(e.valueAt(e.LastParameter).z, 5.14)
+
+    def test70(self):
+        """Check batch arrays match the element objects"""
+
+        vertices = vd.getVertexArray(1.5)
+        self.assertEqual(len(vertices), len(vd.Vertices))
+        for v, (x, y, z) in zip(vd.Vertices, vertices):
+            self.assertRoughly(v.X, x)
+            self.assertRoughly(v.Y, y)
+            self.assertRoughly(z, 1.5)
+
+        edges = vd.getEdgeArray()
+        self.assertEqual(len(edges), len(vd.Edges))
+        for e, (v0, v1, twin, cell, color, primary, linear) in zip(vd.Edges, edges):
+            self.assertEqual([v.Index if v else -1 for v in e.Vertices] or [-1, -1], [v0, v1])
+            self.assertEqual(e.Twin.Index, twin)
+            self.assertEqual(e.Cell.Index, cell)
+            self.assertEqual(e.Color, color)
+            self.assertEqual(e.isPrimary(), primary)
+            self.assertEqual(e.isLinear(), linear)
+
+        cells = vd.getCellArray()
+        self.assertEqual(len(cells), len(vd.Cells))
+        for c, (index, category, color, edge) in zip(vd.Cells, cells):
+            self.assertEqual(c.SourceIndex, index)
+            self.assertEqual(c.SourceCategory, category)
+            self.assertEqual(c.Color, color)
+            self.assertEqual(c.IncidentEdge.Index, edge)
+
+    def test71(self):
+        """Check constructing unchanged and multiple diagrams"""
+
+        def square(x, size):
+            d = Path.Voronoi.Diagram()
+            pts = [(x, 0), (x + size, 0), (x + size, size), (x, size), (x, 0)]
+            for p0, p1 in zip(pts, pts[1:]):
+                d.addSegment(FreeCAD.Vector(*p0), FreeCAD.Vector(*p1))
+            return d
+
+        d0 = square(0, 1)
+        d0.construct()
+        edges = d0.getEdgeArray()
+        d0.colorExterior(7)
+        self.assertNotEqual(d0.getEdgeArray(), edges)
+        d0.construct()
+        self.assertEqual(d0.getEdgeArray(), edges)
+
+        diagrams = [square(i * 3, i + 1) for i in range(4)]
+        Path.Voronoi.Diagram.constructAll(diagrams + [diagrams[0]])
+        for i, d in enumerate(diagrams):
+            s = square(i * 3, i + 1)
+            s.construct()
+            self.assertEqual(d.numEdges(), s.numEdges())
+            self.assertEqual(d.getVertexArray(), s.getVertexArray())
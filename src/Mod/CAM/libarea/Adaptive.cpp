@@ -26,6 +26,12 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <random>
+#include <thread>
 
 namespace ClipperLib
 {
@@ -39,6 +45,9 @@ using namespace std;
 #define SAME_POINT_TOL_SQRD_SCALED 4.0
 #define UNUSED(expr) (void)(expr)
 
+// regions may be processed concurrently, their messages are written one at a time
+static std::mutex outputMutex;
+
 //*****************************************
 // Utils - inline
 //*****************************************
@@ -1135,7 +1144,7 @@ class Interpolation
 
 	double getRandomAngle()
 	{
-		return MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * double(rand()) / double(RAND_MAX);
+		return MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * double(generator() - generator.min()) / double(generator.max() - generator.min());
 	}
 	size_t getPointCount()
 	{
@@ -1143,6 +1152,8 @@ class Interpolation
 	}
 
   private:
+	// own generator, so that the result of a region does not depend on what ran before it
+	std::minstd_rand generator;
 	vector<double> angles;
 	vector<double> areas;
 };
@@ -1718,7 +1729,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 	toolRadiusScaled = long(toolDiameter * scaleFactor / 2);
 	stepOverScaled = toolRadiusScaled * stepOverFactor;
 	progressCallback = &progressCallbackFn;
-	lastProgressTime = clock();
+	lastProgressTime = chrono::steady_clock::now();
 	stopProcessing = false;
 
 	if(helixRampDiameter<NTOL)
@@ -1801,6 +1812,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 	//	Resolve hierarchy and run processing
 	//***************************************
 	double cornerRoundingOffset = 0.15 * toolRadiusScaled / 2;
+	std::vector<std::pair<Paths, Paths>> regions; // bound paths and tool bound paths of each region
 	if (opType == OperationType::otClearingInside || opType == OperationType::otClearingOutside)
 	{
 
@@ -1853,7 +1865,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 				clipof.Clear();
 				clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
 				clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
-				ProcessPolyNode(boundPaths, toolBoundPaths);
+				regions.emplace_back(boundPaths, toolBoundPaths);
 			}
 		}
 	}
@@ -1912,11 +1924,13 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 					clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
 					clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
 
-					ProcessPolyNode(boundPaths, toolBoundPaths);
+					regions.emplace_back(boundPaths, toolBoundPaths);
 				}
 			}
 		}
 	}
+
+	ProcessRegions(regions);
 	return results;
 }
 
@@ -2191,17 +2205,19 @@ bool Adaptive2d::ResolveLinkPath(const IntPoint &startPoint, const IntPoint &end
 	size_t sindex;
 	double par;
 
-	// put a time limit on the resolving the link path
-	clock_t time_limit = (clock_t)(max(keepToolDownDistRatio, 3.0) * CLOCKS_PER_SEC / 6);
+	// put a time limit on the resolving the link path, in wall time as clock() adds up the
+	// time of all the threads when regions are processed concurrently
+	auto time_limit = std::chrono::duration<double>(max(keepToolDownDistRatio, 3.0) / 6);
 
-	clock_t time_out = clock() + time_limit;
+	auto time_out = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(time_limit);
 
 	while (!queue.empty())
 	{
 		if (stopProcessing)
 			return false;
-		if (clock() > time_out)
+		if (std::chrono::steady_clock::now() > time_out)
 		{
+			lock_guard<mutex> lock(outputMutex);
 			cout << "Unable to resolve tool down linking path (limit reached)." << endl;
 			return false;
 		}
@@ -2209,6 +2225,7 @@ bool Adaptive2d::ResolveLinkPath(const IntPoint &startPoint, const IntPoint &end
 		cnt++;
 		if (cnt > limit)
 		{
+			lock_guard<mutex> lock(outputMutex);
 			cout << "Unable to resolve tool down linking path @(" << endPoint.X / scaleFactor << "," << endPoint.Y / scaleFactor << ") (" << limit << " points limit reached)." << endl;
 			return false;
 		}
@@ -2220,6 +2237,7 @@ bool Adaptive2d::ResolveLinkPath(const IntPoint &startPoint, const IntPoint &end
 		{
 			if (linkPaths[i].front() != pointPair.first && linkPaths[i].back() != pointPair.first && linkPaths[i].front() != pointPair.second && linkPaths[i].back() != pointPair.second && IntersectionPoint(linkPaths[i].front(), linkPaths[i].back(), pointPair.first, pointPair.second, clp))
 			{
+				lock_guard<mutex> lock(outputMutex);
 				cout << "Unable to resolve tool down linking path (self-intersects)." << endl;
 				return false;
 			}
@@ -2574,9 +2592,10 @@ void Adaptive2d::AppendToolPath(TPaths &progressPaths, AdaptiveOutput &output,
 
 void Adaptive2d::CheckReportProgress(TPaths &progressPaths, bool force)
 {
-	if (!force && (clock() - lastProgressTime < PROGRESS_TICKS))
+	auto now = chrono::steady_clock::now();
+	if (!force && (now - lastProgressTime < PROGRESS_INTERVAL))
 		return; // not yet
-	lastProgressTime = clock();
+	lastProgressTime = now;
 	if (progressPaths.empty())
 		return;
 	if (progressCallback)
@@ -2622,11 +2641,81 @@ void Adaptive2d::AddPathToProgress(TPaths &progressPaths, const Path pth, Motion
 	}
 }
 
+void Adaptive2d::ProcessRegions(const std::vector<std::pair<Paths, Paths>> &regions)
+{
+	size_t threadCount = std::min<size_t>(std::thread::hardware_concurrency(), regions.size());
+#ifdef DEV_MODE
+	threadCount = 1; // perf counters and debug drawing are not thread safe
+#endif
+	if (threadCount <= 1)
+	{
+		for (const auto &region : regions)
+			ProcessPolyNode(region.first, region.second);
+		return;
+	}
+
+	// Regions are independent: each worker processes them on its own copy of this instance, the
+	// outputs are collected per region and appended in region order. The workers queue their
+	// progress paths, which are passed to the progress callback from this thread only, as the
+	// callback calls into python.
+	std::vector<std::list<AdaptiveOutput>> regionResults(regions.size());
+	std::atomic<size_t> nextRegion(0);
+	std::atomic<bool> stop(stopProcessing);
+	std::mutex progressMutex;
+	TPaths pendingProgress;
+	std::function<bool(TPaths)> queueProgress = [&](TPaths paths) {
+		std::lock_guard<std::mutex> lock(progressMutex);
+		pendingProgress.insert(pendingProgress.end(), paths.begin(), paths.end());
+		return stop.load();
+	};
+	auto reportProgress = [&]() {
+		TPaths paths;
+		{
+			std::lock_guard<std::mutex> lock(progressMutex);
+			paths.swap(pendingProgress);
+		}
+		if (!paths.empty() && progressCallback && *progressCallback && (*progressCallback)(paths))
+			stop = true;
+	};
+	auto worker = [&]() {
+		Adaptive2d regionWorker(*this);
+		regionWorker.progressCallback = &queueProgress;
+		for (size_t i = nextRegion++; i < regions.size(); i = nextRegion++)
+		{
+			regionWorker.results.clear();
+			regionWorker.current_region = int(i);
+			regionWorker.stopProcessing = stop.load();
+			regionWorker.ProcessPolyNode(regions[i].first, regions[i].second);
+			regionResults[i].swap(regionWorker.results);
+		}
+	};
+
+	std::vector<std::future<void>> workers;
+	for (size_t i = 0; i < threadCount; i++)
+		workers.push_back(std::async(std::launch::async, worker));
+	for (auto &w : workers)
+	{
+		while (w.wait_for(std::chrono::milliseconds(PROGRESS_POLL_MS)) != std::future_status::ready)
+			reportProgress();
+	}
+	reportProgress();
+	for (auto &w : workers)
+		w.get();
+
+	stopProcessing = stop;
+	current_region += int(regions.size());
+	for (auto &regionResult : regionResults)
+		results.splice(results.end(), regionResult);
+}
+
 void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 {
 	Perf_ProcessPolyNode.Start();
 	current_region++;
-	cout << "** Processing region: " << current_region << endl;
+	{
+		lock_guard<mutex> lock(outputMutex);
+		cout << "** Processing region: " << current_region << endl;
+	}
 
 	// node paths are already constrained to tool boundary path for adaptive path before finishing pass
 	Clipper clip;
@@ -3019,11 +3108,13 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 				};
 				if (remaining.empty())
 				{
+					lock_guard<mutex> lock(outputMutex);
 					cout << "All cleared." << endl;
 					break;
 				}
 				else
 				{
+					lock_guard<mutex> lock(outputMutex);
 					cout << "Clearing " << remaining.size() << " remaining internal path(s)." << endl;
 				}
 
@@ -21,6 +21,7 @@
 ***************************************************************************/
 
 #include "clipper.hpp"
+#include <chrono>
 #include <vector>
 #include <list>
 #include <time.h>
@@ -120,11 +121,12 @@ class Adaptive2d
 	double optimalCutAreaPD = 0;
 	bool stopProcessing = false;
 	int current_region=0;
-	clock_t lastProgressTime = 0;
+	std::chrono::steady_clock::time_point lastProgressTime;
 
 	std::function<bool(TPaths)> *progressCallback = NULL;
 	Path toolGeometry; // tool geometry at coord 0,0, should not be modified
 
+	void ProcessRegions(const std::vector<std::pair<Paths, Paths>> &regions);
 	void ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths);
 	bool FindEntryPoint(TPaths &progressPaths, const Paths &toolBoundPaths, const Paths &bound, ClearedArea &cleared /*output*/,
 						IntPoint &entryPoint /*output*/, IntPoint &toolPos, DoublePoint &toolDir);
@@ -164,7 +166,8 @@ class Adaptive2d
 
 	const long PASSES_LIMIT = __LONG_MAX__;			   // limit used while debugging
 	const long POINTS_PER_PASS_LIMIT = __LONG_MAX__;   // limit used while debugging
-	const clock_t PROGRESS_TICKS = CLOCKS_PER_SEC / 10; // progress report interval
+	const std::chrono::milliseconds PROGRESS_INTERVAL{100}; // progress report interval
+	const int PROGRESS_POLL_MS = 100; // progress report interval while regions are processed concurrently
 };
 } // namespace AdaptivePath
 #endif
\ No newline at end of file
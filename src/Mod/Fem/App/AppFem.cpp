@@ -59,6 +59,7 @@
 #include "FemSetGeometryObject.h"
 #include "FemSetNodesObject.h"
 #include "FemSolverObject.h"
+#include "FemCcxResultsPy.h"
 #include "HypothesisPy.h"
 
 #ifdef FC_USE_VTK
@@ -123,6 +124,7 @@ PyMOD_INIT_FUNC(Fem)
     Fem::StdMeshers_SegmentLengthAroundVertexPy ::init_type(femModule);
     Fem::StdMeshers_StartEndLengthPy            ::init_type(femModule);
     Fem::StdMeshers_Hexa_3DPy                   ::init_type(femModule);
+    Fem::CcxFrdResultsPy                        ::init_type();
 
     // Add Types to module
     Base::Interpreter().addType(&Fem::FemMeshPy::Type,femModule,"FemMesh");
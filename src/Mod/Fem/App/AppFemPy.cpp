@@ -30,10 +30,13 @@
 #include <App/Document.h>
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectPy.h>
+#include <Base/GeometryPyCXX.h>
 #include <Base/Interpreter.h>
 #include <Base/PlacementPy.h>
 #include <Mod/Part/App/OCCError.h>
 
+#include "FemCcxReader.h"
+#include "FemCcxResultsPy.h"
 #include "FemMesh.h"
 #include "FemMeshObject.h"
 #include "FemMeshPy.h"
@@ -65,6 +68,15 @@ public:
         add_varargs_method("read",
                            &Module::read,
                            "Read a mesh from a file and returns a Mesh object.");
+        add_varargs_method("readCcxFrd",
+                           &Module::readCcxFrd,
+                           "readCcxFrd(string) -- Read the nodes and elements of a CalculiX frd "
+                           "file into a dict. Its results are a sequence of result sets, each one "
+                           "is read when it is accessed.");
+        add_varargs_method("readCcxDat",
+                           &Module::readCcxDat,
+                           "readCcxDat(string) -- Read the eigenmodes and frequencies of a "
+                           "CalculiX dat file into a list of dicts.");
 #ifdef FC_USE_VTK
         add_varargs_method("readResult",
                            &Module::readResult,
@@ -229,6 +241,57 @@ private:
         mesh->read(EncodedName.c_str());
         return Py::asObject(new FemMeshPy(mesh.release()));
     }
+    static Py::Dict elementsToDict(const CcxFrdReader::Elements& elements)
+    {
+        Py::Dict dict;
+        for (size_t i = 0; i < elements.ids.size(); ++i) {
+            Py::Tuple nodes(elements.size);
+            for (int j = 0; j < elements.size; ++j) {
+                nodes.setItem(j, Py::Long(elements.nodes[i * elements.size + j]));
+            }
+            dict.setItem(Py::Long(elements.ids[i]), nodes);
+        }
+        return dict;
+    }
+    Py::Object readCcxFrd(const Py::Tuple& args)
+    {
+        char* Name;
+        if (!PyArg_ParseTuple(args.ptr(), "et", "utf-8", &Name)) {
+            throw Py::Exception();
+        }
+
+        std::string EncodedName = std::string(Name);
+        PyMem_Free(Name);
+
+        auto reader = std::make_shared<CcxFrdReader>(EncodedName);
+        Py::Dict dict;
+        dict.setItem("Nodes", CcxFrdResultsPy::valuesToDict(reader->readNodes()));
+        for (const auto& it : reader->readElements()) {
+            dict.setItem(it.first, elementsToDict(it.second));
+        }
+        // the result sets are only read when they are accessed
+        dict.setItem("Results", Py::asObject(new CcxFrdResultsPy(reader)));
+        return dict;
+    }
+    Py::Object readCcxDat(const Py::Tuple& args)
+    {
+        char* Name;
+        if (!PyArg_ParseTuple(args.ptr(), "et", "utf-8", &Name)) {
+            throw Py::Exception();
+        }
+
+        std::string EncodedName = std::string(Name);
+        PyMem_Free(Name);
+
+        Py::List modes;
+        for (const auto& it : readCcxDatEigenmodes(EncodedName)) {
+            Py::Dict mode;
+            mode.setItem("eigenmode", Py::Long(it.first));
+            mode.setItem("frequency", Py::Float(it.second));
+            modes.append(mode);
+        }
+        return modes;
+    }
 
 #ifdef FC_USE_VTK
     Py::Object readResult(const Py::Tuple& args)
@@ -0,0 +1,649 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <QFile>
+#include <QString>
+#endif
+
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+
+#include "FemCcxReader.h"
+
+
+using namespace Fem;
+
+namespace
+{
+
+struct Line
+{
+    const char* begin;
+    const char* end;
+
+    // whether the line has text at the given column, like line[column:...] == text in Python
+    bool at(size_t column, const char* text) const
+    {
+        size_t length = std::strlen(text);
+        return size_t(end - begin) >= column + length
+            && std::memcmp(begin + column, text, length) == 0;
+    }
+};
+
+class LineReader
+{
+public:
+    LineReader(const char* begin, const char* end)
+        : pos(begin)
+        , last(end)
+    {}
+
+    bool next(Line& line)
+    {
+        if (pos >= last) {
+            return false;
+        }
+        line.begin = pos;
+        auto newline = static_cast<const char*>(std::memchr(pos, '\n', last - pos));
+        line.end = newline ? newline : last;
+        pos = newline ? newline + 1 : last;
+        if (line.end > line.begin && line.end[-1] == '\r') {
+            --line.end;
+        }
+        return true;
+    }
+
+private:
+    const char* pos;
+    const char* last;
+};
+
+const char* nextLine(const char* pos, const char* end)
+{
+    auto newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+    return newline ? newline + 1 : end;
+}
+
+// copy the columns [from, to) of a line without surrounding blanks, empty if there is nothing
+size_t column(const Line& line, size_t from, size_t to, char* buffer, size_t bufferSize)
+{
+    size_t length = line.end - line.begin;
+    from = std::min(from, length);
+    to = std::min(to, length);
+    while (from < to && std::isspace(static_cast<unsigned char>(line.begin[from]))) {
+        ++from;
+    }
+    while (to > from && std::isspace(static_cast<unsigned char>(line.begin[to - 1]))) {
+        --to;
+    }
+    if (to - from >= bufferSize) {
+        return 0;
+    }
+    std::memcpy(buffer, line.begin + from, to - from);
+    buffer[to - from] = '\0';
+    return to - from;
+}
+
+bool parseInt(const Line& line, size_t from, size_t to, int& value)
+{
+    char buffer[32];
+    size_t length = column(line, from, to, buffer, sizeof(buffer));
+    if (length == 0) {
+        return false;
+    }
+    char* end = nullptr;
+    long result = std::strtol(buffer, &end, 10);
+    if (end != buffer + length) {
+        return false;
+    }
+    value = static_cast<int>(result);
+    return true;
+}
+
+bool parseDouble(const Line& line, size_t from, size_t to, double& value)
+{
+    char buffer[32];
+    size_t length = column(line, from, to, buffer, sizeof(buffer));
+    if (length == 0) {
+        return false;
+    }
+    char* end = nullptr;
+    value = std::strtod(buffer, &end);
+    return end == buffer + length;
+}
+
+int toInt(const Line& line, size_t from, size_t to)
+{
+    int value = 0;
+    if (!parseInt(line, from, to, value)) {
+        std::string text(line.begin, line.end);
+        throw Base::BadFormatError("Invalid integer in frd file line: " + text);
+    }
+    return value;
+}
+
+double toDouble(const Line& line, size_t from, size_t to)
+{
+    double value = 0.0;
+    if (!parseDouble(line, from, to, value)) {
+        std::string text(line.begin, line.end);
+        throw Base::BadFormatError("Invalid number in frd file line: " + text);
+    }
+    return value;
+}
+
+// the result blocks that are read, with the header text that starts them at column 5
+struct ResultKind
+{
+    const char* name;
+    const char* header;
+    int size;
+};
+
+const ResultKind resultKinds[] = {
+    {"disp", "DISP", 3},
+    {"stress", "STRESS", 6},
+    {"strain", "TOSTRAIN", 6},
+    {"peeq", "PE", 1},
+    {"temp", "NDTEMP", 1},
+    {"heatflux", "FLUX", 3},
+    {"mflow", "MAFLOW", 1},
+    {"npressure", "STPRES", 1},
+};
+
+// a CalculiX element type and the FreeCAD element it becomes
+struct ElementKind
+{
+    int type;
+    const char* name;
+    std::vector<int> order;  // 1 based positions of the frd nodes in FreeCAD order
+};
+
+// node orders fit with the node order in FemMesh::writeABAQUS.  cgx, and thus the frd file,
+// uses a different node order than ccx for the quadratic hexa and penta elements.
+const std::vector<ElementKind>& elementKinds()
+{
+    static const std::vector<ElementKind> kinds = {
+        {1, "Hexa8Elem", {6, 7, 8, 5, 2, 3, 4, 1}},
+        {2, "Penta6Elem", {5, 6, 4, 2, 3, 1}},
+        {3, "Tetra4Elem", {2, 1, 3, 4}},
+        {4, "Hexa20Elem", {8, 5, 6, 7, 4, 1, 2, 3, 20, 17, 18, 19, 12, 9, 10, 11, 16, 13, 14, 15}},
+        {5, "Penta15Elem", {5, 6, 4, 2, 3, 1, 14, 15, 13, 8, 9, 7, 11, 12, 10}},
+        {6, "Tetra10Elem", {2, 1, 3, 4, 5, 7, 6, 9, 8, 10}},
+        {7, "Tria3Elem", {1, 2, 3}},
+        {8, "Tria6Elem", {1, 2, 3, 4, 5, 6}},
+        {9, "Quad4Elem", {1, 2, 3, 4}},
+        {10, "Quad8Elem", {1, 2, 3, 4, 5, 6, 7, 8}},
+        {11, "Seg2Elem", {1, 2}},
+        {12, "Seg3Elem", {1, 2, 3}},
+    };
+    return kinds;
+}
+
+// split blocks into chunks of about chunkSize bytes.  Chunks start at a " -1" line, which
+// starts every node, element and result record, so they can be parsed independently.
+template<typename BlockType>
+std::vector<BlockType> splitBlocks(const std::vector<BlockType>& blocks)
+{
+    const size_t chunkSize = 1 << 20;
+    std::vector<BlockType> chunks;
+    for (const auto& block : blocks) {
+        const char* begin = block.begin;
+        while (begin < block.end) {
+            const char* end = begin + std::min(chunkSize, size_t(block.end - begin));
+            if (end < block.end && end[-1] != '\n') {
+                end = nextLine(end, block.end);
+            }
+            while (end < block.end && !Line {end, block.end}.at(1, "-1")) {
+                end = nextLine(end, block.end);
+            }
+            chunks.push_back({begin, end});
+            begin = end;
+        }
+    }
+    return chunks;
+}
+
+// parse the chunks of the blocks concurrently and return the results in file order
+template<typename Result, typename BlockType, typename Parse>
+std::vector<Result> parseBlocks(const std::vector<BlockType>& blocks, Parse parse)
+{
+    std::vector<BlockType> chunks = splitBlocks(blocks);
+    std::vector<Result> results(chunks.size());
+    std::vector<std::string> errors(chunks.size());
+
+#pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        try {
+            parse(chunks[i].begin, chunks[i].end, results[i]);
+        }
+        catch (const Base::Exception& e) {
+            errors[i] = e.what();
+        }
+    }
+
+    for (const auto& error : errors) {
+        if (!error.empty()) {
+            throw Base::BadFormatError(error);
+        }
+    }
+    return results;
+}
+
+}  // namespace
+
+CcxFrdReader::CcxFrdReader(const std::string& fileName)
+    : file(std::make_unique<QFile>(QString::fromUtf8(fileName.c_str())))
+{
+    if (!file->open(QIODevice::ReadOnly)) {
+        throw Base::FileException("Cannot open file", fileName.c_str());
+    }
+    qint64 size = file->size();
+    if (size > 0) {
+        data = reinterpret_cast<const char*>(file->map(0, size));
+        if (!data) {
+            throw Base::FileException("Cannot map file", fileName.c_str());
+        }
+        dataEnd = data + size;
+    }
+
+    readInOutNodes(fileName);
+    scan();
+}
+
+CcxFrdReader::~CcxFrdReader() = default;
+
+void CcxFrdReader::readInOutNodes(const std::string& fileName)
+{
+    std::string inOutName = fileName.substr(0, fileName.rfind('.')) + "_inout_nodes.txt";
+    Base::FileInfo fi(inOutName);
+    if (!fi.exists()) {
+        return;
+    }
+
+    Base::Console().Message("Read special 1DFlow nodes data from: %s\n", inOutName.c_str());
+    Base::ifstream str(fi, std::ios::in);
+    std::string text;
+    while (std::getline(str, text)) {
+        if (text.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        // element, end node, node taking the results of the end node
+        size_t first = text.find(',');
+        size_t second = first == std::string::npos ? first : text.find(',', first + 1);
+        if (second == std::string::npos) {
+            throw Base::BadFormatError("Invalid line in " + inOutName + ": " + text);
+        }
+        size_t third = text.find(',', second + 1);
+        Line line {text.data(), text.data() + text.size()};
+        size_t last = third == std::string::npos ? text.size() : third;
+        inOutNodes.emplace_back(toInt(line, first + 1, second), toInt(line, second + 1, last));
+    }
+}
+
+//! find the node, element and result blocks and group the result blocks into result sets.  A
+//! new result set starts when the eigenmode number or the step time grows.
+void CcxFrdReader::scan()
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    const char* nodesStart = nullptr;
+    const char* elementsStart = nullptr;
+    std::map<std::string, const char*> resultsStart;
+    ResultSetBlocks current {nan, nan, {}};
+
+    bool timeFound = false;
+    bool endOfSection = false;
+    bool endOfData = false;
+    bool nodeElementSection = false;
+    bool eigenChanged = false;
+    bool timeChanged = false;
+    int eigenmode = 0;
+    double timestep = 0.0;
+
+    LineReader reader(data, dataEnd);
+    Line line;
+    while (reader.next(line)) {
+        if (line.at(4, "2C") && !nodesStart) {
+            nodesStart = line.begin;
+        }
+        if (line.at(4, "3C") && !elementsStart) {
+            elementsStart = line.begin;
+        }
+
+        if (line.at(5, "PMODE")) {
+            int mode = toInt(line, 30, 36);
+            if (mode > eigenmode) {
+                eigenmode = mode;
+                eigenChanged = true;
+            }
+        }
+        if (line.at(4, "1PSTEP")) {
+            timeFound = true;
+        }
+        if (timeFound && line.at(2, "100CL")) {
+            double time = toDouble(line, 13, 25);
+            if (time > timestep) {
+                timestep = time;
+                timeChanged = true;
+            }
+        }
+
+        for (const auto& kind : resultKinds) {
+            if (line.at(5, kind.header)) {
+                resultsStart.emplace(kind.name, line.begin);
+            }
+        }
+
+        if (line.at(1, "-3")) {
+            endOfSection = true;
+            if (nodesStart) {
+                nodeBlocks.push_back({nodesStart, line.begin});
+                nodesStart = nullptr;
+                nodeElementSection = true;
+            }
+            if (elementsStart) {
+                elementBlocks.push_back({elementsStart, line.begin});
+                elementsStart = nullptr;
+                nodeElementSection = true;
+            }
+            for (const auto& it : resultsStart) {
+                current.fields[it.first] = {it.second, line.begin};
+                nodeElementSection = false;
+            }
+            resultsStart.clear();
+        }
+
+        if (line.at(1, "9999")) {
+            endOfData = true;
+        }
+
+        if ((eigenChanged || timeChanged || endOfData) && endOfSection && !nodeElementSection) {
+            resultSets.push_back(current);
+            current = {nan, nan, {}};
+            endOfSection = false;
+        }
+
+        if (eigenChanged) {
+            current.number = eigenmode;
+            eigenChanged = false;
+        }
+        if (timeChanged) {
+            current.time = timestep;
+            timeFound = false;
+            timeChanged = false;
+        }
+    }
+}
+
+CcxFrdReader::Values CcxFrdReader::readNodes() const
+{
+    auto parse = [](const char* begin, const char* end, Values& nodes) {
+        LineReader reader(begin, end);
+        Line line;
+        while (reader.next(line)) {
+            if (!line.at(1, "-1")) {
+                continue;
+            }
+            nodes.ids.push_back(toInt(line, 4, 13));
+            nodes.values.push_back(toDouble(line, 13, 25));
+            nodes.values.push_back(toDouble(line, 25, 37));
+            nodes.values.push_back(toDouble(line, 37, 49));
+        }
+    };
+    auto chunks = parseBlocks<Values>(nodeBlocks, parse);
+
+    Values nodes;
+    nodes.size = 3;
+    for (const auto& chunk : chunks) {
+        nodes.ids.insert(nodes.ids.end(), chunk.ids.begin(), chunk.ids.end());
+        nodes.values.insert(nodes.values.end(), chunk.values.begin(), chunk.values.end());
+    }
+    return nodes;
+}
+
+std::map<std::string, CcxFrdReader::Elements> CcxFrdReader::readElements() const
+{
+    const auto& kinds = elementKinds();
+    using ElementChunk = std::vector<Elements>;
+
+    auto parse = [this, &kinds](const char* begin, const char* end, ElementChunk& elements) {
+        elements.resize(kinds.size());
+        const ElementKind* kind = nullptr;
+        Elements* target = nullptr;
+        int element = 0;
+        std::vector<int> frdNodes;
+
+        LineReader reader(begin, end);
+        Line line;
+        while (reader.next(line)) {
+            if (line.at(1, "-1")) {
+                element = toInt(line, 4, 13);
+                int type = toInt(line, 14, 18);
+                auto it = std::find_if(kinds.begin(), kinds.end(), [type](const ElementKind& k) {
+                    return k.type == type;
+                });
+                kind = it != kinds.end() ? &*it : nullptr;
+                target = kind ? &elements[it - kinds.begin()] : nullptr;
+                frdNodes.clear();
+                continue;
+            }
+            if (!line.at(1, "-2") || !kind) {
+                continue;
+            }
+
+            // up to ten nodes per line, hexa20 and penta15 continue on a second line
+            size_t count = std::min<size_t>(10, kind->order.size() - frdNodes.size());
+            for (size_t i = 0; i < count; ++i) {
+                frdNodes.push_back(toInt(line, 3 + 10 * i, 13 + 10 * i));
+            }
+            if (frdNodes.size() < kind->order.size()) {
+                continue;
+            }
+
+            std::vector<int> nodes;
+            nodes.reserve(kind->order.size());
+            for (int position : kind->order) {
+                nodes.push_back(frdNodes[position - 1]);
+            }
+            frdNodes.clear();
+
+            if (kind->type == 12 && !inOutNodes.empty()) {
+                // 1D flow elements: the fluid inlet and outlet nodes get their own numbers
+                bool found = false;
+                std::vector<int> flowNodes;
+                for (const auto& inOut : inOutNodes) {
+                    if (nodes[0] == inOut.first) {
+                        flowNodes = {inOut.second, nodes[2], nodes[0]};
+                        found = true;
+                    }
+                    else if (nodes[2] == inOut.first) {
+                        flowNodes = {nodes[0], inOut.second, nodes[2]};
+                        found = true;
+                    }
+                }
+                if (!found) {
+                    continue;
+                }
+                nodes = flowNodes;
+            }
+
+            target->ids.push_back(element);
+            target->nodes.insert(target->nodes.end(), nodes.begin(), nodes.end());
+        }
+    };
+    auto chunks = parseBlocks<ElementChunk>(elementBlocks, parse);
+
+    std::map<std::string, Elements> elements;
+    for (size_t i = 0; i < kinds.size(); ++i) {
+        Elements& result = elements[kinds[i].name];
+        result.size = static_cast<int>(kinds[i].order.size());
+        for (const auto& chunk : chunks) {
+            result.ids.insert(result.ids.end(), chunk[i].ids.begin(), chunk[i].ids.end());
+            result.nodes.insert(result.nodes.end(), chunk[i].nodes.begin(), chunk[i].nodes.end());
+        }
+    }
+    return elements;
+}
+
+size_t CcxFrdReader::countResultSets() const
+{
+    return resultSets.size();
+}
+
+std::pair<double, double> CcxFrdReader::getResultSetTime(size_t index) const
+{
+    if (index >= resultSets.size()) {
+        throw Base::IndexError("Result set index out of range");
+    }
+    return {resultSets[index].number, resultSets[index].time};
+}
+
+std::vector<std::string> CcxFrdReader::getResultSetFields(size_t index) const
+{
+    if (index >= resultSets.size()) {
+        throw Base::IndexError("Result set index out of range");
+    }
+    std::vector<std::string> names;
+    for (const auto& it : resultSets[index].fields) {
+        names.push_back(it.first);
+    }
+    return names;
+}
+
+CcxFrdReader::ResultSet CcxFrdReader::readResultSet(size_t index) const
+{
+    if (index >= resultSets.size()) {
+        throw Base::IndexError("Result set index out of range");
+    }
+
+    const ResultSetBlocks& blocks = resultSets[index];
+    ResultSet result {blocks.number, blocks.time, {}};
+    for (const auto& it : blocks.fields) {
+        result.fields[it.first] = readValues(it.first, it.second);
+    }
+    return result;
+}
+
+CcxFrdReader::Values CcxFrdReader::readValues(const std::string& name, const Block& block) const
+{
+    auto kind = std::find_if(std::begin(resultKinds),
+                             std::end(resultKinds),
+                             [&name](const ResultKind& k) {
+                                 return name == k.name;
+                             });
+    const int size = kind->size;
+    // tensors are written as (xx, yy, zz, xy, yz, zx), FreeCAD uses (xx, yy, zz, xy, xz, yz)
+    const bool tensor = size == 6;
+    // mass flow is written in t/s, FreeCAD uses kg/s
+    const double factor = name == "mflow" ? 1000.0 : 1.0;
+    // the 1D flow end nodes pass their results on
+    const bool flow = name == "mflow" || name == "npressure";
+
+    auto parse = [&](const char* begin, const char* end, Values& values) {
+        double row[6];
+        LineReader reader(begin, end);
+        Line line;
+        while (reader.next(line)) {
+            if (!line.at(1, "-1")) {
+                continue;
+            }
+            int id = toInt(line, 4, 13);
+            for (int i = 0; i < size; ++i) {
+                row[i] = toDouble(line, 13 + 12 * i, 25 + 12 * i) * factor;
+            }
+            if (tensor) {
+                std::swap(row[4], row[5]);
+            }
+
+            values.ids.push_back(id);
+            values.values.insert(values.values.end(), row, row + size);
+            if (flow) {
+                for (const auto& inOut : inOutNodes) {
+                    if (id == inOut.first) {
+                        values.ids.push_back(inOut.second);
+                        values.values.insert(values.values.end(), row, row + size);
+                    }
+                }
+            }
+        }
+    };
+    auto chunks = parseBlocks<Values>(std::vector<Block> {block}, parse);
+
+    Values values;
+    values.size = size;
+    for (const auto& chunk : chunks) {
+        values.ids.insert(values.ids.end(), chunk.ids.begin(), chunk.ids.end());
+        values.values.insert(values.values.end(), chunk.values.begin(), chunk.values.end());
+    }
+    return values;
+}
+
+std::vector<std::pair<int, double>> Fem::readCcxDatEigenmodes(const std::string& fileName)
+{
+    Base::FileInfo fi(fileName);
+    Base::ifstream str(fi, std::ios::in);
+    if (!str) {
+        throw Base::FileException("Cannot open file", fi);
+    }
+
+    const char* eigenvalueOutputSection = "     E I G E N V A L U E   O U T P U T";
+    std::vector<std::pair<int, double>> modes;
+    bool sectionFound = false;
+    bool modeReading = false;
+    std::string text;
+    while (std::getline(str, text)) {
+        if (!text.empty() && text.back() == '\r') {
+            text.pop_back();
+        }
+        if (text.find(eigenvalueOutputSection) != std::string::npos) {
+            sectionFound = true;
+        }
+        if (!sectionFound) {
+            continue;
+        }
+
+        Line line {text.data(), text.data() + text.size()};
+        int mode = 0;
+        double frequency = 0.0;
+        if (parseInt(line, 0, 7, mode) && parseDouble(line, 39, 55, frequency)) {
+            modes.emplace_back(mode, frequency);
+            modeReading = true;
+        }
+        else if (modeReading) {
+            // the first line that is no mode after the modes ends the section
+            sectionFound = false;
+            modeReading = false;
+        }
+    }
+    return modes;
+}
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef FEM_CCXREADER_H
+#define FEM_CCXREADER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Mod/Fem/FemGlobal.h>
+
+class QFile;
+
+namespace Fem
+{
+
+/** Reader for CalculiX .frd result files
+ *
+ * The file is memory mapped and scanned once on construction to find the node, element and
+ * result blocks.  The blocks themselves are only parsed when they are asked for, in parallel
+ * chunks, so large multi step results can be read one result set at a time.
+ *
+ * Node numbers, node order and the grouping of the blocks into result sets follow the old
+ * Python reader in feminout/importCcxFrdResults.py.
+ */
+class FemExport CcxFrdReader
+{
+public:
+    /// node or element numbers with the same number of values for each of them
+    struct Values
+    {
+        int size = 0;
+        std::vector<int> ids;
+        std::vector<double> values;
+    };
+
+    /// elements of one type, with their nodes in FreeCAD order
+    struct Elements
+    {
+        int size = 0;
+        std::vector<int> ids;
+        std::vector<int> nodes;
+    };
+
+    /// the results of one time step or eigenmode
+    struct ResultSet
+    {
+        double number;  // eigenmode number, NaN if not an eigenmode
+        double time;    // step time, NaN if not given
+        std::map<std::string, Values> fields;  // keyed by "disp", "stress", ...
+    };
+
+    explicit CcxFrdReader(const std::string& fileName);
+    ~CcxFrdReader();
+
+    Values readNodes() const;
+    /// keyed by the element type name, e.g. "Tetra10Elem", all types are present
+    std::map<std::string, Elements> readElements() const;
+    size_t countResultSets() const;
+    /// number and time of a result set, without reading its values
+    std::pair<double, double> getResultSetTime(size_t index) const;
+    /// names of the fields of a result set, without reading their values
+    std::vector<std::string> getResultSetFields(size_t index) const;
+    ResultSet readResultSet(size_t index) const;
+
+private:
+    struct Block
+    {
+        const char* begin;
+        const char* end;
+    };
+    struct ResultSetBlocks
+    {
+        double number;
+        double time;
+        std::map<std::string, Block> fields;
+    };
+
+    void readInOutNodes(const std::string& fileName);
+    void scan();
+    Values readValues(const std::string& name, const Block& block) const;
+
+    std::unique_ptr<QFile> file;
+    const char* data = nullptr;
+    const char* dataEnd = nullptr;
+    std::vector<Block> nodeBlocks;
+    std::vector<Block> elementBlocks;
+    std::vector<ResultSetBlocks> resultSets;
+    // 1D flow: element end node and the node that takes its results, see _inout_nodes.txt
+    std::vector<std::pair<int, int>> inOutNodes;
+};
+
+/// eigenmode numbers and frequencies from the eigenvalue output of a CalculiX .dat file
+FemExport std::vector<std::pair<int, double>> readCcxDatEigenmodes(const std::string& fileName);
+
+}  // namespace Fem
+
+#endif  // FEM_CCXREADER_H
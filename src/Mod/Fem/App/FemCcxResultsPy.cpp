@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <cmath>
+#endif
+
+#include <Base/GeometryPyCXX.h>
+
+#include "FemCcxResultsPy.h"
+
+
+using namespace Fem;
+
+void CcxFrdResultsPy::init_type()
+{
+    behaviors().name("CcxFrdResults");
+    behaviors().doc("Result sets of a CalculiX frd file, each one is read when it is accessed");
+    // you must have overwritten the virtual functions
+    behaviors().supportRepr();
+    behaviors().supportGetattr();
+    behaviors().supportSequenceType(Py::PythonType::support_sequence_length
+                                    | Py::PythonType::support_sequence_item);
+
+    add_varargs_method("getFieldNames",
+                       &CcxFrdResultsPy::getFieldNames,
+                       "getFieldNames(int) -- The names of the results of a result set, "
+                       "without reading them.");
+}
+
+CcxFrdResultsPy::CcxFrdResultsPy(std::shared_ptr<CcxFrdReader> reader)
+    : reader(std::move(reader))
+{}
+
+CcxFrdResultsPy::~CcxFrdResultsPy() = default;
+
+Py::Object CcxFrdResultsPy::repr()
+{
+    std::string s = "<CcxFrdResults with " + std::to_string(reader->countResultSets())
+        + " result sets>";
+    return Py::String(s);
+}
+
+PyCxx_ssize_t CcxFrdResultsPy::sequence_length()
+{
+    return static_cast<PyCxx_ssize_t>(reader->countResultSets());
+}
+
+Py::Object CcxFrdResultsPy::sequence_item(Py_ssize_t index)
+{
+    // the iteration over the sequence ends with the IndexError
+    if (index < 0 || static_cast<size_t>(index) >= reader->countResultSets()) {
+        throw Py::IndexError("Result set index out of range");
+    }
+
+    CcxFrdReader::ResultSet resultSet = reader->readResultSet(index);
+    Py::Dict result;
+    if (std::isnan(resultSet.number)) {
+        result.setItem("number", Py::Float(resultSet.number));
+    }
+    else {
+        result.setItem("number", Py::Long(static_cast<long>(resultSet.number)));
+    }
+    result.setItem("time", Py::Float(resultSet.time));
+    for (const auto& it : resultSet.fields) {
+        result.setItem(it.first, valuesToDict(it.second));
+    }
+    return result;
+}
+
+Py::Object CcxFrdResultsPy::getFieldNames(const Py::Tuple& args)
+{
+    int index;
+    if (!PyArg_ParseTuple(args.ptr(), "i", &index)) {
+        throw Py::Exception();
+    }
+    if (index < 0 || static_cast<size_t>(index) >= reader->countResultSets()) {
+        throw Py::IndexError("Result set index out of range");
+    }
+
+    Py::List names;
+    for (const auto& name : reader->getResultSetFields(index)) {
+        names.append(Py::String(name));
+    }
+    return names;
+}
+
+Py::Dict CcxFrdResultsPy::valuesToDict(const CcxFrdReader::Values& values)
+{
+    Py::Dict dict;
+    for (size_t i = 0; i < values.ids.size(); ++i) {
+        const double* value = &values.values[i * values.size];
+        Py::Object item;
+        if (values.size == 1) {
+            item = Py::Float(value[0]);
+        }
+        else if (values.size == 3) {
+            item = Py::Vector(Base::Vector3d(value[0], value[1], value[2]));
+        }
+        else {
+            Py::Tuple tuple(values.size);
+            for (int j = 0; j < values.size; ++j) {
+                tuple.setItem(j, Py::Float(value[j]));
+            }
+            item = tuple;
+        }
+        dict.setItem(Py::Long(values.ids[i]), item);
+    }
+    return dict;
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef FEM_CCXRESULTSPY_H
+#define FEM_CCXRESULTSPY_H
+
+#include <memory>
+#include <CXX/Extensions.hxx>
+
+#include "FemCcxReader.h"
+
+
+namespace Fem
+{
+
+/** Read only sequence of the result sets of a CalculiX .frd file
+ *
+ * A result set is parsed and converted to a dict each time it is accessed, and nothing of it is
+ * kept by the sequence. Iterating over it therefore holds one result set in memory at a time.
+ */
+class CcxFrdResultsPy: public Py::PythonExtension<CcxFrdResultsPy>
+{
+public:
+    static void init_type();  // announce properties and methods
+
+    explicit CcxFrdResultsPy(std::shared_ptr<CcxFrdReader> reader);
+    ~CcxFrdResultsPy() override;
+
+    Py::Object repr() override;
+    PyCxx_ssize_t sequence_length() override;
+    Py::Object sequence_item(Py_ssize_t index) override;
+
+    Py::Object getFieldNames(const Py::Tuple& args);
+
+    /// the values as dict keyed by node number, of floats, vectors or tuples
+    static Py::Dict valuesToDict(const CcxFrdReader::Values& values);
+
+private:
+    std::shared_ptr<CcxFrdReader> reader;
+};
+
+}  // namespace Fem
+
+#endif  // FEM_CCXRESULTSPY_H
@@ -24,14 +24,31 @@
 
 #ifndef _PreComp_
 #include <Python.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <numeric>
 
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepAdaptor_Surface.hxx>
 #include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTopAdaptor_FClass2d.hxx>
 #include <BRep_Tool.hxx>
 #include <Bnd_Box.hxx>
+#include <Extrema_ExtPC.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
 #include <SMDS_MeshGroup.hxx>
 #include <SMESHDS_Group.hxx>
 #include <SMESHDS_GroupBase.hxx>
@@ -41,6 +58,8 @@
 #include <SMESH_Mesh.hxx>
 #include <SMESH_MeshEditor.hxx>
 #include <ShapeAnalysis_ShapeTolerance.hxx>
+#include <ShapeAnalysis_Surface.hxx>
+#include <Standard_Version.hxx>
 #include <StdMeshers_Deflection1D.hxx>
 #include <StdMeshers_LocalLength.hxx>
 #include <StdMeshers_MaxElementArea.hxx>
@@ -50,6 +69,9 @@
 #include <StdMeshers_Quadrangle_2D.hxx>
 #include <StdMeshers_Regular_1D.hxx>
 #include <StdMeshers_StartEndLength.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Solid.hxx>
@@ -87,33 +109,83 @@ static int StatCount = 0;
 #endif
 
 SMESH_Gen* FemMesh::_mesh_gen = nullptr;
+std::atomic<std::size_t> FemMesh::lastRevision {0};
 
 TYPESYSTEM_SOURCE(Fem::FemMesh, Base::Persistence)
 
 FemMesh::FemMesh()
+    : meshData(std::make_shared<FemMeshData>())
+    , myMesh(nullptr)
+    , revision(++lastRevision)
 {
     // Base::Console().Log("FemMesh::FemMesh():%p (id=%i)\n",this,StatCount);
-    //  create a mesh always with new StudyId to avoid overlapping destruction
-#if SMESH_VERSION_MAJOR >= 9
-    myMesh = getGenerator()->CreateMesh(false);
-#else
-    myMesh = getGenerator()->CreateMesh(StatCount++, false);
-#endif
+    // the SMESH mesh is only created when it is needed
 }
 
 FemMesh::FemMesh(const FemMesh& mesh)
+    : _Mtrx(mesh._Mtrx)
+    , meshData(mesh.getMeshData())
+    , myMesh(nullptr)
+    , revision(++lastRevision)
+{}
+
+FemMesh::~FemMesh()
 {
+    // Base::Console().Log("FemMesh::~FemMesh():%p\n",this);
+    destroySMesh();
+}
+
+FemMesh& FemMesh::operator=(const FemMesh& mesh)
+{
+    if (this != &mesh) {
+        std::shared_ptr<const FemMeshData> data = mesh.getMeshData();
+        {
+            std::lock_guard<std::mutex> lock(smeshMutex);
+            if (smeshShared) {
+                // the SMESH mesh handed out stays valid, it gets the new content
+                TopoDS_Shape aNull;
+                myMesh->ShapeToMesh(aNull);
+                myMesh->Clear();
+                data->toSMesh(myMesh);
+            }
+            else {
+                destroySMesh();
+            }
+        }
+        _Mtrx = mesh._Mtrx;
+        meshData = data;
+        meshChanged();
+    }
+    return *this;
+}
+
+SMESH_Mesh* FemMesh::createSMesh() const
+{
+    //  create a mesh always with new StudyId to avoid overlapping destruction
 #if SMESH_VERSION_MAJOR >= 9
-    myMesh = getGenerator()->CreateMesh(false);
+    return getGenerator()->CreateMesh(false);
 #else
-    myMesh = getGenerator()->CreateMesh(StatCount++, false);
+    return getGenerator()->CreateMesh(StatCount++, false);
 #endif
-    copyMeshData(mesh);
 }
 
-FemMesh::~FemMesh()
+SMESH_Mesh* FemMesh::loadSMesh() const
 {
-    // Base::Console().Log("FemMesh::~FemMesh():%p\n",this);
+    std::lock_guard<std::mutex> lock(smeshMutex);
+    if (!myMesh) {
+        myMesh = createSMesh();
+        if (meshData) {
+            meshData->toSMesh(myMesh);
+        }
+    }
+    return myMesh;
+}
+
+void FemMesh::destroySMesh() const
+{
+    if (!myMesh) {
+        return;
+    }
 
     try {
         TopoDS_Shape aNull;
@@ -124,85 +196,215 @@ FemMesh::~FemMesh()
     }
     catch (...) {
     }
+    myMesh = nullptr;
+    smeshShared = false;
 }
 
-FemMesh& FemMesh::operator=(const FemMesh& mesh)
+void FemMesh::releaseSMesh() const
 {
-    if (this != &mesh) {
-#if SMESH_VERSION_MAJOR >= 9
-        myMesh = getGenerator()->CreateMesh(true);
-#else
-        myMesh = getGenerator()->CreateMesh(0, true);
-#endif
-        copyMeshData(mesh);
+    std::lock_guard<std::mutex> lock(smeshMutex);
+    if (meshData && !smeshShared) {
+        destroySMesh();
     }
-    return *this;
 }
 
-void FemMesh::copyMeshData(const FemMesh& mesh)
+void FemMesh::makeCompact()
 {
-    _Mtrx = mesh._Mtrx;
+    // a mesh with a shape or hypotheses may still be meshed
+    if (!meshData && !myMesh->HasShapeToMesh() && hypoth.empty()) {
+        meshData = FemMeshData::fromSMesh(myMesh);
+        std::lock_guard<std::mutex> lock(smeshMutex);
+        if (!smeshShared) {
+            destroySMesh();
+        }
+    }
+}
 
-    // See file SMESH_I/SMESH_Gen_i.cxx in the git repo of smesh at
-    // https://git.salome-platform.org
-#if 1
-    // 1. Get source mesh
-    SMESHDS_Mesh* srcMeshDS = mesh.myMesh->GetMeshDS();
+std::shared_ptr<const FemMeshData> FemMesh::getMeshData() const
+{
+    if (meshData) {
+        return meshData;
+    }
+    return FemMeshData::fromSMesh(myMesh);
+}
 
-    // 2. Get target mesh
-    SMESHDS_Mesh* newMeshDS = this->myMesh->GetMeshDS();
-    SMESH_MeshEditor editor(this->myMesh);
+std::shared_ptr<const FemMeshData> FemMesh::getCompactData() const
+{
+    return meshData;
+}
 
-    // 3. Get elements to copy
-    SMDS_ElemIteratorPtr srcElemIt;
-    SMDS_NodeIteratorPtr srcNodeIt;
-    srcElemIt = srcMeshDS->elementsIterator();
-    srcNodeIt = srcMeshDS->nodesIterator();
+namespace
+{
 
-    // 4. Copy elements
-    int iN;
-    const SMDS_MeshNode *nSrc, *nTgt;
-    std::vector<const SMDS_MeshNode*> nodes;
-    while (srcElemIt->more()) {
-        const SMDS_MeshElement* elem = srcElemIt->next();
-        // find / add nodes
-        nodes.resize(elem->NbNodes());
+// sorts the ids together with their values, size values per id
+template<typename T>
+void sortById(std::vector<int>& ids, std::vector<T>& values, size_t size)
+{
+    // SMESH mostly iterates in the order of the ids already
+    if (std::is_sorted(ids.begin(), ids.end())) {
+        return;
+    }
+    std::vector<size_t> order(ids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&ids](size_t i, size_t j) {
+        return ids[i] < ids[j];
+    });
+    std::vector<int> sortedIds;
+    std::vector<T> sortedValues;
+    sortedIds.reserve(ids.size());
+    sortedValues.reserve(values.size());
+    for (size_t i : order) {
+        sortedIds.push_back(ids[i]);
+        sortedValues.insert(sortedValues.end(),
+                            values.begin() + i * size,
+                            values.begin() + (i + 1) * size);
+    }
+    ids.swap(sortedIds);
+    values.swap(sortedValues);
+}
+
+}  // namespace
+
+// See file SMESH_I/SMESH_Gen_i.cxx in the git repo of smesh at
+// https://git.salome-platform.org for how a mesh is copied
+std::shared_ptr<const FemMeshData> FemMeshData::fromSMesh(const SMESH_Mesh* mesh)
+{
+    auto data = std::make_shared<FemMeshData>();
+    const SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
+
+    // nodes, free nodes included
+    data->nodeIds.reserve(meshDS->NbNodes());
+    data->coords.reserve(3 * meshDS->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
+    while (aNodeIter->more()) {
+        const SMDS_MeshNode* aNode = aNodeIter->next();
+        data->nodeIds.push_back(aNode->GetID());
+        data->coords.push_back(aNode->X());
+        data->coords.push_back(aNode->Y());
+        data->coords.push_back(aNode->Z());
+    }
+    sortById(data->nodeIds, data->coords, 3);
+
+    // elements, one block per entity type
+    std::map<SMDSAbs_EntityType, size_t> blocks;
+    std::vector<int> nodes;
+    SMDS_ElemIteratorPtr aElemIter = meshDS->elementsIterator();
+    while (aElemIter->more()) {
+        const SMDS_MeshElement* elem = aElemIter->next();
+        if (elem->GetType() == SMDSAbs_Node) {
+            continue;
+        }
+
+        auto it = blocks.find(elem->GetEntityType());
+        if (it == blocks.end()) {
+            it = blocks.emplace(elem->GetEntityType(), data->elements.size()).first;
+            Elements block;
+            block.entity = elem->GetEntityType();
+            block.type = elem->GetType();
+            block.poly = elem->IsPoly();
+            data->elements.push_back(std::move(block));
+        }
+        Elements& block = data->elements[it->second];
+
+        nodes.clear();
         SMDS_ElemIteratorPtr nIt = elem->nodesIterator();
-        for (iN = 0; nIt->more(); ++iN) {
-            nSrc = static_cast<const SMDS_MeshNode*>(nIt->next());
-            nTgt = newMeshDS->FindNode(nSrc->GetID());
-            if (!nTgt) {
-                nTgt = newMeshDS->AddNodeWithID(nSrc->X(), nSrc->Y(), nSrc->Z(), nSrc->GetID());
+        while (nIt->more()) {
+            nodes.push_back(nIt->next()->GetID());
+        }
+
+        // the offsets are only needed once the elements differ in size
+        int count = static_cast<int>(nodes.size());
+        if (block.ids.empty()) {
+            block.nodesPerElement = count;
+        }
+        else if (block.offsets.empty() && count != block.nodesPerElement) {
+            block.offsets.resize(block.ids.size() + 1);
+            for (size_t i = 0; i < block.offsets.size(); ++i) {
+                block.offsets[i] = i * block.nodesPerElement;
             }
-            nodes[iN] = nTgt;
+        }
+        block.ids.push_back(elem->GetID());
+        block.nodes.insert(block.nodes.end(), nodes.begin(), nodes.end());
+        if (!block.offsets.empty()) {
+            block.offsets.push_back(block.nodes.size());
         }
 
-        // add elements
-        if (elem->GetType() != SMDSAbs_Node) {
-            int ID = elem->GetID();
-            switch (elem->GetEntityType()) {
-                case SMDSEntity_Polyhedra:
+        switch (block.entity) {
+            case SMDSEntity_Polyhedra:
 #if SMESH_VERSION_MAJOR >= 9
-                    editor.GetMeshDS()->AddPolyhedralVolumeWithID(
-                        nodes,
-                        static_cast<const SMDS_MeshVolume*>(elem)->GetQuantities(),
-                        ID);
+                block.quantities.push_back(
+                    static_cast<const SMDS_MeshVolume*>(elem)->GetQuantities());
 #else
-                    editor.GetMeshDS()->AddPolyhedralVolumeWithID(
-                        nodes,
-                        static_cast<const SMDS_VtkVolume*>(elem)->GetQuantities(),
-                        ID);
+                block.quantities.push_back(
+                    static_cast<const SMDS_VtkVolume*>(elem)->GetQuantities());
 #endif
+                break;
+            case SMDSEntity_Ball:
+                block.diameters.push_back(
+                    static_cast<const SMDS_BallElement*>(elem)->GetDiameter());
+                break;
+            default:
+                break;
+        }
+    }
+
+    for (auto& block : data->elements) {
+        block.ids.shrink_to_fit();
+        block.offsets.shrink_to_fit();
+        block.nodes.shrink_to_fit();
+    }
+
+    // groups, GetGroup() isn't const
+    SMESH_Mesh* groupMesh = const_cast<SMESH_Mesh*>(mesh);  // NOLINT
+    for (int id : mesh->GetGroupIds()) {
+        SMESH_Group* group = groupMesh->GetGroup(id);
+        const SMESHDS_GroupBase* groupDS = group->GetGroupDS();
+        Group groupData;
+        groupData.id = id;
+        groupData.name = group->GetName();
+        groupData.type = groupDS->GetType();
+        SMDS_ElemIteratorPtr eIt = groupDS->GetElements();
+        while (eIt->more()) {
+            groupData.ids.push_back(eIt->next()->GetID());
+        }
+        data->groups.push_back(std::move(groupData));
+    }
+
+    return data;
+}
+
+void FemMeshData::toSMesh(SMESH_Mesh* mesh) const
+{
+    SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
+    SMESH_MeshEditor editor(mesh);
+
+    for (size_t i = 0; i < nodeIds.size(); ++i) {
+        meshDS->AddNodeWithID(coords[3 * i], coords[3 * i + 1], coords[3 * i + 2], nodeIds[i]);
+    }
+
+    std::vector<const SMDS_MeshNode*> nodes;
+    for (const auto& block : elements) {
+        for (size_t i = 0; i < block.size(); ++i) {
+            const int* ids = block.elementNodes(i);
+            nodes.resize(block.countNodes(i));
+            for (size_t j = 0; j < nodes.size(); ++j) {
+                nodes[j] = meshDS->FindNode(ids[j]);
+            }
+
+            int ID = block.ids[i];
+            switch (block.entity) {
+                case SMDSEntity_Polyhedra:
+                    meshDS->AddPolyhedralVolumeWithID(nodes, block.quantities[i], ID);
                     break;
                 case SMDSEntity_Ball: {
                     SMESH_MeshEditor::ElemFeatures elemFeat;
-                    elemFeat.Init(static_cast<const SMDS_BallElement*>(elem)->GetDiameter());
+                    elemFeat.Init(block.diameters[i]);
                     elemFeat.SetID(ID);
                     editor.AddElement(nodes, elemFeat);
                     break;
                 }
                 default: {
-                    SMESH_MeshEditor::ElemFeatures elemFeat(elem->GetType(), elem->IsPoly());
+                    SMESH_MeshEditor::ElemFeatures elemFeat(block.type, block.poly);
                     elemFeat.SetID(ID);
                     editor.AddElement(nodes, elemFeat);
                     break;
@@ -211,313 +413,87 @@ void FemMesh::copyMeshData(const FemMesh& mesh)
         }
     }
 
-    // 4(b). Copy free nodes
-    if (srcNodeIt && srcMeshDS->NbNodes() != newMeshDS->NbNodes()) {
-        while (srcNodeIt->more()) {
-            nSrc = srcNodeIt->next();
-            if (nSrc->NbInverseElements() == 0) {
-                nTgt = newMeshDS->AddNodeWithID(nSrc->X(), nSrc->Y(), nSrc->Z(), nSrc->GetID());
+    // the groups keep their ids
+    for (const auto& group : groups) {
+        auto groupDS = new SMESHDS_Group(group.id, meshDS, group.type);
+        groupDS->SetStoreName(group.name.c_str());
+        mesh->AddGroup(groupDS);
+        SMDS_MeshGroup& smdsGroup = groupDS->SMDSGroup();
+        for (int id : group.ids) {
+            const SMDS_MeshElement* elem =
+                group.type == SMDSAbs_Node ? meshDS->FindNode(id) : meshDS->FindElement(id);
+            if (elem) {
+                smdsGroup.Add(elem);
             }
         }
     }
 
-    // 5. Copy groups
-    SMESH_Mesh::GroupIteratorPtr gIt = mesh.myMesh->GetGroups();
-    while (gIt->more()) {
-        SMESH_Group* group = gIt->next();
-        const SMESHDS_GroupBase* groupDS = group->GetGroupDS();
-
-        // Check group type. We copy nodal groups containing nodes of copied element
-        SMDSAbs_ElementType groupType = groupDS->GetType();
-        if (groupType != SMDSAbs_Node && newMeshDS->GetMeshInfo().NbElements(groupType) == 0) {
-            continue;  // group type differs from types of meshPart
-        }
-
-        // Find copied elements in the group
-        std::vector<const SMDS_MeshElement*> groupElems;
-        SMDS_ElemIteratorPtr eIt = groupDS->GetElements();
-        const SMDS_MeshElement* foundElem;
-        if (groupType == SMDSAbs_Node) {
-            while (eIt->more()) {
-                if ((foundElem = newMeshDS->FindNode(eIt->next()->GetID()))) {
-                    groupElems.push_back(foundElem);
-                }
-            }
-        }
-        else {
-            while (eIt->more()) {
-                if ((foundElem = newMeshDS->FindElement(eIt->next()->GetID()))) {
-                    groupElems.push_back(foundElem);
-                }
-            }
-        }
+    meshDS->Modified();
+}
 
-        // Make a new group
-        if (!groupElems.empty()) {
-            int aId = -1;
-            SMESH_Group* newGroupObj = this->myMesh->AddGroup(groupType, group->GetName(), aId);
-            SMESHDS_Group* newGroupDS = dynamic_cast<SMESHDS_Group*>(newGroupObj->GetGroupDS());
-            if (newGroupDS) {
-                SMDS_MeshGroup& smdsGroup = ((SMESHDS_Group*)newGroupDS)->SMDSGroup();
-                for (auto it : groupElems) {
-                    smdsGroup.Add(it);
-                }
-            }
+std::size_t FemMeshData::countElements(SMDSAbs_ElementType type,
+                                       std::initializer_list<SMDSAbs_EntityType> entities) const
+{
+    std::size_t count = 0;
+    for (const auto& block : elements) {
+        if (block.type == type
+            && (entities.size() == 0
+                || std::find(entities.begin(), entities.end(), block.entity) != entities.end())) {
+            count += block.size();
         }
     }
+    return count;
+}
 
-    newMeshDS->Modified();
-
-#else
-    SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
-
-    // Some further information is still not copied:
-    // https://forum.freecad.org/viewtopic.php?f=18&t=18982#p148114
-    SMDS_NodeIteratorPtr aNodeIter = mesh.myMesh->GetMeshDS()->nodesIterator();
-    for (; aNodeIter->more();) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        double temp[3];
-        aNode->GetXYZ(temp);
-        meshds->AddNodeWithID(temp[0], temp[1], temp[2], aNode->GetID());
-    }
-    SMDS_EdgeIteratorPtr aEdgeIter = mesh.myMesh->GetMeshDS()->edgesIterator();
-    for (; aEdgeIter->more();) {
-        const SMDS_MeshEdge* aEdge = aEdgeIter->next();
-        meshds->AddEdgeWithID(aEdge->GetNode(0), aEdge->GetNode(1), aEdge->GetID());
-    }
-
-    SMDS_FaceIteratorPtr aFaceIter = mesh.myMesh->GetMeshDS()->facesIterator();
-    for (; aFaceIter->more();) {
-        const SMDS_MeshFace* aFace = aFaceIter->next();
-        switch (aFace->NbNodes()) {
-            case 3:
-                meshds->AddFaceWithID(aFace->GetNode(0),
-                                      aFace->GetNode(1),
-                                      aFace->GetNode(2),
-                                      aFace->GetID());
-                break;
-            case 4:
-                meshds->AddFaceWithID(aFace->GetNode(0),
-                                      aFace->GetNode(1),
-                                      aFace->GetNode(2),
-                                      aFace->GetNode(3),
-                                      aFace->GetID());
-                break;
-            case 6:
-                meshds->AddFaceWithID(aFace->GetNode(0),
-                                      aFace->GetNode(1),
-                                      aFace->GetNode(2),
-                                      aFace->GetNode(3),
-                                      aFace->GetNode(4),
-                                      aFace->GetNode(5),
-                                      aFace->GetID());
-                break;
-            case 8:
-                meshds->AddFaceWithID(aFace->GetNode(0),
-                                      aFace->GetNode(1),
-                                      aFace->GetNode(2),
-                                      aFace->GetNode(3),
-                                      aFace->GetNode(4),
-                                      aFace->GetNode(5),
-                                      aFace->GetNode(6),
-                                      aFace->GetNode(7),
-                                      aFace->GetID());
-                break;
-            default: {
-                std::vector<const SMDS_MeshNode*> aNodes;
-                for (int i = 0; aFace->NbNodes(); i++) {
-                    aNodes.push_back(aFace->GetNode(0));
-                }
-                meshds->AddPolygonalFaceWithID(aNodes, aFace->GetID());
-            } break;
+std::size_t FemMeshData::countPolyElements(SMDSAbs_ElementType type) const
+{
+    std::size_t count = 0;
+    for (const auto& block : elements) {
+        if (block.type == type && block.poly) {
+            count += block.size();
         }
     }
+    return count;
+}
 
-    SMDS_VolumeIteratorPtr aVolIter = mesh.myMesh->GetMeshDS()->volumesIterator();
-    for (; aVolIter->more();) {
-        const SMDS_MeshVolume* aVol = aVolIter->next();
-        switch (aVol->NbNodes()) {
-            case 4:
-                meshds->AddVolumeWithID(aVol->GetNode(0),
-                                        aVol->GetNode(1),
-                                        aVol->GetNode(2),
-                                        aVol->GetNode(3),
-                                        aVol->GetID());
-                break;
-            case 5:
-                meshds->AddVolumeWithID(aVol->GetNode(0),
-                                        aVol->GetNode(1),
-                                        aVol->GetNode(2),
-                                        aVol->GetNode(3),
-                                        aVol->GetNode(4),
-                                        aVol->GetID());
-                break;
-            case 6:
-                meshds->AddVolumeWithID(aVol->GetNode(0),
-                                        aVol->GetNode(1),
-                                        aVol->GetNode(2),
-                                        aVol->GetNode(3),
-                                        aVol->GetNode(4),
-                                        aVol->GetNode(5),
-                                        aVol->GetID());
-                break;
-            case 8:
-                meshds->AddVolumeWithID(aVol->GetNode(0),
-                                        aVol->GetNode(1),
-                                        aVol->GetNode(2),
-                                        aVol->GetNode(3),
-                                        aVol->GetNode(4),
-                                        aVol->GetNode(5),
-                                        aVol->GetNode(6),
-                                        aVol->GetNode(7),
-                                        aVol->GetID());
-                break;
-            case 10:
-                meshds->AddVolumeWithID(aVol->GetNode(0),
-                                        aVol->GetNode(1),
-                                        aVol->GetNode(2),
-                                        aVol->GetNode(3),
-                                        aVol->GetNode(4),
-                                        aVol->GetNode(5),
-                                        aVol->GetNode(6),
-                                        aVol->GetNode(7),
-                                        aVol->GetNode(8),
-                                        aVol->GetNode(9),
-                                        aVol->GetID());
-                break;
-            case 13:
-                meshds->AddVolumeWithID(aVol->GetNode(0),
-                                        aVol->GetNode(1),
-                                        aVol->GetNode(2),
-                                        aVol->GetNode(3),
-                                        aVol->GetNode(4),
-                                        aVol->GetNode(5),
-                                        aVol->GetNode(6),
-                                        aVol->GetNode(7),
-                                        aVol->GetNode(8),
-                                        aVol->GetNode(9),
-                                        aVol->GetNode(10),
-                                        aVol->GetNode(11),
-                                        aVol->GetNode(12),
-                                        aVol->GetID());
-                break;
-            case 15:
-                meshds->AddVolumeWithID(aVol->GetNode(0),
-                                        aVol->GetNode(1),
-                                        aVol->GetNode(2),
-                                        aVol->GetNode(3),
-                                        aVol->GetNode(4),
-                                        aVol->GetNode(5),
-                                        aVol->GetNode(6),
-                                        aVol->GetNode(7),
-                                        aVol->GetNode(8),
-                                        aVol->GetNode(9),
-                                        aVol->GetNode(10),
-                                        aVol->GetNode(11),
-                                        aVol->GetNode(12),
-                                        aVol->GetNode(13),
-                                        aVol->GetNode(14),
-                                        aVol->GetID());
-                break;
-            case 20:
-                meshds->AddVolumeWithID(aVol->GetNode(0),
-                                        aVol->GetNode(1),
-                                        aVol->GetNode(2),
-                                        aVol->GetNode(3),
-                                        aVol->GetNode(4),
-                                        aVol->GetNode(5),
-                                        aVol->GetNode(6),
-                                        aVol->GetNode(7),
-                                        aVol->GetNode(8),
-                                        aVol->GetNode(9),
-                                        aVol->GetNode(10),
-                                        aVol->GetNode(11),
-                                        aVol->GetNode(12),
-                                        aVol->GetNode(13),
-                                        aVol->GetNode(14),
-                                        aVol->GetNode(15),
-                                        aVol->GetNode(16),
-                                        aVol->GetNode(17),
-                                        aVol->GetNode(18),
-                                        aVol->GetNode(19),
-                                        aVol->GetID());
-                break;
-            default: {
-                if (aVol->IsPoly()) {
-                    const SMDS_PolyhedralVolumeOfNodes* aPolyVol =
-                        dynamic_cast<const SMDS_PolyhedralVolumeOfNodes*>(aVol);
-                    if (!aPolyVol) {
-                        break;
-                    }
-                    std::vector<const SMDS_MeshNode*> aNodes;
-                    for (int i = 0; i < aPolyVol->NbNodes(); i++) {
-                        aNodes.push_back(aPolyVol->GetNode(i));
-                    }
-                    meshds->AddPolyhedralVolumeWithID(aNodes,
-                                                      aPolyVol->GetQuanities(),
-                                                      aPolyVol->GetID());
-                }
-            } break;
-        }
-    }
-
-    // Copy groups
-    std::list<int> grpIds = mesh.myMesh->GetGroupIds();
-    for (auto it : grpIds) {
-        // group of source mesh
-        SMESH_Group* sourceGroup = mesh.myMesh->GetGroup(it);
-        SMESHDS_GroupBase* sourceGroupDS = sourceGroup->GetGroupDS();
-
-        int aId;
-        if (sourceGroupDS->GetType() == SMDSAbs_Node) {
-            SMESH_Group* targetGroup =
-                this->myMesh->AddGroup(SMDSAbs_Node, sourceGroupDS->GetStoreName(), aId);
-            if (targetGroup) {
-                SMESHDS_Group* targetGroupDS =
-                    dynamic_cast<SMESHDS_Group*>(targetGroup->GetGroupDS());
-                if (targetGroupDS) {
-                    SMDS_ElemIteratorPtr aIter = sourceGroupDS->GetElements();
-                    while (aIter->more()) {
-                        const SMDS_MeshElement* aElem = aIter->next();
-                        const SMDS_MeshNode* aNode = meshds->FindNode(aElem->GetID());
-                        if (aNode) {
-                            targetGroupDS->SMDSGroup().Add(aNode);
-                        }
-                    }
-                }
-            }
-        }
-        else {
-            SMESH_Group* targetGroup = this->myMesh->AddGroup(sourceGroupDS->GetType(),
-                                                              sourceGroupDS->GetStoreName(),
-                                                              aId);
-            if (targetGroup) {
-                SMESHDS_Group* targetGroupDS =
-                    dynamic_cast<SMESHDS_Group*>(targetGroup->GetGroupDS());
-                if (targetGroupDS) {
-                    SMDS_ElemIteratorPtr aIter = sourceGroupDS->GetElements();
-                    while (aIter->more()) {
-                        const SMDS_MeshElement* aElem = aIter->next();
-                        const SMDS_MeshElement* aElement = meshds->FindElement(aElem->GetID());
-                        if (aElement) {
-                            targetGroupDS->SMDSGroup().Add(aElement);
-                        }
-                    }
-                }
-            }
+std::size_t FemMeshData::memSize() const
+{
+    std::size_t size = nodeIds.capacity() * sizeof(int) + coords.capacity() * sizeof(double);
+    for (const auto& block : elements) {
+        size += block.ids.capacity() * sizeof(int);
+        size += block.offsets.capacity() * sizeof(std::size_t);
+        size += block.nodes.capacity() * sizeof(int);
+        size += block.diameters.capacity() * sizeof(double);
+        for (const auto& quantities : block.quantities) {
+            size += quantities.capacity() * sizeof(int);
         }
     }
-#endif
+    for (const auto& group : groups) {
+        size += group.ids.capacity() * sizeof(int);
+    }
+    return size;
 }
 
 const SMESH_Mesh* FemMesh::getSMesh() const
 {
-    return myMesh;
+    SMESH_Mesh* mesh = loadSMesh();
+    std::lock_guard<std::mutex> lock(smeshMutex);
+    smeshShared = true;
+    return mesh;
+}
+
+const SMESH_Mesh* FemMesh::getTemporarySMesh() const
+{
+    return loadSMesh();
 }
 
 SMESH_Mesh* FemMesh::getSMesh()
 {
-    return myMesh;
+    // the mesh may be changed by the caller, so SMESH holds it from now on
+    SMESH_Mesh* mesh = loadSMesh();
+    meshData.reset();
+    meshChanged();
+    return mesh;
 }
 
 SMESH_Gen* FemMesh::getGenerator()
@@ -530,7 +506,7 @@ SMESH_Gen* FemMesh::getGenerator()
 
 void FemMesh::addHypothesis(const TopoDS_Shape& aSubShape, SMESH_HypothesisPtr hyp)
 {
-    myMesh->AddHypothesis(aSubShape, hyp->GetID());
+    getSMesh()->AddHypothesis(aSubShape, hyp->GetID());
     SMESH_HypothesisPtr ptr(hyp);
     hypoth.push_back(ptr);
 }
@@ -603,14 +579,16 @@ void FemMesh::setStandardHypotheses()
 #endif
 
     // Apply hypothesis
+    SMESH_Mesh* mesh = getSMesh();
     for (int i = 0; i < hyp; i++) {
-        myMesh->AddHypothesis(myMesh->GetShapeToMesh(), i);
+        mesh->AddHypothesis(mesh->GetShapeToMesh(), i);
     }
 }
 
 void FemMesh::compute()
 {
-    getGenerator()->Compute(*myMesh, myMesh->GetShapeToMesh());
+    SMESH_Mesh* mesh = getSMesh();
+    getGenerator()->Compute(*mesh, mesh->GetShapeToMesh());
 }
 
 std::set<long> FemMesh::getSurfaceNodes(long /*ElemId*/, short /*FaceId*/, float /*Angle*/) const
@@ -633,7 +611,7 @@ std::list<std::pair<int, int>> FemMesh::getVolumesByFace(const TopoDS_Face& face
     std::map<int, std::set<int>> face_nodes;
 
     // get faces that contribute to 'nodes_on_face' with all of its nodes
-    SMDS_FaceIteratorPtr face_iter = myMesh->GetMeshDS()->facesIterator();
+    SMDS_FaceIteratorPtr face_iter = loadSMesh()->GetMeshDS()->facesIterator();
     while (face_iter && face_iter->more()) {
         const SMDS_MeshFace* face = face_iter->next();
         SMDS_NodeIteratorPtr node_iter = face->nodeIterator();
@@ -657,8 +635,17 @@ std::list<std::pair<int, int>> FemMesh::getVolumesByFace(const TopoDS_Face& face
         }
     }
 
+    // index the faces by their smallest node, a volume can only contain the faces indexed by
+    // one of its own nodes
+    std::multimap<int, std::map<int, std::set<int>>::const_iterator> faces_by_node;
+    for (auto it = face_nodes.cbegin(); it != face_nodes.cend(); ++it) {
+        if (!it->second.empty()) {
+            faces_by_node.emplace(*it->second.begin(), it);
+        }
+    }
+
     // get all nodes of a volume and check which faces contribute to it with all of its nodes
-    SMDS_VolumeIteratorPtr vol_iter = myMesh->GetMeshDS()->volumesIterator();
+    SMDS_VolumeIteratorPtr vol_iter = loadSMesh()->GetMeshDS()->volumesIterator();
     while (vol_iter->more()) {
         const SMDS_MeshVolume* vol = vol_iter->next();
         SMDS_NodeIteratorPtr node_iter = vol->nodeIterator();
@@ -668,17 +655,17 @@ std::list<std::pair<int, int>> FemMesh::getVolumesByFace(const TopoDS_Face& face
             node_ids.insert(node->GetID());
         }
 
-        for (const auto& it : face_nodes) {
-            std::vector<int> element_face_nodes;
-            std::set_intersection(node_ids.begin(),
+        for (int id : node_ids) {
+            auto range = faces_by_node.equal_range(id);
+            for (auto jt = range.first; jt != range.second; ++jt) {
+                const auto& it = *jt->second;
+                // For curved faces it is possible that a volume contributes more than one face
+                if (std::includes(node_ids.begin(),
                                   node_ids.end(),
                                   it.second.begin(),
-                                  it.second.end(),
-                                  std::back_insert_iterator<std::vector<int>>(element_face_nodes));
-
-            // For curved faces it is possible that a volume contributes more than one face
-            if (element_face_nodes.size() == it.second.size()) {
-                result.emplace_back(vol->GetID(), it.first);
+                                  it.second.end())) {
+                    result.emplace_back(vol->GetID(), it.first);
+                }
             }
         }
     }
@@ -694,7 +681,7 @@ std::list<int> FemMesh::getFacesByFace(const TopoDS_Face& face) const
     std::list<int> result;
     std::set<int> nodes_on_face = getNodesByFace(face);
 
-    SMDS_FaceIteratorPtr face_iter = myMesh->GetMeshDS()->facesIterator();
+    SMDS_FaceIteratorPtr face_iter = loadSMesh()->GetMeshDS()->facesIterator();
     while (face_iter->more()) {
         const SMDS_MeshFace* face = static_cast<const SMDS_MeshFace*>(face_iter->next());
         int numNodes = face->NbNodes();
@@ -726,7 +713,7 @@ std::list<int> FemMesh::getEdgesByEdge(const TopoDS_Edge& edge) const
     std::list<int> result;
     std::set<int> nodes_on_edge = getNodesByEdge(edge);
 
-    SMDS_EdgeIteratorPtr edge_iter = myMesh->GetMeshDS()->edgesIterator();
+    SMDS_EdgeIteratorPtr edge_iter = loadSMesh()->GetMeshDS()->edgesIterator();
     while (edge_iter->more()) {
         const SMDS_MeshEdge* edge = static_cast<const SMDS_MeshEdge*>(edge_iter->next());
         int numNodes = edge->NbNodes();
@@ -770,7 +757,7 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
         elem_order.insert(std::make_pair(c3d10.size(), c3d10));
     }
 
-    SMDS_VolumeIteratorPtr vol_iter = myMesh->GetMeshDS()->volumesIterator();
+    SMDS_VolumeIteratorPtr vol_iter = loadSMesh()->GetMeshDS()->volumesIterator();
     std::set<int> element_nodes;
     int num_of_nodes;
     while (vol_iter->more()) {
@@ -839,9 +826,299 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
     return result;
 }
 
+struct FemMesh::NodeCacheEntry
+{
+    TopoDS_Shape shape;
+    Base::Matrix4D transform;
+    std::vector<int> nodes;
+};
+
+bool FemMesh::findCachedNodes(const TopoDS_Shape& shape, std::set<int>& nodes) const
+{
+    std::lock_guard<std::mutex> lock(nodeCacheMutex);
+    for (const auto& entry : nodeCache) {
+        if (entry.shape.IsSame(shape) && entry.transform == _Mtrx) {
+            nodes = std::set<int>(entry.nodes.begin(), entry.nodes.end());
+            return true;
+        }
+    }
+    return false;
+}
+
+void FemMesh::cacheNodes(const TopoDS_Shape& shape, const std::set<int>& nodes) const
+{
+    const std::size_t cacheSize = 16;
+    std::lock_guard<std::mutex> lock(nodeCacheMutex);
+    nodeCache.push_back({shape, _Mtrx, std::vector<int>(nodes.begin(), nodes.end())});
+    if (nodeCache.size() > cacheSize) {
+        nodeCache.pop_front();
+    }
+}
+
+void FemMesh::meshChanged()
+{
+    revision = ++lastRevision;
+    std::lock_guard<std::mutex> lock(nodeCacheMutex);
+    nodeCache.clear();
+    derivedData.clear();
+}
+
+std::shared_ptr<void> FemMesh::getDerivedData(const std::string& key) const
+{
+    std::lock_guard<std::mutex> lock(nodeCacheMutex);
+    auto it = derivedData.find(key);
+    return it != derivedData.end() ? it->second : nullptr;
+}
+
+void FemMesh::setDerivedData(const std::string& key, std::shared_ptr<void> data) const
+{
+    std::lock_guard<std::mutex> lock(nodeCacheMutex);
+    derivedData[key] = std::move(data);
+}
+
+namespace
+{
+
+// tells if a point belongs to a shape, each thread gets its own
+using NodeTest = std::function<bool(const gp_Pnt&)>;
+
+// the exact test: the distance between the point and the shape is below limit
+bool isNearShape(const TopoDS_Shape& shape, const gp_Pnt& point, double limit)
+{
+    BRepBuilderAPI_MakeVertex aBuilder(point);
+    TopoDS_Shape s = aBuilder.Vertex();
+    BRepExtrema_DistShapeShape measure(shape, s);
+    measure.Perform();
+    if (!measure.IsDone() || measure.NbSolution() < 1) {
+        return false;
+    }
+    return measure.Value() < limit;
+}
+
+// the nodes of the mesh inside the box for which the test is true.  The nodes are tested in
+// parallel, each thread with its own test.
+std::set<int> findNodes(const FemMeshData& data,
+                        const Base::Matrix4D& Mtrx,
+                        const Bnd_Box& box,
+                        const std::function<NodeTest()>& makeTest)
+{
+    const std::vector<int>& nodes = data.nodeIds;
+    std::vector<char> found(nodes.size(), 0);
+#pragma omp parallel
+    {
+        NodeTest test = makeTest();
+#pragma omp for schedule(dynamic, 1024)
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const double* xyz = &data.coords[3 * i];
+            Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
+            // Apply the matrix to hold the BoundBox in absolute space.
+            vec = Mtrx * vec;
+
+            gp_Pnt pnt(vec.x, vec.y, vec.z);
+            if (!box.IsOut(pnt)) {
+                found[i] = test(pnt);
+            }
+        }
+    }
+
+    // the node ids are sorted already
+    std::vector<int> ids;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (found[i]) {
+            ids.push_back(nodes[i]);
+        }
+    }
+    return {ids.begin(), ids.end()};
+}
+
+// a bounding volume hierarchy over the triangles of a tessellated face, to reject the nodes
+// that are clearly away from the face before the exact test
+class TriangleTree
+{
+public:
+    explicit TriangleTree(const TopoDS_Face& face)
+    {
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) tria = BRep_Tool::Triangulation(face, loc);
+        if (tria.IsNull()) {
+            return;
+        }
+        const gp_Trsf trsf = loc.Transformation();
+        auto node = [&](int index) {
+#if OCC_VERSION_HEX < 0x070600
+            return tria->Nodes()(index).Transformed(trsf).XYZ();
+#else
+            return tria->Node(index).Transformed(trsf).XYZ();
+#endif
+        };
+        for (int i = 1; i <= tria->NbTriangles(); i++) {
+            Standard_Integer n1, n2, n3;
+#if OCC_VERSION_HEX < 0x070600
+            tria->Triangles()(i).Get(n1, n2, n3);
+#else
+            tria->Triangle(i).Get(n1, n2, n3);
+#endif
+            Triangle triangle {node(n1), node(n2), node(n3)};
+            // degenerated triangles are covered by their neighbours
+            gp_XYZ normal = (triangle[1] - triangle[0]).Crossed(triangle[2] - triangle[0]);
+            if (normal.SquareModulus() > 0.0) {
+                triangles.push_back(triangle);
+            }
+        }
+        if (!triangles.empty()) {
+            nodes.emplace_back();
+            build(0, 0, triangles.size());
+        }
+    }
+
+    bool isEmpty() const
+    {
+        return triangles.empty();
+    }
+
+    /// whether the point is closer than distance to one of the triangles
+    bool isNear(const gp_XYZ& point, double distance) const
+    {
+        const double distance2 = distance * distance;
+        std::vector<size_t> stack {0};
+        while (!stack.empty()) {
+            const TreeNode& node = nodes[stack.back()];
+            stack.pop_back();
+            if (boxDistance2(node, point) > distance2) {
+                continue;
+            }
+            if (node.count == 0) {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+                continue;
+            }
+            for (size_t i = node.first; i < node.first + node.count; i++) {
+                if (triangleDistance2(triangles[i], point) <= distance2) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    using Triangle = std::array<gp_XYZ, 3>;
+    struct TreeNode
+    {
+        gp_XYZ min;
+        gp_XYZ max;
+        size_t first = 0;  // first triangle of a leaf, first child of an inner node
+        size_t count = 0;  // number of triangles of a leaf, 0 for inner nodes
+    };
+
+    void build(size_t index, size_t first, size_t count)
+    {
+        const size_t leafSize = 4;
+        gp_XYZ min = triangles[first][0];
+        gp_XYZ max = min;
+        for (size_t i = first; i < first + count; i++) {
+            for (const gp_XYZ& p : triangles[i]) {
+                for (int axis = 1; axis <= 3; axis++) {
+                    min.SetCoord(axis, std::min(min.Coord(axis), p.Coord(axis)));
+                    max.SetCoord(axis, std::max(max.Coord(axis), p.Coord(axis)));
+                }
+            }
+        }
+        nodes[index].min = min;
+        nodes[index].max = max;
+        if (count <= leafSize) {
+            nodes[index].first = first;
+            nodes[index].count = count;
+            return;
+        }
+
+        // split at the median of the longest side
+        gp_XYZ size = max - min;
+        int axis = size.X() >= size.Y() && size.X() >= size.Z() ? 1 : (size.Y() >= size.Z() ? 2 : 3);
+        size_t middle = first + count / 2;
+        std::nth_element(triangles.begin() + first,
+                         triangles.begin() + middle,
+                         triangles.begin() + first + count,
+                         [axis](const Triangle& t1, const Triangle& t2) {
+                             return (t1[0] + t1[1] + t1[2]).Coord(axis)
+                                 < (t2[0] + t2[1] + t2[2]).Coord(axis);
+                         });
+        size_t child = nodes.size();
+        nodes.emplace_back();
+        nodes.emplace_back();
+        nodes[index].first = child;
+        nodes[index].count = 0;
+        build(child, first, middle - first);
+        build(child + 1, middle, first + count - middle);
+    }
+
+    static double boxDistance2(const TreeNode& node, const gp_XYZ& point)
+    {
+        double distance2 = 0.0;
+        for (int axis = 1; axis <= 3; axis++) {
+            double d = std::max({node.min.Coord(axis) - point.Coord(axis),
+                                 point.Coord(axis) - node.max.Coord(axis),
+                                 0.0});
+            distance2 += d * d;
+        }
+        return distance2;
+    }
+
+    // squared distance to the closest point of a non degenerated triangle, see Ericson,
+    // Real-Time Collision Detection, 5.1.5
+    static double triangleDistance2(const Triangle& triangle, const gp_XYZ& p)
+    {
+        const gp_XYZ& a = triangle[0];
+        const gp_XYZ& b = triangle[1];
+        const gp_XYZ& c = triangle[2];
+        gp_XYZ ab = b - a;
+        gp_XYZ ac = c - a;
+        gp_XYZ ap = p - a;
+        double d1 = ab.Dot(ap);
+        double d2 = ac.Dot(ap);
+        if (d1 <= 0.0 && d2 <= 0.0) {
+            return ap.SquareModulus();
+        }
+        gp_XYZ bp = p - b;
+        double d3 = ab.Dot(bp);
+        double d4 = ac.Dot(bp);
+        if (d3 >= 0.0 && d4 <= d3) {
+            return bp.SquareModulus();
+        }
+        double vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+            return (ap - ab * (d1 / (d1 - d3))).SquareModulus();
+        }
+        gp_XYZ cp = p - c;
+        double d5 = ab.Dot(cp);
+        double d6 = ac.Dot(cp);
+        if (d6 >= 0.0 && d5 <= d6) {
+            return cp.SquareModulus();
+        }
+        double vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+            return (ap - ac * (d2 / (d2 - d6))).SquareModulus();
+        }
+        double va = d3 * d6 - d5 * d4;
+        if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+            return (bp - (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)))).SquareModulus();
+        }
+        double sum = va + vb + vc;
+        return (ap - ab * (vb / sum) - ac * (vc / sum)).SquareModulus();
+    }
+
+    std::vector<Triangle> triangles;
+    std::vector<TreeNode> nodes;
+};
+
+}  // namespace
+
 std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
 {
     std::set<int> result;
+    if (findCachedNodes(solid, result)) {
+        return result;
+    }
 
     Bnd_Box box;
     BRepBndLib::Add(solid, box);
@@ -854,49 +1131,33 @@ std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
                         limit,
                         limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(solid, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
+    // a node inside the solid has the distance 0 to it, so classifying the node is the same as
+    // measuring its distance
+    auto makeTest = [&solid, limit]() -> NodeTest {
+        auto classifier = std::make_shared<BRepClass3d_SolidClassifier>(solid);
+        return [&solid, limit, classifier](const gp_Pnt& pnt) {
+            try {
+                classifier->Perform(pnt, limit);
+                TopAbs_State state = classifier->State();
+                return state == TopAbs_IN || state == TopAbs_ON;
             }
-
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
+            catch (const Standard_Failure&) {
+                return isNearShape(solid, pnt, limit);
             }
-        }
-    }
+        };
+    };
+
+    result = findNodes(*getMeshData(), getTransform(), box, makeTest);
+    cacheNodes(solid, result);
     return result;
 }
 
 std::set<int> FemMesh::getNodesByFace(const TopoDS_Face& face) const
 {
     std::set<int> result;
+    if (findCachedNodes(face, result)) {
+        return result;
+    }
 
     Bnd_Box box;
     BRepBndLib::Add(
@@ -907,50 +1168,57 @@ std::set<int> FemMesh::getNodesByFace(const TopoDS_Face& face) const
     double limit = BRep_Tool::Tolerance(face);
     box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(face, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
+    // tessellate a copy of the face once, nodes further away from the triangles than the
+    // deflection allows for can't be on the face
+    double deflection = std::sqrt(box.SquareExtent()) * 0.001;
+    TopoDS_Face tessellated = TopoDS::Face(BRepBuilderAPI_Copy(face).Shape());
+    BRepMesh_IncrementalMesh(tessellated, deflection, Standard_False, 0.5, Standard_False);
+    auto tree = std::make_shared<TriangleTree>(tessellated);
+    double margin = 4.0 * deflection + limit;
+
+    // for these surfaces the projection finds the closest point of the whole surface, so nodes
+    // that are further away from it than limit can't be on the face either
+    GeomAbs_SurfaceType type = BRepAdaptor_Surface(face).GetType();
+    bool elementary = type == GeomAbs_Plane || type == GeomAbs_Cylinder || type == GeomAbs_Cone
+        || type == GeomAbs_Sphere || type == GeomAbs_Torus;
+
+    auto makeTest = [&face, limit, tree, margin, elementary]() -> NodeTest {
+        auto surface = std::make_shared<ShapeAnalysis_Surface>(BRep_Tool::Surface(face));
+        auto classifier = std::make_shared<BRepTopAdaptor_FClass2d>(face, Precision::PConfusion());
+        return [&face, limit, tree, margin, elementary, surface, classifier](const gp_Pnt& pnt) {
+            if (!tree->isEmpty() && !tree->isNear(pnt.XYZ(), margin)) {
+                return false;
             }
-
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
+            try {
+                gp_Pnt2d uv = surface->ValueOfUV(pnt, limit);
+                if (surface->Gap() < limit) {
+                    TopAbs_State state = classifier->Perform(uv);
+                    if (state == TopAbs_IN || state == TopAbs_ON) {
+                        return true;
+                    }
+                }
+                else if (elementary) {
+                    return false;
+                }
             }
-        }
-    }
+            catch (const Standard_Failure&) {
+            }
+            // close to the boundary of the face or on a free form surface
+            return isNearShape(face, pnt, limit);
+        };
+    };
 
+    result = findNodes(*getMeshData(), getTransform(), box, makeTest);
+    cacheNodes(face, result);
     return result;
 }
 
 std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge& edge) const
 {
     std::set<int> result;
+    if (findCachedNodes(edge, result)) {
+        return result;
+    }
 
     Bnd_Box box;
     BRepBndLib::Add(edge, box);
@@ -958,44 +1226,44 @@ std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge& edge) const
     double limit = BRep_Tool::Tolerance(edge);
     box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(edge, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
+    // the distance to an edge is the smallest of the distances to the inner extrema of the
+    // curve and to its end points
+    auto makeTest = [&edge, limit]() -> NodeTest {
+        if (BRep_Tool::Degenerated(edge)) {
+            return [&edge, limit](const gp_Pnt& pnt) {
+                return isNearShape(edge, pnt, limit);
+            };
+        }
+        auto curve = std::make_shared<BRepAdaptor_Curve>(edge);
+        auto extrema = std::make_shared<Extrema_ExtPC>();
+        extrema->Initialize(*curve, curve->FirstParameter(), curve->LastParameter());
+        gp_Pnt first = curve->Value(curve->FirstParameter());
+        gp_Pnt last = curve->Value(curve->LastParameter());
+        return [&edge, limit, curve, extrema, first, last](const gp_Pnt& pnt) {
+            double limit2 = limit * limit;
+            if (pnt.SquareDistance(first) < limit2 || pnt.SquareDistance(last) < limit2) {
+                return true;
             }
-
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
+            try {
+                extrema->Perform(pnt);
+                if (!extrema->IsDone()) {
+                    return isNearShape(edge, pnt, limit);
+                }
+                for (int i = 1; i <= extrema->NbExt(); i++) {
+                    if (extrema->SquareDistance(i) < limit2) {
+                        return true;
+                    }
+                }
+                return false;
             }
-        }
-    }
+            catch (const Standard_Failure&) {
+                return isNearShape(edge, pnt, limit);
+            }
+        };
+    };
 
+    result = findNodes(*getMeshData(), getTransform(), box, makeTest);
+    cacheNodes(edge, result);
     return result;
 }
 
@@ -1012,7 +1280,7 @@ std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex& vertex) const
     const Base::Matrix4D Mtrx(getTransform());
 
     std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
+    SMDS_NodeIteratorPtr aNodeIter = loadSMesh()->GetMeshDS()->nodesIterator();
     while (aNodeIter->more()) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
         nodes.push_back(aNode);
@@ -1039,7 +1307,7 @@ std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex& vertex) const
 std::list<int> FemMesh::getElementNodes(int id) const
 {
     std::list<int> result;
-    const SMDS_MeshElement* elem = myMesh->GetMeshDS()->FindElement(id);
+    const SMDS_MeshElement* elem = loadSMesh()->GetMeshDS()->FindElement(id);
     if (elem) {
         for (int i = 0; i < elem->NbNodes(); i++) {
             result.push_back(elem->GetNode(i)->GetID());
@@ -1052,7 +1320,7 @@ std::list<int> FemMesh::getElementNodes(int id) const
 std::list<int> FemMesh::getNodeElements(int id, SMDSAbs_ElementType type) const
 {
     std::list<int> result;
-    const SMDS_MeshNode* node = myMesh->GetMeshDS()->FindNode(id);
+    const SMDS_MeshNode* node = loadSMesh()->GetMeshDS()->FindNode(id);
     if (node) {
         SMDS_ElemIteratorPtr it = node->GetInverseElementIterator(type);
         while (it->more()) {
@@ -1069,7 +1337,7 @@ std::set<int> FemMesh::getEdgesOnly() const
     std::set<int> resultIDs;
 
     // edges
-    SMDS_EdgeIteratorPtr aEdgeIter = myMesh->GetMeshDS()->edgesIterator();
+    SMDS_EdgeIteratorPtr aEdgeIter = loadSMesh()->GetMeshDS()->edgesIterator();
     while (aEdgeIter->more()) {
         const SMDS_MeshEdge* aEdge = aEdgeIter->next();
         std::list<int> enodes = getElementNodes(aEdge->GetID());
@@ -1077,7 +1345,7 @@ std::set<int> FemMesh::getEdgesOnly() const
         bool edgeBelongsToAFace = false;
 
         // faces
-        SMDS_FaceIteratorPtr aFaceIter = myMesh->GetMeshDS()->facesIterator();
+        SMDS_FaceIteratorPtr aFaceIter = loadSMesh()->GetMeshDS()->facesIterator();
         while (aFaceIter->more()) {
             const SMDS_MeshFace* aFace = aFaceIter->next();
             std::list<int> fnodes = getElementNodes(aFace->GetID());
@@ -1133,7 +1401,7 @@ std::set<int> FemMesh::getFacesOnly() const
     std::set<int> resultIDs;
 
     // faces
-    SMDS_FaceIteratorPtr aFaceIter = myMesh->GetMeshDS()->facesIterator();
+    SMDS_FaceIteratorPtr aFaceIter = loadSMesh()->GetMeshDS()->facesIterator();
     while (aFaceIter->more()) {
         const SMDS_MeshFace* aFace = aFaceIter->next();
         std::list<int> fnodes = getElementNodes(aFace->GetID());
@@ -1141,7 +1409,7 @@ std::set<int> FemMesh::getFacesOnly() const
         bool faceBelongsToAVolume = false;
 
         // volumes
-        SMDS_VolumeIteratorPtr aVolIter = myMesh->GetMeshDS()->volumesIterator();
+        SMDS_VolumeIteratorPtr aVolIter = loadSMesh()->GetMeshDS()->volumesIterator();
         while (aVolIter->more()) {
             const SMDS_MeshVolume* aVol = aVolIter->next();
             std::list<int> vnodes = getElementNodes(aVol->GetID());
@@ -1657,7 +1925,7 @@ void FemMesh::readNastran(const std::string& Filename)
                         Base::TimeElapsed::diffTimeF(Start, Base::TimeElapsed()));
 
     // Now fill the SMESH datastructure
-    SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
+    SMESHDS_Mesh* meshds = this->getSMesh()->GetMeshDS();
     meshds->ClearMesh();
 
     for (auto it : mesh_elements) {
@@ -1784,7 +2052,7 @@ void FemMesh::readNastran95(const std::string& Filename)
                         Base::TimeElapsed::diffTimeF(Start, Base::TimeElapsed()));
 
     // Now fill the SMESH datastructure
-    SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
+    SMESHDS_Mesh* meshds = this->getSMesh()->GetMeshDS();
     meshds->ClearMesh();
 
     for (auto it : mesh_nodes) {
@@ -1883,6 +2151,7 @@ void FemMesh::read(const char* FileName)
 {
     Base::FileInfo File(FileName);
     _Mtrx = Base::Matrix4D();
+    SMESH_Mesh* mesh = getSMesh();
 
     // checking on the file
     if (!File.isReadable()) {
@@ -1891,24 +2160,24 @@ void FemMesh::read(const char* FileName)
 
     if (File.hasExtension("unv")) {
         // read UNV file
-        myMesh->UNVToMesh(File.filePath().c_str());
+        mesh->UNVToMesh(File.filePath().c_str());
     }
     else if (File.hasExtension("med")) {
-        myMesh->MEDToMesh(File.filePath().c_str(), File.fileNamePure().c_str());
+        mesh->MEDToMesh(File.filePath().c_str(), File.fileNamePure().c_str());
     }
     else if (File.hasExtension("inp")) {
         // read Abaqus inp mesh file
         readAbaqus(File.filePath());
 
         // if the file doesn't contain supported geometries try Nastran95
-        SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
+        SMESHDS_Mesh* meshds = mesh->GetMeshDS();
         if (meshds->NbNodes() == 0) {
             readNastran95(File.filePath());
         }
     }
     else if (File.hasExtension("stl")) {
         // read brep-file
-        myMesh->STLToMesh(File.filePath().c_str());
+        mesh->STLToMesh(File.filePath().c_str());
     }
     else if (File.hasExtension("bdf")) {
         // read Nastran-file
@@ -1929,6 +2198,87 @@ void FemMesh::read(const char* FileName)
     }
 }
 
+namespace
+{
+
+// elements of one type with their nodes in the order of the solver
+struct ElementBlock
+{
+    std::vector<int> ids;
+    std::vector<int> nodes;
+
+    void add(int id, const int* elementNodes, const std::vector<int>& order)
+    {
+        ids.push_back(id);
+        for (int jt : order) {
+            nodes.push_back(elementNodes[jt]);
+        }
+    }
+
+    void sort();
+};
+
+void ElementBlock::sort()
+{
+    if (!ids.empty()) {
+        sortById(ids, nodes, nodes.size() / ids.size());
+    }
+}
+
+void appendNumber(std::string& text, int number)
+{
+    char buffer[16];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    text.append(buffer, result.ptr);
+}
+
+// the same as a stream with precision 13 writes
+void appendNumber(std::string& text, double number)
+{
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.13g", number);
+    text.append(buffer, length);
+}
+
+// the same as Python writes with the format "{:.6f}"
+void appendFixed(std::string& text, double number)
+{
+    char buffer[512];  // all digits of the integer part are written
+    int length = std::snprintf(buffer, sizeof(buffer), "%.6f", number);
+    text.append(buffer, std::min<size_t>(length, sizeof(buffer) - 1));
+}
+
+/* Writes count lines, line i being formatted by formatLine.  The lines are formatted in
+ * parallel in chunks, and only a bounded number of chunks is kept in memory before it is
+ * written, whatever the size of the mesh.
+ */
+void writeLines(std::ostream& out,
+                size_t count,
+                const std::function<void(size_t, std::string&)>& formatLine)
+{
+    const size_t chunkSize = 4096;
+    const size_t numChunks = 64;
+    std::vector<std::string> chunks(numChunks);
+    for (size_t first = 0; first < count; first += chunkSize * numChunks) {
+        size_t last = std::min(count, first + chunkSize * numChunks);
+        size_t used = (last - first + chunkSize - 1) / chunkSize;
+#pragma omp parallel for schedule(dynamic)
+        for (size_t i = 0; i < used; ++i) {
+            std::string& chunk = chunks[i];
+            chunk.clear();
+            size_t end = std::min(last, first + (i + 1) * chunkSize);
+            for (size_t line = first + i * chunkSize; line < end; ++line) {
+                formatLine(line, chunk);
+            }
+        }
+        for (size_t i = 0; i < used; ++i) {
+            out.write(chunks[i].data(), static_cast<std::streamsize>(chunks[i].size()));
+        }
+    }
+}
+
+}  // namespace
+
 void FemMesh::writeABAQUS(const std::string& Filename,
                           int elemParam,
                           bool groupParam,
@@ -2159,39 +2509,45 @@ void FemMesh::writeABAQUS(const std::string& Filename,
     volTypeMap.insert(std::make_pair(penta15.size(), variants["Penta15"]));
 
 
-    // get all data --> Extract Nodes and Elements of the current SMESH datastructure
-    using VertexMap = std::map<int, Base::Vector3d>;
-    using NodesMap = std::map<int, std::vector<int>>;
-    using ElementsMap = std::map<std::string, NodesMap>;
+    // get all data --> Extract Nodes and Elements of the compact mesh data
+    using ElementsMap = std::map<std::string, ElementBlock>;
+    std::shared_ptr<const FemMeshData> data = getMeshData();
 
-    // get nodes
-    VertexMap vertexMap;  // empty nodes map
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    Base::Vector3d current_node;
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        current_node.Set(aNode->X(), aNode->Y(), aNode->Z());
-        current_node = _Mtrx * current_node;
-        vertexMap[aNode->GetID()] = current_node;
+    // get nodes, they are sorted by their number
+    const std::vector<int>& nodeIds = data->nodeIds;
+    std::vector<Base::Vector3d> nodeCoords(nodeIds.size());
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < nodeCoords.size(); ++i) {
+        const double* xyz = &data->coords[3 * i];
+        nodeCoords[i] = _Mtrx * Base::Vector3d(xyz[0], xyz[1], xyz[2]);
     }
 
-    // get volumes
-    ElementsMap elementsMapVol;  // empty volumes map
-    SMDS_VolumeIteratorPtr aVolIter = myMesh->GetMeshDS()->volumesIterator();
-    while (aVolIter->more()) {
-        const SMDS_MeshVolume* aVol = aVolIter->next();
-        std::pair<int, std::vector<int>> apair;
-        apair.first = aVol->GetID();
-        int numNodes = aVol->NbNodes();
-        std::map<int, std::string>::iterator it = volTypeMap.find(numNodes);
-        if (it != volTypeMap.end()) {
-            const std::vector<int>& order = elemOrderMap[it->second];
-            for (int jt : order) {
-                apair.second.push_back(aVol->GetNode(jt)->GetID());
+    // adds the elements of the type, only those in the set if one is given
+    auto addElements = [&elemOrderMap, &data](ElementsMap& elementsMap,
+                                              const std::map<int, std::string>& typeMap,
+                                              SMDSAbs_ElementType type,
+                                              const std::set<int>* only = nullptr) {
+        for (const auto& block : data->elements) {
+            if (block.type != type) {
+                continue;
+            }
+            for (size_t i = 0; i < block.size(); ++i) {
+                if (only && only->count(block.ids[i]) == 0) {
+                    continue;
+                }
+                auto it = typeMap.find(block.countNodes(i));
+                if (it != typeMap.end()) {
+                    elementsMap[it->second].add(block.ids[i],
+                                                block.elementNodes(i),
+                                                elemOrderMap[it->second]);
+                }
             }
-            elementsMapVol[it->second].insert(apair);
         }
-    }
+    };
+
+    // get volumes
+    ElementsMap elementsMapVol;  // empty volumes map
+    addElements(elementsMapVol, volTypeMap, SMDSAbs_Volume);
 
     // get faces
     ElementsMap elementsMapFac;  // empty faces map used for elemParam = 1
@@ -2199,39 +2555,12 @@ void FemMesh::writeABAQUS(const std::string& Filename,
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty())) {
         // for elemParam = 1 we only fill the elementsMapFac if the elmentsMapVol is empty
         // we're going to fill the elementsMapFac with all faces
-        SMDS_FaceIteratorPtr aFaceIter = myMesh->GetMeshDS()->facesIterator();
-        while (aFaceIter->more()) {
-            const SMDS_MeshFace* aFace = aFaceIter->next();
-            std::pair<int, std::vector<int>> apair;
-            apair.first = aFace->GetID();
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
-            if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aFace->GetNode(jt)->GetID());
-                }
-                elementsMapFac[it->second].insert(apair);
-            }
-        }
+        addElements(elementsMapFac, faceTypeMap, SMDSAbs_Face);
     }
     if (elemParam == 2) {
         // we're going to fill the elementsMapFac with the facesOnly
         std::set<int> facesOnly = getFacesOnly();
-        for (int itfa : facesOnly) {
-            std::pair<int, std::vector<int>> apair;
-            apair.first = itfa;
-            const SMDS_MeshElement* aFace = myMesh->GetMeshDS()->FindElement(itfa);
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
-            if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aFace->GetNode(jt)->GetID());
-                }
-                elementsMapFac[it->second].insert(apair);
-            }
-        }
+        addElements(elementsMapFac, faceTypeMap, SMDSAbs_Face, &facesOnly);
     }
 
     // get edges
@@ -2240,38 +2569,17 @@ void FemMesh::writeABAQUS(const std::string& Filename,
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty() && elementsMapFac.empty())) {
         // for elemParam = 1 we only fill the elementsMapEdg if the elmentsMapVol
         // and elmentsMapFac are empty we're going to fill the elementsMapEdg with all edges
-        SMDS_EdgeIteratorPtr aEdgeIter = myMesh->GetMeshDS()->edgesIterator();
-        while (aEdgeIter->more()) {
-            const SMDS_MeshEdge* aEdge = aEdgeIter->next();
-            std::pair<int, std::vector<int>> apair;
-            apair.first = aEdge->GetID();
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
-            if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aEdge->GetNode(jt)->GetID());
-                }
-                elementsMapEdg[it->second].insert(apair);
-            }
-        }
+        addElements(elementsMapEdg, edgeTypeMap, SMDSAbs_Edge);
     }
     if (elemParam == 2) {
         // we're going to fill the elementsMapEdg with the edgesOnly
         std::set<int> edgesOnly = getEdgesOnly();
-        for (int ited : edgesOnly) {
-            std::pair<int, std::vector<int>> apair;
-            apair.first = ited;
-            const SMDS_MeshElement* aEdge = myMesh->GetMeshDS()->FindElement(ited);
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
-            if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aEdge->GetNode(jt)->GetID());
-                }
-                elementsMapEdg[it->second].insert(apair);
-            }
+        addElements(elementsMapEdg, edgeTypeMap, SMDSAbs_Edge, &edgesOnly);
+    }
+
+    for (auto* elementsMap : {&elementsMapVol, &elementsMapFac, &elementsMapEdg}) {
+        for (auto& it : *elementsMap) {
+            it.second.sort();
         }
     }
 
@@ -2280,8 +2588,6 @@ void FemMesh::writeABAQUS(const std::string& Filename,
     // https://forum.freecad.org/viewtopic.php?f=10&t=37436
     Base::FileInfo fi(Filename);
     Base::ofstream anABAQUS_Output(fi);
-    // https://forum.freecad.org/viewtopic.php?f=18&t=22759#p176669
-    anABAQUS_Output.precision(13);
 
     // add some text and make sure one of the known elemParam values is used
     anABAQUS_Output << "** written by FreeCAD inp file writer for CalculiX,Abaqus meshes"
@@ -2320,11 +2626,10 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         case ABAQUS_FaceVariant::Axisymmetric:
         case ABAQUS_FaceVariant::Axisymmetric_Reduced:
             for (const auto& elMap : elementsMapFac) {
-                const NodesMap& nodeMap = elMap.second;
-                for (const auto& nodes : nodeMap) {
-                    for (int n : nodes.second) {
-                        Base::Vector3d& vertex = vertexMap[n];
-                        vertex.z = 0.0;
+                for (int n : elMap.second.nodes) {
+                    auto it = std::lower_bound(nodeIds.begin(), nodeIds.end(), n);
+                    if (it != nodeIds.end() && *it == n) {
+                        nodeCoords[it - nodeIds.begin()].z = 0.0;
                     }
                 }
             }
@@ -2333,61 +2638,52 @@ void FemMesh::writeABAQUS(const std::string& Filename,
             break;
     }
 
-    // This way we get sorted output.
+    // The nodes are sorted by their number.
     // See https://forum.freecad.org/viewtopic.php?f=18&t=12646&start=40#p103004
-    for (const auto& it : vertexMap) {
-        anABAQUS_Output << it.first << ", " << it.second.x << ", " << it.second.y << ", "
-                        << it.second.z << std::endl;
-    }
+    // https://forum.freecad.org/viewtopic.php?f=18&t=22759#p176669 for the precision
+    writeLines(anABAQUS_Output, nodeIds.size(), [&](size_t i, std::string& text) {
+        appendNumber(text, nodeIds[i]);
+        text += ", ";
+        appendNumber(text, nodeCoords[i].x);
+        text += ", ";
+        appendNumber(text, nodeCoords[i].y);
+        text += ", ";
+        appendNumber(text, nodeCoords[i].z);
+        text += '\n';
+    });
     anABAQUS_Output << std::endl << std::endl;
-    ;
 
+    auto writeElements = [&anABAQUS_Output](const ElementsMap& elementsMap,
+                                            const char* comment,
+                                            const char* elset) {
+        for (const auto& it : elementsMap) {
+            anABAQUS_Output << "** " << comment << std::endl;
+            anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=" << elset << std::endl;
+            const ElementBlock& block = it.second;
+            size_t size = block.nodes.size() / block.ids.size();
+            writeLines(anABAQUS_Output, block.ids.size(), [&](size_t i, std::string& text) {
+                appendNumber(text, block.ids[i]);
+                // Calculix allows max 16 entries in one line, a hexa20 has more !
+                for (size_t ct = 0; ct < size; ++ct) {
+                    text += ct == 15 ? ",\n" : ", ";
+                    appendNumber(text, block.nodes[i * size + ct]);
+                }
+                text += '\n';
+            });
+        }
+    };
 
     // write volumes to file
     std::string elsetname;
     if (!elementsMapVol.empty()) {
-        for (const auto& it : elementsMapVol) {
-            anABAQUS_Output << "** Volume elements" << std::endl;
-            anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Evolumes" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                // Calculix allows max 16 entries in one line, a hexa20 has more !
-                int ct = 0;  // counter
-                bool first_line = true;
-                for (auto kt = jt.second.begin(); kt != jt.second.end(); ++kt, ++ct) {
-                    if (ct < 15) {
-                        anABAQUS_Output << ", " << *kt;
-                    }
-                    else {
-                        if (first_line) {
-                            anABAQUS_Output << "," << std::endl << *kt;
-                            first_line = false;
-                        }
-                        else {
-                            anABAQUS_Output << ", " << *kt;
-                        }
-                    }
-                }
-                anABAQUS_Output << std::endl;
-            }
-        }
+        writeElements(elementsMapVol, "Volume elements", "Evolumes");
         elsetname += "Evolumes";
         anABAQUS_Output << std::endl;
     }
 
     // write faces to file
     if (!elementsMapFac.empty()) {
-        for (const auto& it : elementsMapFac) {
-            anABAQUS_Output << "** Face elements" << std::endl;
-            anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Efaces" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                for (int kt : jt.second) {
-                    anABAQUS_Output << ", " << kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
-        }
+        writeElements(elementsMapFac, "Face elements", "Efaces");
         if (elsetname.empty()) {
             elsetname += "Efaces";
         }
@@ -2399,17 +2695,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
 
     // write edges to file
     if (!elementsMapEdg.empty()) {
-        for (const auto& it : elementsMapEdg) {
-            anABAQUS_Output << "** Edge elements" << std::endl;
-            anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Eedges" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                for (int kt : jt.second) {
-                    anABAQUS_Output << ", " << kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
-        }
+        writeElements(elementsMapEdg, "Edge elements", "Eedges");
         if (elsetname.empty()) {
             elsetname += "Eedges";
         }
@@ -2432,13 +2718,12 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         // get and write group data
         anABAQUS_Output << std::endl << "** Group data" << std::endl;
 
-        std::list<int> groupIDs = myMesh->GetGroupIds();
-        for (int it : groupIDs) {
+        for (const auto& group : data->groups) {
 
             // get and write group info and group definition
             // TODO group element type code has duplicate code of
             // PyObject* FemMeshPy::getGroupElementType()
-            SMDSAbs_ElementType aElementType = myMesh->GetGroup(it)->GetGroupDS()->GetType();
+            SMDSAbs_ElementType aElementType = group.type;
             const char* groupElementType = "";
             switch (aElementType) {
                 case SMDSAbs_All:
@@ -2466,8 +2751,8 @@ void FemMesh::writeABAQUS(const std::string& Filename,
                     groupElementType = "Unknown";
                     break;
             }
-            const char* groupName = myMesh->GetGroup(it)->GetName();
-            anABAQUS_Output << "** GroupID: " << (it) << " --> GroupName: " << groupName
+            const char* groupName = group.name.c_str();
+            anABAQUS_Output << "** GroupID: " << group.id << " --> GroupName: " << groupName
                             << " --> GroupElementType: " << groupElementType << std::endl;
 
             if (aElementType == SMDSAbs_Node) {
@@ -2478,15 +2763,13 @@ void FemMesh::writeABAQUS(const std::string& Filename,
             }
 
             // get and write group elements
-            std::set<int> ids;
-            SMDS_ElemIteratorPtr aElemIter = myMesh->GetGroup(it)->GetGroupDS()->GetElements();
-            while (aElemIter->more()) {
-                const SMDS_MeshElement* aElement = aElemIter->next();
-                ids.insert(aElement->GetID());
-            }
-            for (int it : ids) {
-                anABAQUS_Output << it << std::endl;
-            }
+            std::vector<int> ids = group.ids;
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            writeLines(anABAQUS_Output, ids.size(), [&ids](size_t i, std::string& text) {
+                appendNumber(text, ids[i]);
+                text += '\n';
+            });
 
             // write newline after each group
             anABAQUS_Output << std::endl;
@@ -2495,34 +2778,149 @@ void FemMesh::writeABAQUS(const std::string& Filename,
     }
 }
 
-
 void FemMesh::writeZ88(const std::string& FileName) const
 {
     Base::TimeElapsed Start;
     Base::Console().Log("Start: FemMesh::writeZ88() =================================\n");
 
-    /*
-    Python command to export FemMesh from StartWB FEM 3D example:
-    import feminout.importZ88Mesh
-    feminout.importZ88Mesh.write(App.ActiveDocument.Box_Mesh.FemMesh, '/tmp/mesh.z88')
-    */
-
-    PyObject* module = PyImport_ImportModule("feminout.importZ88Mesh");
-    if (!module) {
-        return;
+    std::shared_ptr<const FemMeshData> data = getMeshData();
+
+    // only the elements of the highest dimension are written, and they all have to be of the
+    // same kind, see feminout/importZ88Mesh.py for the reader
+    SMDSAbs_ElementType type = SMDSAbs_Edge;
+    std::initializer_list<SMDSAbs_EntityType> tetras = {SMDSEntity_Tetra, SMDSEntity_Quad_Tetra};
+    std::initializer_list<SMDSAbs_EntityType> hexas = {SMDSEntity_Hexa,
+                                                       SMDSEntity_Quad_Hexa,
+                                                       SMDSEntity_TriQuad_Hexa};
+    std::initializer_list<SMDSAbs_EntityType> triangles = {SMDSEntity_Triangle,
+                                                           SMDSEntity_Quad_Triangle,
+                                                           SMDSEntity_BiQuad_Triangle};
+    std::initializer_list<SMDSAbs_EntityType> quadrangles = {SMDSEntity_Quadrangle,
+                                                             SMDSEntity_Quad_Quadrangle,
+                                                             SMDSEntity_BiQuad_Quadrangle};
+    std::size_t count = data->countElements(SMDSAbs_Volume);
+    bool sameKind = true;
+    if (count > 0) {
+        type = SMDSAbs_Volume;
+        sameKind = data->countElements(type, tetras) == count
+            || data->countElements(type, hexas) == count;
+    }
+    else if ((count = data->countElements(SMDSAbs_Face)) > 0) {
+        type = SMDSAbs_Face;
+        sameKind = data->countElements(type, triangles) == count
+            || data->countElements(type, quadrangles) == count;
     }
-    try {
-        Py::Module z88mod(module, true);
-        Py::Object mesh = Py::asObject(new FemMeshPy(const_cast<FemMesh*>(this)));
-        Py::Callable method(z88mod.getAttr("write"));
-        Py::Tuple args(2);
-        args.setItem(0, mesh);
-        args.setItem(1, Py::String(FileName));
-        method.apply(args);
+    else {
+        count = data->countElements(SMDSAbs_Edge);
+    }
+
+    // the Z88 element type and the FreeCAD nodes in the order of Z88, by number of nodes
+    // clang-format off
+    const std::map<int, std::pair<int, std::vector<int>>> z88Types {
+        // seg2, seg3 FreeCAD --> stab4 Z88, the middle node is left out
+        // N1, N2
+        {SMDSAbs_Edge * 100 + 2, {4, {0, 1}}},
+        {SMDSAbs_Edge * 100 + 3, {4, {0, 1}}},
+        // tria6 FreeCAD --> schale24 Z88
+        // N1, N2, N3, N4, N5, N6
+        {SMDSAbs_Face * 100 + 6, {24, {0, 1, 2, 3, 4, 5}}},
+        // quad8 FreeCAD --> schale23 Z88
+        // N1, N2, N3, N4, N5, N6, N7, N8
+        {SMDSAbs_Face * 100 + 8, {23, {0, 1, 2, 3, 4, 5, 6, 7}}},
+        // tetra4 FreeCAD --> volume17 Z88
+        // N4, N2, N3, N1
+        {SMDSAbs_Volume * 100 + 4, {17, {3, 1, 2, 0}}},
+        // tetra10 FreeCAD --> volume16 Z88
+        // N1, N2, N4, N3, N5, N9, N8, N6, N10, N7, FC to Z88 is different as Z88 to FC
+        {SMDSAbs_Volume * 100 + 10, {16, {0, 1, 3, 2, 4, 8, 7, 5, 9, 6}}},
+        // hexa8 FreeCAD --> volume1 Z88
+        // N1, N2, N3, N4, N5, N6, N7, N8
+        {SMDSAbs_Volume * 100 + 8, {1, {0, 1, 2, 3, 4, 5, 6, 7}}},
+        // hexa20 FreeCAD --> volume10 Z88
+        // N1, N2, N3, N4, N5, N6, N7, N8, N9, N10,
+        // N11, N12, N13, N14, N15, N16, N17, N18, N19, N20
+        {SMDSAbs_Volume * 100 + 20,
+         {10, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19}}},
+    };
+    // clang-format on
+
+    // the first element by number gives the number of nodes of all of them
+    int firstId = std::numeric_limits<int>::max();
+    int size = 0;
+    for (const auto& block : data->elements) {
+        for (size_t i = 0; block.type == type && i < block.size(); ++i) {
+            if (block.ids[i] < firstId) {
+                firstId = block.ids[i];
+                size = block.countNodes(i);
+            }
+        }
     }
-    catch (Py::Exception& e) {
-        e.clear();
+    for (const auto& block : data->elements) {
+        for (size_t i = 0; sameKind && block.type == type && i < block.size(); ++i) {
+            sameKind = block.countNodes(i) == size;
+        }
+    }
+    auto z88Type = z88Types.find(type * 100 + size);
+    if (count == 0 || !sameKind || z88Type == z88Types.end()) {
+        Base::Console().Error("Writing of the mesh to Z88 is not supported, it needs elements "
+                              "of one kind: seg2, seg3, tria6, quad8, tetra4, tetra10, hexa8 or "
+                              "hexa20.\n");
+        return;
     }
+
+    // the elements with their nodes in the order of Z88, sorted by their number
+    ElementBlock elements;
+    for (const auto& block : data->elements) {
+        for (size_t i = 0; block.type == type && i < block.size(); ++i) {
+            elements.add(block.ids[i], block.elementNodes(i), z88Type->second.second);
+        }
+    }
+    elements.sort();
+    const int elementType = z88Type->second.first;
+    const size_t nodesPerElement = z88Type->second.second.size();
+    // beams and volumes have 3 degrees of freedom per node, shells 6
+    const int nodeDof = type == SMDSAbs_Face ? 6 : 3;
+
+    Base::FileInfo fi(FileName);
+    Base::ofstream z88Output(fi);
+
+    // first line, some z88 specific stuff: dimension, nodes, elements, dofs, unknown flag
+    const std::vector<int>& nodeIds = data->nodeIds;
+    z88Output << 3 << " " << nodeIds.size() << " " << count << " " << nodeDof * nodeIds.size()
+              << " " << 0 << " written by FreeCAD\n";
+
+    // nodes, sorted by their number
+    writeLines(z88Output, nodeIds.size(), [&](size_t i, std::string& text) {
+        const double* xyz = &data->coords[3 * i];
+        Base::Vector3d point = _Mtrx * Base::Vector3d(xyz[0], xyz[1], xyz[2]);
+        appendNumber(text, nodeIds[i]);
+        text += ' ';
+        appendNumber(text, nodeDof);
+        for (double value : {point.x, point.y, point.z}) {
+            text += ' ';
+            appendFixed(text, value);
+        }
+        text += '\n';
+    });
+
+    // elements, a line with number and type followed by a line with the nodes
+    writeLines(z88Output, elements.ids.size(), [&](size_t i, std::string& text) {
+        appendNumber(text, elements.ids[i]);
+        text += ' ';
+        appendNumber(text, elementType);
+        text += '\n';
+        for (size_t ct = 0; ct < nodesPerElement; ++ct) {
+            if (ct > 0) {
+                text += ' ';
+            }
+            appendNumber(text, elements.nodes[i * nodesPerElement + ct]);
+        }
+        text += '\n';
+    });
+    z88Output.close();
+
+    Base::Console().Log("    %f: Done \n",
+                        Base::TimeElapsed::diffTimeF(Start, Base::TimeElapsed()));
 }
 
 
@@ -2533,24 +2931,24 @@ void FemMesh::write(const char* FileName) const
     if (File.hasExtension("unv")) {
         Base::Console().Log("FEM mesh object will be exported to unv format.\n");
         // write UNV file
-        myMesh->ExportUNV(File.filePath().c_str());
+        loadSMesh()->ExportUNV(File.filePath().c_str());
     }
     else if (File.hasExtension("med")) {
         Base::Console().Log("FEM mesh object will be exported to med format.\n");
-        myMesh->ExportMED(File.filePath().c_str(),
-                          File.fileNamePure().c_str(),
-                          false,
-                          2);  // 2 means MED_V2_2 version!
+        loadSMesh()->ExportMED(File.filePath().c_str(),
+                               File.fileNamePure().c_str(),
+                               false,
+                               2);  // 2 means MED_V2_2 version!
     }
     else if (File.hasExtension("stl")) {
         Base::Console().Log("FEM mesh object will be exported to stl format.\n");
         // export to stl file
-        myMesh->ExportSTL(File.filePath().c_str(), false);
+        loadSMesh()->ExportSTL(File.filePath().c_str(), false);
     }
     else if (File.hasExtension("dat")) {
         Base::Console().Log("FEM mesh object will be exported to dat format.\n");
         // export to dat file
-        myMesh->ExportDAT(File.filePath().c_str());
+        loadSMesh()->ExportDAT(File.filePath().c_str());
     }
     else if (File.hasExtension("inp")) {
         Base::Console().Log("FEM mesh object will be exported to inp format.\n");
@@ -2583,7 +2981,7 @@ void FemMesh::write(const char* FileName) const
 
 unsigned int FemMesh::getMemSize() const
 {
-    return 0;
+    return meshData ? static_cast<unsigned int>(meshData->memSize()) : 0;
 }
 
 void FemMesh::Save(Base::Writer& writer) const
@@ -2653,7 +3051,16 @@ void FemMesh::SaveDocFile(Base::Writer& writer) const
     // create a temporary file and copy the content to the zip stream
     Base::FileInfo fi(App::Application::getTempFileName().c_str());
 
-    myMesh->ExportUNV(fi.filePath().c_str());
+    // a compact mesh is only put into SMESH for the export
+    bool loaded = true;
+    {
+        std::lock_guard<std::mutex> lock(smeshMutex);
+        loaded = myMesh != nullptr;
+    }
+    loadSMesh()->ExportUNV(fi.filePath().c_str());
+    if (!loaded) {
+        releaseSMesh();
+    }
 
     Base::ifstream file(fi, std::ios::in | std::ios::binary);
     if (file) {
@@ -2679,7 +3086,8 @@ void FemMesh::RestoreDocFile(Base::Reader& reader)
     file.close();
 
     // read the shape from the temp file
-    myMesh->UNVToMesh(fi.filePath().c_str());
+    getSMesh()->UNVToMesh(fi.filePath().c_str());
+    makeCompact();
 
     // delete the temp file
     fi.deleteFile();
@@ -2689,6 +3097,27 @@ void FemMesh::transformGeometry(const Base::Matrix4D& rclTrf)
 {
     // We perform a translation and rotation of the current active Mesh object
     Base::Matrix4D clMatrix(rclTrf);
+    if (meshData) {
+        // the data may be shared with other meshes
+        auto data = std::make_shared<FemMeshData>(*meshData);
+        for (size_t i = 0; i < data->nodeIds.size(); ++i) {
+            double* xyz = &data->coords[3 * i];
+            Base::Vector3d current_node = clMatrix * Base::Vector3d(xyz[0], xyz[1], xyz[2]);
+            xyz[0] = current_node.x;
+            xyz[1] = current_node.y;
+            xyz[2] = current_node.z;
+        }
+        meshData = data;
+        // an SMESH mesh made from the compact data is freed, unless it was handed out by
+        // getSMesh(), then it is moved as well and stays valid
+        releaseSMesh();
+    }
+
+    meshChanged();
+    std::lock_guard<std::mutex> lock(smeshMutex);
+    if (!myMesh) {
+        return;
+    }
     SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
     Base::Vector3d current_node;
     for (; aNodeIter->more();) {
@@ -2710,11 +3139,25 @@ Base::Matrix4D FemMesh::getTransform() const
     return _Mtrx;
 }
 
+std::size_t FemMesh::getRevision() const
+{
+    return revision;
+}
+
 Base::BoundBox3d FemMesh::getBoundBox() const
 {
     Base::BoundBox3d box;
 
-    const SMESHDS_Mesh* data = getSMesh()->GetMeshDS();
+    if (meshData) {
+        const std::vector<double>& coords = meshData->coords;
+        for (size_t i = 0; i < coords.size(); i += 3) {
+            // Apply the matrix to hold the BoundBox in absolute space.
+            box.Add(_Mtrx * Base::Vector3d(coords[i], coords[i + 1], coords[i + 2]));
+        }
+        return box;
+    }
+
+    const SMESHDS_Mesh* data = myMesh->GetMeshDS();
 
     SMDS_NodeIteratorPtr aNodeIter = data->nodesIterator();
     for (; aNodeIter->more();) {
@@ -2759,14 +3202,23 @@ void FemMesh::getPoints(std::vector<Base::Vector3d>& Points,
                         double /*Accuracy*/,
                         uint16_t /*flags*/) const
 {
-    const SMESHDS_Mesh* data = getSMesh()->GetMeshDS();
     std::vector<Base::Vector3d> nodes;
-    nodes.reserve(data->NbNodes());
+    if (meshData) {
+        const std::vector<double>& coords = meshData->coords;
+        nodes.reserve(coords.size() / 3);
+        for (size_t i = 0; i < coords.size(); i += 3) {
+            nodes.emplace_back(coords[i], coords[i + 1], coords[i + 2]);
+        }
+    }
+    else {
+        const SMESHDS_Mesh* data = myMesh->GetMeshDS();
+        nodes.reserve(data->NbNodes());
 
-    SMDS_NodeIteratorPtr aNodeIter = data->nodesIterator();
-    for (; aNodeIter->more();) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.emplace_back(aNode->X(), aNode->Y(), aNode->Z());
+        SMDS_NodeIteratorPtr aNodeIter = data->nodesIterator();
+        for (; aNodeIter->more();) {
+            const SMDS_MeshNode* aNode = aNodeIter->next();
+            nodes.emplace_back(aNode->X(), aNode->Y(), aNode->Z());
+        }
     }
 
     Points = transformPointsToOutside(nodes);
@@ -2777,7 +3229,36 @@ struct Fem::FemMesh::FemMeshInfo FemMesh::getInfo() const
 
     struct FemMeshInfo rtrn;
 
-    const SMESHDS_Mesh* data = getSMesh()->GetMeshDS();
+    if (meshData) {
+        const FemMeshData& data = *meshData;
+        auto count = [&data](SMDSAbs_ElementType type,
+                             std::initializer_list<SMDSAbs_EntityType> entities = {}) {
+            return static_cast<int>(data.countElements(type, entities));
+        };
+        rtrn.numFaces = count(SMDSAbs_Face);
+        rtrn.numNode = static_cast<int>(data.nodeIds.size());
+        rtrn.numTria = count(SMDSAbs_Face,
+                             {SMDSEntity_Triangle,
+                              SMDSEntity_Quad_Triangle,
+                              SMDSEntity_BiQuad_Triangle});
+        rtrn.numQuad = count(SMDSAbs_Face,
+                             {SMDSEntity_Quadrangle,
+                              SMDSEntity_Quad_Quadrangle,
+                              SMDSEntity_BiQuad_Quadrangle});
+        rtrn.numPoly = static_cast<int>(data.countPolyElements(SMDSAbs_Face));
+        rtrn.numVolu = count(SMDSAbs_Volume);
+        rtrn.numTetr = count(SMDSAbs_Volume, {SMDSEntity_Tetra, SMDSEntity_Quad_Tetra});
+        rtrn.numHexa = count(SMDSAbs_Volume,
+                             {SMDSEntity_Hexa, SMDSEntity_Quad_Hexa, SMDSEntity_TriQuad_Hexa});
+        rtrn.numPyrd = count(SMDSAbs_Volume, {SMDSEntity_Pyramid, SMDSEntity_Quad_Pyramid});
+        rtrn.numPris = count(SMDSAbs_Volume, {SMDSEntity_Penta, SMDSEntity_Quad_Penta});
+        rtrn.numHedr = static_cast<int>(data.countPolyElements(SMDSAbs_Volume));
+        rtrn.numEdges = count(SMDSAbs_Edge);
+        rtrn.numGroups = static_cast<int>(data.groups.size());
+        return rtrn;
+    }
+
+    const SMESHDS_Mesh* data = myMesh->GetMeshDS();
     const SMDS_MeshInfo& info = data->GetMeshInfo();
     rtrn.numFaces = data->NbFaces();
     rtrn.numNode = info.NbNodes();
@@ -2790,6 +3271,8 @@ struct Fem::FemMesh::FemMeshInfo FemMesh::getInfo() const
     rtrn.numPyrd = info.NbPyramids();
     rtrn.numPris = info.NbPrisms();
     rtrn.numHedr = info.NbPolyhedrons();
+    rtrn.numEdges = info.NbEdges();
+    rtrn.numGroups = myMesh->NbGroup();
 
     return rtrn;
 }
@@ -2797,7 +3280,7 @@ struct Fem::FemMesh::FemMeshInfo FemMesh::getInfo() const
 
 Base::Quantity FemMesh::getVolume() const
 {
-    SMDS_VolumeIteratorPtr aVolIter = myMesh->GetMeshDS()->volumesIterator();
+    SMDS_VolumeIteratorPtr aVolIter = loadSMesh()->GetMeshDS()->volumesIterator();
 
     // Calculate Mesh Volume
     // For an accurate Volume Calculation of a quadratic Tetrahedron
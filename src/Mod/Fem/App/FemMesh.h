@@ -23,8 +23,14 @@
 #ifndef FEM_FEMMESH_H
 #define FEM_FEMMESH_H
 
+#include <atomic>
+#include <initializer_list>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <vector>
 
 #include <SMDSAbs_ElementType.hxx>
@@ -78,7 +84,73 @@ enum class ABAQUS_EdgeVariant
 
 using SMESH_HypothesisPtr = std::shared_ptr<SMESH_Hypothesis>;
 
+/** A finished mesh in flat arrays
+ *
+ * SMESH allocates every node and element as an object of its own, which takes a lot of memory
+ * for large meshes.  A mesh that is only shown, saved, exported or used for results is kept in
+ * these arrays instead.  The data never changes once it is made, so copies of a mesh share it.
+ */
+struct FemExport FemMeshData
+{
+    /// the elements of one entity type
+    struct Elements
+    {
+        SMDSAbs_EntityType entity;
+        SMDSAbs_ElementType type;
+        bool poly;
+        std::vector<int> ids;
+        /// the nodes of element i start at offsets[i], only used if the elements differ in size
+        std::vector<std::size_t> offsets;
+        int nodesPerElement = 0;
+        std::vector<int> nodes;
+        /// the number of nodes of each face of a polyhedron
+        std::vector<std::vector<int>> quantities;
+        /// the diameters of balls
+        std::vector<double> diameters;
+
+        std::size_t size() const
+        {
+            return ids.size();
+        }
+        const int* elementNodes(std::size_t i) const
+        {
+            return nodes.data() + (offsets.empty() ? i * nodesPerElement : offsets[i]);
+        }
+        int countNodes(std::size_t i) const
+        {
+            return offsets.empty() ? nodesPerElement
+                                   : static_cast<int>(offsets[i + 1] - offsets[i]);
+        }
+    };
+
+    struct Group
+    {
+        int id;
+        std::string name;
+        SMDSAbs_ElementType type;
+        std::vector<int> ids;
+    };
+
+    /// the node ids in increasing order, and x, y, z of each node
+    std::vector<int> nodeIds;
+    std::vector<double> coords;
+    std::vector<Elements> elements;
+    std::vector<Group> groups;
+
+    static std::shared_ptr<const FemMeshData> fromSMesh(const SMESH_Mesh* mesh);
+    void toSMesh(SMESH_Mesh* mesh) const;
+
+    /// the number of elements of the type, or of the entity types if given
+    std::size_t countElements(SMDSAbs_ElementType type,
+                              std::initializer_list<SMDSAbs_EntityType> entities = {}) const;
+    std::size_t countPolyElements(SMDSAbs_ElementType type) const;
+    std::size_t memSize() const;
+};
+
 /** The representation of a FemMesh
+ *
+ * A mesh is either kept in SMESH, to be edited or meshed, or in a FemMeshData once it is
+ * finished.  In the latter case SMESH is only made when it is asked for.
  */
 class FemExport FemMesh: public Data::ComplexGeoData
 {
@@ -90,8 +162,23 @@ public:
     ~FemMesh() override;
 
     FemMesh& operator=(const FemMesh&);
+    /** the mesh in SMESH, made from the compact data if needed.
+     * The returned mesh lives as long as this FemMesh, changes of the FemMesh are applied to it.
+     */
     const SMESH_Mesh* getSMesh() const;
+    /// the mesh in SMESH to be changed, the compact data is dropped
     SMESH_Mesh* getSMesh();
+    /** the mesh in SMESH for a short use, e.g. to build a view of it.
+     * A mesh made from the compact data is only valid until releaseSMesh() is called,
+     * TemporarySMesh calls it at the end of a scope.
+     */
+    const SMESH_Mesh* getTemporarySMesh() const;
+    /// the mesh in flat arrays, made from SMESH if the mesh isn't compact
+    std::shared_ptr<const FemMeshData> getMeshData() const;
+    /// the flat arrays if the mesh is compact, else null
+    std::shared_ptr<const FemMeshData> getCompactData() const;
+    /// frees the SMESH mesh made from the compact data, unless getSMesh() handed it out
+    void releaseSMesh() const;
     static SMESH_Gen* getGenerator();
     void addHypothesis(const TopoDS_Shape& aSubShape, SMESH_HypothesisPtr hyp);
     void setStandardHypotheses();
@@ -151,6 +238,17 @@ public:
     std::set<int> getFacesOnly() const;
     //@}
 
+    /// a number that changes with every change of the mesh and is never shared by two meshes
+    std::size_t getRevision() const;
+
+    /** @name Data derived from the mesh */
+    //@{
+    /// get the data kept with setDerivedData() under key, or null
+    std::shared_ptr<void> getDerivedData(const std::string& key) const;
+    /// keep data derived from the mesh, e.g. its VTK grid, until the mesh changes or is deleted
+    void setDerivedData(const std::string& key, std::shared_ptr<void> data) const;
+    //@}
+
     /** @name Placement control */
     //@{
     /// set the transformation
@@ -193,6 +291,8 @@ public:
         int numPyrd;
         int numPris;
         int numHedr;
+        int numEdges;
+        int numGroups;
     };
 
     ///
@@ -210,7 +310,13 @@ public:
     void writeZ88(const std::string& FileName) const;
 
 private:
-    void copyMeshData(const FemMesh&);
+    SMESH_Mesh* createSMesh() const;
+    SMESH_Mesh* loadSMesh() const;
+    void destroySMesh() const;
+    void makeCompact();
+    bool findCachedNodes(const TopoDS_Shape& shape, std::set<int>& nodes) const;
+    void cacheNodes(const TopoDS_Shape& shape, const std::set<int>& nodes) const;
+    void meshChanged();
     void readNastran(const std::string& Filename);
     void readNastran95(const std::string& Filename);
     void readZ88(const std::string& Filename);
@@ -219,10 +325,56 @@ private:
 private:
     /// positioning matrix
     Base::Matrix4D _Mtrx;
-    SMESH_Mesh* myMesh;
+    /// the mesh if it is compact, else null
+    std::shared_ptr<const FemMeshData> meshData;
+    /// the mesh to edit, or made from meshData on demand
+    mutable SMESH_Mesh* myMesh;
+    /// set when getSMesh() handed myMesh out, it is then kept until the FemMesh is deleted
+    mutable bool smeshShared = false;
+    mutable std::mutex smeshMutex;
 
     std::list<SMESH_HypothesisPtr> hypoth;
     static SMESH_Gen* _mesh_gen;
+    std::size_t revision;
+    static std::atomic<std::size_t> lastRevision;
+
+    /// nodes found for the last shapes by getNodesBySolid, getNodesByFace and getNodesByEdge
+    struct NodeCacheEntry;
+    mutable std::mutex nodeCacheMutex;
+    mutable std::list<NodeCacheEntry> nodeCache;
+    /// data other modules derived from the mesh, see setDerivedData(), also nodeCacheMutex guards it
+    mutable std::map<std::string, std::shared_ptr<void>> derivedData;
+};
+
+/** The SMESH mesh of a FemMesh for read-only use within a scope.
+ * A mesh made from the compact data is freed again when the scope is left.
+ */
+class TemporarySMesh
+{
+public:
+    explicit TemporarySMesh(const FemMesh& mesh)
+        : femMesh(mesh)
+        , smesh(mesh.getTemporarySMesh())
+    {}
+    ~TemporarySMesh()
+    {
+        femMesh.releaseSMesh();
+    }
+    TemporarySMesh(const TemporarySMesh&) = delete;
+    TemporarySMesh& operator=(const TemporarySMesh&) = delete;
+
+    const SMESH_Mesh* get() const
+    {
+        return smesh;
+    }
+    const SMESH_Mesh* operator->() const
+    {
+        return smesh;
+    }
+
+private:
+    const FemMesh& femMesh;
+    const SMESH_Mesh* smesh;
 };
 
 }  // namespace Fem
@@ -59,11 +59,61 @@
 
 using namespace Fem;
 
+namespace
+{
+
+// the mesh for the getters, a compact mesh stays compact unlike with the non-const getSMesh().
+// The SMESH mesh made from the compact data is freed again when this goes out of scope, so
+// getters called for single nodes or groups read the compact data instead.
+class ReadSMesh: public TemporarySMesh
+{
+public:
+    using TemporarySMesh::TemporarySMesh;
+
+    // SMESH lacks const versions of some getters like GetGroup()
+    SMESH_Mesh* operator->() const
+    {
+        return const_cast<SMESH_Mesh*>(get());  // NOLINT
+    }
+};
+
+// the name, type and elements of a group, false if there is no group with the id
+bool readGroup(const FemMesh* mesh, int id, FemMeshData::Group& result)
+{
+    if (auto data = mesh->getCompactData()) {
+        auto it = std::find_if(data->groups.begin(), data->groups.end(), [id](const auto& group) {
+            return group.id == id;
+        });
+        if (it == data->groups.end()) {
+            return false;
+        }
+        result = *it;
+        return true;
+    }
+
+    ReadSMesh smesh(*mesh);
+    SMESH_Group* group = smesh->GetGroup(id);
+    if (!group) {
+        return false;
+    }
+    result.id = id;
+    result.name = group->GetName();
+    result.type = group->GetGroupDS()->GetType();
+    result.ids.clear();
+    SMDS_ElemIteratorPtr aElemIter = group->GetGroupDS()->GetElements();
+    while (aElemIter->more()) {
+        result.ids.push_back(aElemIter->next()->GetID());
+    }
+    return true;
+}
+
+}  // namespace
+
 // returns a string which represents the object e.g. when printed in python
 std::string FemMeshPy::representation() const
 {
     std::stringstream str;
-    getFemMeshPtr()->getSMesh()->Dump(str);
+    ReadSMesh(*getFemMeshPtr())->Dump(str);
     return str.str();
 }
 
@@ -144,7 +194,7 @@ PyObject* FemMeshPy::addHypothesis(PyObject* args)
 
     TopoDS_Shape shape;
     if (!shp) {
-        shape = getFemMeshPtr()->getSMesh()->GetShapeToMesh();
+        shape = ReadSMesh(*getFemMeshPtr())->GetShapeToMesh();
     }
     else {
         shape = static_cast<Part::TopoShapePy*>(shp)->getTopoShapePtr()->getShape();
@@ -1103,10 +1153,26 @@ PyObject* FemMeshPy::getNodeById(PyObject* args)
     }
 
     Base::Matrix4D Mtrx = getFemMeshPtr()->getTransform();
-    const SMDS_MeshNode* aNode = getFemMeshPtr()->getSMesh()->GetMeshDS()->FindNode(id);
+    Base::Vector3d vec;
+    bool found = false;
+    if (auto data = getFemMeshPtr()->getCompactData()) {
+        auto it = std::lower_bound(data->nodeIds.begin(), data->nodeIds.end(), id);
+        if (it != data->nodeIds.end() && *it == id) {
+            const double* xyz = data->coords.data() + 3 * (it - data->nodeIds.begin());
+            vec = Base::Vector3d(xyz[0], xyz[1], xyz[2]);
+            found = true;
+        }
+    }
+    else {
+        ReadSMesh smesh(*getFemMeshPtr());
+        const SMDS_MeshNode* aNode = smesh->GetMeshDS()->FindNode(id);
+        if (aNode) {
+            vec = Base::Vector3d(aNode->X(), aNode->Y(), aNode->Z());
+            found = true;
+        }
+    }
 
-    if (aNode) {
-        Base::Vector3d vec(aNode->X(), aNode->Y(), aNode->Z());
+    if (found) {
         vec = Mtrx * vec;
         return new Base::VectorPy(vec);
     }
@@ -1302,12 +1368,12 @@ PyObject* FemMeshPy::getGroupName(PyObject* args)
         return nullptr;
     }
 
-    SMESH_Group* group = getFemMeshPtr()->getSMesh()->GetGroup(id);
-    if (!group) {
+    FemMeshData::Group group;
+    if (!readGroup(getFemMeshPtr(), id, group)) {
         PyErr_SetString(PyExc_ValueError, "No group for given id");
         return nullptr;
     }
-    return PyUnicode_FromString(group->GetName());
+    return PyUnicode_FromString(group.name.c_str());
 }
 
 PyObject* FemMeshPy::getGroupElementType(PyObject* args)
@@ -1317,13 +1383,13 @@ PyObject* FemMeshPy::getGroupElementType(PyObject* args)
         return nullptr;
     }
 
-    SMESH_Group* group = getFemMeshPtr()->getSMesh()->GetGroup(id);
-    if (!group) {
+    FemMeshData::Group group;
+    if (!readGroup(getFemMeshPtr(), id, group)) {
         PyErr_SetString(PyExc_ValueError, "No group for given id");
         return nullptr;
     }
 
-    SMDSAbs_ElementType elemType = group->GetGroupDS()->GetType();
+    SMDSAbs_ElementType elemType = group.type;
     auto it = std::find_if(vecTypeName.begin(), vecTypeName.end(), [=](const pairStrElemType& x) {
         return x.second == elemType;
     });
@@ -1340,18 +1406,13 @@ PyObject* FemMeshPy::getGroupElements(PyObject* args)
         return nullptr;
     }
 
-    SMESH_Group* group = getFemMeshPtr()->getSMesh()->GetGroup(id);
-    if (!group) {
+    FemMeshData::Group group;
+    if (!readGroup(getFemMeshPtr(), id, group)) {
         PyErr_SetString(PyExc_ValueError, "No group for given id");
         return nullptr;
     }
 
-    std::set<int> ids;
-    SMDS_ElemIteratorPtr aElemIter = group->GetGroupDS()->GetElements();
-    while (aElemIter->more()) {
-        const SMDS_MeshElement* aElement = aElemIter->next();
-        ids.insert(aElement->GetID());
-    }
+    std::set<int> ids(group.ids.begin(), group.ids.end());
 
     Py::Tuple tuple(ids.size());
     int index = 0;
@@ -1459,11 +1520,29 @@ PyObject* FemMeshPy::getElementType(PyObject* args)
         return nullptr;
     }
 
-    // An element ...
-    SMDSAbs_ElementType elemType = getFemMeshPtr()->getSMesh()->GetElementType(id, true);
-    // ... or a node
-    if (elemType == SMDSAbs_All) {
-        elemType = getFemMeshPtr()->getSMesh()->GetElementType(id, false);
+    SMDSAbs_ElementType elemType = SMDSAbs_All;
+    if (auto data = getFemMeshPtr()->getCompactData()) {
+        // An element ...
+        for (const auto& block : data->elements) {
+            if (std::find(block.ids.begin(), block.ids.end(), id) != block.ids.end()) {
+                elemType = block.type;
+                break;
+            }
+        }
+        // ... or a node
+        if (elemType == SMDSAbs_All
+            && std::binary_search(data->nodeIds.begin(), data->nodeIds.end(), id)) {
+            elemType = SMDSAbs_Node;
+        }
+    }
+    else {
+        ReadSMesh smesh(*getFemMeshPtr());
+        // An element ...
+        elemType = smesh->GetElementType(id, true);
+        // ... or a node
+        if (elemType == SMDSAbs_All) {
+            elemType = smesh->GetElementType(id, false);
+        }
     }
 
     auto it =
@@ -1498,8 +1577,8 @@ PyObject* FemMeshPy::getIdByElementType(PyObject* args)
 
     SMDSAbs_ElementType elemType = it->second;
     std::set<int> ids;
-    SMDS_ElemIteratorPtr aElemIter =
-        getFemMeshPtr()->getSMesh()->GetMeshDS()->elementsIterator(elemType);
+    ReadSMesh smesh(*getFemMeshPtr());
+    SMDS_ElemIteratorPtr aElemIter = smesh->GetMeshDS()->elementsIterator(elemType);
     while (aElemIter->more()) {
         const SMDS_MeshElement* aElem = aElemIter->next();
         ids.insert(aElem->GetID());
@@ -1525,7 +1604,17 @@ Py::Dict FemMeshPy::getNodes() const
     // get the actual transform of the FemMesh
     Base::Matrix4D Mtrx = getFemMeshPtr()->getTransform();
 
-    SMDS_NodeIteratorPtr aNodeIter = getFemMeshPtr()->getSMesh()->GetMeshDS()->nodesIterator();
+    if (auto data = getFemMeshPtr()->getCompactData()) {
+        for (std::size_t i = 0; i < data->nodeIds.size(); i++) {
+            const double* xyz = data->coords.data() + 3 * i;
+            Base::Vector3d vec = Mtrx * Base::Vector3d(xyz[0], xyz[1], xyz[2]);
+            dict[Py::Long(data->nodeIds[i])] = Py::asObject(new Base::VectorPy(vec));
+        }
+        return dict;
+    }
+
+    ReadSMesh smesh(*getFemMeshPtr());
+    SMDS_NodeIteratorPtr aNodeIter = smesh->GetMeshDS()->nodesIterator();
     while (aNodeIter->more()) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
         Base::Vector3d vec(aNode->X(), aNode->Y(), aNode->Z());
@@ -1541,13 +1630,14 @@ Py::Dict FemMeshPy::getNodes() const
 
 Py::Long FemMeshPy::getNodeCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbNodes());
+    return Py::Long(getFemMeshPtr()->getInfo().numNode);
 }
 
 Py::Tuple FemMeshPy::getEdges() const
 {
     std::set<int> ids;
-    SMDS_EdgeIteratorPtr aEdgeIter = getFemMeshPtr()->getSMesh()->GetMeshDS()->edgesIterator();
+    ReadSMesh smesh(*getFemMeshPtr());
+    SMDS_EdgeIteratorPtr aEdgeIter = smesh->GetMeshDS()->edgesIterator();
     while (aEdgeIter->more()) {
         const SMDS_MeshEdge* aEdge = aEdgeIter->next();
         ids.insert(aEdge->GetID());
@@ -1576,13 +1666,14 @@ Py::Tuple FemMeshPy::getEdgesOnly() const
 
 Py::Long FemMeshPy::getEdgeCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbEdges());
+    return Py::Long(getFemMeshPtr()->getInfo().numEdges);
 }
 
 Py::Tuple FemMeshPy::getFaces() const
 {
     std::set<int> ids;
-    SMDS_FaceIteratorPtr aFaceIter = getFemMeshPtr()->getSMesh()->GetMeshDS()->facesIterator();
+    ReadSMesh smesh(*getFemMeshPtr());
+    SMDS_FaceIteratorPtr aFaceIter = smesh->GetMeshDS()->facesIterator();
     while (aFaceIter->more()) {
         const SMDS_MeshFace* aFace = aFaceIter->next();
         ids.insert(aFace->GetID());
@@ -1611,28 +1702,29 @@ Py::Tuple FemMeshPy::getFacesOnly() const
 
 Py::Long FemMeshPy::getFaceCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbFaces());
+    return Py::Long(getFemMeshPtr()->getInfo().numFaces);
 }
 
 Py::Long FemMeshPy::getTriangleCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbTriangles());
+    return Py::Long(getFemMeshPtr()->getInfo().numTria);
 }
 
 Py::Long FemMeshPy::getQuadrangleCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbQuadrangles());
+    return Py::Long(getFemMeshPtr()->getInfo().numQuad);
 }
 
 Py::Long FemMeshPy::getPolygonCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbPolygons());
+    return Py::Long(getFemMeshPtr()->getInfo().numPoly);
 }
 
 Py::Tuple FemMeshPy::getVolumes() const
 {
     std::set<int> ids;
-    SMDS_VolumeIteratorPtr aVolIter = getFemMeshPtr()->getSMesh()->GetMeshDS()->volumesIterator();
+    ReadSMesh smesh(*getFemMeshPtr());
+    SMDS_VolumeIteratorPtr aVolIter = smesh->GetMeshDS()->volumesIterator();
     while (aVolIter->more()) {
         const SMDS_MeshVolume* aVol = aVolIter->next();
         ids.insert(aVol->GetID());
@@ -1649,47 +1741,47 @@ Py::Tuple FemMeshPy::getVolumes() const
 
 Py::Long FemMeshPy::getVolumeCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbVolumes());
+    return Py::Long(getFemMeshPtr()->getInfo().numVolu);
 }
 
 Py::Long FemMeshPy::getTetraCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbTetras());
+    return Py::Long(getFemMeshPtr()->getInfo().numTetr);
 }
 
 Py::Long FemMeshPy::getHexaCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbHexas());
+    return Py::Long(getFemMeshPtr()->getInfo().numHexa);
 }
 
 Py::Long FemMeshPy::getPyramidCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbPyramids());
+    return Py::Long(getFemMeshPtr()->getInfo().numPyrd);
 }
 
 Py::Long FemMeshPy::getPrismCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbPrisms());
+    return Py::Long(getFemMeshPtr()->getInfo().numPris);
 }
 
 Py::Long FemMeshPy::getPolyhedronCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbPolyhedrons());
+    return Py::Long(getFemMeshPtr()->getInfo().numHedr);
 }
 
 Py::Long FemMeshPy::getSubMeshCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbSubMesh());
+    return Py::Long(ReadSMesh(*getFemMeshPtr())->NbSubMesh());
 }
 
 Py::Long FemMeshPy::getGroupCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbGroup());
+    return Py::Long(getFemMeshPtr()->getInfo().numGroups);
 }
 
 Py::Tuple FemMeshPy::getGroups() const
 {
-    std::list<int> groupIDs = getFemMeshPtr()->getSMesh()->GetGroupIds();
+    std::list<int> groupIDs = ReadSMesh(*getFemMeshPtr())->GetGroupIds();
 
     Py::Tuple tuple(groupIDs.size());
     int index = 0;
@@ -24,8 +24,13 @@
 
 #ifndef _PreComp_
 #include <Python.h>
+#include <cstring>
+#include <set>
+#include <vtkCellData.h>
 #include <vtkDoubleArray.h>
+#include <vtkGenericCell.h>
 #include <vtkPointData.h>
+#include <vtkSMPTools.h>
 #endif
 
 #include <App/Document.h>
@@ -39,6 +44,41 @@ using namespace App;
 
 PROPERTY_SOURCE(Fem::FemPostFilter, Fem::FemPostObject)
 
+namespace
+{
+
+// some methods of vtkDataSet build internal data on their first call and are only thread
+// safe after that, see vtkDataSet.h
+void prepareSharedInput(vtkDataSet* dataSet)
+{
+    dataSet->GetBounds();
+    if (dataSet->GetNumberOfCells() > 0) {
+        vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+        dataSet->GetCell(0, cell);
+    }
+
+    // the ranges of the arrays are cached
+    vtkFieldData* fieldData[] = {dataSet->GetPointData(), dataSet->GetCellData()};
+    for (vtkFieldData* fields : fieldData) {
+        for (int i = 0; i < fields->GetNumberOfArrays(); ++i) {
+            vtkDataArray* array = fields->GetArray(i);
+            if (!array) {
+                continue;
+            }
+            for (int j = -1; j < array->GetNumberOfComponents(); ++j) {
+                array->GetRange(j);
+            }
+        }
+    }
+}
+
+bool isProbePipeline(const std::string& name)
+{
+    return name == "DataAlongLine" || name == "DataAtPoint";
+}
+
+}  // namespace
+
 
 FemPostFilter::FemPostFilter()
 {
@@ -61,6 +101,59 @@ void FemPostFilter::setActiveFilterPipeline(std::string name)
 {
     if (m_activePipeline != name && isValid()) {
         m_activePipeline = name;
+        m_inputData = nullptr;
+    }
+}
+
+void FemPostFilter::setPipelineInput(FilterPipeline& pipe, vtkDataObject* data)
+{
+    // every filter gets its own shallow copy of the input: the copies share the points, cells
+    // and arrays but not the pipeline information VTK keeps in the data object, so filters
+    // with the same input can be updated in parallel
+    if (m_inputData != data || m_inputTime != data->GetMTime()) {
+        vtkSmartPointer<vtkDataObject> copy =
+            vtkSmartPointer<vtkDataObject>::Take(data->NewInstance());
+        copy->ShallowCopy(data);
+        pipe.source->SetInputDataObject(copy);
+        m_inputData = data;
+        m_inputTime = data->GetMTime();
+    }
+}
+
+void FemPostFilter::updateFilterPipelines(const std::vector<FemPostFilter*>& filters)
+{
+    // the inputs are set up in this thread, only the VTK algorithms run in parallel
+    std::vector<vtkAlgorithm*> targets;
+    std::set<vtkDataObject*> inputs;
+    for (FemPostFilter* filter : filters) {
+        if (filter->m_pipelines.empty() || filter->m_activePipeline.empty()
+            || isProbePipeline(filter->m_activePipeline)) {
+            continue;
+        }
+        vtkDataObject* data = filter->getInputData();
+        vtkDataSet* dataSet = vtkDataSet::SafeDownCast(data);
+        if (!dataSet) {
+            continue;
+        }
+        if (inputs.insert(data).second) {
+            prepareSharedInput(dataSet);
+        }
+
+        FilterPipeline& pipe = filter->m_pipelines[filter->m_activePipeline];
+        filter->setPipelineInput(pipe, data);
+        targets.push_back(pipe.target);
+    }
+
+    // a single filter is updated when it is executed. The clip, cut, contour and warp filters
+    // of VTK use vtkSMPTools, if its backend runs them with several threads already the filters
+    // are updated one after the other to not start threads in every thread
+    if (targets.size() < 2 || vtkSMPTools::GetEstimatedNumberOfThreads() > 1) {
+        return;
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < targets.size(); ++i) {
+        targets[i]->Update();
     }
 }
 
@@ -73,13 +166,14 @@ DocumentObjectExecReturn* FemPostFilter::execute()
             return StdReturn;
         }
 
-        if ((m_activePipeline == "DataAlongLine") || (m_activePipeline == "DataAtPoint")) {
+        if (isProbePipeline(m_activePipeline)) {
             pipe.filterSource->SetSourceData(getInputData());
             pipe.filterTarget->Update();
             Data.setValue(pipe.filterTarget->GetOutputDataObject(0));
         }
         else {
-            pipe.source->SetInputDataObject(data);
+            // the pipeline is up to date if updateFilterPipelines() ran it with this input
+            setPipelineInput(pipe, data);
             pipe.target->Update();
             Data.setValue(pipe.target->GetOutputDataObject(0));
         }
@@ -1022,15 +1116,20 @@ DocumentObjectExecReturn* FemPostWarpVectorFilter::execute()
         }
     }
 
-    App::Enumeration empty;
-    Vector.setValue(empty);
-    m_vectorFields.setEnums(VectorArray);
-    Vector.setValue(m_vectorFields);
+    // the field list is only set again when the fields changed, otherwise the changed Vector
+    // would make the warp run again on every change of the factor
+    if (VectorArray != m_vectorFields.getEnumVector()) {
+        App::Enumeration empty;
+        Vector.setValue(empty);
+        m_vectorFields.setEnums(VectorArray);
+        Vector.setValue(m_vectorFields);
 
-    // search if the current field is in the available ones and set it
-    std::vector<std::string>::iterator it = std::find(VectorArray.begin(), VectorArray.end(), val);
-    if (!val.empty() && it != VectorArray.end()) {
-        Vector.setValue(val.c_str());
+        // search if the current field is in the available ones and set it
+        std::vector<std::string>::iterator it =
+            std::find(VectorArray.begin(), VectorArray.end(), val);
+        if (!val.empty() && it != VectorArray.end()) {
+            Vector.setValue(val.c_str());
+        }
     }
 
     // recalculate the filter
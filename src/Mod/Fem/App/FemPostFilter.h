@@ -56,6 +56,12 @@ public:
 
     App::DocumentObjectExecReturn* execute() override;
 
+    /** Update the VTK pipelines of the filters with their current input, the filters run in
+     * parallel unless the VTK filters use several threads themselves.  Nothing is changed in the
+     * document, when the filters are executed afterwards they only take over the results.
+     */
+    static void updateFilterPipelines(const std::vector<FemPostFilter*>& filters);
+
 protected:
     vtkDataObject* getInputData();
 
@@ -72,9 +78,14 @@ protected:
     FilterPipeline& getFilterPipeline(std::string name);
 
 private:
+    void setPipelineInput(FilterPipeline& pipe, vtkDataObject* data);
+
     // handling of multiple pipelines which can be the filter
     std::map<std::string, FilterPipeline> m_pipelines;
     std::string m_activePipeline;
+    // the input data the source of the active pipeline has a copy of
+    vtkSmartPointer<vtkDataObject> m_inputData;
+    vtkMTimeType m_inputTime = 0;
 };
 
 // ***************************************************************************
@@ -24,6 +24,8 @@
 
 #ifndef _PreComp_
 #include <Python.h>
+#include <algorithm>
+#include <memory>
 #include <vtkAppendFilter.h>
 #include <vtkDataSetReader.h>
 #include <vtkImageData.h>
@@ -44,6 +46,7 @@
 #include "FemMeshObject.h"
 #include "FemPostPipeline.h"
 #include "FemPostPipelinePy.h"
+#include "FemPostTimeSeries.h"
 #include "FemVTKTools.h"
 
 
@@ -73,7 +76,23 @@ FemPostPipeline::FemPostPipeline()
                       "In serial, every filter gets the output of the previous one as input.\n"
                       "In parallel, every filter gets the pipeline source as input.\n"
                       "In custom, every filter keeps its input set by the user.");
+    ADD_PROPERTY_TYPE(TimeSeries,
+                      (""),
+                      "Time Series",
+                      App::Prop_ReadOnly,
+                      "The file of a result series, its steps are read when they are shown");
+    ADD_PROPERTY_TYPE(Frame,
+                      (0),
+                      "Time Series",
+                      App::Prop_None,
+                      "The step of the result series shown by the pipeline");
+    ADD_PROPERTY_TYPE(FrameTimes,
+                      (),
+                      "Time Series",
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "The time of each step of the result series");
     Mode.setEnums(ModeEnums);
+    setFrameRange();
 }
 
 FemPostPipeline::~FemPostPipeline() = default;
@@ -127,7 +146,7 @@ bool FemPostPipeline::canRead(Base::FileInfo File)
 {
 
     // from FemResult only unstructural mesh is supported in femvtktoools.cpp
-    return File.hasExtension({"vtk", "vtp", "vts", "vtr", "vti", "vtu", "pvtu"});
+    return File.hasExtension({"vtk", "vtp", "vts", "vtr", "vti", "vtu", "pvtu", "pvd", "frd"});
 }
 
 void FemPostPipeline::read(Base::FileInfo File)
@@ -138,6 +157,14 @@ void FemPostPipeline::read(Base::FileInfo File)
         throw Base::FileException("File to load not existing or not readable", File);
     }
 
+    if (File.hasExtension({"pvd", "frd"})) {
+        readSeries(File);
+        return;
+    }
+    if (!TimeSeries.isEmpty()) {
+        TimeSeries.setValue("");
+    }
+
     if (File.hasExtension("vtu")) {
         readXMLFile<vtkXMLUnstructuredGridReader>(File.filePath());
     }
@@ -164,6 +191,58 @@ void FemPostPipeline::read(Base::FileInfo File)
     }
 }
 
+void FemPostPipeline::readSeries(Base::FileInfo File)
+{
+    // index the series before changing anything, it throws if the file can't be read
+    auto series = std::make_unique<FemPostTimeSeries>(File);
+    TimeSeries.setValue(File.filePath());
+    timeSeries = std::move(series);
+
+    std::vector<double> times(timeSeries->countFrames());
+    for (size_t i = 0; i < times.size(); ++i) {
+        times[i] = timeSeries->getTime(i);
+    }
+    FrameTimes.setValues(times);
+    setFrameRange();
+    Frame.setValue(0);
+}
+
+FemPostTimeSeries* FemPostPipeline::getTimeSeries()
+{
+    if (!timeSeries && !TimeSeries.isEmpty()) {
+        timeSeries = std::make_unique<FemPostTimeSeries>(Base::FileInfo(TimeSeries.getValue()));
+    }
+    return timeSeries.get();
+}
+
+void FemPostPipeline::loadFrame()
+{
+    try {
+        FemPostTimeSeries* series = getTimeSeries();
+        if (!series) {
+            return;
+        }
+        long frame = std::min<long>(Frame.getValue(), long(series->countFrames()) - 1);
+        Data.setValue(series->getFrame(std::max<long>(frame, 0)));
+        recomputeChildren();
+    }
+    catch (const Base::Exception& e) {
+        Base::Console().Error("%s: Cannot load frame %ld of %s: %s\n",
+                              getFullName().c_str(),
+                              Frame.getValue(),
+                              TimeSeries.getValue(),
+                              e.what());
+    }
+}
+
+void FemPostPipeline::setFrameRange()
+{
+    frameConstraints.LowerBound = 0;
+    frameConstraints.UpperBound = std::max<long>(long(FrameTimes.getSize()) - 1, 0);
+    frameConstraints.StepSize = 1;
+    Frame.setConstraints(&frameConstraints);
+}
+
 void FemPostPipeline::scale(double s)
 {
     Data.scale(s);
@@ -171,6 +250,19 @@ void FemPostPipeline::scale(double s)
 
 void FemPostPipeline::onChanged(const Property* prop)
 {
+    if (prop == &TimeSeries) {
+        // the series is indexed again when a frame is needed
+        timeSeries.reset();
+        if (TimeSeries.isEmpty() && FrameTimes.getSize() > 0 && !isRestoring()) {
+            FrameTimes.setValues(std::vector<double>());
+            setFrameRange();
+        }
+    }
+    else if (prop == &Frame && !isRestoring()) {
+        // the data of the restored frame is saved with the document
+        loadFrame();
+    }
+
     if (prop == &Filter || prop == &Mode) {
 
         // if we are in custom mode the user is free to set the input
@@ -249,8 +341,25 @@ void FemPostPipeline::onChanged(const Property* prop)
     App::GeoFeature::onChanged(prop);
 }
 
+void FemPostPipeline::onDocumentRestored()
+{
+    setFrameRange();
+    Fem::FemPostFilter::onDocumentRestored();
+}
+
 void FemPostPipeline::recomputeChildren()
 {
+    // the filters working on the data of the pipeline are independent of each other,
+    // their VTK pipelines are updated in parallel here and taken over when they are executed
+    std::vector<FemPostFilter*> branches;
+    for (const auto& obj : Filter.getValues()) {
+        auto filter = static_cast<FemPostFilter*>(obj);
+        if (!filter->Input.getValue() || filter->Input.getValue() == this) {
+            branches.push_back(filter);
+        }
+    }
+    FemPostFilter::updateFilterPipelines(branches);
+
     for (const auto& obj : Filter.getValues()) {
         obj->touch();
     }
@@ -290,6 +399,10 @@ void FemPostPipeline::load(FemResultObject* res)
         return;
     }
 
+    if (!TimeSeries.isEmpty()) {
+        TimeSeries.setValue("");
+    }
+
     // first copy the mesh over
     // ***************************
     const FemMesh& mesh = static_cast<FemMeshObject*>(res->Mesh.getValue())->FemMesh.getValue();
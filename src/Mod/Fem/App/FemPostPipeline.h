@@ -28,12 +28,17 @@
 #include "FemPostObject.h"
 #include "FemResultObject.h"
 
+#include <memory>
 #include <vtkSmartPointer.h>
 
+#include <App/PropertyFile.h>
+
 
 namespace Fem
 {
 
+class FemPostTimeSeries;
+
 class FemExport FemPostPipeline: public Fem::FemPostFilter
 {
     PROPERTY_HEADER_WITH_OVERRIDE(Fem::FemPostPipeline);
@@ -46,6 +51,9 @@ public:
     App::PropertyLinkList Filter;
     App::PropertyLink Functions;
     App::PropertyEnumeration Mode;
+    App::PropertyFile TimeSeries;
+    App::PropertyIntegerConstraint Frame;
+    App::PropertyFloatList FrameTimes;
 
     short mustExecute() const override;
     App::DocumentObjectExecReturn* execute() override;
@@ -59,6 +67,8 @@ public:
     // load data from files
     static bool canRead(Base::FileInfo file);
     void read(Base::FileInfo file);
+    // load a series of results, their steps are read when the frame is shown
+    void readSeries(Base::FileInfo file);
     void scale(double s);
 
     // load from results
@@ -71,10 +81,18 @@ public:
 
 protected:
     void onChanged(const App::Property* prop) override;
+    void onDocumentRestored() override;
 
 private:
     static const char* ModeEnums[];
 
+    FemPostTimeSeries* getTimeSeries();
+    void loadFrame();
+    void setFrameRange();
+
+    std::unique_ptr<FemPostTimeSeries> timeSeries;
+    App::PropertyIntegerConstraint::Constraints frameConstraints;
+
     template<class TReader>
     void readXMLFile(std::string file)
     {
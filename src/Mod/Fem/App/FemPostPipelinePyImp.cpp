@@ -53,6 +53,18 @@ PyObject* FemPostPipelinePy::read(PyObject* args)
     return nullptr;
 }
 
+PyObject* FemPostPipelinePy::readSeries(PyObject* args)
+{
+    char* Name;
+    if (PyArg_ParseTuple(args, "et", "utf-8", &Name)) {
+        std::string EncodedName = std::string(Name);
+        PyMem_Free(Name);
+        getFemPostPipelinePtr()->readSeries(Base::FileInfo(EncodedName));
+        Py_Return;
+    }
+    return nullptr;
+}
+
 PyObject* FemPostPipelinePy::scale(PyObject* args)
 {
     double scale;
@@ -0,0 +1,417 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+#include <QXmlStreamReader>
+
+#include <SMDS_MeshCell.hxx>
+
+#include <vtkDataSetReader.h>
+#include <vtkDoubleArray.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkXMLGenericDataObjectReader.h>
+#endif
+
+#include <Base/Console.h>
+#include <Base/Exception.h>
+
+#include "FemCcxReader.h"
+#include "FemPostTimeSeries.h"
+
+
+using namespace Fem;
+
+namespace
+{
+
+// the number of steps kept in memory
+const size_t cacheSize = 4;
+
+bool isNumber(const std::string& text)
+{
+    return !text.empty() && std::all_of(text.begin(), text.end(), [](char c) {
+        return std::isdigit(static_cast<unsigned char>(c));
+    });
+}
+
+// the name of a numbered file without its number, like "result_" for "result_12.vtu"
+std::string numberedFilePrefix(const Base::FileInfo& file)
+{
+    std::string name = file.fileNamePure();
+    size_t end = name.find_last_not_of("0123456789");
+    return end == std::string::npos ? std::string() : name.substr(0, end + 1);
+}
+
+vtkSmartPointer<vtkDataObject> readStepFile(const std::string& fileName)
+{
+    Base::FileInfo file(fileName);
+    if (!file.isReadable()) {
+        throw Base::FileException("Time step file not existing or not readable", file);
+    }
+    if (file.hasExtension("vtk")) {
+        vtkSmartPointer<vtkDataSetReader> reader = vtkSmartPointer<vtkDataSetReader>::New();
+        reader->SetFileName(fileName.c_str());
+        reader->Update();
+        return reader->GetOutputDataObject(0);
+    }
+    vtkSmartPointer<vtkXMLGenericDataObjectReader> reader =
+        vtkSmartPointer<vtkXMLGenericDataObjectReader>::New();
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    return reader->GetOutputDataObject(0);
+}
+
+// frd result fields as VTK point data, with the names and units of FemVTKTools
+struct FrdArray
+{
+    const char* field;
+    int component;  // -1 for all components
+    const char* name;
+    double factor;
+};
+
+const FrdArray frdArrays[] = {
+    {"disp", -1, "Displacement", 0.001},
+    {"stress", 0, "Stress xx component", 1e6},
+    {"stress", 1, "Stress yy component", 1e6},
+    {"stress", 2, "Stress zz component", 1e6},
+    {"stress", 3, "Stress xy component", 1e6},
+    {"stress", 4, "Stress xz component", 1e6},
+    {"stress", 5, "Stress yz component", 1e6},
+    {"strain", 0, "Strain xx component", 1.0},
+    {"strain", 1, "Strain yy component", 1.0},
+    {"strain", 2, "Strain zz component", 1.0},
+    {"strain", 3, "Strain xy component", 1.0},
+    {"strain", 4, "Strain xz component", 1.0},
+    {"strain", 5, "Strain yz component", 1.0},
+    {"peeq", 0, "Equivalent Plastic Strain", 1.0},
+    {"temp", 0, "Temperature", 1.0},
+    {"heatflux", -1, "Heat Flux", 1.0},
+    {"mflow", 0, "Mass Flow Rate", 1.0},
+    {"npressure", 0, "Network Pressure", 1e6},
+};
+
+// the values of one node as a tuple of the array, node ids start at 1
+template<typename Function>
+vtkSmartPointer<vtkDoubleArray>
+makeArray(const CcxFrdReader::Values& values, vtkIdType nPoints, int dim, Function tuple)
+{
+    vtkSmartPointer<vtkDoubleArray> data = vtkSmartPointer<vtkDoubleArray>::New();
+    data->SetNumberOfComponents(dim);
+    data->SetNumberOfTuples(nPoints);
+    for (int i = 0; i < dim; ++i) {
+        data->FillComponent(i, 0.0);
+    }
+    std::vector<double> buffer(dim);
+    for (size_t i = 0; i < values.ids.size(); ++i) {
+        vtkIdType id = values.ids[i] - 1;
+        if (id >= 0 && id < nPoints) {
+            tuple(&values.values[i * values.size], buffer.data());
+            data->SetTuple(id, buffer.data());
+        }
+    }
+    return data;
+}
+
+}  // namespace
+
+FemPostTimeSeries::FemPostTimeSeries(const Base::FileInfo& file)
+{
+    if (!file.isReadable()) {
+        throw Base::FileException("File to load not existing or not readable", file);
+    }
+
+    if (file.hasExtension("pvd")) {
+        indexCollection(file);
+    }
+    else if (file.hasExtension("frd")) {
+        indexFrd(file);
+    }
+    else {
+        indexNumberedFiles(file);
+    }
+
+    if (steps.empty()) {
+        throw Base::FileException("No time steps found", file);
+    }
+    Base::Console().Log("%zu time steps found in %s\n", steps.size(), file.filePath().c_str());
+}
+
+FemPostTimeSeries::~FemPostTimeSeries() = default;
+
+bool FemPostTimeSeries::canRead(const Base::FileInfo& file)
+{
+    if (file.hasExtension({"pvd", "frd"})) {
+        return true;
+    }
+    return file.hasExtension({"vtk", "vtp", "vts", "vtr", "vti", "vtu", "pvtu"})
+        && numberedFilePrefix(file) != file.fileNamePure();
+}
+
+size_t FemPostTimeSeries::countFrames() const
+{
+    return steps.size();
+}
+
+double FemPostTimeSeries::getTime(size_t frame) const
+{
+    if (frame >= steps.size()) {
+        throw Base::IndexError("Time step index out of range");
+    }
+    return steps[frame].time;
+}
+
+vtkSmartPointer<vtkDataObject> FemPostTimeSeries::getFrame(size_t frame)
+{
+    if (frame >= steps.size()) {
+        throw Base::IndexError("Time step index out of range");
+    }
+
+    auto it = std::find_if(cache.begin(), cache.end(), [frame](const auto& entry) {
+        return entry.first == frame;
+    });
+    if (it != cache.end()) {
+        cache.splice(cache.begin(), cache, it);
+        return it->second;
+    }
+
+    vtkSmartPointer<vtkDataObject> data = frdReader ? readFrdStep(frame) : readStep(frame);
+    cache.emplace_front(frame, data);
+    if (cache.size() > cacheSize) {
+        cache.pop_back();
+    }
+    return data;
+}
+
+void FemPostTimeSeries::indexCollection(const Base::FileInfo& file)
+{
+    QFile device(QString::fromStdString(file.filePath()));
+    if (!device.open(QIODevice::ReadOnly)) {
+        throw Base::FileException("Cannot open file", file);
+    }
+
+    // <VTKFile type="Collection"><Collection><DataSet timestep="..." file="..."/>...
+    // only the first part of each time step is used
+    QXmlStreamReader xml(&device);
+    std::vector<std::pair<double, std::string>> found;
+    while (!xml.atEnd()) {
+        if (xml.readNext() != QXmlStreamReader::StartElement
+            || xml.name() != QLatin1String("DataSet")) {
+            continue;
+        }
+        QXmlStreamAttributes attributes = xml.attributes();
+        QString part = attributes.value(QLatin1String("part")).toString();
+        if (!part.isEmpty() && part != QLatin1String("0")) {
+            continue;
+        }
+        QString name = attributes.value(QLatin1String("file")).toString();
+        if (name.isEmpty()) {
+            continue;
+        }
+        bool ok = false;
+        double time = attributes.value(QLatin1String("timestep")).toString().toDouble(&ok);
+        QFileInfo step(QDir(QString::fromStdString(file.dirPath())), name);
+        found.emplace_back(ok ? time : double(found.size()), step.filePath().toStdString());
+    }
+    if (xml.hasError()) {
+        throw Base::BadFormatError("Invalid collection file " + file.filePath() + ": "
+                                   + xml.errorString().toStdString());
+    }
+
+    std::stable_sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (const auto& it : found) {
+        steps.push_back({it.second, it.first});
+    }
+}
+
+void FemPostTimeSeries::indexNumberedFiles(const Base::FileInfo& file)
+{
+    std::string prefix = numberedFilePrefix(file);
+    std::string extension = file.extension();
+
+    std::vector<std::pair<long, std::string>> found;
+    for (const auto& it : Base::FileInfo(file.dirPath()).getDirectoryContent()) {
+        std::string name = it.fileNamePure();
+        if (it.extension() == extension && name.compare(0, prefix.size(), prefix) == 0
+            && isNumber(name.substr(prefix.size()))) {
+            found.emplace_back(std::atol(name.c_str() + prefix.size()), it.filePath());
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+    for (const auto& it : found) {
+        steps.push_back({it.second, double(it.first)});
+    }
+}
+
+void FemPostTimeSeries::indexFrd(const Base::FileInfo& file)
+{
+    frdReader = std::make_unique<CcxFrdReader>(file.filePath());
+    for (size_t i = 0; i < frdReader->countResultSets(); ++i) {
+        // eigenmodes have a number but no time
+        std::pair<double, double> time = frdReader->getResultSetTime(i);
+        double value = !std::isnan(time.second) ? time.second
+            : !std::isnan(time.first)           ? time.first
+                                                : double(i);
+        steps.push_back({file.filePath(), value});
+    }
+    if (steps.empty()) {
+        return;
+    }
+
+    // the mesh is the same for all result sets, like in FemVTKTools only the volumes are used
+    // if there are any, the faces otherwise
+    frdMesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+
+    CcxFrdReader::Values nodes = frdReader->readNodes();
+    vtkIdType nPoints = 0;
+    for (int id : nodes.ids) {
+        nPoints = std::max<vtkIdType>(nPoints, id);
+    }
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetDataTypeToDouble();
+    points->SetNumberOfPoints(nPoints);
+    for (vtkIdType i = 0; i < nPoints; ++i) {
+        points->SetPoint(i, 0.0, 0.0, 0.0);
+    }
+    for (size_t i = 0; i < nodes.ids.size(); ++i) {
+        points->SetPoint(nodes.ids[i] - 1, &nodes.values[i * nodes.size]);
+    }
+    frdMesh->SetPoints(points);
+
+    const std::pair<const char*, SMDSAbs_EntityType> volumeTypes[] = {
+        {"Tetra4Elem", SMDSEntity_Tetra},
+        {"Tetra10Elem", SMDSEntity_Quad_Tetra},
+        {"Hexa8Elem", SMDSEntity_Hexa},
+        {"Hexa20Elem", SMDSEntity_Quad_Hexa},
+        {"Penta6Elem", SMDSEntity_Penta},
+        {"Penta15Elem", SMDSEntity_Quad_Penta},
+    };
+    const std::pair<const char*, SMDSAbs_EntityType> faceTypes[] = {
+        {"Tria3Elem", SMDSEntity_Triangle},
+        {"Tria6Elem", SMDSEntity_Quad_Triangle},
+        {"Quad4Elem", SMDSEntity_Quadrangle},
+        {"Quad8Elem", SMDSEntity_Quad_Quadrangle},
+    };
+
+    // the element nodes are in FreeCAD order, which is the SMDS order
+    std::map<std::string, CcxFrdReader::Elements> elements = frdReader->readElements();
+    auto addCells = [&](const auto& types) {
+        bool added = false;
+        std::vector<vtkIdType> ids;
+        for (const auto& type : types) {
+            const CcxFrdReader::Elements& elems = elements[type.first];
+            const std::vector<int>& order = SMDS_MeshCell::toVtkOrder(type.second);
+            const int cellType = SMDS_MeshCell::toVtkType(type.second);
+            ids.resize(elems.size);
+            for (size_t i = 0; i < elems.ids.size(); ++i) {
+                const int* nodes = &elems.nodes[i * elems.size];
+                for (int j = 0; j < elems.size; ++j) {
+                    ids[j] = nodes[order.empty() ? j : order[j]] - 1;
+                }
+                frdMesh->InsertNextCell(cellType, elems.size, ids.data());
+                added = true;
+            }
+        }
+        return added;
+    };
+    frdMesh->Allocate();
+    if (!addCells(volumeTypes)) {
+        addCells(faceTypes);
+    }
+}
+
+vtkSmartPointer<vtkDataObject> FemPostTimeSeries::readStep(size_t frame) const
+{
+    vtkSmartPointer<vtkDataObject> data = readStepFile(steps[frame].fileName);
+    if (!data) {
+        throw Base::FileException("Cannot read time step", steps[frame].fileName.c_str());
+    }
+    return data;
+}
+
+vtkSmartPointer<vtkDataObject> FemPostTimeSeries::readFrdStep(size_t frame) const
+{
+    CcxFrdReader::ResultSet result = frdReader->readResultSet(frame);
+
+    // the points and cells are shared by all frames
+    vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    grid->ShallowCopy(frdMesh);
+    const vtkIdType nPoints = grid->GetNumberOfPoints();
+    vtkPointData* pointData = grid->GetPointData();
+
+    for (const FrdArray& array : frdArrays) {
+        auto it = result.fields.find(array.field);
+        if (it == result.fields.end()) {
+            continue;
+        }
+        const CcxFrdReader::Values& values = it->second;
+        const int dim = array.component < 0 ? values.size : 1;
+        vtkSmartPointer<vtkDoubleArray> data =
+            makeArray(values, nPoints, dim, [&](const double* in, double* out) {
+                for (int i = 0; i < dim; ++i) {
+                    out[i] = in[array.component < 0 ? i : array.component] * array.factor;
+                }
+            });
+        data->SetName(array.name);
+        pointData->AddArray(data);
+    }
+
+    auto disp = result.fields.find("disp");
+    if (disp != result.fields.end() && disp->second.size == 3) {
+        vtkSmartPointer<vtkDoubleArray> data =
+            makeArray(disp->second, nPoints, 1, [](const double* in, double* out) {
+                out[0] = std::sqrt(in[0] * in[0] + in[1] * in[1] + in[2] * in[2]) * 0.001;
+            });
+        data->SetName("Displacement Magnitude");
+        pointData->AddArray(data);
+    }
+
+    auto stress = result.fields.find("stress");
+    if (stress != result.fields.end() && stress->second.size == 6) {
+        vtkSmartPointer<vtkDoubleArray> data =
+            makeArray(stress->second, nPoints, 1, [](const double* s, double* out) {
+                double normal = (s[0] - s[1]) * (s[0] - s[1]) + (s[1] - s[2]) * (s[1] - s[2])
+                    + (s[2] - s[0]) * (s[2] - s[0]);
+                double shear = s[3] * s[3] + s[4] * s[4] + s[5] * s[5];
+                out[0] = std::sqrt(0.5 * normal + 3.0 * shear) * 1e6;
+            });
+        data->SetName("von Mises Stress");
+        pointData->AddArray(data);
+    }
+
+    return grid;
+}
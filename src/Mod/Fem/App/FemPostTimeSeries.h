@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef FEM_FEMPOSTTIMESERIES_H
+#define FEM_FEMPOSTTIMESERIES_H
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <vtkDataObject.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <Base/FileInfo.h>
+#include <Mod/Fem/FemGlobal.h>
+
+
+namespace Fem
+{
+
+class CcxFrdReader;
+
+/** The steps of a transient result on disk
+ *
+ * The steps of a .pvd collection, of numbered VTK files like result_1.vtu, result_2.vtu, ...
+ * or the result sets of a CalculiX .frd file are indexed once, and each step is only read when
+ * it is asked for.  The last steps read are kept in a small cache, so going back and forth
+ * between frames is fast without holding the whole series in memory.
+ */
+class FemExport FemPostTimeSeries
+{
+public:
+    explicit FemPostTimeSeries(const Base::FileInfo& file);
+    ~FemPostTimeSeries();
+
+    static bool canRead(const Base::FileInfo& file);
+
+    size_t countFrames() const;
+    /// the time of the frame, its number if the series has no times
+    double getTime(size_t frame) const;
+    /// the data of the frame, read from disk if it isn't cached
+    vtkSmartPointer<vtkDataObject> getFrame(size_t frame);
+
+private:
+    struct Step
+    {
+        std::string fileName;
+        double time;
+    };
+
+    void indexCollection(const Base::FileInfo& file);
+    void indexNumberedFiles(const Base::FileInfo& file);
+    void indexFrd(const Base::FileInfo& file);
+    vtkSmartPointer<vtkDataObject> readStep(size_t frame) const;
+    vtkSmartPointer<vtkDataObject> readFrdStep(size_t frame) const;
+
+    std::vector<Step> steps;
+    std::unique_ptr<CcxFrdReader> frdReader;
+    vtkSmartPointer<vtkUnstructuredGrid> frdMesh;
+    std::list<std::pair<size_t, vtkSmartPointer<vtkDataObject>>> cache;
+};
+
+}  // namespace Fem
+
+
+#endif  // FEM_FEMPOSTTIMESERIES_H
@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 #include <Python.h>
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <map>
@@ -40,6 +41,7 @@
 #include <vtkDoubleArray.h>
 #include <vtkHexahedron.h>
 #include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
 #include <vtkPointData.h>
 #include <vtkPyramid.h>
 #include <vtkQuad.h>
@@ -53,6 +55,7 @@
 #include <vtkTriangle.h>
 #include <vtkUnsignedCharArray.h>
 #include <vtkUnstructuredGrid.h>
+#include <vtkVersionMacros.h>
 #include <vtkWedge.h>
 #include <vtkXMLPUnstructuredGridReader.h>
 #include <vtkXMLUnstructuredGridReader.h>
@@ -100,34 +103,87 @@ void writeVTKFile(const char* filename, vtkSmartPointer<vtkUnstructuredGrid> dat
 namespace
 {
 
-// Helper function to fill vtkCellArray from SMDS_Mesh using vtk cell order
-template<typename T, typename E>
-void fillVtkArray(vtkSmartPointer<vtkCellArray>& elemArray, std::vector<int>& types, const E* elem)
+// Helper function to set the cells of a vtkUnstructuredGrid from element blocks of the mesh
+// data using vtk cell order.  The offset and connectivity arrays are built in one go and filled
+// in parallel instead of inserting a vtkCell for each element.
+void fillVtkCells(vtkSmartPointer<vtkUnstructuredGrid>& grid,
+                  const std::vector<const FemMeshData::Elements*>& blocks)
 {
-    vtkSmartPointer<T> cell = vtkSmartPointer<T>::New();
-    const std::vector<int>& order = SMDS_MeshCell::toVtkOrder(elem->GetEntityType());
-    if (!order.empty()) {
-        for (int i = 0; i < elem->NbNodes(); ++i) {
-            cell->GetPointIds()->SetId(i, elem->GetNode(order[i])->GetID() - 1);
+    std::vector<vtkIdType> firstCells(blocks.size() + 1, 0);
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        firstCells[b + 1] = firstCells[b] + static_cast<vtkIdType>(blocks[b]->size());
+    }
+    const vtkIdType nCells = firstCells.back();
+    std::vector<int> types(nCells);
+    std::vector<const std::vector<int>*> orders(blocks.size());
+    std::vector<vtkIdType> offsets(nCells + 1, 0);
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        // SMDS_MeshCell builds its tables on first use, so don't call it in parallel
+        const FemMeshData::Elements& block = *blocks[b];
+        int type = SMDS_MeshCell::toVtkType(block.entity);
+        orders[b] = &SMDS_MeshCell::toVtkOrder(block.entity);
+        for (vtkIdType i = 0, cell = firstCells[b]; cell < firstCells[b + 1]; ++i, ++cell) {
+            types[cell] = type;
+            offsets[cell + 1] = offsets[cell] + block.countNodes(i);
         }
     }
-    else {
-        for (int i = 0; i < elem->NbNodes(); ++i) {
-            cell->GetPointIds()->SetId(i, elem->GetNode(i)->GetID() - 1);
+
+    vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+#if VTK_MAJOR_VERSION >= 9
+    connectivity->SetNumberOfValues(offsets[nCells]);
+#else
+    // legacy layout, the number of points followed by the points of each cell
+    connectivity->SetNumberOfValues(offsets[nCells] + nCells);
+#endif
+    vtkIdType* data = connectivity->GetPointer(0);
+
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        const FemMeshData::Elements& block = *blocks[b];
+        const std::vector<int>& order = *orders[b];
+        const vtkIdType firstCell = firstCells[b];
+#pragma omp parallel for schedule(static)
+        for (vtkIdType i = 0; i < static_cast<vtkIdType>(block.size()); ++i) {
+            const vtkIdType cell = firstCell + i;
+            const int* nodes = block.elementNodes(i);
+            const int nbNodes = block.countNodes(i);
+#if VTK_MAJOR_VERSION >= 9
+            vtkIdType* ids = data + offsets[cell];
+#else
+            vtkIdType* ids = data + offsets[cell] + cell;
+            *ids++ = nbNodes;
+#endif
+            if (!order.empty()) {
+                for (int j = 0; j < nbNodes; ++j) {
+                    ids[j] = nodes[order[j]] - 1;
+                }
+            }
+            else {
+                for (int j = 0; j < nbNodes; ++j) {
+                    ids[j] = nodes[j] - 1;
+                }
+            }
         }
     }
-    elemArray->InsertNextCell(cell);
-    types.push_back(SMDS_MeshCell::toVtkType(elem->GetEntityType()));
+
+    vtkSmartPointer<vtkCellArray> elemArray = vtkSmartPointer<vtkCellArray>::New();
+#if VTK_MAJOR_VERSION >= 9
+    vtkSmartPointer<vtkIdTypeArray> offsetArray = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsetArray->SetNumberOfValues(nCells + 1);
+    std::copy(offsets.begin(), offsets.end(), offsetArray->GetPointer(0));
+    elemArray->SetData(offsetArray, connectivity);
+#else
+    elemArray->SetCells(nCells, connectivity);
+#endif
+    grid->SetCells(types.data(), elemArray);
 }
 
-// Helper function to fill SMDS_Mesh elements ID from vtk cell
-void fillMeshElementIds(vtkCell* cell, std::vector<int>& ids)
+// Helper function to fill SMDS_Mesh elements ID from vtk cell points
+void fillMeshElementIds(VTKCellType cellType, vtkIdList* pointIds, std::vector<int>& ids)
 {
-    VTKCellType cellType = static_cast<VTKCellType>(cell->GetCellType());
     const std::vector<int>& order = SMDS_MeshCell::fromVtkOrder(cellType);
-    vtkIdType* vtkIds = cell->GetPointIds()->GetPointer(0);
+    vtkIdType* vtkIds = pointIds->GetPointer(0);
     ids.clear();
-    int nbPoints = cell->GetNumberOfPoints();
+    int nbPoints = pointIds->GetNumberOfIds();
     ids.resize(nbPoints);
     if (!order.empty()) {
         for (int i = 0; i < nbPoints; ++i) {
@@ -141,6 +197,14 @@ void fillMeshElementIds(vtkCell* cell, std::vector<int>& ids)
     }
 }
 
+// the grid exported from a mesh, it is kept with the mesh until the mesh changes or is deleted
+struct CachedGrid
+{
+    float scale;
+    vtkSmartPointer<vtkUnstructuredGrid> grid;
+};
+const char* const cachedGridKey = "FemVTKTools::exportVTKMesh";
+
 }  // namespace
 
 
@@ -157,15 +221,19 @@ void FemVTKTools::importVTKMesh(vtkSmartPointer<vtkDataSet> dataset, FemMesh* me
     meshds->ClearMesh();
 
     for (vtkIdType i = 0; i < nPoints; i++) {
-        double* p = dataset->GetPoint(i);
+        double p[3];
+        dataset->GetPoint(i, p);
         meshds->AddNodeWithID(p[0] * scale, p[1] * scale, p[2] * scale, i + 1);
     }
 
+    // read the point ids of the cells without building a vtkCell for each of them
+    vtkSmartPointer<vtkIdList> pointIds = vtkSmartPointer<vtkIdList>::New();
+    std::vector<int> ids;
     for (vtkIdType iCell = 0; iCell < nCells; iCell++) {
-        vtkCell* cell = dataset->GetCell(iCell);
-        std::vector<int> ids;
-        fillMeshElementIds(cell, ids);
-        switch (cell->GetCellType()) {
+        VTKCellType cellType = static_cast<VTKCellType>(dataset->GetCellType(iCell));
+        dataset->GetCellPoints(iCell, pointIds);
+        fillMeshElementIds(cellType, pointIds, ids);
+        switch (cellType) {
             // 2D faces
             case VTK_TRIANGLE:  // tria3
                 meshds->AddFaceWithID(ids[0], ids[1], ids[2], iCell + 1);
@@ -330,86 +398,61 @@ FemMesh* FemVTKTools::readVTKMesh(const char* filename, FemMesh* mesh)
     return mesh;
 }
 
-void exportFemMeshFaces(vtkSmartPointer<vtkUnstructuredGrid> grid,
-                        const SMDS_FaceIteratorPtr& aFaceIter)
+void exportFemMeshFaces(vtkSmartPointer<vtkUnstructuredGrid> grid, const FemMeshData& data)
 {
     Base::Console().Log("  Start: VTK mesh builder faces.\n");
 
-    vtkSmartPointer<vtkCellArray> elemArray = vtkSmartPointer<vtkCellArray>::New();
-    std::vector<int> types;
-
-    while (aFaceIter->more()) {
-        const SMDS_MeshFace* aFace = aFaceIter->next();
-        // triangle
-        if (aFace->GetEntityType() == SMDSEntity_Triangle) {
-            fillVtkArray<vtkTriangle>(elemArray, types, aFace);
-        }
-        // quad
-        else if (aFace->GetEntityType() == SMDSEntity_Quadrangle) {
-            fillVtkArray<vtkQuad>(elemArray, types, aFace);
-        }
-        // quadratic triangle
-        else if (aFace->GetEntityType() == SMDSEntity_Quad_Triangle) {
-            fillVtkArray<vtkQuadraticTriangle>(elemArray, types, aFace);
+    std::vector<const FemMeshData::Elements*> faces;
+    for (const auto& block : data.elements) {
+        if (block.type != SMDSAbs_Face) {
+            continue;
         }
-        // quadratic quad
-        else if (aFace->GetEntityType() == SMDSEntity_Quad_Quadrangle) {
-            fillVtkArray<vtkQuadraticQuad>(elemArray, types, aFace);
-        }
-        else {
-            throw Base::TypeError("Face not yet supported by FreeCAD's VTK mesh builder\n");
+        switch (block.entity) {
+            case SMDSEntity_Triangle:         // triangle
+            case SMDSEntity_Quadrangle:       // quad
+            case SMDSEntity_Quad_Triangle:    // quadratic triangle
+            case SMDSEntity_Quad_Quadrangle:  // quadratic quad
+                faces.push_back(&block);
+                break;
+            default:
+                throw Base::TypeError("Face not yet supported by FreeCAD's VTK mesh builder\n");
         }
     }
 
-    if (elemArray->GetNumberOfCells() > 0) {
-        grid->SetCells(types.data(), elemArray);
+    if (!faces.empty()) {
+        fillVtkCells(grid, faces);
     }
 
     Base::Console().Log("  End: VTK mesh builder faces.\n");
 }
 
-void exportFemMeshCells(vtkSmartPointer<vtkUnstructuredGrid> grid,
-                        const SMDS_VolumeIteratorPtr& aVolIter)
+void exportFemMeshCells(vtkSmartPointer<vtkUnstructuredGrid> grid, const FemMeshData& data)
 {
     Base::Console().Log("  Start: VTK mesh builder volumes.\n");
 
-    vtkSmartPointer<vtkCellArray> elemArray = vtkSmartPointer<vtkCellArray>::New();
-    std::vector<int> types;
-
-    while (aVolIter->more()) {
-        const SMDS_MeshVolume* aVol = aVolIter->next();
-
-        if (aVol->GetEntityType() == SMDSEntity_Tetra) {  // tetra4
-            fillVtkArray<vtkTetra>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Pyramid) {  // pyra5
-            fillVtkArray<vtkPyramid>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Penta) {  // penta6
-            fillVtkArray<vtkWedge>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Hexa) {  // hexa8
-            fillVtkArray<vtkHexahedron>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Quad_Tetra) {  // tetra10
-            fillVtkArray<vtkQuadraticTetra>(elemArray, types, aVol);
+    std::vector<const FemMeshData::Elements*> volumes;
+    for (const auto& block : data.elements) {
+        if (block.type != SMDSAbs_Volume) {
+            continue;
         }
-        else if (aVol->GetEntityType() == SMDSEntity_Quad_Pyramid) {  // pyra13
-            fillVtkArray<vtkQuadraticPyramid>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Quad_Penta) {  // penta15
-            fillVtkArray<vtkQuadraticWedge>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Quad_Hexa) {  // hexa20
-            fillVtkArray<vtkQuadraticHexahedron>(elemArray, types, aVol);
-        }
-        else {
-            throw Base::TypeError("Volume not yet supported by FreeCAD's VTK mesh builder\n");
+        switch (block.entity) {
+            case SMDSEntity_Tetra:         // tetra4
+            case SMDSEntity_Pyramid:       // pyra5
+            case SMDSEntity_Penta:         // penta6
+            case SMDSEntity_Hexa:          // hexa8
+            case SMDSEntity_Quad_Tetra:    // tetra10
+            case SMDSEntity_Quad_Pyramid:  // pyra13
+            case SMDSEntity_Quad_Penta:    // penta15
+            case SMDSEntity_Quad_Hexa:     // hexa20
+                volumes.push_back(&block);
+                break;
+            default:
+                throw Base::TypeError("Volume not yet supported by FreeCAD's VTK mesh builder\n");
         }
     }
 
-    if (elemArray->GetNumberOfCells() > 0) {
-        grid->SetCells(types.data(), elemArray);
+    if (!volumes.empty()) {
+        fillVtkCells(grid, volumes);
     }
 
     Base::Console().Log("  End: VTK mesh builder volumes.\n");
@@ -419,44 +462,62 @@ void FemVTKTools::exportVTKMesh(const FemMesh* mesh,
                                 vtkSmartPointer<vtkUnstructuredGrid> grid,
                                 float scale)
 {
+    // the conversion is repeated each time a result pipeline is loaded, reuse the grid of an
+    // unchanged mesh.  The callers only add point data arrays to their grids, so the points and
+    // cells are shared with the grid kept with the mesh.
+    auto cached = std::static_pointer_cast<CachedGrid>(mesh->getDerivedData(cachedGridKey));
+    if (cached && cached->scale == scale) {
+        grid->ShallowCopy(cached->grid);
+        Base::Console().Log("VTK mesh builder: reuse the grid of the unchanged mesh\n");
+        return;
+    }
 
     Base::Console().Log("Start: VTK mesh builder ======================\n");
-    const SMESH_Mesh* smesh = mesh->getSMesh();
-    const SMESHDS_Mesh* meshDS = smesh->GetMeshDS();
+    // the compact data of the mesh, SMESH isn't needed
+    std::shared_ptr<const FemMeshData> data = mesh->getMeshData();
 
     // nodes
     Base::Console().Log("  Start: VTK mesh builder nodes.\n");
 
+    // the node ids are sorted
+    const std::vector<int>& nodeIds = data->nodeIds;
+    vtkIdType nPoints = nodeIds.empty() ? 0 : nodeIds.back();
+
+    // memory is allocated by VTK points size for max node id, not for point count
+    // if the SMESH mesh has gaps in node numbering, points without any element
+    // assignment are at the origin in these point gaps
+    // this needs to be taken into account on node mapping when FreeCAD FEM results
+    // are exported to vtk
     vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* node = aNodeIter->next();  // why float, not double?
-        double coords[3] = {double(node->X() * scale),
-                            double(node->Y() * scale),
-                            double(node->Z() * scale)};
-        points->InsertPoint(node->GetID() - 1, coords);
-        // memory is allocated by VTK points size for max node id, not for point count
-        // if the SMESH mesh has gaps in node numbering, points without any element
-        // assignment will be inserted in these point gaps too
-        // this needs to be taken into account on node mapping when FreeCAD FEM results
-        // are exported to vtk
+    points->SetNumberOfPoints(nPoints);
+    float* coords = static_cast<float*>(points->GetVoidPointer(0));  // why float, not double?
+    std::fill(coords, coords + 3 * nPoints, 0.0F);
+#pragma omp parallel for schedule(static)
+    for (vtkIdType i = 0; i < static_cast<vtkIdType>(nodeIds.size()); ++i) {
+        const double* xyz = &data->coords[3 * i];
+        float* point = coords + 3 * (nodeIds[i] - 1);
+        point[0] = static_cast<float>(xyz[0] * scale);
+        point[1] = static_cast<float>(xyz[1] * scale);
+        point[2] = static_cast<float>(xyz[2] * scale);
     }
     grid->SetPoints(points);
     // nodes debugging
-    const SMDS_MeshInfo& info = meshDS->GetMeshInfo();
-    Base::Console().Log("    Size of nodes in SMESH grid: %i.\n", info.NbNodes());
+    Base::Console().Log("    Size of nodes in FemMesh: %i.\n", int(nodeIds.size()));
     const vtkIdType nNodes = grid->GetNumberOfPoints();
     Base::Console().Log("    Size of nodes in VTK grid: %i.\n", nNodes);
     Base::Console().Log("  End: VTK mesh builder nodes.\n");
 
     // faces
-    SMDS_FaceIteratorPtr aFaceIter = meshDS->facesIterator();
-    exportFemMeshFaces(grid, aFaceIter);
+    exportFemMeshFaces(grid, *data);
 
     // volumes
-    SMDS_VolumeIteratorPtr aVolIter = meshDS->volumesIterator();
-    exportFemMeshCells(grid, aVolIter);
+    exportFemMeshCells(grid, *data);
+
+    auto entry = std::make_shared<CachedGrid>();
+    entry->scale = scale;
+    entry->grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    entry->grid->ShallowCopy(grid);
+    mesh->setDerivedData(cachedGridKey, entry);
 
     Base::Console().Log("End: VTK mesh builder ======================\n");
 }
@@ -846,8 +907,9 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result,
         Base::Console().Error("Result object does not correctly link to mesh");
         return;
     }
-    const SMESH_Mesh* smesh = static_cast<FemMeshObject*>(meshObj)->FemMesh.getValue().getSMesh();
-    const SMESHDS_Mesh* meshDS = smesh->GetMeshDS();
+    std::shared_ptr<const FemMeshData> meshData =
+        static_cast<FemMeshObject*>(meshObj)->FemMesh.getValue().getMeshData();
+    const std::vector<int>& nodeIds = meshData->nodeIds;
 
     // all result object meshes are in mm therefore for e.g. length outputs like
     // displacement we must divide by 1000
@@ -889,11 +951,10 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result,
                 factor = 1.0;
             }
 
-            SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-            for (const auto& jt : vel) {
-                const SMDS_MeshNode* node = aNodeIter->next();
+            for (size_t i = 0; i < vel.size() && i < nodeIds.size(); ++i) {
+                const Base::Vector3d& jt = vel[i];
                 double tuple[] = {jt.x * factor, jt.y * factor, jt.z * factor};
-                data->SetTuple(node->GetID() - 1, tuple);
+                data->SetTuple(nodeIds[i] - 1, tuple);
             }
             grid->GetPointData()->AddArray(data);
             Base::Console().Log(
@@ -955,13 +1016,9 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result,
                 factor = 1.0;
             }
 
-            SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-            for (double i : vec) {
-                const SMDS_MeshNode* node = aNodeIter->next();
-                // for the MassFlowRate the last vec entries can be a nullptr, thus check this
-                if (node) {
-                    data->SetValue(node->GetID() - 1, i * factor);
-                }
+            // for the MassFlowRate there can be more vec entries than nodes, thus check this
+            for (size_t i = 0; i < vec.size() && i < nodeIds.size(); ++i) {
+                data->SetValue(nodeIds[i] - 1, vec[i] * factor);
             }
 
             grid->GetPointData()->AddArray(data);
@@ -24,6 +24,8 @@
 
 #ifndef _PreComp_
 #include <Python.h>
+#include <iterator>
+#include <string>
 #include <vtkCompositeDataSet.h>
 #include <vtkMultiBlockDataSet.h>
 #include <vtkMultiPieceDataSet.h>
@@ -32,12 +34,16 @@
 #include <vtkStructuredGrid.h>
 #include <vtkUniformGrid.h>
 #include <vtkUnstructuredGrid.h>
-#include <vtkXMLDataSetWriter.h>
 #include <vtkXMLImageDataReader.h>
+#include <vtkXMLImageDataWriter.h>
 #include <vtkXMLPolyDataReader.h>
+#include <vtkXMLPolyDataWriter.h>
 #include <vtkXMLRectilinearGridReader.h>
+#include <vtkXMLRectilinearGridWriter.h>
 #include <vtkXMLStructuredGridReader.h>
+#include <vtkXMLStructuredGridWriter.h>
 #include <vtkXMLUnstructuredGridReader.h>
+#include <vtkXMLUnstructuredGridWriter.h>
 #endif
 
 #include <App/Application.h>
@@ -45,7 +51,6 @@
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
 #include <Base/Reader.h>
-#include <Base/Stream.h>
 #include <Base/Writer.h>
 #include <CXX/Objects.hxx>
 
@@ -56,6 +61,51 @@ using namespace Fem;
 
 TYPESYSTEM_SOURCE(Fem::PropertyPostDataObject, App::Property)
 
+namespace
+{
+
+// the data sets are written with the XML writer of their type, vtkXMLDataSetWriter
+// only passes the file name on to it but not the output string
+vtkSmartPointer<vtkXMLWriter> createXMLWriter(int type)
+{
+    switch (type) {
+        case VTK_POLY_DATA:
+            return vtkSmartPointer<vtkXMLPolyDataWriter>::New();
+        case VTK_STRUCTURED_GRID:
+            return vtkSmartPointer<vtkXMLStructuredGridWriter>::New();
+        case VTK_RECTILINEAR_GRID:
+            return vtkSmartPointer<vtkXMLRectilinearGridWriter>::New();
+        case VTK_UNSTRUCTURED_GRID:
+            return vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+        case VTK_UNIFORM_GRID:
+            return vtkSmartPointer<vtkXMLImageDataWriter>::New();
+        default:
+            return nullptr;
+    }
+}
+
+vtkSmartPointer<vtkXMLReader> createXMLReader(const std::string& extension)
+{
+    if (extension == "vtp") {
+        return vtkSmartPointer<vtkXMLPolyDataReader>::New();
+    }
+    if (extension == "vts") {
+        return vtkSmartPointer<vtkXMLStructuredGridReader>::New();
+    }
+    if (extension == "vtr") {
+        return vtkSmartPointer<vtkXMLRectilinearGridReader>::New();
+    }
+    if (extension == "vtu") {
+        return vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
+    }
+    if (extension == "vti") {
+        return vtkSmartPointer<vtkXMLImageDataReader>::New();
+    }
+    return nullptr;
+}
+
+}  // namespace
+
 PropertyPostDataObject::PropertyPostDataObject() = default;
 
 PropertyPostDataObject::~PropertyPostDataObject() = default;
@@ -101,6 +151,7 @@ void PropertyPostDataObject::scaleDataObject(vtkDataObject* dataObject, double s
 
 void PropertyPostDataObject::scale(double s)
 {
+    readRestoredData();
     if (m_dataObject) {
         aboutToSetValue();
         scaleDataObject(m_dataObject, s);
@@ -112,6 +163,11 @@ void PropertyPostDataObject::setValue(const vtkSmartPointer<vtkDataObject>& ds)
 {
     aboutToSetValue();
 
+    {
+        std::lock_guard<std::mutex> lock(m_restoreMutex);
+        m_restoredData.clear();
+        m_restoreFailed = false;
+    }
     if (ds) {
         createDataObjectByExternalType(ds);
         m_dataObject->DeepCopy(ds);
@@ -125,24 +181,25 @@ void PropertyPostDataObject::setValue(const vtkSmartPointer<vtkDataObject>& ds)
 
 const vtkSmartPointer<vtkDataObject>& PropertyPostDataObject::getValue() const
 {
+    readRestoredData();
     return m_dataObject;
 }
 
 bool PropertyPostDataObject::isComposite()
 {
-
+    readRestoredData();
     return m_dataObject && !m_dataObject->IsA("vtkDataSet");
 }
 
 bool PropertyPostDataObject::isDataSet()
 {
-
+    readRestoredData();
     return m_dataObject && m_dataObject->IsA("vtkDataSet");
 }
 
 int PropertyPostDataObject::getDataType()
 {
-
+    readRestoredData();
     if (!m_dataObject) {
         return -1;
     }
@@ -163,6 +220,13 @@ void PropertyPostDataObject::setPyObject(PyObject* /*value*/)
 App::Property* PropertyPostDataObject::Copy() const
 {
     PropertyPostDataObject* prop = new PropertyPostDataObject();
+    // data that hasn't been read yet is copied as it is
+    {
+        std::lock_guard<std::mutex> lock(m_restoreMutex);
+        prop->m_restoredData = m_restoredData;
+        prop->m_restoredType = m_restoredType;
+        prop->m_restoreFailed = m_restoreFailed;
+    }
     if (m_dataObject) {
 
         prop->createDataObjectByExternalType(m_dataObject);
@@ -172,7 +236,8 @@ App::Property* PropertyPostDataObject::Copy() const
     return prop;
 }
 
-void PropertyPostDataObject::createDataObjectByExternalType(vtkSmartPointer<vtkDataObject> ex)
+void PropertyPostDataObject::createDataObjectByExternalType(
+    vtkSmartPointer<vtkDataObject> ex) const
 {
 
     switch (ex->GetDataObjectType()) {
@@ -210,13 +275,19 @@ void PropertyPostDataObject::createDataObjectByExternalType(vtkSmartPointer<vtkD
 void PropertyPostDataObject::Paste(const App::Property& from)
 {
     aboutToSetValue();
-    m_dataObject = dynamic_cast<const PropertyPostDataObject&>(from).m_dataObject;
+    const auto& other = dynamic_cast<const PropertyPostDataObject&>(from);
+    std::lock_guard<std::mutex> lock(other.m_restoreMutex);
+    m_dataObject = other.m_dataObject;
+    m_restoredData = other.m_restoredData;
+    m_restoredType = other.m_restoredType;
+    m_restoreFailed = other.m_restoreFailed;
     hasSetValue();
 }
 
 unsigned int PropertyPostDataObject::getMemSize() const
 {
-    return m_dataObject ? m_dataObject->GetActualMemorySize() : 0;
+    unsigned int size = static_cast<unsigned int>(m_restoredData.size());
+    return m_dataObject ? size + m_dataObject->GetActualMemorySize() : size;
 }
 
 void PropertyPostDataObject::getPaths(std::vector<App::ObjectIdentifier>& /*paths*/) const
@@ -247,40 +318,44 @@ void PropertyPostDataObject::getPaths(std::vector<App::ObjectIdentifier>& /*path
 void PropertyPostDataObject::Save(Base::Writer& writer) const
 {
     std::string extension;
-    if (!m_dataObject) {
+    if (!m_restoredData.empty()) {
+        extension = m_restoredType;
+    }
+    else if (!m_dataObject) {
         return;
     }
-
-    switch (m_dataObject->GetDataObjectType()) {
-
-        case VTK_POLY_DATA:
-            extension = "vtp";
-            break;
-        case VTK_STRUCTURED_GRID:
-            extension = "vts";
-            break;
-        case VTK_RECTILINEAR_GRID:
-            extension = "vtr";
-            break;
-        case VTK_UNSTRUCTURED_GRID:
-            extension = "vtu";
-            break;
-        case VTK_UNIFORM_GRID:
-            extension = "vti";  // image data
-            break;
-            // TODO:multi-datasets use multiple files, this needs to be implemented specially
-            //         case VTK_COMPOSITE_DATA_SET:
-            //             prop->m_dataObject = vtkCompositeDataSet::New();
-            //             break;
-            //         case VTK_MULTIBLOCK_DATA_SET:
-            //             prop->m_dataObject = vtkMultiBlockDataSet::New();
-            //             break;
-            //         case VTK_MULTIPIECE_DATA_SET:
-            //             prop->m_dataObject = vtkMultiPieceDataSet::New();
-            //             break;
-        default:
-            break;
-    };
+    else {
+        switch (m_dataObject->GetDataObjectType()) {
+
+            case VTK_POLY_DATA:
+                extension = "vtp";
+                break;
+            case VTK_STRUCTURED_GRID:
+                extension = "vts";
+                break;
+            case VTK_RECTILINEAR_GRID:
+                extension = "vtr";
+                break;
+            case VTK_UNSTRUCTURED_GRID:
+                extension = "vtu";
+                break;
+            case VTK_UNIFORM_GRID:
+                extension = "vti";  // image data
+                break;
+                // TODO:multi-datasets use multiple files, this needs to be implemented specially
+                //         case VTK_COMPOSITE_DATA_SET:
+                //             prop->m_dataObject = vtkCompositeDataSet::New();
+                //             break;
+                //         case VTK_MULTIBLOCK_DATA_SET:
+                //             prop->m_dataObject = vtkMultiBlockDataSet::New();
+                //             break;
+                //         case VTK_MULTIPIECE_DATA_SET:
+                //             prop->m_dataObject = vtkMultiPieceDataSet::New();
+                //             break;
+            default:
+                break;
+        };
+    }
 
     if (!writer.isForceXML()) {
         std::string file = "Data." + extension;
@@ -306,22 +381,21 @@ void PropertyPostDataObject::Restore(Base::XMLReader& reader)
 
 void PropertyPostDataObject::SaveDocFile(Base::Writer& writer) const
 {
+    // data restored from the document and not used since then is written back unchanged
+    {
+        std::lock_guard<std::mutex> lock(m_restoreMutex);
+        if (!m_restoredData.empty()) {
+            writer.Stream().write(m_restoredData.data(), m_restoredData.size());
+            return;
+        }
+    }
+
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (!m_dataObject) {
         return;
     }
 
-    // create a temporary file and copy the content to the zip stream
-    // once the tmp. filename is known use always the same because otherwise
-    // we may run into some problems on the Linux platform
-    static Base::FileInfo fi(App::Application::getTempFileName());
-
-    vtkSmartPointer<vtkXMLDataSetWriter> xmlWriter = vtkSmartPointer<vtkXMLDataSetWriter>::New();
-    xmlWriter->SetInputDataObject(m_dataObject);
-    xmlWriter->SetFileName(fi.filePath().c_str());
-    xmlWriter->SetDataModeToBinary();
-
 #ifdef VTK_CELL_ARRAY_V2
     // Looks like an invalid data object that causes a crash with vtk9
     vtkUnstructuredGrid* dataGrid = vtkUnstructuredGrid::SafeDownCast(m_dataObject);
@@ -331,106 +405,103 @@ void PropertyPostDataObject::SaveDocFile(Base::Writer& writer) const
     }
 #endif
 
-    if (xmlWriter->Write() != 1) {
-        // Note: Do NOT throw an exception here because if the tmp. file could
-        // not be created we should not abort.
+    // the file is built in memory with the arrays appended as raw binary data, as the
+    // document is compressed anyway the arrays are only compressed on request
+    vtkSmartPointer<vtkXMLWriter> xmlWriter = createXMLWriter(m_dataObject->GetDataObjectType());
+    if (xmlWriter) {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Fem/InOutVtk");
+        xmlWriter->SetInputDataObject(m_dataObject);
+        xmlWriter->WriteToOutputStringOn();
+        xmlWriter->SetDataModeToAppended();
+        xmlWriter->EncodeAppendedDataOff();
+        if (hGrp->GetBool("CompressPostData", false)) {
+            xmlWriter->SetCompressorTypeToZLib();
+        }
+        else {
+            xmlWriter->SetCompressorTypeToNone();
+        }
+    }
+
+    if (!xmlWriter || xmlWriter->Write() != 1) {
+        // Note: Do NOT throw an exception here because if the data could not be
+        // written we should not abort.
         // We only print an error message but continue writing the next files to the
         // stream...
         App::PropertyContainer* father = this->getContainer();
         if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
             App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
-            Base::Console().Error("Dataset of '%s' cannot be written to vtk file '%s'\n",
-                                  obj->Label.getValue(),
-                                  fi.filePath().c_str());
+            Base::Console().Error("Dataset of '%s' cannot be written to vtk file\n",
+                                  obj->Label.getValue());
         }
         else {
-            Base::Console().Error("Cannot save vtk file '%s'\n", fi.filePath().c_str());
+            Base::Console().Error("Cannot save vtk file\n");
         }
 
-        std::stringstream ss;
-        ss << "Cannot save vtk file '" << fi.filePath() << "'";
-        writer.addError(ss.str());
-    }
-
-    Base::ifstream file(fi, std::ios::in | std::ios::binary);
-    if (file) {
-        std::streambuf* buf = file.rdbuf();
-        writer.Stream() << buf;
+        writer.addError("Cannot save vtk file");
+        return;
     }
 
-    file.close();
-    // remove temp file
-    fi.deleteFile();
+    const std::string data = xmlWriter->GetOutputString();
+    writer.Stream().write(data.data(), data.size());
 }
 
 void PropertyPostDataObject::RestoreDocFile(Base::Reader& reader)
 {
-    Base::FileInfo xml(reader.getFileName());
-    // create a temporary file and copy the content from the zip stream
-    Base::FileInfo fi(App::Application::getTempFileName());
-
-    // read in the ASCII file and write back to the file stream
-    Base::ofstream file(fi, std::ios::out | std::ios::binary);
-    unsigned long ulSize = 0;
-    if (reader) {
-        std::streambuf* buf = file.rdbuf();
-        reader >> buf;
-        file.flush();
-        ulSize = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-    }
-    file.close();
-
-    // Read the data from the temp file
-    if (ulSize > 0) {
-        std::string extension = xml.extension();
-
-        // TODO: read in of composite data structures need to be coded,
-        // including replace of "GetOutputAsDataSet()"
-        vtkSmartPointer<vtkXMLReader> xmlReader;
-        if (extension == "vtp") {
-            xmlReader = vtkSmartPointer<vtkXMLPolyDataReader>::New();
-        }
-        else if (extension == "vts") {
-            xmlReader = vtkSmartPointer<vtkXMLStructuredGridReader>::New();
-        }
-        else if (extension == "vtr") {
-            xmlReader = vtkSmartPointer<vtkXMLRectilinearGridReader>::New();
-        }
-        else if (extension == "vtu") {
-            xmlReader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
-        }
-        else if (extension == "vti") {
-            xmlReader = vtkSmartPointer<vtkXMLImageDataReader>::New();
-        }
+    // the data is only read when it is used, e.g. by a filter or a view provider,
+    // until then it is kept as it is in the document
+    std::string data((std::istreambuf_iterator<char>(reader)), std::istreambuf_iterator<char>());
+
+    aboutToSetValue();
+    {
+        std::lock_guard<std::mutex> lock(m_restoreMutex);
+        m_dataObject = nullptr;
+        m_restoredType = Base::FileInfo(reader.getFileName()).extension();
+        m_restoredData = std::move(data);
+        m_restoreFailed = false;
+    }
+    hasSetValue();
+}
+
+void PropertyPostDataObject::readRestoredData() const
+{
+    // the getters are called from the threads updating the filters, only one of them
+    // reads the data and the others wait until it is there
+    std::lock_guard<std::mutex> lock(m_restoreMutex);
+    if (m_restoredData.empty() || m_restoreFailed) {
+        return;
+    }
 
-        xmlReader->SetFileName(fi.filePath().c_str());
+    // TODO: read in of composite data structures need to be coded,
+    // including replace of "GetOutputAsDataSet()"
+    vtkSmartPointer<vtkXMLReader> xmlReader = createXMLReader(m_restoredType);
+    vtkDataSet* dataSet = nullptr;
+    if (xmlReader) {
+        xmlReader->ReadFromInputStringOn();
+        xmlReader->SetInputString(m_restoredData);
         xmlReader->Update();
+        dataSet = xmlReader->GetOutputAsDataSet();
+    }
 
-        if (!xmlReader->GetOutputAsDataSet()) {
-            // Note: Do NOT throw an exception here because if the tmp. created file could
-            // not be read it's NOT an indication for an invalid input stream 'reader'.
-            // We only print an error message but continue reading the next files from the
-            // stream...
-            App::PropertyContainer* father = this->getContainer();
-            if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
-                App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
-                Base::Console().Error("Dataset file '%s' with data of '%s' seems to be empty\n",
-                                      fi.filePath().c_str(),
-                                      obj->Label.getValue());
-            }
-            else {
-                Base::Console().Warning("Loaded Dataset file '%s' seems to be empty\n",
-                                        fi.filePath().c_str());
-            }
+    if (!dataSet) {
+        // Note: Do NOT throw an exception here, an unreadable data set is reported once
+        // and the property stays empty. The data is kept so that saving the document
+        // again doesn't lose it.
+        m_restoreFailed = true;
+        App::PropertyContainer* father = this->getContainer();
+        if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
+            App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
+            Base::Console().Error("Dataset with data of '%s' seems to be empty\n",
+                                  obj->Label.getValue());
         }
         else {
-            aboutToSetValue();
-            createDataObjectByExternalType(xmlReader->GetOutputAsDataSet());
-            m_dataObject->DeepCopy(xmlReader->GetOutputAsDataSet());
-            hasSetValue();
+            Base::Console().Warning("Loaded Dataset seems to be empty\n");
         }
+        return;
     }
 
-    // delete the temp file
-    fi.deleteFile();
+    // the reader isn't used anymore, so its output can be taken over without a copy
+    createDataObjectByExternalType(dataSet);
+    m_dataObject->ShallowCopy(dataSet);
+    std::string().swap(m_restoredData);
 }
@@ -23,6 +23,9 @@
 #ifndef FEM_PROPERTYPOSTDATASET_H
 #define FEM_PROPERTYPOSTDATASET_H
 
+#include <mutex>
+#include <string>
+
 #include <vtkDataObject.h>
 #include <vtkSmartPointer.h>
 
@@ -82,10 +85,20 @@ public:
 
 private:
     static void scaleDataObject(vtkDataObject*, double s);
+    /// read the data restored from a document when it is first needed
+    void readRestoredData() const;
 
 protected:
-    void createDataObjectByExternalType(vtkSmartPointer<vtkDataObject> ex);
-    vtkSmartPointer<vtkDataObject> m_dataObject;
+    void createDataObjectByExternalType(vtkSmartPointer<vtkDataObject> ex) const;
+    mutable vtkSmartPointer<vtkDataObject> m_dataObject;
+
+private:
+    /// the VTK XML file restored from a document, and its extension, until it is read
+    mutable std::string m_restoredData;
+    mutable std::string m_restoredType;
+    /// set when the restored data can't be read, it is then kept to be saved again
+    mutable bool m_restoreFailed = false;
+    mutable std::mutex m_restoreMutex;
 };
 
 }  // namespace Fem
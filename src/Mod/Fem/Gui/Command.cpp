@@ -124,8 +124,8 @@ static std::string getSelectedNodes(Gui::View3DInventorViewer* view)
         return {};
     }
 
-    const SMESHDS_Mesh* data =
-        static_cast<Fem::FemMeshObject*>(docObj[0])->FemMesh.getValue().getSMesh()->GetMeshDS();
+    Fem::TemporarySMesh smesh(static_cast<Fem::FemMeshObject*>(docObj[0])->FemMesh.getValue());
+    const SMESHDS_Mesh* data = smesh->GetMeshDS();
 
     SMDS_NodeIteratorPtr aNodeIter = data->nodesIterator();
     Base::Vector3f pt2d;
@@ -24,7 +24,6 @@
 
 #ifndef _PreComp_
 #include <QTextStream>
-#include <SMESH_Mesh.hxx>
 #endif
 
 #include <Mod/Fem/App/FemMeshProperty.h>
@@ -94,14 +93,14 @@ QVariant PropertyFemMeshItem::value(const App::Property*) const
     const std::vector<App::Property*>& props = getPropertyData();
     for (auto pt : props) {
         Fem::PropertyFemMesh* prop = static_cast<Fem::PropertyFemMesh*>(pt);
-        const SMESH_Mesh* mesh = prop->getValue().getSMesh();
-        ctN += mesh->NbNodes();
-        ctE += mesh->NbEdges();
-        ctF += mesh->NbFaces();
-        ctP += mesh->NbPolygons();
-        ctV += mesh->NbVolumes();
-        ctH += mesh->NbPolyhedrons();
-        ctG += mesh->NbGroup();
+        Fem::FemMesh::FemMeshInfo info = prop->getValue().getInfo();
+        ctN += info.numNode;
+        ctE += info.numEdges;
+        ctF += info.numFaces;
+        ctP += info.numPoly;
+        ctV += info.numVolu;
+        ctH += info.numHedr;
+        ctG += info.numGroups;
     }
 
     QString str;
@@ -154,8 +153,7 @@ int PropertyFemMeshItem::countNodes() const
     const std::vector<App::Property*>& props = getPropertyData();
     for (auto pt : props) {
         Fem::PropertyFemMesh* prop = static_cast<Fem::PropertyFemMesh*>(pt);
-        const SMESH_Mesh* mesh = prop->getValue().getSMesh();
-        ctN += mesh->NbNodes();
+        ctN += prop->getValue().getInfo().numNode;
     }
 
     return ctN;
@@ -167,8 +165,7 @@ int PropertyFemMeshItem::countEdges() const
     const std::vector<App::Property*>& props = getPropertyData();
     for (auto pt : props) {
         Fem::PropertyFemMesh* prop = static_cast<Fem::PropertyFemMesh*>(pt);
-        const SMESH_Mesh* mesh = prop->getValue().getSMesh();
-        ctE += mesh->NbEdges();
+        ctE += prop->getValue().getInfo().numEdges;
     }
 
     return ctE;
@@ -180,8 +177,7 @@ int PropertyFemMeshItem::countFaces() const
     const std::vector<App::Property*>& props = getPropertyData();
     for (auto pt : props) {
         Fem::PropertyFemMesh* prop = static_cast<Fem::PropertyFemMesh*>(pt);
-        const SMESH_Mesh* mesh = prop->getValue().getSMesh();
-        ctF += mesh->NbFaces();
+        ctF += prop->getValue().getInfo().numFaces;
     }
 
     return ctF;
@@ -193,8 +189,7 @@ int PropertyFemMeshItem::countPolygons() const
     const std::vector<App::Property*>& props = getPropertyData();
     for (auto pt : props) {
         Fem::PropertyFemMesh* prop = static_cast<Fem::PropertyFemMesh*>(pt);
-        const SMESH_Mesh* mesh = prop->getValue().getSMesh();
-        ctP += mesh->NbPolygons();
+        ctP += prop->getValue().getInfo().numPoly;
     }
 
     return ctP;
@@ -206,8 +201,7 @@ int PropertyFemMeshItem::countVolumes() const
     const std::vector<App::Property*>& props = getPropertyData();
     for (auto pt : props) {
         Fem::PropertyFemMesh* prop = static_cast<Fem::PropertyFemMesh*>(pt);
-        const SMESH_Mesh* mesh = prop->getValue().getSMesh();
-        ctV += mesh->NbVolumes();
+        ctV += prop->getValue().getInfo().numVolu;
     }
 
     return ctV;
@@ -219,8 +213,7 @@ int PropertyFemMeshItem::countPolyhedrons() const
     const std::vector<App::Property*>& props = getPropertyData();
     for (auto pt : props) {
         Fem::PropertyFemMesh* prop = static_cast<Fem::PropertyFemMesh*>(pt);
-        const SMESH_Mesh* mesh = prop->getValue().getSMesh();
-        ctH += mesh->NbPolyhedrons();
+        ctH += prop->getValue().getInfo().numHedr;
     }
 
     return ctH;
@@ -232,8 +225,7 @@ int PropertyFemMeshItem::countGroups() const
     const std::vector<App::Property*>& props = getPropertyData();
     for (auto pt : props) {
         Fem::PropertyFemMesh* prop = static_cast<Fem::PropertyFemMesh*>(pt);
-        const SMESH_Mesh* mesh = prop->getValue().getSMesh();
-        ctG += mesh->NbGroup();
+        ctG += prop->getValue().getInfo().numGroups;
     }
 
     return ctG;
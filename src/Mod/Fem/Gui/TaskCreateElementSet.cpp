@@ -606,10 +606,9 @@ void TaskCreateElementSet::DefineNodes(const Base::Polygon2d& polygon,
                                        const Gui::ViewVolumeProjection& proj,
                                        bool inner)
 {
-    const SMESHDS_Mesh* srcMeshDS =
-        const_cast<SMESH_Mesh*>(
-            pcObject->FemMesh.getValue<Fem::FemMeshObject*>()->FemMesh.getValue().getSMesh())
-            ->GetMeshDS();
+    Fem::TemporarySMesh smesh(
+        pcObject->FemMesh.getValue<Fem::FemMeshObject*>()->FemMesh.getValue());
+    const SMESHDS_Mesh* srcMeshDS = smesh->GetMeshDS();
 
     std::vector<Gui::SelectionSingleton::SelObj> selection =
         Gui::Selection().getSelection();  // [0];
@@ -159,10 +159,9 @@ void TaskCreateNodeSet::DefineNodes(const Base::Polygon2d& polygon,
                                     const Gui::ViewVolumeProjection& proj,
                                     bool inner)
 {
-    const SMESHDS_Mesh* data = pcObject->FemMesh.getValue<Fem::FemMeshObject*>()
-                                   ->FemMesh.getValue()
-                                   .getSMesh()
-                                   ->GetMeshDS();
+    Fem::TemporarySMesh smesh(
+        pcObject->FemMesh.getValue<Fem::FemMeshObject*>()->FemMesh.getValue());
+    const SMESHDS_Mesh* data = smesh->GetMeshDS();
 
     SMDS_NodeIteratorPtr aNodeIter = data->nodesIterator();
     Base::Vector3f pt2d;
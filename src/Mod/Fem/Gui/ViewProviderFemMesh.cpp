@@ -555,10 +555,9 @@ std::set<long> ViewProviderFemMesh::getHighlightNodes() const
 void ViewProviderFemMesh::setHighlightNodes(const std::set<long>& HighlightedNodes)
 {
     if (!HighlightedNodes.empty()) {
-        const SMESHDS_Mesh* data = static_cast<Fem::FemMeshObject*>(this->pcObject)
-                                       ->FemMesh.getValue()
-                                       .getSMesh()
-                                       ->GetMeshDS();
+        Fem::TemporarySMesh smesh(
+            static_cast<Fem::FemMeshObject*>(this->pcObject)->FemMesh.getValue());
+        const SMESHDS_Mesh* data = smesh->GetMeshDS();
 
         pcAnoCoords->point.setNum(HighlightedNodes.size());
         SbVec3f* verts = pcAnoCoords->point.startEditing();
@@ -941,7 +940,9 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
 
     const Fem::PropertyFemMesh* mesh = static_cast<const Fem::PropertyFemMesh*>(prop);
 
-    const SMESHDS_Mesh* data = mesh->getValue().getSMesh()->GetMeshDS();
+    // the builder needs SMESH, a compact mesh doesn't need to keep it
+    Fem::TemporarySMesh smesh(mesh->getValue());
+    const SMESHDS_Mesh* data = smesh->GetMeshDS();
 
     int numFaces = data->NbFaces();
     int numNodes = data->NbNodes();
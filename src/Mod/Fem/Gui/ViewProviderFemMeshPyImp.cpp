@@ -280,17 +280,17 @@ Py::List ViewProviderFemMeshPy::getHighlightedNodes() const
 void ViewProviderFemMeshPy::setHighlightedNodes(Py::List arg)
 {
     ViewProviderFemMesh* vp = this->getViewProviderFemMeshPtr();
-    const SMESHDS_Mesh* data = static_cast<Fem::FemMeshObject*>(vp->getObject())
-                                   ->FemMesh.getValue()
-                                   .getSMesh()
-                                   ->GetMeshDS();
-
     std::set<long> res;
-    for (Py::List::iterator it = arg.begin(); it != arg.end(); ++it) {
-        long id = static_cast<long>(Py::Long(*it));
-        const SMDS_MeshNode* node = data->FindNode(id);
-        if (node) {
-            res.insert(id);
+    {
+        Fem::TemporarySMesh smesh(
+            static_cast<Fem::FemMeshObject*>(vp->getObject())->FemMesh.getValue());
+        const SMESHDS_Mesh* data = smesh->GetMeshDS();
+        for (Py::List::iterator it = arg.begin(); it != arg.end(); ++it) {
+            long id = static_cast<long>(Py::Long(*it));
+            const SMDS_MeshNode* node = data->FindNode(id);
+            if (node) {
+                res.insert(id);
+            }
         }
     }
 
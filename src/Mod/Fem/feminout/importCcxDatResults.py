@@ -34,10 +34,6 @@ import os
 
 import FreeCAD
 from FreeCAD import Console
-from builtins import open as pyopen
-
-
-EIGENVALUE_OUTPUT_SECTION = "     E I G E N V A L U E   O U T P U T"
 
 
 # ********* generic FreeCAD import and export methods *********
@@ -68,29 +64,6 @@ def import_dat(filename, Analysis=None):
 # read a calculix result file and extract the data
 def readResult(dat_input):
     Console.PrintMessage(f"Read ccx results from dat file: {dat_input}\n")
-    dat_file = pyopen(dat_input, "r")
-    eigenvalue_output_section_found = False
-    mode_reading = False
-    results = []
-
-    for line in dat_file:
-        if EIGENVALUE_OUTPUT_SECTION in line:
-            # Found EIGENVALUE_OUTPUT_SECTION
-            eigenvalue_output_section_found = True
-        if eigenvalue_output_section_found:
-            try:
-                mode = int(line[0:7])
-                mode_frequency = float(line[39:55])
-                m = {}
-                m["eigenmode"] = mode
-                m["frequency"] = mode_frequency
-                results.append(m)
-                mode_reading = True
-            except Exception:
-                if mode_reading:
-                    # Conversion error after mode reading started, so it's the end of section
-                    eigenvalue_output_section_found = False
-                    mode_reading = False
+    import Fem
 
-    dat_file.close()
-    return results
+    return Fem.readCcxDat(dat_input)
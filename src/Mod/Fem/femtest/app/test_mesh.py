@@ -192,6 +192,167 @@ class TestMeshCommon(unittest.TestCase):
             f"Problem in test_writeAbaqus_precision, \n{read_node_line}\n{expected}",
         )
 
+    # ********************************************************************************************
+    def test_writeZ88_python(self):
+        # the Z88 mesh is written in C++, the file is the same as the one of the Python writer
+        from feminout import importZ88Mesh
+
+        fm = self.create_mixed_mesh()
+        fm.Placement = FreeCAD.Placement(FreeCAD.Vector(10, 20, 30), FreeCAD.Rotation(0, 0, 90))
+        tmp_dir = testtools.get_fem_test_tmp_dir("mesh_common_z88")
+        cpp_file = join(tmp_dir, "mesh_cpp.z88")
+        python_file = join(tmp_dir, "mesh_python.z88")
+        fm.write(cpp_file)
+        importZ88Mesh.write(fm, python_file)
+        with open(cpp_file) as f:
+            cpp_text = f.read()
+        with open(python_file) as f:
+            python_text = f.read()
+        self.assertEqual(python_text, cpp_text)
+
+    # ********************************************************************************************
+    def create_mixed_mesh(self):
+        # volumes, faces and edges with groups of nodes and elements
+        from femexamples.meshes.mesh_canticcx_tetra10 import create_elements
+        from femexamples.meshes.mesh_canticcx_tetra10 import create_nodes
+
+        fm = Fem.FemMesh()
+        create_nodes(fm)
+        create_elements(fm)
+        fm.addFace([1, 2, 3], 1001)
+        fm.addEdge([1, 2], 1002)
+        node_group = fm.addGroup("MyNodeGroup", "Node")
+        fm.addGroupElements(node_group, [1, 2, 3, 40])
+        volume_group = fm.addGroup("MyVolumeGroup", "Volume")
+        fm.addGroupElements(volume_group, [149, 150, 151])
+        return fm
+
+    def get_mesh_content(self, fm):
+        elements = list(fm.Volumes) + list(fm.Faces) + list(fm.Edges)
+        return {
+            "nodes": fm.Nodes,
+            "elements": {e: (fm.getElementType(e), fm.getElementNodes(e)) for e in elements},
+            "groups": {
+                fm.getGroupName(g): (fm.getGroupElementType(g), sorted(fm.getGroupElements(g)))
+                for g in fm.Groups
+            },
+        }
+
+    # ********************************************************************************************
+    def test_compact_mesh_copy(self):
+        # a copy keeps the mesh in compact arrays, it is put into SMESH again for the getters
+        fm = self.create_mixed_mesh()
+        expected = self.get_mesh_content(fm)
+        compact = fm.copy()
+        self.assertEqual(expected, self.get_mesh_content(compact))
+
+        # changing the copy puts it into SMESH for good, the original stays as it was
+        compact.addNode(100, 100, 100, 5000)
+        self.assertEqual(fm.NodeCount + 1, compact.NodeCount)
+        self.assertEqual(expected, self.get_mesh_content(fm))
+
+    # ********************************************************************************************
+    def test_compact_mesh_save_restore(self):
+        # a restored mesh is compact, saving it again has to put it into SMESH for the export
+        fm = self.create_mixed_mesh()
+        expected = self.get_mesh_content(fm)
+        mesh_obj = self.document.addObject("Fem::FemMeshObject", "CompactMesh")
+        mesh_obj.FemMesh = fm
+
+        tmp_dir = testtools.get_fem_test_tmp_dir("mesh_common_compact")
+        first_file = join(tmp_dir, "compact_first.FCStd")
+        second_file = join(tmp_dir, "compact_second.FCStd")
+        self.document.saveCopy(first_file)
+
+        doc = FreeCAD.openDocument(first_file)
+        try:
+            doc.saveCopy(second_file)
+            self.assertEqual(expected, self.get_mesh_content(doc.CompactMesh.FemMesh))
+        finally:
+            FreeCAD.closeDocument(doc.Name)
+
+        doc = FreeCAD.openDocument(second_file)
+        try:
+            self.assertEqual(expected, self.get_mesh_content(doc.CompactMesh.FemMesh))
+        finally:
+            FreeCAD.closeDocument(doc.Name)
+
+    # ********************************************************************************************
+    def test_vtk_export_changed_mesh(self):
+        # the exported grid is kept with the mesh, a change of the mesh has to drop it
+        fm = self.create_mixed_mesh()
+        tmp_dir = testtools.get_fem_test_tmp_dir("mesh_common_vtk_export")
+        vtk_file = join(tmp_dir, "mesh.vtk")
+        fm.write(vtk_file)
+        node_count = Fem.read(vtk_file).NodeCount
+        # the second export reuses the kept grid
+        fm.write(vtk_file)
+        self.assertEqual(node_count, Fem.read(vtk_file).NodeCount)
+
+        node_id = max(fm.Nodes) + 1
+        fm.addNode(100, 200, 300, node_id)
+        fm.write(vtk_file)
+        exported = Fem.read(vtk_file)
+        self.assertEqual(node_count + 1, exported.NodeCount)
+        self.assertTrue(exported.Nodes[node_id].isEqual(FreeCAD.Vector(100, 200, 300), 1e-6))
+
+    # ********************************************************************************************
+    def test_compact_mesh_transform(self):
+        # the transformation of a compact mesh must not change the meshes it shares its data with
+        fm = self.create_mixed_mesh()
+        expected = self.get_mesh_content(fm)
+        compact = fm.copy()
+        # the SMESH mesh of the getters is moved along
+        compact.getElementNodes(149)
+
+        matrix = FreeCAD.Matrix()
+        matrix.move(FreeCAD.Vector(10, 20, 30))
+        compact.transformGeometry(matrix)
+
+        moved = self.get_mesh_content(compact)
+        self.assertEqual(expected["elements"], moved["elements"])
+        self.assertEqual(expected["groups"], moved["groups"])
+        for node_id, point in expected["nodes"].items():
+            self.assertTrue(
+                moved["nodes"][node_id].isEqual(point + FreeCAD.Vector(10, 20, 30), 1e-9),
+                f"Node {node_id} is not moved as expected",
+            )
+        self.assertEqual(expected, self.get_mesh_content(fm))
+
+    # ********************************************************************************************
+    def test_compact_mesh_getters(self):
+        # the getters read a compact mesh without putting it into SMESH for good
+        fm = self.create_mixed_mesh()
+        compact = fm.copy()
+        counts = [
+            "NodeCount",
+            "EdgeCount",
+            "FaceCount",
+            "TriangleCount",
+            "QuadrangleCount",
+            "PolygonCount",
+            "VolumeCount",
+            "TetraCount",
+            "HexaCount",
+            "PyramidCount",
+            "PrismCount",
+            "PolyhedronCount",
+            "GroupCount",
+        ]
+        for count in counts:
+            self.assertEqual(getattr(fm, count), getattr(compact, count), count)
+        self.assertEqual(fm.Groups, compact.Groups)
+        for node_id in fm.Nodes:
+            self.assertEqual(fm.getNodeById(node_id), compact.getNodeById(node_id))
+        node_id = max(fm.Nodes) + 1
+        self.assertRaises(ValueError, compact.getNodeById, node_id)
+        self.assertRaises(ValueError, compact.getGroupName, max(fm.Groups) + 1)
+        unused_id = max(list(fm.Nodes) + list(fm.Volumes) + list(fm.Faces) + list(fm.Edges)) + 1
+        self.assertRaises(ValueError, compact.getElementType, unused_id)
+
+        # both are still the same after the getters
+        self.assertEqual(self.get_mesh_content(fm), self.get_mesh_content(compact))
+
 
 # ************************************************************************************************
 # ************************************************************************************************
@@ -26,6 +26,7 @@ __author__ = "Bernd Hahnebach"
 __url__ = "https://www.freecad.org"
 
 import unittest
+from os import listdir
 from os.path import join
 
 import FreeCAD
@@ -205,3 +206,225 @@ class TestResult(unittest.TestCase):
         self.assertEqual(
             disp_abs, expected_dispabs, "Calculated displacement abs are not the expected values."
         )
+
+    # ********************************************************************************************
+    def read_frd_blocks(self, lines, header, size):
+        # the values of the blocks starting with header, parsed by column like CalculiX writes them
+        blocks = []
+        values = None
+        for li in lines:
+            if li.startswith(header):
+                values = {}
+                blocks.append(values)
+            elif values is not None and li.startswith(" -1"):
+                columns = range(13, 13 + 12 * size, 12)
+                values[int(li[3:13])] = tuple(float(li[c : c + 12]) for c in columns)
+            elif li.startswith(" -3"):
+                values = None
+        return blocks
+
+    # ********************************************************************************************
+    def test_read_frd(self):
+        import math
+        import Fem
+
+        frd_file = join(testtools.get_fem_test_home_dir(), "calculix", "box_static.frd")
+        with open(frd_file) as f:
+            lines = f.readlines()
+        nodes = self.read_frd_blocks(lines, "    2C", 3)[0]
+        disp = self.read_frd_blocks(lines, " -4  DISP", 3)[0]
+        stress = self.read_frd_blocks(lines, " -4  STRESS", 6)[0]
+
+        m = Fem.readCcxFrd(frd_file)
+        self.assertEqual(len(m["Nodes"]), 280)
+        self.assertEqual(len(nodes), 280)
+        for n, coords in nodes.items():
+            self.assertEqual(tuple(m["Nodes"][n]), coords)
+        self.assertEqual(len(m["Tetra10Elem"]), 129)
+
+        results = m["Results"]
+        self.assertEqual(len(results), 1)
+        self.assertEqual(sorted(results.getFieldNames(0)), ["disp", "strain", "stress"])
+        result_set = results[0]
+        self.assertTrue(math.isnan(result_set["number"]))
+        self.assertEqual(result_set["time"], 1.0)
+        self.assertEqual(len(result_set["disp"]), 280)
+        for n, values in disp.items():
+            self.assertEqual(tuple(result_set["disp"][n]), values)
+        # stresses are written as (xx, yy, zz, xy, yz, zx), FreeCAD uses (xx, yy, zz, xy, xz, yz)
+        for n, values in stress.items():
+            expected = values[:4] + (values[5], values[4])
+            self.assertEqual(tuple(result_set["stress"][n]), expected)
+
+        with self.assertRaises(IndexError):
+            results[1]
+        with self.assertRaises(IndexError):
+            results.getFieldNames(1)
+
+    # ********************************************************************************************
+    def test_read_frd_steps(self):
+        import Fem
+
+        # the test data has one step only, repeat its displacements for the times 1, 2 and 3
+        # with the factors 1, 2 and 3
+        frd_static = join(testtools.get_fem_test_home_dir(), "calculix", "box_static.frd")
+        with open(frd_static) as f:
+            lines = f.readlines()
+        first = next(i for i, li in enumerate(lines) if li.startswith("    1PSTEP"))
+        last = next(i for i, li in enumerate(lines) if li.startswith(" -3") and i > first)
+        disp = self.read_frd_blocks(lines, " -4  DISP", 3)[0]
+        tmp_dir = testtools.get_fem_test_tmp_dir("result_read_frd_steps")
+        frd_file = join(tmp_dir, "box_steps.frd")
+        with open(frd_file, "w") as f:
+            f.writelines(lines[:first])
+            for step in (1, 2, 3):
+                for li in lines[first : last + 1]:
+                    if li.startswith("  100CL"):
+                        li = li[:13] + f"{float(step):.9f}".ljust(12) + li[25:]
+                    elif li.startswith(" -1"):
+                        values = [float(li[13 + 12 * i : 25 + 12 * i]) * step for i in range(3)]
+                        li = li[:13] + "".join(f"{v:12.5E}" for v in values) + "\n"
+                    f.write(li)
+            f.write(" 9999\n")
+
+        results = Fem.readCcxFrd(frd_file)["Results"]
+        self.assertEqual(len(results), 3)
+        # the sets are read one by one while iterating
+        for step, result_set in enumerate(results, 1):
+            self.assertEqual(result_set["time"], float(step))
+            self.assertEqual(list(result_set), ["number", "time", "disp"])
+            for n, values in disp.items():
+                expected = tuple(float(f"{v * step:12.5E}") for v in values)
+                self.assertEqual(tuple(result_set["disp"][n]), expected)
+        self.assertEqual(results[2]["time"], 3.0)
+
+    # ********************************************************************************************
+    def test_post_data_save_restore(self):
+        # the data of a result pipeline is saved in memory and read lazily on restore,
+        # it has to come back unchanged with and without compression of the arrays
+        if "BUILD_FEM_VTK" not in FreeCAD.__cmake__:
+            fcc_print("FEM_VTK post processing is disabled.")
+            return
+
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Fem/InOutVtk")
+        compress_saved = param.GetBool("CompressPostData", False)
+        try:
+            for compress in (False, True):
+                param.SetBool("CompressPostData", compress)
+                self.check_post_data_save_restore(compress)
+        finally:
+            param.SetBool("CompressPostData", compress_saved)
+
+    def check_post_data_save_restore(self, compress):
+        import Fem
+
+        frd_file = join(testtools.get_fem_test_home_dir(), "calculix", "box_static.frd")
+        tmp_dir = testtools.get_fem_test_tmp_dir("result_post_data")
+        doc_file = join(tmp_dir, "post_data.FCStd")
+
+        pipeline = self.document.addObject("Fem::FemPostPipeline", "Pipeline")
+        pipeline.read(frd_file)
+        # the data has to be restored from the document and not from the result file
+        pipeline.TimeSeries = ""
+        self.document.recompute()
+        pipeline.writeVTK(join(tmp_dir, "before.vtu"))
+        before = Fem.read(join(tmp_dir, "before.vtu"))
+        self.assertGreater(before.NodeCount, 0)
+
+        self.document.saveCopy(doc_file)
+        doc = FreeCAD.openDocument(doc_file)
+        try:
+            doc.getObject("Pipeline").writeVTK(join(tmp_dir, "after.vtu"))
+            after = Fem.read(join(tmp_dir, "after.vtu"))
+            msg = f"Post data differs after save and restore (CompressPostData={compress})."
+            self.assertEqual(before.NodeCount, after.NodeCount, msg)
+            self.assertEqual(before.ElementCount, after.ElementCount, msg)
+            self.assertEqual(before.VolumeCount, after.VolumeCount, msg)
+        finally:
+            FreeCAD.closeDocument(doc.Name)
+        self.document.removeObject("Pipeline")
+
+    # ********************************************************************************************
+    def test_post_frd_time_series(self):
+        # a frd file with several steps is loaded as time series, one step at a time
+        if "BUILD_FEM_VTK" not in FreeCAD.__cmake__:
+            fcc_print("FEM_VTK post processing is disabled.")
+            return
+
+        import Fem
+
+        # the test data has one step only, repeat its results for the times 1, 2 and 3
+        frd_static = join(testtools.get_fem_test_home_dir(), "calculix", "box_static.frd")
+        with open(frd_static) as f:
+            lines = f.readlines()
+        first = next(i for i, li in enumerate(lines) if li.startswith("    1PSTEP"))
+        last = next(i for i, li in enumerate(lines) if li.startswith(" 9999"))
+        tmp_dir = testtools.get_fem_test_tmp_dir("result_frd_time_series")
+        frd_file = join(tmp_dir, "box_steps.frd")
+        with open(frd_file, "w") as f:
+            f.writelines(lines[:first])
+            for time in (1.0, 2.0, 3.0):
+                for li in lines[first:last]:
+                    if li.startswith("  100CL"):
+                        li = li[:13] + f"{time:.9f}".ljust(12) + li[25:]
+                    f.write(li)
+            f.writelines(lines[last:])
+
+        # the importer creates a pipeline for the frd file
+        Fem.insert(frd_file, self.document.Name)
+        pipeline = self.document.getObject("box_steps")
+        self.assertIsNotNone(pipeline, "No result pipeline created for the frd file.")
+        self.assertEqual(pipeline.FrameTimes, [1.0, 2.0, 3.0])
+
+        node_counts = []
+        for frame in (0, 2, 1):
+            pipeline.Frame = frame
+            self.document.recompute()
+            self.assertEqual(pipeline.Frame, frame)
+            vtu_file = join(tmp_dir, f"frame_{frame}.vtu")
+            pipeline.writeVTK(vtu_file)
+            node_counts.append(Fem.read(vtu_file).NodeCount)
+        self.assertGreater(node_counts[0], 0)
+        self.assertEqual(node_counts, 3 * [node_counts[0]])
+
+    # ********************************************************************************************
+    def test_post_filters_parallel(self):
+        # the filters of a pipeline in parallel mode are updated together, their results
+        # have to be the same as those of the filters updated one by one
+        if "BUILD_FEM_VTK" not in FreeCAD.__cmake__:
+            fcc_print("FEM_VTK post processing is disabled.")
+            return
+
+        frd_file = join(testtools.get_fem_test_home_dir(), "calculix", "box_static.frd")
+        tmp_dir = testtools.get_fem_test_tmp_dir("result_post_filters_parallel")
+        filter_types = (
+            "Fem::FemPostWarpVectorFilter",
+            "Fem::FemPostScalarClipFilter",
+            "Fem::FemPostContoursFilter",
+        )
+
+        def make_pipeline(name, types):
+            pipeline = self.document.addObject("Fem::FemPostPipeline", name)
+            pipeline.Mode = "Parallel"
+            filters = [self.document.addObject(t, name + t.split("::")[1]) for t in types]
+            pipeline.Filter = filters
+            self.document.recompute()
+            pipeline.read(frd_file)
+            self.document.recompute()
+            return filters
+
+        def result(post_object):
+            post_object.writeVTK(join(tmp_dir, post_object.Name + ".vtk"))
+            # the extension is replaced by the one of the data type of the filter
+            vtk_file = next(f for f in listdir(tmp_dir) if f.startswith(post_object.Name + "."))
+            with open(join(tmp_dir, vtk_file), "rb") as f:
+                return f.read()
+
+        parallel = make_pipeline("Parallel", filter_types)
+        for i, (t, parallel_filter) in enumerate(zip(filter_types, parallel)):
+            serial_filter = make_pipeline(f"Single{i}", (t,))[0]
+            self.assertEqual(
+                result(parallel_filter),
+                result(serial_filter),
+                f"Result of {t} differs when updated in parallel.",
+            )
@@ -26,6 +26,7 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <cmath>
+#include <future>
 
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepAdaptor_CompCurve.hxx>
@@ -725,6 +726,20 @@ void checkAndMatchHasher(TopoShape& topoShape1, const TopoShape& topoShape2)
 }  // namespace
 #endif
 
+namespace
+{
+// Mapped names of a source element found for one element of the mapping shape
+struct SubElementNames
+{
+    int index {};
+    std::vector<std::pair<Data::MappedName, Data::ElementIDRefs>> names;
+};
+
+// Minimum number of sub-elements before mapSubElement() distributes the name
+// lookup of vertexes, edges and faces to separate threads.
+constexpr int ParallelSubElementThreshold = 3000;
+}  // namespace
+
 // TODO: Refactor mapSubElementTypeForShape to reduce complexity
 void TopoShape::mapSubElementTypeForShape(const TopoShape& other,
                                           TopAbs_ShapeEnum type,
@@ -872,18 +887,27 @@ void TopoShape::mapSubElement(const TopoShape& other, const char* op, bool force
         }
     };
 
-    for (auto type : types) {
-        auto& shapeMap = _cache->getAncestry(type);
-        auto& otherMap = other._cache->getAncestry(type);
+    // The ancestry of both shapes is built here, and any pending element map
+    // of the other shape is flushed, so that the lookups below are read only
+    // and can safely run concurrently for each element type.
+    std::array<TopoShapeCache::Ancestry*, 3> shapeMaps {};
+    std::array<TopoShapeCache::Ancestry*, 3> otherMaps {};
+    int total = 0;
+    for (size_t i = 0; i < types.size(); ++i) {
+        shapeMaps[i] = &_cache->getAncestry(types[i]);
+        otherMaps[i] = &other._cache->getAncestry(types[i]);
+        total += std::min(shapeMaps[i]->count(), otherMaps[i]->count());
+    }
+    other.elementMap();
+
+    auto collect = [this, &other](TopAbs_ShapeEnum type,
+                                  TopoShapeCache::Ancestry& shapeMap,
+                                  TopoShapeCache::Ancestry& otherMap) {
+        std::vector<SubElementNames> result;
         if (!shapeMap.count() || !otherMap.count()) {
-            continue;
-        }
-        if (!forceHasher && other.Hasher) {
-            forceHasher = true;
-            checkHasher(other);
+            return result;
         }
         const char* shapetype = shapeName(type).c_str();
-        std::ostringstream ss;
 
         bool forward;
         int count;
@@ -895,6 +919,7 @@ void TopoShape::mapSubElement(const TopoShape& other, const char* op, bool force
             forward = false;
             count = shapeMap.count();
         }
+        result.reserve(count);
         for (int k = 1; k <= count; ++k) {
             int i, idx;
             if (forward) {
@@ -911,9 +936,51 @@ void TopoShape::mapSubElement(const TopoShape& other, const char* op, bool force
                     continue;
                 }
             }
-            Data::IndexedName element = Data::IndexedName::fromConst(shapetype, idx);
-            for (auto& v :
-                 other.getElementMappedNames(Data::IndexedName::fromConst(shapetype, i), true)) {
+            result.emplace_back();
+            auto& entry = result.back();
+            entry.index = idx;
+            entry.names =
+                other.getElementMappedNames(Data::IndexedName::fromConst(shapetype, i), true);
+        }
+        return result;
+    };
+
+    std::array<std::vector<SubElementNames>, 3> collected;
+    if (total >= ParallelSubElementThreshold) {
+        std::array<std::future<std::vector<SubElementNames>>, 3> futures;
+        for (size_t i = 0; i < types.size(); ++i) {
+            futures[i] = std::async(std::launch::async,
+                                    collect,
+                                    types[i],
+                                    std::ref(*shapeMaps[i]),
+                                    std::ref(*otherMaps[i]));
+        }
+        for (size_t i = 0; i < types.size(); ++i) {
+            collected[i] = futures[i].get();
+        }
+    }
+    else {
+        for (size_t i = 0; i < types.size(); ++i) {
+            collected[i] = collect(types[i], *shapeMaps[i], *otherMaps[i]);
+        }
+    }
+
+    // Encoding touches the string hasher and the element map of this shape,
+    // so the merge is done serially and in a fixed type order to keep the
+    // generated names stable.
+    std::ostringstream ss;
+    for (size_t t = 0; t < types.size(); ++t) {
+        if (!shapeMaps[t]->count() || !otherMaps[t]->count()) {
+            continue;
+        }
+        if (!forceHasher && other.Hasher) {
+            forceHasher = true;
+            checkHasher(other);
+        }
+        const char* shapetype = shapeName(types[t]).c_str();
+        for (auto& entry : collected[t]) {
+            Data::IndexedName element = Data::IndexedName::fromConst(shapetype, entry.index);
+            for (auto& v : entry.names) {
                 auto& name = v.first;
                 auto& sids = v.second;
                 if (sids.size()) {
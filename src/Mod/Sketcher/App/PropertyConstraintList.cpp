@@ -293,6 +293,40 @@ bool PropertyConstraintList::getPyPathValue(const App::ObjectIdentifier& path,
     return true;
 }
 
+bool PropertyConstraintList::getQuantityPathValue(const App::ObjectIdentifier& path,
+                                                  Base::Quantity& value) const
+{
+    if (path.numSubComponents() != 2 || path.getPropertyComponent(0).getName() != getName()) {
+        return false;
+    }
+
+    const ObjectIdentifier::Component& c1 = path.getPropertyComponent(1);
+
+    const Constraint* cstr = nullptr;
+
+    if (c1.isArray()) {
+        // an index out of range is reported by getPyPathValue()
+        int count = static_cast<int>(_lValueList.size());
+        int index = c1.getIndex();
+        if (index >= -count && index < count) {
+            cstr = _lValueList[index < 0 ? index + count : index];
+        }
+    }
+    else if (c1.isSimple()) {
+        for (auto c : _lValueList) {
+            if (c->Name == c1.getName()) {
+                cstr = c;
+                break;
+            }
+        }
+    }
+    if (!cstr) {
+        return false;
+    }
+    value = cstr->getPresentationValue();
+    return true;
+}
+
 void PropertyConstraintList::setPyObject(PyObject* value)
 {
     if (PyList_Check(value)) {
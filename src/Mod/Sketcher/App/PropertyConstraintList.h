@@ -147,6 +147,8 @@ public:
     void getPaths(std::vector<App::ObjectIdentifier>& paths) const override;
 
     bool getPyPathValue(const App::ObjectIdentifier& path, Py::Object& res) const override;
+    bool getQuantityPathValue(const App::ObjectIdentifier& path,
+                              Base::Quantity& value) const override;
 
     using ConstraintInfo = std::pair<int, const Constraint*>;
 
@@ -75,6 +75,8 @@ Sketch::Sketch()
     , ConstraintsCounter(0)
     , isInitMove(false)
     , isFine(true)
+    , moveGeoId(GeoEnum::GeoUndef)
+    , movePos(PointPos::none)
     , moveStep(0)
     , defaultSolver(GCS::DogLeg)
     , defaultSolverRedundant(GCS::DogLeg)
@@ -4773,6 +4775,9 @@ int Sketch::initMove(int geoId, PointPos pos, bool fine)
 
     clearTemporaryConstraints();
 
+    moveGeoId = geoId;
+    movePos = pos;
+
     // don't try to move sketches that contain conflicting constraints
     if (hasConflicts()) {
         isInitMove = false;
@@ -5071,6 +5076,37 @@ void Sketch::resetInitMove()
     isInitMove = false;
 }
 
+bool Sketch::continueMove(int geoId, PointPos pos)
+{
+    if (!isInitMove || !isFine || hasConflicts()) {
+        return false;
+    }
+
+    if (checkGeoId(geoId) != moveGeoId || pos != movePos) {
+        return false;
+    }
+
+    updateMoveReference();
+    return true;
+}
+
+void Sketch::updateMoveReference()
+{
+    GCSsys.updateReference();
+
+    // the targets of the last move are the new initial positions, like initMove() would set
+    // them. A line dragged by its middle keeps the extent of the solved line.
+    InitParameters = MoveParameters;
+    if (moveGeoId >= 0 && Geoms[moveGeoId].type == Line
+        && (movePos == PointPos::none || movePos == PointPos::mid) && InitParameters.size() >= 4) {
+        GCS::Line& l = Lines[Geoms[moveGeoId].index];
+        InitParameters[0] = *l.p1.x;
+        InitParameters[1] = *l.p1.y;
+        InitParameters[2] = *l.p2.x;
+        InitParameters[3] = *l.p2.y;
+    }
+}
+
 int Sketch::initBSplinePieceMove(int geoId,
                                  PointPos pos,
                                  const Base::Vector3d& firstPoint,
@@ -5082,6 +5118,10 @@ int Sketch::initBSplinePieceMove(int geoId,
 
     clearTemporaryConstraints();
 
+    // a piece move is never continued by continueMove()
+    moveGeoId = GeoEnum::GeoUndef;
+    movePos = pos;
+
     // don't try to move sketches that contain conflicting constraints
     if (hasConflicts()) {
         isInitMove = false;
@@ -5160,9 +5200,11 @@ int Sketch::movePoint(int geoId, PointPos pos, Base::Vector3d toPoint, bool rela
                 moveStep = (toPoint - initToPoint).Length();
             }
             else {
-                // I am getting too far away from the original solution so reinit the solution
+                // I am getting too far away from the original solution so reinit the solution.
+                // The temporary constraints and subsystems do not depend on the position, so
+                // only the reference solution and the initial positions are refreshed.
                 if ((toPoint - initToPoint).Length() > 20 * moveStep) {
-                    initMove(geoId, pos);
+                    updateMoveReference();
                     initToPoint = toPoint;
                 }
             }
@@ -175,6 +175,14 @@ public:
      */
     void resetInitMove();
 
+    /** Continues a drag of the same point (or curve) initialized by a previous movePoint().
+     * The temporary constraints and the subsystem decomposition are kept, only the current
+     * sketch status is taken as the new reference.
+     * Returns false if there is no such drag with fine precision, in which case it must be
+     * initialized again.
+     */
+    bool continueMove(int geoId, PointPos pos);
+
     /** Limits a b-spline drag to the segment around `firstPoint`.
      */
     int limitBSplineMove(int geoId, PointPos pos, const Base::Vector3d& firstPoint);
@@ -608,6 +616,8 @@ private:
 
     bool isInitMove;
     bool isFine;
+    int moveGeoId;
+    PointPos movePos;
     Base::Vector3d initToPoint;
     double moveStep;
 
@@ -740,6 +750,8 @@ private:
 
     /// checks if the index bounds and converts negative indices to positive
     int checkGeoId(int geoId) const;
+    /// takes the current solution and move targets as starting point of the following moves
+    void updateMoveReference();
     GCS::Curve* getGCSCurveByGeoId(int geoId);
     const GCS::Curve* getGCSCurveByGeoId(int geoId) const;
 
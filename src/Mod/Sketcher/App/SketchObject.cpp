@@ -1013,6 +1013,11 @@ int SketchObject::movePoint(int GeoId, PointPos PosId, const Base::Vector3d& toP
     if (lastHasConflict)// conflicting constraints
         return -1;
 
+    // consecutive absolute moves of the same point keep the temporary constraints and the
+    // subsystems of the solver, anything else sets up the move from scratch
+    if (relative || !solvedSketch.continueMove(GeoId, PosId))
+        solvedSketch.resetInitMove();
+
     // move the point and solve
     lastSolverStatus = solvedSketch.movePoint(GeoId, PosId, toPoint, relative);
 
@@ -1030,7 +1035,8 @@ int SketchObject::movePoint(int GeoId, PointPos PosId, const Base::Vector3d& toP
         }
     }
 
-    solvedSketch.resetInitMove();// reset solver point moving mechanism
+    if (relative || lastSolverStatus != 0)
+        solvedSketch.resetInitMove();// reset solver point moving mechanism
 
     return lastSolverStatus;
 }
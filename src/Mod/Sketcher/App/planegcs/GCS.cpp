@@ -51,6 +51,9 @@
 #include <future>
 #include <iostream>
 #include <limits>
+#include <numeric>
+#include <thread>
+#include <type_traits>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -84,6 +87,9 @@
 #include <Eigen/OrderingMethods>
 #endif
 
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseLU>
+
 // _GCS_EXTRACT_SOLVER_SUBSYSTEM_ to be enabled in Constraints.h when needed.
 #if defined(_GCS_EXTRACT_SOLVER_SUBSYSTEM_) || defined(_DEBUG_TO_FILE)
 #include <fstream>
@@ -479,6 +485,7 @@ System::System()
     , convergenceRedundant(1e-10)
     , qrAlgorithm(EigenSparseQR)
     , dogLegGaussStep(FullPivLU)
+    , sparseJacobianThreshold(500)
     , qrpivotThreshold(1E-13)
     , debugMode(Minimal)
     , LM_eps(1E-10)
@@ -1957,6 +1964,13 @@ void System::setReference()
     }
 }
 
+void System::updateReference()
+{
+    if (isInit) {
+        setReference();
+    }
+}
+
 void System::resetToReference()
 {
     if (reference.size() == plist.size()) {
@@ -1975,31 +1989,91 @@ int System::solve(VEC_pD& params, bool isFine, Algorithm alg, bool isRedundantso
     return solve(isFine, alg, isRedundantsolving);
 }
 
+namespace
+{
+
+// Below this number of parameters the clusters of a system are solved and diagnosed in the
+// calling thread, as starting the threads would cost more than it saves.
+constexpr std::size_t ParallelClustersMinParameters = 200;
+
+// Calls task(i) for i in [0, count), distributed over the available cores if parallel is true.
+// The tasks must not touch any state shared with other indices.
+template<typename Task>
+void runConcurrently(std::size_t count, bool parallel, Task&& task)
+{
+    std::size_t threads =
+        parallel ? std::min<std::size_t>(count, std::max(1U, std::thread::hardware_concurrency()))
+                 : 1;
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+        futures.push_back(std::async([&task, count, threads, t]() {
+            for (std::size_t i = t; i < count; i += threads) {
+                task(i);
+            }
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+}  // namespace
+
 int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
 {
     if (!isInit) {
         return Failed;
     }
 
-    bool isReset = false;
-    // return success by default in order to permit coincidence constraints to be applied
-    // even if no other system has to be solved
-    int res = Success;
+    // the components identified by initSolution do not share any unknown parameter, so each one
+    // can be solved in its own thread
+    std::vector<int> clusters;
+    std::size_t clusterParams = 0;
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
-            resetToReference();
-            isReset = true;
+        if (subSystems[cid] || subSystemsAux[cid]) {
+            clusters.push_back(cid);
+            clusterParams += plists[cid].size();
         }
+    }
+
+    if (!clusters.empty()) {
+        resetToReference();
+    }
+
+    // Base::Console is not thread-safe, so iteration level debugging solves serially
+    bool parallel = clusters.size() > 1 && clusterParams >= ParallelClustersMinParameters
+        && debugMode != IterationLevel;
+#ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
+    parallel = false;
+#endif
+
+    std::vector<int> results(clusters.size(), Success);
+    runConcurrently(clusters.size(), parallel, [&](std::size_t i) {
+        int cid = clusters[i];
         if (subSystems[cid] && subSystemsAux[cid]) {
-            res = std::max(res,
-                           solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
+            results[i] = solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving);
         }
         else if (subSystems[cid]) {
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
+            results[i] = solve(subSystems[cid], isFine, alg, isRedundantsolving);
         }
-        else if (subSystemsAux[cid]) {
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+        else {
+            results[i] = solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
         }
+    });
+
+    // return success by default in order to permit coincidence constraints to be applied
+    // even if no other system has to be solved
+    int res = Success;
+    for (int result : results) {
+        res = std::max(res, result);
     }
     if (res == Success) {
         for (std::set<Constraint*>::const_iterator constr = redundant.begin();
@@ -2158,7 +2232,124 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     return Failed;
 }
 
+namespace
+{
+
+// solves the augmented normal equations A*h = g of Levenberg-Marquardt
+Eigen::VectorXd solveAugmented(const Eigen::MatrixXd& A, const Eigen::VectorXd& g)
+{
+    return A.fullPivLu().solve(g);
+}
+
+Eigen::VectorXd solveAugmented(const Eigen::SparseMatrix<double>& A, const Eigen::VectorXd& g)
+{
+    // A = J^T*J + mu*I is symmetric positive definite for mu > 0
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(A);
+    if (ldlt.info() != Eigen::Success) {
+        // a zero increment is rejected by the caller, which increases the damping
+        return Eigen::VectorXd::Zero(g.size());
+    }
+    return ldlt.solve(g);
+}
+
+// https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
+// https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
+Eigen::VectorXd
+gaussNewtonStep(const Eigen::MatrixXd& Jx, const Eigen::VectorXd& fx, DogLegGaussStep method)
+{
+    switch (method) {
+        case FullPivLU:
+            return Jx.fullPivLu().solve(-fx);
+        case LeastNormFullPivLU:
+            return Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
+        case LeastNormLdlt:
+            return Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
+    }
+    return Eigen::VectorXd::Zero(Jx.cols());
+}
+
+Eigen::VectorXd gaussNewtonStep(const Eigen::SparseMatrix<double>& Jx,
+                                const Eigen::VectorXd& fx,
+                                DogLegGaussStep method)
+{
+    // the least norm steps factorize J*J^T as sparse matrix, with a LU or a LDLT decomposition
+    // like their dense versions. FullPivLU gives a basic solution of J*h = -f, the sparse step
+    // takes the least norm solution from a LDLT decomposition of J*J^T instead, which is much
+    // cheaper than any sparse factorization of the rectangular J. J*J^T is singular if there are
+    // redundant constraints, then FullPivLU uses the basic solution of a rank revealing sparse QR
+    // of J, and the other steps are computed on the dense jacobian.
+    Eigen::VectorXd y;
+    switch (method) {
+        case FullPivLU: {
+            Eigen::SparseMatrix<double> JJt = Jx * Jx.transpose();
+            Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(JJt);
+            if (ldlt.info() == Eigen::Success) {
+                Eigen::VectorXd h_gn = Jx.transpose() * ldlt.solve(-fx);
+                // near singular pivots give a step that does not solve J*h = -f
+                if (h_gn.allFinite() && (Jx * h_gn + fx).norm() <= 1e-6 * (1.0 + fx.norm())) {
+                    return h_gn;
+                }
+            }
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> qr(Jx);
+            if (qr.info() == Eigen::Success) {
+                Eigen::VectorXd h_gn = qr.solve(-fx);
+                if (qr.info() == Eigen::Success && h_gn.allFinite()) {
+                    return h_gn;
+                }
+            }
+#endif
+            break;
+        }
+        case LeastNormFullPivLU: {
+            Eigen::SparseMatrix<double> JJt = Jx * Jx.transpose();
+            Eigen::SparseLU<Eigen::SparseMatrix<double>> lu(JJt);
+            if (lu.info() == Eigen::Success) {
+                y = lu.solve(-fx);
+            }
+            break;
+        }
+        case LeastNormLdlt: {
+            Eigen::SparseMatrix<double> JJt = Jx * Jx.transpose();
+            Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(JJt);
+            if (ldlt.info() == Eigen::Success) {
+                y = ldlt.solve(-fx);
+            }
+            break;
+        }
+    }
+    if (y.size() == fx.size()) {
+        Eigen::VectorXd h_gn = Jx.transpose() * y;
+        if (h_gn.allFinite()) {
+            return h_gn;
+        }
+    }
+    return gaussNewtonStep(Eigen::MatrixXd(Jx), fx, method);
+}
+
+template<typename JacobianMatrix>
+const char* jacobianName()
+{
+    return std::is_same<JacobianMatrix, Eigen::MatrixXd>::value ? "Dense" : "Sparse";
+}
+
+}  // namespace
+
+bool System::useSparseJacobian(SubSystem* subsys) const
+{
+    return sparseJacobianThreshold > 0 && subsys->pSize() >= sparseJacobianThreshold;
+}
+
 int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
+{
+    if (useSparseJacobian(subsys)) {
+        return solve_LM_impl<Eigen::SparseMatrix<double>>(subsys, isRedundantsolving);
+    }
+    return solve_LM_impl<Eigen::MatrixXd>(subsys, isRedundantsolving);
+}
+
+template<typename JacobianMatrix>
+int System::solve_LM_impl(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
     extractSubsystem(subsys, isRedundantsolving);
@@ -2173,8 +2364,8 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd e(csize),
         e_new(csize);  // vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);  // Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    JacobianMatrix J(csize, xsize);  // Jacobi of the subsystem
+    JacobianMatrix A(xsize, xsize);
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
 
     subsys->redirectParams();
@@ -2198,7 +2389,8 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         std::stringstream stream;
         stream << "LM: eps: " << eps << ", eps1: " << eps1 << ", tau: " << tau
                << ", convergence: " << (isRedundantsolving ? convergenceRedundant : convergence)
-               << ", xsize: " << xsize << ", maxIter: " << maxIterNumber << "\n";
+               << ", xsize: " << xsize << ", maxIter: " << maxIterNumber
+               << ", jacobian: " << jacobianName<JacobianMatrix>() << "\n";
 
         const std::string tmp = stream.str();
         Base::Console().Log(tmp.c_str());
@@ -2247,11 +2439,11 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         while (k < 50) {
             // augment normal equations A = A+uI
             for (int i = 0; i < xsize; ++i) {
-                A(i, i) += mu;
+                A.coeffRef(i, i) += mu;
             }
 
             // solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
+            h = solveAugmented(A, g);
             double rel_error = (A * h - g).norm() / g.norm();
 
             // check if solving works
@@ -2302,7 +2494,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
             mu *= nu;
             nu *= 2.0;
             for (int i = 0; i < xsize; ++i) {  // restore diagonal J^T J entries
-                A(i, i) = diag_A(i);
+                A.coeffRef(i, i) = diag_A(i);
             }
 
             k++;
@@ -2334,6 +2526,15 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
 
 int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
+{
+    if (useSparseJacobian(subsys)) {
+        return solve_DL_impl<Eigen::SparseMatrix<double>>(subsys, isRedundantsolving);
+    }
+    return solve_DL_impl<Eigen::MatrixXd>(subsys, isRedundantsolving);
+}
+
+template<typename JacobianMatrix>
+int System::solve_DL_impl(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
     extractSubsystem(subsys, isRedundantsolving);
@@ -2365,7 +2566,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
                        : (dogLegGaussStep == LeastNormFullPivLU ? "LeastNormFullPivLU"
                                                                 : "LeastNormLdlt"))
                << ", xsize: " << xsize << ", csize: " << csize << ", maxIter: " << maxIterNumber
-               << "\n";
+               << ", jacobian: " << jacobianName<JacobianMatrix>() << "\n";
 
         const std::string tmp = stream.str();
         Base::Console().Log(tmp.c_str());
@@ -2373,7 +2574,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    JacobianMatrix Jx(csize, xsize), Jx_new(csize, xsize);
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
     subsys->redirectParams();
@@ -2419,19 +2620,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
             h_sd = alpha * g;
 
             // get the gauss-newton step
-            // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
-            // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
-            switch (dogLegGaussStep) {
-                case FullPivLU:
-                    h_gn = Jx.fullPivLu().solve(-fx);
-                    break;
-                case LeastNormFullPivLU:
-                    h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
-                    break;
-                case LeastNormLdlt:
-                    h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
-                    break;
-            }
+            h_gn = gaussNewtonStep(Jx, fx, dogLegGaussStep);
 
             double rel_error = (Jx * h_gn + fx).norm() / fx.norm();
             if (rel_error > 1e15) {
@@ -5378,14 +5567,30 @@ void System::identifyDependentParametersDenseQR(const Eigen::MatrixXd& J,
                                                 const GCS::VEC_pD& pdiagnoselist,
                                                 bool silent)
 {
-    Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJ;
-    Eigen::MatrixXd Rparams;
+    identifyDependentParametersInBlocks(
+        J,
+        jacobianconstraintmap,
+        pdiagnoselist,
+        [this, silent](const Eigen::MatrixXd& Jblock,
+                       const std::map<int, int>& blockconstraintmap,
+                       const GCS::VEC_pD& blockdiagnoselist,
+                       std::vector<std::vector<double*>>& parameterGroups,
+                       VEC_pD& dependentParameters) {
+            Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJ;
+            Eigen::MatrixXd Rparams;
 
-    int rank;
+            int rank;
 
-    makeDenseQRDecomposition(J, jacobianconstraintmap, qrJ, rank, Rparams, false, true);
+            makeDenseQRDecomposition(Jblock, blockconstraintmap, qrJ, rank, Rparams, false, true);
 
-    identifyDependentParameters(qrJ, Rparams, rank, pdiagnoselist, silent);
+            identifyDependentParameters(qrJ,
+                                        Rparams,
+                                        rank,
+                                        blockdiagnoselist,
+                                        parameterGroups,
+                                        dependentParameters,
+                                        silent);
+        });
 }
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
@@ -5394,28 +5599,164 @@ void System::identifyDependentParametersSparseQR(const Eigen::MatrixXd& J,
                                                  const GCS::VEC_pD& pdiagnoselist,
                                                  bool silent)
 {
-    Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJ;
-    Eigen::MatrixXd Rparams;
+    identifyDependentParametersInBlocks(
+        J,
+        jacobianconstraintmap,
+        pdiagnoselist,
+        [this, silent](const Eigen::MatrixXd& Jblock,
+                       const std::map<int, int>& blockconstraintmap,
+                       const GCS::VEC_pD& blockdiagnoselist,
+                       std::vector<std::vector<double*>>& parameterGroups,
+                       VEC_pD& dependentParameters) {
+            Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJ;
+            Eigen::MatrixXd Rparams;
+
+            int nontransprank;
+
+            makeSparseQRDecomposition(Jblock,
+                                      blockconstraintmap,
+                                      SqrJ,
+                                      nontransprank,
+                                      Rparams,
+                                      false,
+                                      true);  // do not transpose allow to diagnose parameters
+
+            identifyDependentParameters(SqrJ,
+                                        Rparams,
+                                        nontransprank,
+                                        blockdiagnoselist,
+                                        parameterGroups,
+                                        dependentParameters,
+                                        silent);
+        });
+}
+#endif
+
+template<typename Identify>
+void System::identifyDependentParametersInBlocks(const Eigen::MatrixXd& J,
+                                                 const std::map<int, int>& jacobianconstraintmap,
+                                                 const GCS::VEC_pD& pdiagnoselist,
+                                                 Identify identify)
+{
+    // Only the top rows of the reduced jacobian correspond to driving constraints. The columns
+    // (parameters) are clustered by the rows having a non-zero entry for both of them, which
+    // makes J block diagonal up to a permutation. The dependent parameters of each block are
+    // independent of the rest of blocks.
+    int rows = std::min<int>(jacobianconstraintmap.size(), J.rows());
+    int cols = J.cols();
+
+    VEC_I parent(cols);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto findRoot = [&parent](int col) {
+        while (parent[col] != col) {
+            parent[col] = parent[parent[col]];
+            col = parent[col];
+        }
+        return col;
+    };
+
+    VEC_I rowRoot(rows, -1);
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            if (J(row, col) != 0.) {
+                if (rowRoot[row] < 0) {
+                    rowRoot[row] = findRoot(col);
+                }
+                else {
+                    parent[findRoot(col)] = findRoot(rowRoot[row]);
+                }
+            }
+        }
+    }
+
+    std::map<int, int> blockIndex;  // root column to block
+    VEC_I colBlock(cols);
+    for (int col = 0; col < cols; col++) {
+        colBlock[col] = blockIndex.emplace(findRoot(col), int(blockIndex.size())).first->second;
+    }
+
+    if (blockIndex.size() <= 1) {
+        pDependentParametersGroups.clear();
+        identify(J,
+                 jacobianconstraintmap,
+                 pdiagnoselist,
+                 pDependentParametersGroups,
+                 pDependentParameters);
+        return;
+    }
+
+    struct Block
+    {
+        VEC_I rows;
+        VEC_I cols;
+        std::vector<std::vector<double*>> parameterGroups;
+        VEC_pD dependentParameters;
+    };
+    std::vector<Block> blocks(blockIndex.size());
+    for (int col = 0; col < cols; col++) {
+        blocks[colBlock[col]].cols.push_back(col);
+    }
+    VEC_I fullRowIndex;  // index of the constraint of each row in the full size jacobian
+    for (const auto& entry : jacobianconstraintmap) {
+        fullRowIndex.push_back(entry.second);
+    }
+    for (int row = 0; row < rows; row++) {
+        // a row without any non-zero entry does not constrain any parameter
+        if (rowRoot[row] >= 0) {
+            blocks[colBlock[findRoot(rowRoot[row])]].rows.push_back(row);
+        }
+    }
 
-    int nontransprank;
+    runConcurrently(blocks.size(),
+                    std::size_t(cols) >= ParallelClustersMinParameters,
+                    [&](std::size_t i) {
+                        Block& block = blocks[i];
+                        if (block.rows.empty()) {
+                            // a parameter not constrained at all is dependent on its own
+                            for (int col : block.cols) {
+                                block.parameterGroups.push_back({pdiagnoselist[col]});
+                                block.dependentParameters.push_back(pdiagnoselist[col]);
+                            }
+                            return;
+                        }
 
-    makeSparseQRDecomposition(J,
-                              jacobianconstraintmap,
-                              SqrJ,
-                              nontransprank,
-                              Rparams,
-                              false,
-                              true);  // do not transpose allow to diagnose parameters
+                        Eigen::MatrixXd Jblock(block.rows.size(), block.cols.size());
+                        std::map<int, int> blockconstraintmap;
+                        GCS::VEC_pD blockdiagnoselist;
+                        for (int col : block.cols) {
+                            blockdiagnoselist.push_back(pdiagnoselist[col]);
+                        }
+                        for (int r = 0; r < int(block.rows.size()); r++) {
+                            blockconstraintmap[r] = fullRowIndex[block.rows[r]];
+                            for (int c = 0; c < int(block.cols.size()); c++) {
+                                Jblock(r, c) = J(block.rows[r], block.cols[c]);
+                            }
+                        }
+                        identify(Jblock,
+                                 blockconstraintmap,
+                                 blockdiagnoselist,
+                                 block.parameterGroups,
+                                 block.dependentParameters);
+                    });
 
-    identifyDependentParameters(SqrJ, Rparams, nontransprank, pdiagnoselist, silent);
+    pDependentParametersGroups.clear();
+    for (Block& block : blocks) {
+        pDependentParametersGroups.insert(pDependentParametersGroups.end(),
+                                          block.parameterGroups.begin(),
+                                          block.parameterGroups.end());
+        pDependentParameters.insert(pDependentParameters.end(),
+                                    block.dependentParameters.begin(),
+                                    block.dependentParameters.end());
+    }
 }
-#endif
 
 template<typename T>
 void System::identifyDependentParameters(T& qrJ,
                                          Eigen::MatrixXd& Rparams,
                                          int rank,
                                          const GCS::VEC_pD& pdiagnoselist,
+                                         std::vector<std::vector<double*>>& parameterGroups,
+                                         VEC_pD& dependentParameters,
                                          bool silent)
 {
     (void)silent;  // silent is only used in debug code, but it is important as Base::Console is not
@@ -5432,20 +5773,20 @@ void System::identifyDependentParameters(T& qrJ,
     }
 #endif
 
-    pDependentParametersGroups.resize(qrJ.cols() - rank);
+    parameterGroups.resize(qrJ.cols() - rank);
     for (int j = rank; j < qrJ.cols(); j++) {
         for (int row = 0; row < rank; row++) {
             if (fabs(Rparams(row, j)) > 1e-10) {
                 int origCol = qrJ.colsPermutation().indices()[row];
 
-                pDependentParametersGroups[j - rank].push_back(pdiagnoselist[origCol]);
-                pDependentParameters.push_back(pdiagnoselist[origCol]);
+                parameterGroups[j - rank].push_back(pdiagnoselist[origCol]);
+                dependentParameters.push_back(pdiagnoselist[origCol]);
             }
         }
         int origCol = qrJ.colsPermutation().indices()[j];
 
-        pDependentParametersGroups[j - rank].push_back(pdiagnoselist[origCol]);
-        pDependentParameters.push_back(pdiagnoselist[origCol]);
+        parameterGroups[j - rank].push_back(pdiagnoselist[origCol]);
+        dependentParameters.push_back(pdiagnoselist[origCol]);
     }
 
 #ifdef _GCS_DEBUG
@@ -5454,7 +5795,7 @@ void System::identifyDependentParameters(T& qrJ,
                                                     (Eigen::MatrixXd)qrJ.colsPermutation());
 
         SolverReportingManager::Manager().LogGroupOfParameters("ParameterGroups",
-                                                               pDependentParametersGroups);
+                                                               parameterGroups);
     }
 
 #endif
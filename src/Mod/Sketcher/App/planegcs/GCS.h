@@ -146,6 +146,12 @@ private:
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
+    // JacobianMatrix is either a dense Eigen::MatrixXd or an Eigen::SparseMatrix<double>
+    template<typename JacobianMatrix>
+    int solve_LM_impl(SubSystem* subsys, bool isRedundantsolving);
+    template<typename JacobianMatrix>
+    int solve_DL_impl(SubSystem* subsys, bool isRedundantsolving);
+    bool useSparseJacobian(SubSystem* subsys) const;
 
     void makeReducedJacobian(Eigen::MatrixXd& J,
                              std::map<int, int>& jacobianconstraintmap,
@@ -204,11 +210,21 @@ private:
                                             const GCS::VEC_pD& pdiagnoselist,
                                             bool silent = true);
 
+    // Splits the reduced jacobian into the blocks of the clusters of parameters that do not
+    // depend on each other and runs identify on each block concurrently
+    template<typename Identify>
+    void identifyDependentParametersInBlocks(const Eigen::MatrixXd& J,
+                                             const std::map<int, int>& jacobianconstraintmap,
+                                             const GCS::VEC_pD& pdiagnoselist,
+                                             Identify identify);
+
     template<typename T>
     void identifyDependentParameters(T& qrJ,
                                      Eigen::MatrixXd& Rparams,
                                      int rank,
                                      const GCS::VEC_pD& pdiagnoselist,
+                                     std::vector<std::vector<double*>>& parameterGroups,
+                                     VEC_pD& dependentParameters,
                                      bool silent = true);
 
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -224,6 +240,9 @@ public:
     double convergenceRedundant;
     QRAlgorithm qrAlgorithm;
     DogLegGaussStep dogLegGaussStep;
+    // LM and DogLeg work on a sparse jacobian for subsystems with at least this number of
+    // parameters, 0 to always use a dense jacobian
+    int sparseJacobianThreshold;
     double qrpivotThreshold;
     DebugMode debugMode;
     double LM_eps;
@@ -542,6 +561,9 @@ public:
     void declareUnknowns(VEC_pD& params);
     void declareDrivenParams(VEC_pD& params);
     void initSolution(Algorithm alg = DogLeg);
+    // takes the current parameter values as the starting point of the following solves while
+    // keeping the decomposition into subsystems computed by initSolution()
+    void updateReference();
 
     int solve(bool isFine = true, Algorithm alg = DogLeg, bool isRedundantsolving = false);
     int solve(VEC_pD& params,
@@ -276,6 +276,44 @@ void SubSystem::calcJacobi(Eigen::MatrixXd& jacobi)
     calcJacobi(plist, jacobi);
 }
 
+void SubSystem::calcJacobi(VEC_pD& params, Eigen::SparseMatrix<double>& jacobi)
+{
+    // columns of the redirected parameters, several original parameters may be
+    // reduced to the same one
+    std::map<double*, VEC_I> columns;
+    for (int j = 0; j < int(params.size()); j++) {
+        MAP_pD_pD::const_iterator pmapfind = pmap.find(params[j]);
+        if (pmapfind != pmap.end()) {
+            columns[pmapfind->second].push_back(j);
+        }
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < csize; i++) {
+        std::map<Constraint*, VEC_pD>::const_iterator c2pfind = c2p.find(clist[i]);
+        if (c2pfind == c2p.end()) {
+            continue;
+        }
+        for (double* param : c2pfind->second) {
+            std::map<double*, VEC_I>::const_iterator colfind = columns.find(param);
+            if (colfind != columns.end()) {
+                double value = clist[i]->grad(param);
+                for (int j : colfind->second) {
+                    triplets.emplace_back(i, j, value);
+                }
+            }
+        }
+    }
+
+    jacobi.resize(csize, int(params.size()));
+    jacobi.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+void SubSystem::calcJacobi(Eigen::SparseMatrix<double>& jacobi)
+{
+    calcJacobi(plist, jacobi);
+}
+
 void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
 {
     assert(grad.size() == int(params.size()));
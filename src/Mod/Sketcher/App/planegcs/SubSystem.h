@@ -27,6 +27,7 @@
 #undef max
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 #include "Constraints.h"
 
@@ -78,6 +79,9 @@ public:
     void calcResidual(Eigen::VectorXd& r, double& err);
     void calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi);
     void calcJacobi(Eigen::MatrixXd& jacobi);
+    // sparse variants, only the gradients of the parameters of each constraint are evaluated
+    void calcJacobi(VEC_pD& params, Eigen::SparseMatrix<double>& jacobi);
+    void calcJacobi(Eigen::SparseMatrix<double>& jacobi);
     void calcGrad(VEC_pD& params, Eigen::VectorXd& grad);
     void calcGrad(Eigen::VectorXd& grad);
 
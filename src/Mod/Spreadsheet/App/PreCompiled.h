@@ -45,6 +45,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 // boost
 #include <boost/algorithm/string/predicate.hpp>
@@ -55,6 +56,7 @@
 
 // Qt
 #include <QLocale>
+#include <QtConcurrentMap>
 
 #endif  //_PreComp_
 
@@ -1634,6 +1634,22 @@ const std::set<std::string>& PropertySheet::getDeps(CellAddress pos) const
     }
 }
 
+bool PropertySheet::hasExternalDeps(CellAddress pos) const
+{
+    auto i = cellToDocumentObjectMap.find(pos);
+    if (i == cellToDocumentObjectMap.end()) {
+        return false;
+    }
+
+    std::string ownerName = owner->getFullName();
+    for (const auto& name : i->second) {
+        if (name != ownerName) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void PropertySheet::recomputeDependencies(CellAddress key)
 {
     AtomicPropertyChange signaller(*this);
@@ -192,6 +192,9 @@ public:
 
     const std::set<std::string>& getDeps(App::CellAddress pos) const;
 
+    /// Whether the cell refers to other document objects than its sheet
+    bool hasExternalDeps(App::CellAddress pos) const;
+
     void recomputeDependencies(App::CellAddress key);
 
     PyObject* getPyObject() override;
@@ -24,9 +24,12 @@
 
 #ifndef _PreComp_
 #include <boost/tokenizer.hpp>
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <sstream>
+#include <vector>
+#include <QtConcurrentMap>
 #endif
 
 #include <App/Application.h>
@@ -771,48 +774,61 @@ void Sheet::updateProperty(CellAddress key)
             }
         }
 
-        /* Eval returns either NumberExpression or StringExpression, or
-         * PyObjectExpression objects */
-        auto number = freecad_dynamic_cast<NumberExpression>(output.get());
-        if (number) {
-            long l;
-            auto constant = freecad_dynamic_cast<ConstantExpression>(output.get());
-            if (constant && !constant->isNumber()) {
-                Base::PyGILStateLocker lock;
-                setObjectProperty(key, constant->getPyValue());
-            }
-            else if (!number->getUnit().isEmpty()) {
-                setQuantityProperty(key, number->getValue(), number->getUnit());
-            }
-            else if (number->isInteger(&l)) {
-                setIntegerProperty(key, l);
-            }
-            else {
-                setFloatProperty(key, number->getValue());
-            }
+        setComputedProperty(key, output.get());
+    }
+    else {
+        clear(key);
+    }
+
+    notifyCellUpdated(key);
+}
+
+/**
+ * Set the Property of cell \a key to the value \a output its expression evaluated to.
+ *
+ * @param key    The address of the cell.
+ * @param output The evaluated expression.
+ *
+ */
+
+void Sheet::setComputedProperty(CellAddress key, const Expression* output)
+{
+    /* Eval returns either NumberExpression or StringExpression, or
+     * PyObjectExpression objects */
+    auto number = freecad_dynamic_cast<NumberExpression>(output);
+    if (number) {
+        long l;
+        auto constant = freecad_dynamic_cast<ConstantExpression>(output);
+        if (constant && !constant->isNumber()) {
+            Base::PyGILStateLocker lock;
+            setObjectProperty(key, constant->getPyValue());
+        }
+        else if (!number->getUnit().isEmpty()) {
+            setQuantityProperty(key, number->getValue(), number->getUnit());
+        }
+        else if (number->isInteger(&l)) {
+            setIntegerProperty(key, l);
         }
         else {
-            auto str_expr = freecad_dynamic_cast<StringExpression>(output.get());
-            if (str_expr) {
-                setStringProperty(key, str_expr->getText().c_str());
+            setFloatProperty(key, number->getValue());
+        }
+    }
+    else {
+        auto str_expr = freecad_dynamic_cast<StringExpression>(output);
+        if (str_expr) {
+            setStringProperty(key, str_expr->getText().c_str());
+        }
+        else {
+            Base::PyGILStateLocker lock;
+            auto py_expr = freecad_dynamic_cast<PyObjectExpression>(output);
+            if (py_expr) {
+                setObjectProperty(key, py_expr->getPyValue());
             }
             else {
-                Base::PyGILStateLocker lock;
-                auto py_expr = freecad_dynamic_cast<PyObjectExpression>(output.get());
-                if (py_expr) {
-                    setObjectProperty(key, py_expr->getPyValue());
-                }
-                else {
-                    setObjectProperty(key, Py::Object());
-                }
+                setObjectProperty(key, Py::Object());
             }
         }
     }
-    else {
-        clear(key);
-    }
-
-    cellUpdated(key);
 }
 
 /**
@@ -916,7 +932,7 @@ void Sheet::recomputeCell(CellAddress p)
 
         // Mark as erroneous
         cellErrors.insert(p);
-        cellUpdated(p);
+        notifyCellUpdated(p);
 
         if (e.isDerivedFrom(Base::AbortException::getClassTypeId())) {
             throw;
@@ -924,6 +940,113 @@ void Sheet::recomputeCell(CellAddress p)
     }
 }
 
+/**
+ * @brief Recompute the cells of \a wave, which do not depend on each other.
+ *
+ * The expressions of cells that only refer to this sheet are first evaluated
+ * concurrently without Python, and their properties set one after another.
+ * All other cells, including those whose expressions need Python, are
+ * recomputed as usual.
+ *
+ * @param wave Addresses of the cells, in the order to recompute them.
+ */
+
+void Sheet::recomputeWave(const std::vector<CellAddress>& wave)
+{
+    struct Evaluation
+    {
+        CellAddress address;
+        const Expression* expression;
+        Expression::NumericValue value;
+        bool done = false;
+    };
+
+    std::vector<Evaluation> evaluations;
+    for (const auto& address : wave) {
+        Cell* cell = cells.getValue(address);
+        if (cell && cell->getExpression() && !cell->hasException()
+            && !cells.hasExternalDeps(address)) {
+            evaluations.push_back({address, cell->getExpression()});
+        }
+    }
+
+    if (evaluations.size() > 1) {
+        QtConcurrent::blockingMap(evaluations, [](Evaluation& evaluation) {
+            evaluation.done = evaluation.expression->getNumericValue(evaluation.value);
+        });
+    }
+
+    auto evaluation = evaluations.begin();
+    for (const auto& address : wave) {
+        FC_TRACE(address.toString());
+        if (evaluation != evaluations.end() && evaluation->address == address) {
+            bool done = evaluation->done;
+            std::unique_ptr<Expression> output;
+            if (done) {
+                output.reset(expressionFromNumeric(this, evaluation->value));
+            }
+            ++evaluation;
+            if (done) {
+                try {
+                    setComputedProperty(address, output.get());
+                    cells.clearDirty(address);
+                    cellErrors.erase(address);
+                    notifyCellUpdated(address);
+                    continue;
+                }
+                catch (const Base::Exception&) {
+                    // let recomputeCell() report the error
+                }
+            }
+        }
+        recomputeCell(address);
+    }
+}
+
+/**
+ * Signal that the cell at \a address was updated. While the sheet is
+ * recomputed, the signal is only sent by flushCellUpdates() when done.
+ */
+
+void Sheet::notifyCellUpdated(CellAddress address)
+{
+    if (deferCellUpdates) {
+        updatedCells.insert(address);
+    }
+    else {
+        cellUpdated(address);
+    }
+}
+
+/**
+ * Signal the cells updated during the recomputation, the range of all of them
+ * at once if there is more than one.
+ */
+
+void Sheet::flushCellUpdates()
+{
+    deferCellUpdates = false;
+    if (updatedCells.empty()) {
+        return;
+    }
+
+    std::set<CellAddress> updated;
+    updated.swap(updatedCells);
+    if (updated.size() == 1) {
+        cellUpdated(*updated.begin());
+        return;
+    }
+
+    // std::set is ordered by row first
+    int fromCol = updated.begin()->col();
+    int toCol = fromCol;
+    for (const auto& address : updated) {
+        fromCol = std::min(fromCol, address.col());
+        toCol = std::max(toCol, address.col());
+    }
+    rangeUpdated(Range(updated.begin()->row(), fromCol, updated.rbegin()->row(), toCol));
+}
+
 PropertySheet::BindingType Sheet::getCellBinding(Range& range,
                                                  ExpressionPtr* pStart,
                                                  ExpressionPtr* pEnd,
@@ -1022,6 +1145,21 @@ DocumentObjectExecReturn* Sheet::execute()
 {
     updateBindings();
 
+    // Signal the updated cells once when done
+    struct CellUpdates
+    {
+        explicit CellUpdates(Sheet* owner)
+            : sheet(owner)
+        {
+            sheet->deferCellUpdates = true;
+        }
+        ~CellUpdates()
+        {
+            sheet->flushCellUpdates();
+        }
+        Sheet* sheet;
+    } cellUpdates(this);
+
     // Get dirty cells that we have to recompute
     std::set<CellAddress> dirtyCells = cells.getDirty();
 
@@ -1060,17 +1198,33 @@ DocumentObjectExecReturn* Sheet::execute()
             add_edge(res.first->second, resDep.first->second, graph);
         }
     }
-    // Compute cells
+    // Compute cells, signalling the changes of their contents once
+    PropertySheet::AtomicPropertyChange signaller(cells, false);
     std::list<Vertex> make_order;
     // Sort graph topologically to find evaluation order
     try {
         boost::topological_sort(graph, std::front_inserter(make_order));
+        // Group the cells into waves, each only depending on cells of earlier waves
+        std::vector<int> levels(num_vertices(graph), 0);
+        std::vector<std::vector<CellAddress>> waves;
+        for (auto& pos : make_order) {
+            int level = levels[pos];
+            if (waves.size() <= static_cast<size_t>(level)) {
+                waves.resize(level + 1);
+            }
+            waves[level].push_back(VertexIndexList[pos]);
+
+            auto edges = out_edges(pos, graph);
+            for (auto it = edges.first; it != edges.second; ++it) {
+                auto& next = levels[target(*it, graph)];
+                next = std::max(next, level + 1);
+            }
+        }
+
         // Recompute cells
         FC_LOG("recomputing " << getFullName());
-        for (auto& pos : make_order) {
-            const auto& addr = VertexIndexList[pos];
-            FC_TRACE(addr.toString());
-            recomputeCell(addr);
+        for (const auto& wave : waves) {
+            recomputeWave(wave);
         }
     }
     catch (std::exception&) {
@@ -1080,7 +1234,7 @@ DocumentObjectExecReturn* Sheet::execute()
             if (cell) {
                 cellErrors.insert(v.first);
                 cell->setException("Pending computation due to cyclic dependency", true);
-                cellUpdated(v.first);
+                notifyCellUpdated(v.first);
             }
         }
 
@@ -1146,7 +1300,7 @@ DocumentObjectExecReturn* Sheet::execute()
                     Cell* cell = cells.getValue(v.first);
                     if (cell) {
                         cell->setException(msg.c_str(), true);
-                        cellUpdated(v.first);
+                        notifyCellUpdated(v.first);
                     }
                 }
             }
@@ -1171,6 +1325,8 @@ DocumentObjectExecReturn* Sheet::execute()
     rowHeights.clearDirty();
     columnWidths.clearDirty();
 
+    signaller.tryInvoke();
+
     if (cellErrors.empty()) {
         return DocumentObject::StdReturn;
     }
@@ -245,12 +245,20 @@ protected:
 
     void recomputeCell(App::CellAddress p);
 
+    void recomputeWave(const std::vector<App::CellAddress>& wave);
+
+    void notifyCellUpdated(App::CellAddress address);
+
+    void flushCellUpdates();
+
     App::Property* getProperty(App::CellAddress key) const;
 
     App::Property* getProperty(const char* addr) const;
 
     void updateProperty(App::CellAddress key);
 
+    void setComputedProperty(App::CellAddress key, const App::Expression* output);
+
     App::Property* setStringProperty(App::CellAddress key, const std::string& value);
 
     App::Property* setObjectProperty(App::CellAddress key, Py::Object obj);
@@ -292,6 +300,10 @@ protected:
     int currentRow = -1;
     int currentCol = -1;
 
+    /* Cells updated during a recomputation, signalled once it is done */
+    bool deferCellUpdates = false;
+    std::set<App::CellAddress> updatedCells;
+
     std::vector<App::Range> boundRanges;
 
     std::vector<App::Range> copyCutRanges;
@@ -1572,6 +1572,76 @@ class SpreadsheetCases(unittest.TestCase):
         self.assertLess(abs(sheet.F4.Value - -1.6971), 0.0001)
         self.assertEqual(sheet.F5, FreeCAD.Vector(1.72, 2.96, 4.2))
 
+    def testRecomputeWaves(self):
+        """A chain of dependent cells is recomputed wave by wave"""
+        sheet = self.doc.addObject("Spreadsheet::Sheet", "Spreadsheet")
+        sheet.set("A1", "1")
+        for row in range(2, 11):
+            sheet.set(f"A{row}", f"=A{row - 1} + 1")
+            # in the same wave as the cell in column A of the next row
+            sheet.set(f"B{row}", f"=A{row} * 2 mm")
+        self.doc.recompute()
+        for row in range(2, 11):
+            self.assertEqual(sheet.get(f"A{row}"), row)
+            self.assertEqual(sheet.get(f"B{row}"), Units.Quantity(f"{2 * row} mm"))
+
+        sheet.set("A1", "11")
+        self.doc.recompute()
+        self.assertEqual(sheet.A10, 20)
+        self.assertEqual(sheet.B10, Units.Quantity("40 mm"))
+
+    def testRecomputeWaveMixed(self):
+        """Cells evaluated with and without Python in the same wave"""
+        other = self.doc.addObject("Spreadsheet::Sheet", "Other")
+        other.set("A1", "5")
+        sheet = self.doc.addObject("Spreadsheet::Sheet", "Spreadsheet")
+        sheet.set("A1", "2")
+        sheet.set("B1", "=A1 * 3")
+        sheet.set("B2", "=str(A1)")
+        sheet.set("B3", "=Other.A1 + A1")
+        sheet.set("B4", "=vector(A1; 0; 0)")
+        sheet.set("B5", "=A1 / 4")
+        sheet.set("B6", "=A1 > 1")
+        self.doc.recompute()
+        self.assertEqual(sheet.B1, 6)
+        self.assertEqual(sheet.B2, "2")
+        self.assertEqual(sheet.B3, 7)
+        self.assertEqual(sheet.B4, FreeCAD.Vector(2, 0, 0))
+        self.assertEqual(sheet.B5, 0.5)
+        self.assertEqual(sheet.B6, True)
+
+        other.set("A1", "6")
+        sheet.set("A1", "3")
+        self.doc.recompute()
+        self.assertEqual(sheet.B1, 9)
+        self.assertEqual(sheet.B2, "3")
+        self.assertEqual(sheet.B3, 9)
+        self.assertEqual(sheet.B4, FreeCAD.Vector(3, 0, 0))
+        self.assertEqual(sheet.B5, 0.75)
+
+    def testRecomputeWaveErrors(self):
+        """Failing cells of a wave do not stop the other cells"""
+        sheet = self.doc.addObject("Spreadsheet::Sheet", "Spreadsheet")
+        sheet.set("A1", "0")
+        sheet.set("B1", "=1 / A1")
+        sheet.set("B2", "=A1 + 1")
+        sheet.set("B3", "=1 mm + A1 * 1 deg")
+        sheet.set("C1", "=B1 + 1")
+        self.doc.recompute()
+        self.assertTrue(sheet.B1.startswith("ERR: "))
+        self.assertEqual(sheet.B2, 1)
+        self.assertTrue(sheet.B3.startswith("ERR: "))
+        self.assertTrue(sheet.C1.startswith("ERR: "))
+
+        # the cells recover once the error is gone
+        sheet.set("A1", "2")
+        sheet.set("B3", "=1 mm + A1 * 1 mm")
+        self.doc.recompute()
+        self.assertEqual(sheet.B1, 0.5)
+        self.assertEqual(sheet.B2, 3)
+        self.assertEqual(sheet.B3, Units.Quantity("3 mm"))
+        self.assertEqual(sheet.C1, 1.5)
+
     def tearDown(self):
         # closing doc
         FreeCAD.closeDocument(self.doc.Name)
@@ -23,6 +23,8 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <chrono>
+# include <map>
 # include <BRep_Builder.hxx>
 # include <BRepBuilderAPI_Transform.hxx>
 # include <gp_Trsf.hxx>
@@ -36,11 +38,14 @@
 
 #include <boost_regex.hpp>
 
+#include <App/Document.h>
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectPy.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/FileInfo.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
+#include <Base/Stream.h>
 #include <Base/Vector3D.h>
 #include <Base/VectorPy.h>
 #include <Mod/Import/App/dxf/ImpExpDxf.h>
@@ -146,6 +151,10 @@ public:
         add_varargs_method("writeDXFPage", &Module::writeDXFPage,
             "writeDXFPage(page, filename): Exports a DrawPage to a DXF file."
         );
+        add_varargs_method("exportPages", &Module::exportPages,
+            "[dict] = exportPages([pages], directory, format='svg') -- Recompute the pages, running the hidden line removal of all views concurrently, and\n"
+            "write each page to directory as <page name>.svg or .dxf.  Works without the gui.  Returns the view count, ready time and write time of each page."
+        );
         add_varargs_method("findCentroid", &Module::findCentroid,
             "vector = findCentroid(shape, direction): finds geometric centroid of shape looking in direction."
         );
@@ -466,6 +475,68 @@ private:
         return dxfReturn;
     }
 
+    //! the edges of dvp as svg groups, in view coordinates
+    std::string viewPartSvg(TechDraw::DrawViewPart* dvp)
+    {
+        std::string grpHead1 = "<g fill=\"none\" stroke=\"#000000\" stroke-opacity=\"1\" stroke-width=\"";
+        std::string grpHead2 = "\" stroke-linecap=\"butt\" stroke-linejoin=\"miter\" stroke-miterlimit=\"4\">\n";
+        std::string grpTail  = "</g>\n";
+        TechDraw::SVGOutput svgOut;
+        std::stringstream ss;
+        TechDraw::GeometryObjectPtr gObj = dvp->getGeometryObject();
+        if (!gObj) {
+            return ss.str();
+        }
+        //visible group begin "<g ... >"
+        ss << grpHead1;
+//        double thick = dvp->LineWidth.getValue();
+        double thick = DrawUtil::getDefaultLineWeight("Thick");
+        ss << thick;
+        ss << grpHead2;
+        TopoDS_Shape shape = gObj->getVisHard();
+        ss << svgOut.exportEdges(shape);
+        shape = gObj->getVisOutline();
+        ss << svgOut.exportEdges(shape);
+        if (dvp->SmoothVisible.getValue()) {
+            shape = gObj->getVisSmooth();
+            ss << svgOut.exportEdges(shape);
+        }
+        if (dvp->SeamVisible.getValue()) {
+            shape = gObj->getVisSeam();
+            ss << svgOut.exportEdges(shape);
+        }
+        //visible group end "</g>"
+        ss << grpTail;
+
+        if ( dvp->HardHidden.getValue()  ||
+             dvp->SmoothHidden.getValue() ||
+             dvp->SeamHidden.getValue() ) {
+            //hidden group begin
+            ss << grpHead1;
+//            thick = dvp->HiddenWidth.getValue();
+            thick = DrawUtil::getDefaultLineWeight("Thin");
+            ss << thick;
+            ss << grpHead2;
+            if (dvp->HardHidden.getValue()) {
+                shape = gObj->getHidHard();
+                ss << svgOut.exportEdges(shape);
+                shape = gObj->getHidOutline();
+                ss << svgOut.exportEdges(shape);
+            }
+            if (dvp->SmoothHidden.getValue()) {
+                shape = gObj->getHidSmooth();
+                ss << svgOut.exportEdges(shape);
+            }
+            if (dvp->SeamHidden.getValue()) {
+                shape = gObj->getHidSeam();
+                ss << svgOut.exportEdges(shape);
+            }
+            ss << grpTail;
+            //hidden group end
+        }
+        return ss.str();
+    }
+
     Py::Object viewPartAsSvg(const Py::Tuple& args)
     {
         PyObject *viewObj(nullptr);
@@ -473,68 +544,12 @@ private:
             throw Py::TypeError("expected (DrawViewPart)");
         }
         Py::String svgReturn;
-        std::string grpHead1 = "<g fill=\"none\" stroke=\"#000000\" stroke-opacity=\"1\" stroke-width=\"";
-        std::string grpHead2 = "\" stroke-linecap=\"butt\" stroke-linejoin=\"miter\" stroke-miterlimit=\"4\">\n";
-        std::string grpTail  = "</g>\n";
         try {
-            App::DocumentObject* obj = nullptr;
-            TechDraw::DrawViewPart* dvp = nullptr;
-            TechDraw::SVGOutput svgOut;
-            std::string svgText;
-            std::stringstream ss;
             if (PyObject_TypeCheck(viewObj, &(TechDraw::DrawViewPartPy::Type))) {
-                obj = static_cast<App::DocumentObjectPy*>(viewObj)->getDocumentObjectPtr();
-                dvp = static_cast<TechDraw::DrawViewPart*>(obj);
-                TechDraw::GeometryObjectPtr gObj = dvp->getGeometryObject();
-                //visible group begin "<g ... >"
-                ss << grpHead1;
-//                double thick = dvp->LineWidth.getValue();
-                double thick = DrawUtil::getDefaultLineWeight("Thick");
-                ss << thick;
-                ss << grpHead2;
-                TopoDS_Shape shape = gObj->getVisHard();
-                ss << svgOut.exportEdges(shape);
-                shape = gObj->getVisOutline();
-                ss << svgOut.exportEdges(shape);
-                if (dvp->SmoothVisible.getValue()) {
-                    shape = gObj->getVisSmooth();
-                    ss << svgOut.exportEdges(shape);
-                }
-                if (dvp->SeamVisible.getValue()) {
-                    shape = gObj->getVisSeam();
-                    ss << svgOut.exportEdges(shape);
-                }
-                //visible group end "</g>"
-                ss << grpTail;
-
-                if ( dvp->HardHidden.getValue()  ||
-                     dvp->SmoothHidden.getValue() ||
-                     dvp->SeamHidden.getValue() ) {
-                    //hidden group begin
-                    ss << grpHead1;
-//                    thick = dvp->HiddenWidth.getValue();
-                    thick = DrawUtil::getDefaultLineWeight("Thin");
-                    ss << thick;
-                    ss << grpHead2;
-                    if (dvp->HardHidden.getValue()) {
-                        shape = gObj->getHidHard();
-                        ss << svgOut.exportEdges(shape);
-                        shape = gObj->getHidOutline();
-                        ss << svgOut.exportEdges(shape);
-                    }
-                    if (dvp->SmoothHidden.getValue()) {
-                        shape = gObj->getHidSmooth();
-                        ss << svgOut.exportEdges(shape);
-                    }
-                    if (dvp->SeamHidden.getValue()) {
-                        shape = gObj->getHidSeam();
-                        ss << svgOut.exportEdges(shape);
-                    }
-                    ss << grpTail;
-                    //hidden group end
-                }
+                App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(viewObj)->getDocumentObjectPtr();
+                TechDraw::DrawViewPart* dvp = static_cast<TechDraw::DrawViewPart*>(obj);
                 // ss now contains all edges as Svg
-                svgReturn = Py::String(ss.str());
+                svgReturn = Py::String(viewPartSvg(dvp));
            }
         }
         catch (Base::Exception &e) {
@@ -665,6 +680,131 @@ private:
         return Py::None();
     }
 
+    //! write the views, annotations and dimensions of dPage to a dxf file
+    void writePageDxf(TechDraw::DrawPage* dPage, const std::string& filePath)
+    {
+        std::string layerName = "none";
+        ImpExpDxfWrite writer(filePath);
+        writer.init();
+        if (dPage) {
+            auto views = dPage->getAllViews();
+            for (auto& view : views) {
+                if (view->isDerivedFrom(TechDraw::DrawViewPart::getClassTypeId())) {
+                    TechDraw::DrawViewPart* dvp = static_cast<TechDraw::DrawViewPart*>(view);
+                    layerName = dvp->getNameInDocument();
+                    writer.setLayerName(layerName);
+                    write1ViewDxf(writer, dvp, true);
+
+                } else if (view->isDerivedFrom(TechDraw::DrawViewAnnotation::getClassTypeId())) {
+                    TechDraw::DrawViewAnnotation* dva = static_cast<TechDraw::DrawViewAnnotation*>(view);
+                    layerName = dva->getNameInDocument();
+                    writer.setLayerName(layerName);
+                    double height = dva->TextSize.getValue();  //mm
+                    int just = 1;                              //centered
+                    Base::Vector3d loc(dva->X.getValue(), dva->Y.getValue(), 0.0);
+                    auto lines = dva->Text.getValues();
+                    writer.exportText(lines[0].c_str(), loc, loc, height, just);
+
+                } else if (view->isDerivedFrom(TechDraw::DrawViewDimension::getClassTypeId())) {
+                    DrawViewDimension* dvd = static_cast<TechDraw::DrawViewDimension*>(view);
+                    TechDraw::DrawViewPart* dvp = dvd->getViewPart();
+                    if (!dvp) {
+                        continue;
+                    }
+                    double grandParentX = 0.0;
+                    double grandParentY = 0.0;
+                    if (dvp->isDerivedFrom(TechDraw::DrawProjGroupItem::getClassTypeId())) {
+                        TechDraw::DrawProjGroupItem* dpgi = static_cast<TechDraw::DrawProjGroupItem*>(dvp);
+                        TechDraw::DrawProjGroup* dpg = dpgi->getPGroup();
+                        if (!dpg) {
+                            continue;
+                        }
+                        grandParentX = dpg->X.getValue();
+                        grandParentY = dpg->Y.getValue();
+                    }
+                    double parentX = dvp->X.getValue() + grandParentX;
+                    double parentY = dvp->Y.getValue() + grandParentY;
+                    Base::Vector3d parentPos(parentX, parentY, 0.0);
+                    std::string sDimText;
+                    //this is the same code as in QGIViewDimension::updateDim
+                    if (dvd->isMultiValueSchema()) {
+                        sDimText = dvd->getFormattedDimensionValue(0); //don't format multis
+                    } else {
+                        sDimText = dvd->getFormattedDimensionValue(1);
+                    }
+                    char* dimText = &sDimText[0u];                  //hack for const-ness
+                    float gap = 5.0;                                //hack. don't know font size here.
+                    layerName = dvd->getNameInDocument();
+                    writer.setLayerName(layerName);
+                    int type = 0;                                   //Aligned/Distance
+                    if ( dvd->Type.isValue("Distance")  ||
+                         dvd->Type.isValue("DistanceX") ||
+                         dvd->Type.isValue("DistanceY") )  {
+                        Base::Vector3d textLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
+                        Base::Vector3d lineLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
+                        pointPair pts = dvd->getLinearPoints();
+                        Base::Vector3d dimLine = pts.first() - pts.second();
+                        Base::Vector3d norm(-dimLine.y, dimLine.x, 0.0);
+                        norm.Normalize();
+                        lineLocn = lineLocn + (norm * gap);
+                        Base::Vector3d extLine1Start = Base::Vector3d(pts.first().x, - pts.first().y, 0.0) +
+                                                       Base::Vector3d(parentX, parentY, 0.0);
+                        Base::Vector3d extLine2Start = Base::Vector3d(pts.second().x, - pts.second().y, 0.0) +
+                                                       Base::Vector3d(parentX, parentY, 0.0);
+                        if (dvd->Type.isValue("DistanceX") ) {
+                            type = 1;
+                        } else if (dvd->Type.isValue("DistanceY") ) {
+                            type = 2;
+                        }
+                        writer.exportLinearDim(textLocn, lineLocn, extLine1Start, extLine2Start, dimText, type);
+                    } else if (dvd->Type.isValue("Angle")) {
+                        Base::Vector3d textLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
+                        Base::Vector3d lineLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
+                        anglePoints pts = dvd->getAnglePoints();
+                        Base::Vector3d end1 = pts.first();
+                        end1.y = -end1.y;
+                        Base::Vector3d end2 = pts.second();
+                        end2.y = -end2.y;
+
+                        Base::Vector3d apex = pts.vertex();
+                        apex.y = -apex.y;
+                        apex = apex + parentPos;
+
+                        Base::Vector3d dimLine = end2 - end1;
+                        Base::Vector3d norm(-dimLine.y, dimLine.x, 0.0);
+                        norm.Normalize();
+                        lineLocn = lineLocn + (norm * gap);
+                        end1 = end1 + parentPos;
+                        end2 = end2 + parentPos;
+                        writer.exportAngularDim(textLocn, lineLocn, end1, end2, apex, dimText);
+                    } else if (dvd->Type.isValue("Radius")) {
+                        Base::Vector3d textLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
+                        arcPoints pts = dvd->getArcPoints();
+                        pointPair arrowPts = dvd->getArrowPositions();
+                        Base::Vector3d center = pts.center;
+                        center.y = -center.y;
+                        center = center + parentPos;
+                        Base::Vector3d lineDir = (arrowPts.first() - arrowPts.second()).Normalize();
+                        Base::Vector3d arcPoint = center + lineDir * pts.radius;
+                        writer.exportRadialDim(center, textLocn, arcPoint, dimText);
+                    } else if(dvd->Type.isValue("Diameter")){
+                        Base::Vector3d textLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
+                        arcPoints pts = dvd->getArcPoints();
+                        pointPair arrowPts = dvd->getArrowPositions();
+                        Base::Vector3d center = pts.center;
+                        center.y = -center.y;
+                        center = center + parentPos;
+                        Base::Vector3d lineDir = (arrowPts.first() - arrowPts.second()).Normalize();
+                        Base::Vector3d end1 = center + lineDir * pts.radius;
+                        Base::Vector3d end2 = center - lineDir * pts.radius;
+                        writer.exportDiametricDim(textLocn, end1, end2, dimText);
+                    }
+               }
+            }
+        }
+        writer.endRun();
+    }
+
     Py::Object writeDXFPage(const Py::Tuple& args)
     {
         PyObject *pageObj(nullptr);
@@ -674,139 +814,172 @@ private:
         }
 
         std::string filePath = std::string(name);
-        std::string layerName = "none";
         PyMem_Free(name);
 
         try {
-            ImpExpDxfWrite writer(filePath);
-            writer.init();
-            App::DocumentObject* obj = nullptr;
             TechDraw::DrawPage* dPage = nullptr;
             if (PyObject_TypeCheck(pageObj, &(TechDraw::DrawPagePy::Type))) {
-                obj = static_cast<App::DocumentObjectPy*>(pageObj)->getDocumentObjectPtr();
+                App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(pageObj)->getDocumentObjectPtr();
                 dPage = static_cast<TechDraw::DrawPage*>(obj);
-                auto views = dPage->getAllViews();
-                for (auto& view : views) {
+            }
+            writePageDxf(dPage, filePath);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
+    //! write the views of dPage to an svg file.  The template is drawn by the gui and is not
+    //! part of the output.
+    void writePageSvg(TechDraw::DrawPage* dPage, const std::string& filePath)
+    {
+        Base::FileInfo fi(filePath);
+        Base::ofstream out(fi);
+        if (!out) {
+            throw Base::FileException("Cannot open file for writing", fi);
+        }
+        double width = dPage->getPageWidth();
+        double height = dPage->getPageHeight();
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\"" << width
+            << "mm\" height=\"" << height << "mm\" viewBox=\"0 0 " << width << " " << height << "\">\n";
+        for (auto& view : dPage->getAllViews()) {
+            if (!view->isDerivedFrom(TechDraw::DrawViewPart::getClassTypeId())) {
+                continue;
+            }
+            TechDraw::DrawViewPart* dvp = static_cast<TechDraw::DrawViewPart*>(view);
+            double x = dvp->X.getValue();
+            double y = dvp->Y.getValue();
+            if (dvp->isDerivedFrom(TechDraw::DrawProjGroupItem::getClassTypeId())) {
+                TechDraw::DrawProjGroup* dpg = static_cast<TechDraw::DrawProjGroupItem*>(dvp)->getPGroup();
+                if (dpg) {
+                    x += dpg->X.getValue();
+                    y += dpg->Y.getValue();
+                }
+            }
+            //page y runs up from the bottom edge, svg y runs down from the top
+            out << "<g id=\"" << dvp->getNameInDocument() << "\" transform=\"translate(" << x << ","
+                << height - y << ")\">\n" << viewPartSvg(dvp) << "</g>\n";
+        }
+        out << "</svg>\n";
+    }
+
+    Py::Object exportPages(const Py::Tuple& args)
+    {
+        PyObject *pageList(nullptr);
+        char* dirName(nullptr);
+        const char* formatName = "svg";
+        if (!PyArg_ParseTuple(args.ptr(), "Oet|s", &pageList, "utf-8", &dirName, &formatName)) {
+            throw Py::TypeError("expected ([pages], directory[, format])");
+        }
+        std::string directory(dirName);
+        PyMem_Free(dirName);
+        std::string format(formatName);
+        if (format != "svg" && format != "dxf") {
+            throw Py::ValueError("format must be 'svg' or 'dxf'");
+        }
+        if (!PySequence_Check(pageList)) {
+            throw Py::TypeError("expected a list of pages");
+        }
+
+        std::vector<TechDraw::DrawPage*> pages;
+        Py::Sequence list(pageList);
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+            PyObject* item = (*it).ptr();
+            if (!PyObject_TypeCheck(item, &(TechDraw::DrawPagePy::Type))) {
+                throw Py::TypeError("expected a list of pages");
+            }
+            App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(item)->getDocumentObjectPtr();
+            pages.push_back(static_cast<TechDraw::DrawPage*>(obj));
+        }
+
+        using Clock = std::chrono::steady_clock;
+        auto seconds = [](Clock::duration d) { return std::chrono::duration<double>(d).count(); };
+        auto start = Clock::now();
+
+        //recompute the views of all pages before waiting on any of them, so all their hlr
+        //threads run at the same time
+        //the views keep their previous override once exported, also if the export throws
+        struct KeepUpdatedRestorer
+        {
+            std::vector<std::pair<TechDraw::DrawView*, bool>> views;
+            ~KeepUpdatedRestorer()
+            {
+                //in reverse, so a view listed twice gets its value from before the first override
+                for (auto it = views.rbegin(); it != views.rend(); ++it) {
+                    it->first->overrideKeepUpdated(it->second);
+                }
+            }
+        } restorer;
+        auto& allViews = restorer.views;
+        std::map<App::Document*, std::vector<App::DocumentObject*>> docViews;
+        for (auto& page : pages) {
+            for (auto& view : page->getAllViews()) {
+                auto dv = dynamic_cast<TechDraw::DrawView*>(view);
+                if (!dv) {
+                    continue;
+                }
+                allViews.emplace_back(dv, dv->overrideKeepUpdated());
+                dv->overrideKeepUpdated(true);
+                dv->touch();
+                docViews[dv->getDocument()].push_back(dv);
+            }
+        }
+        Py::List result;
+        try {
+            for (auto& entry : docViews) {
+                entry.first->recompute(entry.second);
+            }
+
+            for (auto& page : pages) {
+                std::vector<TechDraw::DrawViewPart*> parts;
+                for (auto& view : page->getAllViews()) {
                     if (view->isDerivedFrom(TechDraw::DrawViewPart::getClassTypeId())) {
-                        TechDraw::DrawViewPart* dvp = static_cast<TechDraw::DrawViewPart*>(view);
-                        layerName = dvp->getNameInDocument();
-                        writer.setLayerName(layerName);
-                        write1ViewDxf(writer, dvp, true);
-
-                    } else if (view->isDerivedFrom(TechDraw::DrawViewAnnotation::getClassTypeId())) {
-                        TechDraw::DrawViewAnnotation* dva = static_cast<TechDraw::DrawViewAnnotation*>(view);
-                        layerName = dva->getNameInDocument();
-                        writer.setLayerName(layerName);
-                        double height = dva->TextSize.getValue();  //mm
-                        int just = 1;                              //centered
-                        Base::Vector3d loc(dva->X.getValue(), dva->Y.getValue(), 0.0);
-                        auto lines = dva->Text.getValues();
-                        writer.exportText(lines[0].c_str(), loc, loc, height, just);
-
-                    } else if (view->isDerivedFrom(TechDraw::DrawViewDimension::getClassTypeId())) {
-                        DrawViewDimension* dvd = static_cast<TechDraw::DrawViewDimension*>(view);
-                        TechDraw::DrawViewPart* dvp = dvd->getViewPart();
-                        if (!dvp) {
-                            continue;
-                        }
-                        double grandParentX = 0.0;
-                        double grandParentY = 0.0;
-                        if (dvp->isDerivedFrom(TechDraw::DrawProjGroupItem::getClassTypeId())) {
-                            TechDraw::DrawProjGroupItem* dpgi = static_cast<TechDraw::DrawProjGroupItem*>(dvp);
-                            TechDraw::DrawProjGroup* dpg = dpgi->getPGroup();
-                            if (!dpg) {
-                                continue;
-                            }
-                            grandParentX = dpg->X.getValue();
-                            grandParentY = dpg->Y.getValue();
-                        }
-                        double parentX = dvp->X.getValue() + grandParentX;
-                        double parentY = dvp->Y.getValue() + grandParentY;
-                        Base::Vector3d parentPos(parentX, parentY, 0.0);
-                        std::string sDimText;
-                        //this is the same code as in QGIViewDimension::updateDim
-                        if (dvd->isMultiValueSchema()) {
-                            sDimText = dvd->getFormattedDimensionValue(0); //don't format multis
-                        } else {
-                            sDimText = dvd->getFormattedDimensionValue(1);
-                        }
-                        char* dimText = &sDimText[0u];                  //hack for const-ness
-                        float gap = 5.0;                                //hack. don't know font size here.
-                        layerName = dvd->getNameInDocument();
-                        writer.setLayerName(layerName);
-                        int type = 0;                                   //Aligned/Distance
-                        if ( dvd->Type.isValue("Distance")  ||
-                             dvd->Type.isValue("DistanceX") ||
-                             dvd->Type.isValue("DistanceY") )  {
-                            Base::Vector3d textLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
-                            Base::Vector3d lineLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
-                            pointPair pts = dvd->getLinearPoints();
-                            Base::Vector3d dimLine = pts.first() - pts.second();
-                            Base::Vector3d norm(-dimLine.y, dimLine.x, 0.0);
-                            norm.Normalize();
-                            lineLocn = lineLocn + (norm * gap);
-                            Base::Vector3d extLine1Start = Base::Vector3d(pts.first().x, - pts.first().y, 0.0) +
-                                                           Base::Vector3d(parentX, parentY, 0.0);
-                            Base::Vector3d extLine2Start = Base::Vector3d(pts.second().x, - pts.second().y, 0.0) +
-                                                           Base::Vector3d(parentX, parentY, 0.0);
-                            if (dvd->Type.isValue("DistanceX") ) {
-                                type = 1;
-                            } else if (dvd->Type.isValue("DistanceY") ) {
-                                type = 2;
-                            }
-                            writer.exportLinearDim(textLocn, lineLocn, extLine1Start, extLine2Start, dimText, type);
-                        } else if (dvd->Type.isValue("Angle")) {
-                            Base::Vector3d textLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
-                            Base::Vector3d lineLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
-                            anglePoints pts = dvd->getAnglePoints();
-                            Base::Vector3d end1 = pts.first();
-                            end1.y = -end1.y;
-                            Base::Vector3d end2 = pts.second();
-                            end2.y = -end2.y;
-
-                            Base::Vector3d apex = pts.vertex();
-                            apex.y = -apex.y;
-                            apex = apex + parentPos;
-
-                            Base::Vector3d dimLine = end2 - end1;
-                            Base::Vector3d norm(-dimLine.y, dimLine.x, 0.0);
-                            norm.Normalize();
-                            lineLocn = lineLocn + (norm * gap);
-                            end1 = end1 + parentPos;
-                            end2 = end2 + parentPos;
-                            writer.exportAngularDim(textLocn, lineLocn, end1, end2, apex, dimText);
-                        } else if (dvd->Type.isValue("Radius")) {
-                            Base::Vector3d textLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
-                            arcPoints pts = dvd->getArcPoints();
-                            pointPair arrowPts = dvd->getArrowPositions();
-                            Base::Vector3d center = pts.center;
-                            center.y = -center.y;
-                            center = center + parentPos;
-                            Base::Vector3d lineDir = (arrowPts.first() - arrowPts.second()).Normalize();
-                            Base::Vector3d arcPoint = center + lineDir * pts.radius;
-                            writer.exportRadialDim(center, textLocn, arcPoint, dimText);
-                        } else if(dvd->Type.isValue("Diameter")){
-                            Base::Vector3d textLocn(dvd->X.getValue() + parentX, dvd->Y.getValue() + parentY, 0.0);
-                            arcPoints pts = dvd->getArcPoints();
-                            pointPair arrowPts = dvd->getArrowPositions();
-                            Base::Vector3d center = pts.center;
-                            center.y = -center.y;
-                            center = center + parentPos;
-                            Base::Vector3d lineDir = (arrowPts.first() - arrowPts.second()).Normalize();
-                            Base::Vector3d end1 = center + lineDir * pts.radius;
-                            Base::Vector3d end2 = center - lineDir * pts.radius;
-                            writer.exportDiametricDim(textLocn, end1, end2, dimText);
+                        parts.push_back(static_cast<TechDraw::DrawViewPart*>(view));
+                    }
+                }
+                //finishing one step (e.g. a section cut) can start the next (hlr), so repeat
+                //until no view has anything pending
+                bool pending = true;
+                while (pending) {
+                    pending = false;
+                    for (auto& dvp : parts) {
+                        if (dvp->finishPendingTasks()) {
+                            pending = true;
                         }
-                   }
+                    }
                 }
+                double readyTime = seconds(Clock::now() - start);
+
+                auto writeStart = Clock::now();
+                std::string filePath = directory + "/" + page->getNameInDocument() + "." + format;
+                if (format == "dxf") {
+                    writePageDxf(page, filePath);
+                }
+                else {
+                    writePageSvg(page, filePath);
+                }
+                double writeTime = seconds(Clock::now() - writeStart);
+
+                Base::Console().Log("TechDraw.exportPages - %s - %d views ready after %.3fs, written in %.3fs\n",
+                                    page->getNameInDocument(), static_cast<int>(parts.size()),
+                                    readyTime, writeTime);
+                Py::Dict info;
+                info.setItem("Page", Py::String(page->getNameInDocument()));
+                info.setItem("File", Py::String(filePath));
+                info.setItem("Views", Py::Long(static_cast<long>(parts.size())));
+                info.setItem("ReadyTime", Py::Float(readyTime));
+                info.setItem("WriteTime", Py::Float(writeTime));
+                result.append(info);
             }
-            writer.endRun();
         }
         catch (const Base::Exception& e) {
             throw Py::RuntimeError(e.what());
         }
 
-        return Py::None();
+        return result;
     }
 
     Py::Object findCentroid(const Py::Tuple& args)
@@ -319,6 +319,15 @@ void DrawComplexSection::onSectionCutFinished()
     QObject::disconnect(connectAlignWatcher);
 }
 
+bool DrawComplexSection::finishPendingTasks()
+{
+    //onSectionCutFinished only continues once both the cut and the align threads are done
+    if (connectAlignWatcher) {
+        m_alignFuture.waitForFinished();
+    }
+    return DrawViewSection::finishPendingTasks();
+}
+
 //for Aligned strategy, cut the rawShape by each segment of the tool
 //TODO: this process should replace the "makeSectionCut" from DVS
 void DrawComplexSection::makeAlignedPieces(const TopoDS_Shape& rawShape)
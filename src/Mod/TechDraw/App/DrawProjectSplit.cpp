@@ -26,7 +26,9 @@
 # include <algorithm>
 # include <limits>
 # include <sstream>
+#include <Bnd_BoundSortBox.hxx>
 #include <Bnd_Box.hxx>
+#include <Bnd_HArray1OfBox.hxx>
 #include <BRep_Tool.hxx>
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepAlgoAPI_Common.hxx>
@@ -37,6 +39,8 @@
 #include <BRepLProp_CurveTool.hxx>
 #include <Geom_Curve.hxx>
 #include <GeomLib_Tool.hxx>
+#include <TColStd_ListIteratorOfListOfInteger.hxx>
+#include <TColStd_ListOfInteger.hxx>
 #include <gp_Ax2.hxx>
 #include <gp_Pnt.hxx>
 #include <TopExp.hxx>
@@ -592,13 +596,40 @@ std::vector<TopoDS_Edge> DrawProjectSplit::removeOverlapEdges(const std::vector<
     std::vector<TopoDS_Edge> overlapEdges;
     std::vector<bool> skipThisEdge(inEdges.size(), false);
     int edgeCount = inEdges.size();
+
+    //only edges with intersecting boxes can overlap (see isSubset), so index the boxes once
+    //instead of testing every pair of edges
+    Handle(Bnd_HArray1OfBox) edgeBoxes = new Bnd_HArray1OfBox(1, std::max(1, edgeCount));
+    Bnd_Box allBoxes;
+    for (int i = 0; i < edgeCount; i++) {
+        Bnd_Box box;
+        BRepBndLib::Add(inEdges.at(i), box);
+        box.SetGap(0.1);           //same as boxesIntersect
+        edgeBoxes->SetValue(i + 1, box);
+        allBoxes.Add(box);
+    }
+    Bnd_BoundSortBox boxIndex;
+    if (!allBoxes.IsVoid()) {
+        boxIndex.Initialize(allBoxes, edgeBoxes);
+    }
+
     int ie0 = 0;
     for (; ie0 < edgeCount; ie0++) {
-        if (skipThisEdge.at(ie0)) {
+        if (skipThisEdge.at(ie0) || edgeBoxes->Value(ie0 + 1).IsVoid()) {
             continue;
         }
-        int ie1 = ie0 + 1;
-        for (; ie1 < edgeCount; ie1++) {
+        //the later edges whose box touches the box of ie0, in order
+        std::vector<int> candidates;
+        const TColStd_ListOfInteger& hits = boxIndex.Compare(edgeBoxes->Value(ie0 + 1));
+        for (TColStd_ListIteratorOfListOfInteger it(hits); it.More(); it.Next()) {
+            if (it.Value() - 1 > ie0) {
+                candidates.push_back(it.Value() - 1);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        for (int ie1 : candidates) {
             if (skipThisEdge.at(ie1)) {
                 continue;
             }
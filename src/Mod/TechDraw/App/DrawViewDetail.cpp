@@ -408,6 +408,17 @@ void DrawViewDetail::onMakeDetailFinished(void)
     m_tempGeometryObject = buildGeometryObject(m_scaledShape, m_viewAxis);
 }
 
+bool DrawViewDetail::finishPendingTasks()
+{
+    bool finished = false;
+    if (waitingForDetail()) {
+        m_detailFuture.waitForFinished();
+        onMakeDetailFinished();
+        finished = true;
+    }
+    return DrawViewPart::finishPendingTasks() || finished;
+}
+
 bool DrawViewDetail::waitingForResult() const
 {
     if (DrawViewPart::waitingForResult() || waitingForDetail()) {
@@ -37,6 +37,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
 #include <BRepAlgo_NormalProjection.hxx>
 #include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_Copy.hxx>
@@ -46,10 +47,14 @@
 #include <BRepTools.hxx>
 #include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
+#include <Bnd_BoundSortBox.hxx>
 #include <Bnd_Box.hxx>
+#include <Bnd_HArray1OfBox.hxx>
 #include <HLRAlgo_Projector.hxx>
 #include <QtConcurrentRun>
 #include <ShapeAnalysis.hxx>
+#include <TColStd_ListIteratorOfListOfInteger.hxx>
+#include <TColStd_ListOfInteger.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
@@ -62,6 +67,7 @@
 #include <gp_Dir.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_XYZ.hxx>
 #include <sstream>
 #endif
 
@@ -247,11 +253,45 @@ App::DocumentObjectExecReturn* DrawViewPart::execute()
         XDirection.purgeTouched();//don't trigger updates!
     }
 
+    //if neither the source geometry nor the projection changed, the current geometry is still
+    //valid and HLR, face finding and the dependent views don't need to be redone.
+    std::vector<double> parameters = geometryParameters();
+    if (hasGeometry() && parameters == m_geometryParameters
+        && ShapeUtils::isSameShape(shape, m_geometrySource) && !CosmeticVertexes.isTouched()
+        && !CosmeticEdges.isTouched() && !CenterLines.isTouched()) {
+        return DrawView::execute();
+    }
+    m_geometrySource = shape;
+    m_geometryParameters = parameters;
+
     partExec(shape);
 
     return DrawView::execute();
 }
 
+//! the projection parameters that go into the geometry of this view, besides the source shape
+std::vector<double> DrawViewPart::geometryParameters() const
+{
+    std::vector<double> parameters;
+    gp_Ax2 cs = getProjectionCS();
+    for (const gp_XYZ& xyz : {cs.Location().XYZ(), cs.Direction().XYZ(), cs.XDirection().XYZ()}) {
+        parameters.push_back(xyz.X());
+        parameters.push_back(xyz.Y());
+        parameters.push_back(xyz.Z());
+    }
+    parameters.push_back(getScale());
+    parameters.push_back(Rotation.getValue());
+    parameters.push_back(Focus.getValue());
+    parameters.push_back(IsoCount.getValue());
+    parameters.push_back(ScrubCount.getValue());
+    for (bool flag : {Perspective.getValue(), CoarseView.getValue(), SmoothVisible.getValue(),
+                      SeamVisible.getValue(), IsoVisible.getValue(), HardHidden.getValue(),
+                      SmoothHidden.getValue(), SeamHidden.getValue(), IsoHidden.getValue()}) {
+        parameters.push_back(flag ? 1.0 : 0.0);
+    }
+    return parameters;
+}
+
 short DrawViewPart::mustExecute() const
 {
     if (isRestoring()) {
@@ -598,44 +638,58 @@ void DrawViewPart::findFacesOld(const std::vector<BaseGeomPtr> &goEdges)
     }
 
     //HLR algo does not provide all edge intersections for edge endpoints.
-    //need to split long edges touched by Vertex of another edge
+    //need to split long edges touched by Vertex of another edge.
+    //only the edges whose box contains a vertex can have that vertex on them, so the boxes are
+    //indexed once instead of comparing every pair of edges.
+    Handle(Bnd_HArray1OfBox) edgeBoxes = new Bnd_HArray1OfBox(1, std::max(1, (int)nonZero.size()));
+    Bnd_Box allBoxes;
+    for (size_t i = 0; i < nonZero.size(); i++) {
+        Bnd_Box sEdge;
+        BRepBndLib::AddOptimal(nonZero[i], sEdge);
+        sEdge.SetGap(0.1);
+        edgeBoxes->SetValue(i + 1, sEdge);
+        allBoxes.Add(sEdge);
+    }
+    Bnd_BoundSortBox boxIndex;
+    if (!allBoxes.IsVoid()) {
+        boxIndex.Initialize(allBoxes, edgeBoxes);
+    }
+
     std::vector<splitPoint> splits;
     std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
     int iOuter = 0;
     for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {//*** itOuter != nonZero.end() - 1
         TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
         TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::AddOptimal(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
+        if (edgeBoxes->Value(iOuter + 1).IsVoid()) {
             continue;
         }
         if (DrawUtil::isZeroEdge(*itOuter)) {
             continue;                   //skip zero length edges. shouldn't happen ;)
         }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();//***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner, iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;//skip zero length edges. shouldn't happen ;)
+
+        //the edges with a box around either end of this edge, in the order of nonZero
+        std::vector<int> candidates;
+        for (auto& v : {v1, v2}) {
+            const TColStd_ListOfInteger& hits = boxIndex.Compare(BRep_Tool::Pnt(v));
+            for (TColStd_ListIteratorOfListOfInteger it(hits); it.More(); it.Next()) {
+                candidates.push_back(it.Value() - 1);
             }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
 
-            Bnd_Box sInner;
-            BRepBndLib::AddOptimal(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
+        for (int iInner : candidates) {
+            if (iInner == iOuter) {
                 continue;
             }
-            if (sOuter.IsOut(sInner)) {//bboxes of edges don't intersect, don't bother
-                continue;
+            const TopoDS_Edge& inner = nonZero[iInner];
+            if (DrawUtil::isZeroEdge(inner)) {
+                continue;//skip zero length edges. shouldn't happen ;)
             }
 
             double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner), v1, param, false)) {
+            if (DrawProjectSplit::isOnEdge(inner, v1, param, false)) {
                 gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
                 splitPoint s1;
                 s1.i = iInner;
@@ -643,7 +697,7 @@ void DrawViewPart::findFacesOld(const std::vector<BaseGeomPtr> &goEdges)
                 s1.param = param;
                 splits.push_back(s1);
             }
-            if (DrawProjectSplit::isOnEdge((*itInner), v2, param, false)) {
+            if (DrawProjectSplit::isOnEdge(inner, v2, param, false)) {
                 gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
                 splitPoint s2;
                 s2.i = iInner;
@@ -1034,6 +1088,25 @@ bool DrawViewPart::waitingForResult() const
     return false;
 }
 
+//! wait for the hlr and face finding threads and run their completion handlers directly.
+//! The watcher signals are only delivered by a running Qt event loop, which does not exist
+//! when there is no gui (batch export).  Returns true if anything was pending.
+bool DrawViewPart::finishPendingTasks()
+{
+    bool finished = false;
+    if (waitingForHlr()) {
+        m_hlrFuture.waitForFinished();
+        onHlrFinished();
+        finished = true;
+    }
+    if (waitingForFaces()) {
+        m_faceFuture.waitForFinished();
+        onFacesFinished();
+        finished = true;
+    }
+    return finished;
+}
+
 bool DrawViewPart::hasGeometry() const
 {
     if (!geometryObject) {
@@ -211,6 +211,7 @@ public:
     bool waitingForHlr() const { return m_waitingForHlr; }
     void waitingForHlr(bool s) { m_waitingForHlr = s; }
     virtual bool waitingForResult() const;
+    virtual bool finishPendingTasks();
     void progressValueChanged(int v);
 
 public Q_SLOTS:
@@ -219,6 +220,7 @@ public Q_SLOTS:
 
 protected:
     bool checkXDirection() const;
+    std::vector<double> geometryParameters() const;
 
     TechDraw::GeometryObjectPtr geometryObject;
     TechDraw::GeometryObjectPtr m_tempGeometryObject;//holds the new GO until hlr is completed
@@ -250,6 +252,8 @@ private:
     bool nowUnsetting;
     bool m_waitingForFaces;
     bool m_waitingForHlr;
+    TopoDS_Shape m_geometrySource;//source shape of the current geometry
+    std::vector<double> m_geometryParameters;//projection parameters of the current geometry
 
     QMetaObject::Connection connectHlrWatcher;
     QFutureWatcher<void> m_hlrWatcher;
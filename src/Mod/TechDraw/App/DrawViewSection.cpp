@@ -692,6 +692,19 @@ void DrawViewSection::postSectionCutTasks()
     }
 }
 
+//! the cut thread clears waitingForCut before its watcher fires, so the connection tells us if
+//! onSectionCutFinished is still due
+bool DrawViewSection::finishPendingTasks()
+{
+    bool finished = false;
+    if (connectCutWatcher) {
+        m_cutFuture.waitForFinished();
+        onSectionCutFinished();
+        finished = true;
+    }
+    return DrawViewPart::finishPendingTasks() || finished;
+}
+
 bool DrawViewSection::waitingForResult() const
 {
     if (DrawViewPart::waitingForResult() || waitingForCut()) {
@@ -126,6 +126,7 @@ public:
     void waitingForCut(bool s) { m_waitingForCut = s; }
     bool waitingForCut(void) const { return m_waitingForCut; }
     bool waitingForResult() const override;
+    bool finishPendingTasks() override;
 
     virtual TopoDS_Shape makeCuttingTool(double shapeSize);
     virtual TopoDS_Shape getShapeToCut();
@@ -28,7 +28,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <cmath>
+# include <map>
 # include <sstream>
 # include <BRep_Tool.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
@@ -49,6 +51,56 @@
 using namespace TechDraw;
 using namespace boost;
 
+namespace
+{
+//! buckets points on a grid in the XY plane, so the points near a location can be found
+//! without comparing against every point.  Points closer than cellSize to the location are
+//! always among the candidates.
+class PointGrid
+{
+public:
+    explicit PointGrid(double cellSize) : m_cellSize(cellSize) {}
+
+    void add(const Base::Vector3d& point, std::size_t index)
+    {
+        m_cells[cellOf(point)].push_back(index);
+    }
+
+    //! indices of the points in the cells around point, in ascending order
+    std::vector<std::size_t> candidates(const Base::Vector3d& point) const
+    {
+        std::vector<std::size_t> result;
+        Cell center = cellOf(point);
+        for (long long ix = center.first - 1; ix <= center.first + 1; ix++) {
+            for (long long iy = center.second - 1; iy <= center.second + 1; iy++) {
+                auto it = m_cells.find(Cell(ix, iy));
+                if (it != m_cells.end()) {
+                    result.insert(result.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+private:
+    using Cell = std::pair<long long, long long>;
+
+    Cell cellOf(const Base::Vector3d& point) const
+    {
+        return Cell(static_cast<long long>(std::floor(point.x / m_cellSize)),
+                    static_cast<long long>(std::floor(point.y / m_cellSize)));
+    }
+
+    double m_cellSize;
+    std::map<Cell, std::vector<std::size_t>> m_cells;
+};
+
+// DrawUtil::vertexEqual treats points up to 2 * EWTOLERANCE apart in x and y as equal
+constexpr double gridCellSize = 2.0 * EWTOLERANCE;
+}// namespace
+
 //*******************************************************
 //* edgeVisior methods
 //*******************************************************
@@ -270,26 +322,32 @@ std::vector<TopoDS_Vertex> EdgeWalker:: makeUniqueVList(std::vector<TopoDS_Edge>
 {
 //    Base::Console().Message("TRACE - EW::makeUniqueVList() - edgesIn: %d\n", edges.size());
     std::vector<TopoDS_Vertex> uniqueVert;
+    std::vector<Base::Vector3d> uniquePoints;
+    PointGrid grid(gridCellSize);
+    auto isKnown = [&](const Base::Vector3d& point) {
+        for (std::size_t i : grid.candidates(point)) {
+            if (uniquePoints[i].IsEqual(point, EWTOLERANCE)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    auto addVert = [&](const TopoDS_Vertex& vert, const Base::Vector3d& point) {
+        grid.add(point, uniqueVert.size());
+        uniqueVert.push_back(vert);
+        uniquePoints.push_back(point);
+    };
     for(auto& e:edges) {
         Base::Vector3d v1 = DrawUtil::vertex2Vector(TopExp::FirstVertex(e));
         Base::Vector3d v2 = DrawUtil::vertex2Vector(TopExp::LastVertex(e));
-        bool addv1 = true;
-        bool addv2 = true;
         //check if we've already added this vertex
-        for (const auto& v: uniqueVert) {
-            Base::Vector3d v3d = DrawUtil::vertex2Vector(v);
-            if (v3d.IsEqual(v1, EWTOLERANCE)) {
-                addv1 = false;
-            }
-            if (v3d.IsEqual(v2, EWTOLERANCE)) {
-                addv2 = false;
-            }
-        }
+        bool addv1 = !isKnown(v1);
+        bool addv2 = !isKnown(v2);
         if (addv1) {
-            uniqueVert.push_back(TopExp::FirstVertex(e));
+            addVert(TopExp::FirstVertex(e), v1);
         }
         if (addv2) {
-            uniqueVert.push_back(TopExp::LastVertex(e));
+            addVert(TopExp::LastVertex(e), v2);
         }
     }
 //    Base::Console().Message("EW::makeUniqueVList - verts out: %d\n", uniqueVert.size());
@@ -302,15 +360,33 @@ std::vector<WalkerEdge> EdgeWalker::makeWalkerEdges(std::vector<TopoDS_Edge> edg
 {
 //    Base::Console().Message("TRACE - EW::makeWalkerEdges() - edges: %d  verts: %d\n", edges.size(), verts.size());
     m_saveInEdges = edges;
+
+    std::vector<Base::Vector3d> points;
+    PointGrid grid(gridCellSize);
+    for (auto& v : verts) {
+        points.push_back(DrawUtil::vertex2Vector(v));
+        grid.add(points.back(), points.size() - 1);
+    }
+    //same result as findUniqueVert, the lowest index of an equal vertex
+    auto findVert = [&](const TopoDS_Vertex& vx) {
+        Base::Vector3d vx3d = DrawUtil::vertex2Vector(vx);
+        for (std::size_t i : grid.candidates(vx3d)) {
+            if (vx3d.IsEqual(points[i], EWTOLERANCE)) {
+                return i;
+            }
+        }
+        return std::size_t(SIZE_MAX);
+    };
+
     std::vector<WalkerEdge> walkerEdges;
     for (const auto& e:edges) {
         TopoDS_Vertex edgeVertex1 = TopExp::FirstVertex(e);
         TopoDS_Vertex edgeVertex2 = TopExp::LastVertex(e);
-        std::size_t vertex1Index = findUniqueVert(edgeVertex1, verts);
+        std::size_t vertex1Index = findVert(edgeVertex1);
         if (vertex1Index == SIZE_MAX) {
             continue;
         }
-        std::size_t vertex2Index = findUniqueVert(edgeVertex2, verts);
+        std::size_t vertex2Index = findVert(edgeVertex2);
         if (vertex2Index == SIZE_MAX) {
             continue;
         }
@@ -389,15 +465,23 @@ std::vector<embedItem> EdgeWalker::makeEmbedding(const std::vector<TopoDS_Edge>
 //                            edges.size(), uniqueVList.size());
     std::vector<embedItem> result;
 
+    //index the edges by their end points so each vertex is only compared to the edges that
+    //end near it
+    PointGrid grid(gridCellSize);
+    for (std::size_t iEdge = 0; iEdge < edges.size(); iEdge++) {
+        grid.add(DrawUtil::vertex2Vector(TopExp::FirstVertex(edges[iEdge])), iEdge);
+        grid.add(DrawUtil::vertex2Vector(TopExp::LastVertex(edges[iEdge])), iEdge);
+    }
+
     std::size_t iVert = 0;
     //make an embedItem for each vertex in uniqueVList
     //for each vertex v
     //  find all the edges that have v as first or last vertex
     for (auto& v: uniqueVList) {
         TopoDS_Vertex cv = v;               //v is const but we need non-const for vertexEqual
-        std::size_t iEdge = 0;
         std::vector<incidenceItem> iiList;
-        for (auto& e: edges) {
+        for (std::size_t iEdge : grid.candidates(DrawUtil::vertex2Vector(v))) {
+            const TopoDS_Edge& e = edges[iEdge];
             double angle = 0;
             TopoDS_Vertex edgeVertex1 = TopExp::FirstVertex(e);
             TopoDS_Vertex edgeVertex2 = TopExp::LastVertex(e);
@@ -410,7 +494,6 @@ std::vector<embedItem> EdgeWalker::makeEmbedding(const std::vector<TopoDS_Edge>
                 incidenceItem ii(iEdge, angle, m_saveWalkerEdges[iEdge].ed);
                 iiList.push_back(ii);
             }
-            iEdge++;
        }
        //sort incidenceList by angle
        iiList = embedItem::sortIncidenceList(iiList,  false);
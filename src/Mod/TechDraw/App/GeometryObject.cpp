@@ -40,6 +40,7 @@
 #include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
 #include <Bnd_Box.hxx>
+#include <Bnd_Box2d.hxx>
 #include <HLRAlgo_Projector.hxx>
 #include <HLRBRep.hxx>
 #include <HLRBRep_Algo.hxx>
@@ -48,9 +49,12 @@
 #include <HLRBRep_PolyHLRToShape.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
+#include <TopoDS_Iterator.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <gp_Ax1.hxx>
@@ -59,12 +63,25 @@
 #include <gp_Dir.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Trsf.hxx>
+#include <gp_Pnt2d.hxx>
 #include <gp_Vec.hxx>
+#include <QtConcurrentMap>
 #endif// #ifndef _PreComp_
 
 #include <algorithm>
+#include <array>
 #include <chrono>
-
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+
+#include <App/Application.h>
+#include <App/Document.h>
 #include <Base/Console.h>
 #include <Mod/Part/App/PartFeature.h>
 
@@ -140,17 +157,39 @@ void GeometryObject::clear()
     edgeGeom.clear();
 }
 
-void GeometryObject::projectShape(const TopoDS_Shape& inShape, const gp_Ax2& viewAxis)
+namespace
+{
+//! the edge compounds produced by one HLR run
+struct HlrEdges
+{
+    TopoDS_Shape visHard;
+    TopoDS_Shape visOutline;
+    TopoDS_Shape visSmooth;
+    TopoDS_Shape visSeam;
+    TopoDS_Shape visIso;
+    TopoDS_Shape hidHard;
+    TopoDS_Shape hidOutline;
+    TopoDS_Shape hidSmooth;
+    TopoDS_Shape hidSeam;
+    TopoDS_Shape hidIso;
+};
+
+const std::array<TopoDS_Shape HlrEdges::*, 10> hlrEdgeMembers {
+    &HlrEdges::visHard, &HlrEdges::visOutline, &HlrEdges::visSmooth, &HlrEdges::visSeam,
+    &HlrEdges::visIso,  &HlrEdges::hidHard,    &HlrEdges::hidOutline, &HlrEdges::hidSmooth,
+    &HlrEdges::hidSeam, &HlrEdges::hidIso};
+
+//! run the OCC HLR algorithm over shape and convert its output to TechDraw's orientation
+HlrEdges runHlr(const TopoDS_Shape& shape, const gp_Ax2& viewAxis, int isoCount, bool isPersp,
+                double focus)
 {
-    clear();
-
     Handle(HLRBRep_Algo) brep_hlr;
     try {
         brep_hlr = new HLRBRep_Algo();
         //        brep_hlr->Debug(true);
-        brep_hlr->Add(inShape, m_isoCount);
-        if (m_isPersp) {
-            double fLength = std::max(Precision::Confusion(), m_focus);
+        brep_hlr->Add(shape, isoCount);
+        if (isPersp) {
+            double fLength = std::max(Precision::Confusion(), focus);
             HLRAlgo_Projector projector(viewAxis, fLength);
             brep_hlr->Projector(projector);
         }
@@ -170,78 +209,461 @@ void GeometryObject::projectShape(const TopoDS_Shape& inShape, const gp_Ax2& vie
         throw Base::RuntimeError("GeometryObject::projectShape - unknown error");
     }
 
+    auto convert = [](const TopoDS_Shape& hlrShape) {
+        if (hlrShape.IsNull()) {
+            return hlrShape;
+        }
+        TopoDS_Shape result = hlrShape;
+        BRepLib::BuildCurves3d(result);
+        return ShapeUtils::invertGeometry(result);
+    };
+
+    HlrEdges edges;
     try {
         HLRBRep_HLRToShape hlrToShape(brep_hlr);
 
-        if (!hlrToShape.VCompound().IsNull()) {
-            visHard = hlrToShape.VCompound();
-            BRepLib::BuildCurves3d(visHard);
-            visHard =ShapeUtils::invertGeometry(visHard);
-            //            BRepTools::Write(visHard, "GOvisHard.brep");            //debug
+        edges.visHard = convert(hlrToShape.VCompound());
+        //            BRepTools::Write(edges.visHard, "GOvisHard.brep");            //debug
+        edges.visSmooth = convert(hlrToShape.Rg1LineVCompound());
+        edges.visSeam = convert(hlrToShape.RgNLineVCompound());
+        edges.visOutline = convert(hlrToShape.OutLineVCompound());
+        edges.visIso = convert(hlrToShape.IsoLineVCompound());
+        edges.hidHard = convert(hlrToShape.HCompound());
+        edges.hidSmooth = convert(hlrToShape.Rg1LineHCompound());
+        edges.hidSeam = convert(hlrToShape.RgNLineHCompound());
+        edges.hidOutline = convert(hlrToShape.OutLineHCompound());
+        edges.hidIso = convert(hlrToShape.IsoLineHCompound());
+    }
+    catch (const Standard_Failure&) {
+        throw Base::RuntimeError(
+            "GeometryObject::projectShape - OCC error occurred while extracting edges");
+    }
+    catch (...) {
+        throw Base::RuntimeError(
+            "GeometryObject::projectShape - unknown error occurred while extracting edges");
+    }
+    return edges;
+}
+
+void collectHlrItems(const TopoDS_Shape& shape, std::vector<TopoDS_Shape>& items)
+{
+    if (shape.ShapeType() != TopAbs_COMPOUND) {
+        items.push_back(shape);
+        return;
+    }
+    for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+        collectHlrItems(it.Current(), items);
+    }
+}
+
+//! split the input into groups of shapes whose projections overlap.  Shapes in different
+//! groups can not hide each other, so each group can be sent through HLR on its own.
+std::vector<TopoDS_Shape> makeHlrClusters(const TopoDS_Shape& input, const gp_Ax2& viewAxis)
+{
+    std::vector<TopoDS_Shape> items;
+    collectHlrItems(input, items);
+    if (items.size() < 2) {
+        return {input};
+    }
+
+    // the projected bounding box of each item in view coordinates
+    gp_Trsf toView;
+    toView.SetTransformation(gp_Ax3(viewAxis));
+    std::vector<Bnd_Box2d> boxes(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        Bnd_Box box;
+        BRepBndLib::Add(items[i], box);
+        if (box.IsVoid()) {
+            continue;
+        }
+        double xMin, yMin, zMin, xMax, yMax, zMax;
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        for (int corner = 0; corner < 8; corner++) {
+            gp_Pnt point((corner & 1) ? xMax : xMin,
+                         (corner & 2) ? yMax : yMin,
+                         (corner & 4) ? zMax : zMin);
+            point.Transform(toView);
+            boxes[i].Add(gp_Pnt2d(point.X(), point.Y()));
         }
+        boxes[i].Enlarge(Precision::Confusion());
+    }
 
-        if (!hlrToShape.Rg1LineVCompound().IsNull()) {
-            visSmooth = hlrToShape.Rg1LineVCompound();
-            BRepLib::BuildCurves3d(visSmooth);
-            visSmooth =ShapeUtils::invertGeometry(visSmooth);
+    std::vector<size_t> parent(items.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto findRoot = [&parent](size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    auto unite = [&](size_t a, size_t b) {
+        a = findRoot(a);
+        b = findRoot(b);
+        if (a != b) {
+            parent[std::max(a, b)] = std::min(a, b);
         }
+    };
 
-        if (!hlrToShape.RgNLineVCompound().IsNull()) {
-            visSeam = hlrToShape.RgNLineVCompound();
-            BRepLib::BuildCurves3d(visSeam);
-            visSeam =ShapeUtils::invertGeometry(visSeam);
+    // sweep over the boxes sorted by their left edge, testing only boxes that are still open
+    std::vector<size_t> order;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (boxes[i].IsVoid()) {
+            unite(0, i);
+        }
+        else {
+            order.push_back(i);
         }
+    }
+    auto xMinOf = [&boxes](size_t i) {
+        double xMin, yMin, xMax, yMax;
+        boxes[i].Get(xMin, yMin, xMax, yMax);
+        return xMin;
+    };
+    auto xMaxOf = [&boxes](size_t i) {
+        double xMin, yMin, xMax, yMax;
+        boxes[i].Get(xMin, yMin, xMax, yMax);
+        return xMax;
+    };
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return xMinOf(a) < xMinOf(b);
+    });
+    std::vector<size_t> open;
+    for (size_t i : order) {
+        double xMin = xMinOf(i);
+        open.erase(std::remove_if(open.begin(), open.end(),
+                                  [&](size_t j) { return xMaxOf(j) < xMin; }),
+                   open.end());
+        for (size_t j : open) {
+            if (!boxes[i].IsOut(boxes[j])) {
+                unite(i, j);
+            }
+        }
+        open.push_back(i);
+    }
 
-        if (!hlrToShape.OutLineVCompound().IsNull()) {
-            //            BRepTools::Write(hlrToShape.OutLineVCompound(), "GOOutLineVCompound.brep");            //debug
-            visOutline = hlrToShape.OutLineVCompound();
-            BRepLib::BuildCurves3d(visOutline);
-            visOutline =ShapeUtils::invertGeometry(visOutline);
+    // build one compound per group, keeping the input order of the items
+    BRep_Builder builder;
+    std::vector<TopoDS_Shape> clusters;
+    std::map<size_t, size_t> clusterOfRoot;
+    for (size_t i = 0; i < items.size(); i++) {
+        auto inserted = clusterOfRoot.emplace(findRoot(i), clusters.size());
+        if (inserted.second) {
+            TopoDS_Compound comp;
+            builder.MakeCompound(comp);
+            clusters.push_back(comp);
         }
+        builder.Add(clusters[inserted.first->second], items[i]);
+    }
+    if (clusters.size() == 1) {
+        return {input};
+    }
+    return clusters;
+}
 
-        if (!hlrToShape.IsoLineVCompound().IsNull()) {
-            visIso = hlrToShape.IsoLineVCompound();
-            BRepLib::BuildCurves3d(visIso);
-            visIso =ShapeUtils::invertGeometry(visIso);
+//! the input of one HLR run, identified by the shapes of its group and the projection. The
+//! shapes are kept with the entry so their TShapes can not be freed and reused by another shape
+//! while they are cached. Groups only match if they share the same TShapes in the same places,
+//! so unchanged solids of a recomputed source or the same source on another page are found,
+//! while copies of the geometry are not.
+struct HlrInput
+{
+    std::vector<TopoDS_Shape> items;
+    std::array<double, 9> axis;
+    int isoCount;
+    bool isPersp;
+    double focus;
+
+    HlrInput(const TopoDS_Shape& shape, const gp_Ax2& viewAxis, int iso, bool persp,
+             double focalLength)
+        : isoCount(iso), isPersp(persp), focus(persp ? focalLength : 0.0)
+    {
+        collectHlrItems(shape, items);
+        const gp_XYZ& loc = viewAxis.Location().XYZ();
+        const gp_XYZ& dir = viewAxis.Direction().XYZ();
+        const gp_XYZ& xDir = viewAxis.XDirection().XYZ();
+        axis = {loc.X(), loc.Y(), loc.Z(), dir.X(), dir.Y(), dir.Z(), xDir.X(), xDir.Y(), xDir.Z()};
+    }
+
+    bool operator==(const HlrInput& other) const
+    {
+        if (isoCount != other.isoCount || isPersp != other.isPersp || focus != other.focus
+            || axis != other.axis || items.size() != other.items.size()) {
+            return false;
+        }
+        // same TShape, Location and Orientation
+        for (size_t i = 0; i < items.size(); i++) {
+            if (!items[i].IsEqual(other.items[i])) {
+                return false;
+            }
         }
+        return true;
+    }
 
-        if (!hlrToShape.HCompound().IsNull()) {
-            hidHard = hlrToShape.HCompound();
-            BRepLib::BuildCurves3d(hidHard);
-            hidHard =ShapeUtils::invertGeometry(hidHard);
+    std::size_t hash() const
+    {
+        std::size_t seed = 0;
+        auto combine = [&seed](std::size_t value) {
+            // same mixing as boost::hash_combine
+            seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+        for (const auto& item : items) {
+            combine(std::hash<const void*>{}(item.TShape().get()));
+            combine(static_cast<std::size_t>(item.Orientation()));
+            const gp_Trsf& trsf = item.Location().Transformation();
+            for (int row = 1; row <= 3; row++) {
+                for (int col = 1; col <= 4; col++) {
+                    combine(std::hash<double>{}(trsf.Value(row, col)));
+                }
+            }
+        }
+        for (double value : axis) {
+            combine(std::hash<double>{}(value));
         }
+        combine(std::hash<int>{}(isoCount));
+        combine(std::hash<double>{}(focus));
+        combine(std::hash<bool>{}(isPersp));
+        return seed;
+    }
+};
 
-        if (!hlrToShape.Rg1LineHCompound().IsNull()) {
-            hidSmooth = hlrToShape.Rg1LineHCompound();
-            BRepLib::BuildCurves3d(hidSmooth);
-            hidSmooth =ShapeUtils::invertGeometry(hidSmooth);
+//! rough memory use of a cache entry, OCC doesn't report the size of a shape so each edge is
+//! counted with a fixed amount for its curve, vertices and topology. The input shapes are
+//! shared with the source, only the handles to them are counted.
+std::size_t hlrCacheEntrySize(const HlrInput& input, const HlrEdges& edges)
+{
+    const std::size_t bytesPerEdge = 1024;
+    std::size_t size = input.items.size() * sizeof(TopoDS_Shape);
+    for (auto member : hlrEdgeMembers) {
+        const TopoDS_Shape& part = edges.*member;
+        if (!part.IsNull()) {
+            TopTools_IndexedMapOfShape edgeMap;
+            TopExp::MapShapes(part, TopAbs_EDGE, edgeMap);
+            size += edgeMap.Extent() * bytesPerEdge;
         }
+    }
+    return size;
+}
+
+//! HLR results are kept per document for views of the same shapes in the same direction, so
+//! other pages showing the same view, or a view whose source changed only in part, don't have
+//! to run HLR again for all of it. Each document's cache is bounded by its estimated memory use
+//! and dropped when the document is closed.
+struct HlrCacheEntry
+{
+    HlrInput input;
+    std::size_t key;
+    HlrEdges edges;
+    std::size_t size;
+};
+
+struct HlrCache
+{
+    std::list<HlrCacheEntry> entries;  // most recently used first
+    std::unordered_multimap<std::size_t, std::list<HlrCacheEntry>::iterator> index;
+    std::size_t size = 0;
+};
+
+std::mutex hlrCacheMutex;
+std::map<const App::Document*, HlrCache> hlrCaches;
+const std::size_t hlrCacheMaxSize = 64 * 1024 * 1024;
 
-        if (!hlrToShape.RgNLineHCompound().IsNull()) {
-            hidSeam = hlrToShape.RgNLineHCompound();
-            BRepLib::BuildCurves3d(hidSeam);
-            hidSeam =ShapeUtils::invertGeometry(hidSeam);
+void connectHlrCacheCleanup()
+{
+    // connected once and kept for the lifetime of the application
+    static boost::signals2::connection connection =
+        App::GetApplication().signalDeleteDocument.connect([](const App::Document& doc) {
+            std::lock_guard<std::mutex> lock(hlrCacheMutex);
+            hlrCaches.erase(&doc);
+        });
+    (void)connection;
+}
+
+bool findHlrCache(const App::Document* doc, const HlrInput& input, std::size_t key,
+                  HlrEdges& edges)
+{
+    if (!doc) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(hlrCacheMutex);
+    auto cacheIt = hlrCaches.find(doc);
+    if (cacheIt == hlrCaches.end()) {
+        return false;
+    }
+    HlrCache& cache = cacheIt->second;
+    auto range = cache.index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->input == input) {
+            cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+            edges = it->second->edges;
+            return true;
         }
+    }
+    return false;
+}
 
-        if (!hlrToShape.OutLineHCompound().IsNull()) {
-            hidOutline = hlrToShape.OutLineHCompound();
-            BRepLib::BuildCurves3d(hidOutline);
-            hidOutline =ShapeUtils::invertGeometry(hidOutline);
+void storeHlrCache(const App::Document* doc, HlrInput&& input, std::size_t key,
+                   const HlrEdges& edges)
+{
+    if (!doc) {
+        return;
+    }
+    std::size_t size = hlrCacheEntrySize(input, edges);
+    if (size > hlrCacheMaxSize) {
+        return;
+    }
+    connectHlrCacheCleanup();
+
+    std::lock_guard<std::mutex> lock(hlrCacheMutex);
+    HlrCache& cache = hlrCaches[doc];
+    auto range = cache.index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->input == input) {
+            return;
+        }
+    }
+    cache.entries.push_front(HlrCacheEntry {std::move(input), key, edges, size});
+    cache.index.emplace(key, cache.entries.begin());
+    cache.size += size;
+
+    // drop the least recently used entries until the cache fits again
+    while (cache.size > hlrCacheMaxSize) {
+        auto last = std::prev(cache.entries.end());
+        auto lastRange = cache.index.equal_range(last->key);
+        for (auto it = lastRange.first; it != lastRange.second; ++it) {
+            if (it->second == last) {
+                cache.index.erase(it);
+                break;
+            }
         }
+        cache.size -= last->size;
+        cache.entries.erase(last);
+    }
+}
+}// namespace
+
+//! find the visible and hidden edges of inShape.  Groups of solids that do not overlap in the
+//! view are processed concurrently and the results of earlier identical groups are reused.
+void GeometryObject::projectShape(const TopoDS_Shape& inShape, const gp_Ax2& viewAxis)
+{
+    clear();
 
-        if (!hlrToShape.IsoLineHCompound().IsNull()) {
-            hidIso = hlrToShape.IsoLineHCompound();
-            BRepLib::BuildCurves3d(hidIso);
-            hidIso =ShapeUtils::invertGeometry(hidIso);
+    // perspective projections don't map bounding boxes to boxes, so they are not split
+    std::vector<TopoDS_Shape> clusters;
+    if (m_isPersp) {
+        clusters.push_back(inShape);
+    }
+    else {
+        clusters = makeHlrClusters(inShape, viewAxis);
+    }
+
+    // each group is cached on its own, so when one solid of an assembly changes only the group
+    // containing it goes through HLR again
+    struct HlrJob
+    {
+        TopoDS_Shape input;
+        std::unique_ptr<HlrInput> cacheInput;
+        std::size_t key;
+        HlrEdges edges;
+        std::string error;
+    };
+    const App::Document* doc = m_parent ? m_parent->getDocument() : nullptr;
+    std::vector<HlrJob> jobs(clusters.size());
+    std::vector<HlrJob*> pending;
+    for (size_t i = 0; i < clusters.size(); i++) {
+        jobs[i].input = clusters[i];
+        if (doc) {
+            jobs[i].cacheInput = std::make_unique<HlrInput>(clusters[i], viewAxis, m_isoCount,
+                                                            m_isPersp, m_focus);
+            jobs[i].key = jobs[i].cacheInput->hash();
+            if (findHlrCache(doc, *jobs[i].cacheInput, jobs[i].key, jobs[i].edges)) {
+                continue;
+            }
         }
+        pending.push_back(&jobs[i]);
     }
-    catch (const Standard_Failure&) {
-        throw Base::RuntimeError(
-            "GeometryObject::projectShape - OCC error occurred while extracting edges");
+    if (pending.size() == 1) {
+        pending.front()->edges =
+            runHlr(pending.front()->input, viewAxis, m_isoCount, m_isPersp, m_focus);
     }
-    catch (...) {
-        throw Base::RuntimeError(
-            "GeometryObject::projectShape - unknown error occurred while extracting edges");
+    else if (!pending.empty()) {
+        QtConcurrent::blockingMap(pending, [this, &viewAxis](HlrJob* job) {
+            try {
+                job->edges = runHlr(job->input, viewAxis, m_isoCount, m_isPersp, m_focus);
+            }
+            catch (const Base::Exception& e) {
+                job->error = e.what();
+            }
+        });
+        for (auto& job : pending) {
+            if (!job->error.empty()) {
+                throw Base::RuntimeError(job->error);
+            }
+        }
+    }
+    for (auto& job : pending) {
+        if (job->cacheInput) {
+            storeHlrCache(doc, std::move(*job->cacheInput), job->key, job->edges);
+        }
+    }
+
+    HlrEdges edges;
+    if (jobs.size() == 1) {
+        edges = jobs.front().edges;
+    }
+    else {
+        // merge the edges of all groups, in the order of the groups
+        BRep_Builder builder;
+        for (auto member : hlrEdgeMembers) {
+            TopoDS_Compound comp;
+            builder.MakeCompound(comp);
+            bool empty = true;
+            for (auto& job : jobs) {
+                const TopoDS_Shape& part = job.edges.*member;
+                if (part.IsNull()) {
+                    continue;
+                }
+                for (TopoDS_Iterator it(part); it.More(); it.Next()) {
+                    builder.Add(comp, it.Value());
+                    empty = false;
+                }
+            }
+            if (!empty) {
+                edges.*member = comp;
+            }
+        }
+    }
+
+    // only replace the members that HLR produced output for
+    if (!edges.visHard.IsNull()) {
+        visHard = edges.visHard;
+    }
+    if (!edges.visSmooth.IsNull()) {
+        visSmooth = edges.visSmooth;
+    }
+    if (!edges.visSeam.IsNull()) {
+        visSeam = edges.visSeam;
+    }
+    if (!edges.visOutline.IsNull()) {
+        visOutline = edges.visOutline;
+    }
+    if (!edges.visIso.IsNull()) {
+        visIso = edges.visIso;
+    }
+    if (!edges.hidHard.IsNull()) {
+        hidHard = edges.hidHard;
+    }
+    if (!edges.hidSmooth.IsNull()) {
+        hidSmooth = edges.hidSmooth;
+    }
+    if (!edges.hidSeam.IsNull()) {
+        hidSeam = edges.hidSeam;
+    }
+    if (!edges.hidOutline.IsNull()) {
+        hidOutline = edges.hidOutline;
+    }
+    if (!edges.hidIso.IsNull()) {
+        hidIso = edges.hidIso;
     }
 
     makeTDGeometry();
@@ -33,13 +33,18 @@
 
 // standard
 #include <algorithm>
+#include <array>
 #include <cstdio>
 #include <chrono>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <mutex>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -61,6 +66,7 @@
 #include <QLocale>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 
 // OpenCasCade
@@ -384,6 +384,43 @@ bool  ShapeUtils::isShapeReallyNull(TopoDS_Shape shape)
     return shape.IsNull() || !TopoDS_Iterator(shape).More();
 }
 
+//! true if shape and other are made of the same topology at the same place.  Source shapes are
+//! usually rebuilt on every call, with new compounds and new locations, so compounds are compared
+//! member by member and locations by their transformation instead of by identity.
+bool ShapeUtils::isSameShape(const TopoDS_Shape& shape, const TopoDS_Shape& other)
+{
+    if (shape.IsNull() || other.IsNull()) {
+        return shape.IsNull() && other.IsNull();
+    }
+    if (shape.Orientation() != other.Orientation()) {
+        return false;
+    }
+    gp_Trsf trsf = shape.Location().Transformation();
+    gp_Trsf otherTrsf = other.Location().Transformation();
+    for (int row = 1; row <= 3; row++) {
+        for (int col = 1; col <= 4; col++) {
+            if (trsf.Value(row, col) != otherTrsf.Value(row, col)) {
+                return false;
+            }
+        }
+    }
+    if (shape.TShape() == other.TShape()) {
+        return true;
+    }
+    if (shape.ShapeType() != TopAbs_COMPOUND || other.ShapeType() != TopAbs_COMPOUND) {
+        return false;
+    }
+
+    TopoDS_Iterator it(shape, false, false);
+    TopoDS_Iterator otherIt(other, false, false);
+    for (; it.More() && otherIt.More(); it.Next(), otherIt.Next()) {
+        if (!isSameShape(it.Value(), otherIt.Value())) {
+            return false;
+        }
+    }
+    return !it.More() && !otherIt.More();
+}
+
 bool ShapeUtils::edgesAreParallel(TopoDS_Edge edge0, TopoDS_Edge edge1)
 {
     std::pair<Base::Vector3d, Base::Vector3d> ends0 = getEdgeEnds(edge0);
@@ -108,6 +108,7 @@ public:
     static std::pair<Base::Vector3d, Base::Vector3d> getEdgeEnds(TopoDS_Edge edge);
 
     static bool isShapeReallyNull(TopoDS_Shape shape);
+    static bool isSameShape(const TopoDS_Shape& shape, const TopoDS_Shape& other);
 
     static bool edgesAreParallel(TopoDS_Edge edge0, TopoDS_Edge edge1);
 
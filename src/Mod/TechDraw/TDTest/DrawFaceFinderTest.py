@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# test script for the face finding of TechDraw views
+# checks the edge and face counts of dense drawings
+
+
+import FreeCAD
+import tempfile
+import unittest
+import Part
+import TechDraw
+from .TechDrawTestUtilities import createPageWithSVGTemplate
+
+
+def makeLineGrid(size):
+    """Returns the edges of a size x size grid of touching unit squares"""
+    edges = []
+    for i in range(size + 1):
+        for j in range(size):
+            edges.append(Part.makeLine(FreeCAD.Vector(j, i, 0), FreeCAD.Vector(j + 1, i, 0)))
+            edges.append(Part.makeLine(FreeCAD.Vector(i, j, 0), FreeCAD.Vector(i, j + 1, 0)))
+    return edges
+
+
+class DrawFaceFinderTest(unittest.TestCase):
+    def setUp(self):
+        """Creates a page"""
+        FreeCAD.newDocument("TDFaces")
+        FreeCAD.setActiveDocument("TDFaces")
+        FreeCAD.ActiveDocument = FreeCAD.getDocument("TDFaces")
+
+        self.page = createPageWithSVGTemplate()
+        self.page.KeepUpdated = False
+        print("DrawFaceFinder test: page created")
+
+    def tearDown(self):
+        print("DrawFaceFinder test finished")
+        FreeCAD.closeDocument("TDFaces")
+
+    def testEdgeWalkerGrid(self):
+        """Tests if every cell of a dense grid of edges is found as a face"""
+        print("testing edgeWalker on a grid")
+        size = 30
+        edges = makeLineGrid(size)
+        self.assertEqual(len(edges), 2 * size * (size + 1))
+
+        wires = TechDraw.edgeWalker(edges, False)
+        self.assertEqual(len(wires), size * size)
+        for wire in wires:
+            self.assertEqual(len(wire.Edges), 4)
+            self.assertAlmostEqual(Part.Face(wire).Area, 1.0, 6)
+
+        # the outer boundary of the grid is the biggest face
+        wires = TechDraw.edgeWalker(edges, True)
+        self.assertEqual(len(wires), size * size + 1)
+        self.assertEqual(max(len(wire.Edges) for wire in wires), 4 * size)
+
+    def testDenseView(self):
+        """Tests the edges and faces of a view of many boxes"""
+        print("testing a dense view")
+        size = 20
+        boxes = [Part.makeBox(1, 1, 1, FreeCAD.Vector(2 * i, 2 * j, 0))
+                 for i in range(size) for j in range(size)]
+        feature = FreeCAD.ActiveDocument.addObject("Part::Feature", "Boxes")
+        feature.Shape = Part.makeCompound(boxes)
+
+        view = FreeCAD.ActiveDocument.addObject("TechDraw::DrawViewPart", "View")
+        self.page.addView(view)
+        view.Source = [feature]
+
+        # exportPages recomputes the view and waits for its threads
+        with tempfile.TemporaryDirectory() as directory:
+            TechDraw.exportPages([self.page], directory, "svg")
+        self.assertTrue("Up-to-date" in view.State, "DrawViewPart is not Up-to-date")
+
+        # each box is seen from the top as a square
+        edges = view.getVisibleEdges()
+        self.assertEqual(len(edges), 4 * size * size, "DrawViewPart has wrong number of edges")
+
+        # the squares are not connected, so every face is found once and none encloses the others
+        wires = TechDraw.edgeWalker(edges, True)
+        self.assertEqual(len(wires), size * size, "wrong number of faces in the view")
+
+
+if __name__ == "__main__":
+    unittest.main()
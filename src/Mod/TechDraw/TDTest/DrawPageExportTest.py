@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# test script for the headless export of TechDraw pages
+# creates a page with 1 view and writes it as svg and dxf
+
+
+import FreeCAD
+import os
+import tempfile
+import unittest
+import TechDraw
+from .TechDrawTestUtilities import createPageWithSVGTemplate
+
+
+class DrawPageExportTest(unittest.TestCase):
+    def setUp(self):
+        """Creates a page with a view of a box"""
+        FreeCAD.newDocument("TDExport")
+        FreeCAD.setActiveDocument("TDExport")
+        FreeCAD.ActiveDocument = FreeCAD.getDocument("TDExport")
+
+        box = FreeCAD.ActiveDocument.addObject("Part::Box", "Box")
+
+        self.page = createPageWithSVGTemplate()
+        self.page.Scale = 5.0
+        # the export recomputes the views even if the page is not kept up to date
+        self.page.KeepUpdated = False
+        self.view = FreeCAD.ActiveDocument.addObject("TechDraw::DrawViewPart", "View")
+        self.page.addView(self.view)
+        self.view.Source = [box]
+        print("DrawPageExport test: page created")
+
+    def tearDown(self):
+        print("DrawPageExport test finished")
+        FreeCAD.closeDocument("TDExport")
+
+    def export(self, directory, format):
+        result = TechDraw.exportPages([self.page], directory, format)
+        self.assertEqual(len(result), 1)
+        self.assertEqual(result[0]["Page"], "Page")
+        self.assertEqual(result[0]["Views"], 1)
+        self.assertEqual(result[0]["File"], directory + "/Page." + format)
+        self.assertTrue(os.path.exists(result[0]["File"]), "exportPages did not write a file")
+        with open(result[0]["File"]) as f:
+            return f.read()
+
+    def testExportSvg(self):
+        """Tests if a page is exported to svg without the gui"""
+        print("testing exportPages to svg")
+        with tempfile.TemporaryDirectory() as directory:
+            svg = self.export(directory, "svg")
+        self.assertTrue(svg.startswith("<?xml"))
+        self.assertIn('<g id="View"', svg)
+        # the 4 visible edges of the box seen from the top
+        self.assertEqual(svg.count("<path"), 4)
+        self.assertEqual(len(self.view.getVisibleEdges()), 4)
+        self.assertFalse(self.page.KeepUpdated)
+
+    def testExportDxf(self):
+        """Tests if a page is exported to dxf without the gui"""
+        print("testing exportPages to dxf")
+        with tempfile.TemporaryDirectory() as directory:
+            dxf = self.export(directory, "dxf")
+        self.assertIn("ENTITIES", dxf)
+        self.assertIn("LINE", dxf)
+        self.assertEqual(len(self.view.getVisibleEdges()), 4)
+
+    def testExportErrors(self):
+        """Tests if invalid arguments are rejected"""
+        with tempfile.TemporaryDirectory() as directory:
+            with self.assertRaises(ValueError):
+                TechDraw.exportPages([self.page], directory, "pdf")
+            with self.assertRaises(TypeError):
+                TechDraw.exportPages([self.view], directory)
+            self.assertEqual(os.listdir(directory), [])
+
+
+if __name__ == "__main__":
+    unittest.main()
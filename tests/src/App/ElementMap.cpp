@@ -553,4 +553,38 @@ TEST_F(ElementMapTest, addAndGetChildElementsTest)
             return e.indexedName.toString() == "Pong2";
         }));
 }
+TEST_F(ElementMapTest, saveBinaryRestoreBinaryTest)
+{
+    // Arrange
+    LessComplexPart cube(1L, "Box", _hasher);
+    Data::MappedName postfixed(Data::IndexedName("Edge", 1));
+    postfixed += ";:H1,E";
+    cube.elementMapPtr->setElementName(Data::IndexedName("Edge", 1), postfixed, cube.Tag);
+    Data::ElementMap::MappedChildElements child = {Data::IndexedName("Vertex", 1),
+                                                   2,
+                                                   0,
+                                                   3L,
+                                                   Data::ElementMapPtr(),
+                                                   QByteArray("child"),
+                                                   _sid};
+    cube.elementMapPtr->addChildElements(cube.Tag, {child});
+    std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+
+    // Act
+    cube.elementMapPtr->saveBinary(stream);
+    auto restored = std::make_shared<Data::ElementMap>()->restoreBinary(_hasher, stream);
+
+    // Assert
+    EXPECT_EQ(restored->size(), cube.elementMapPtr->size());
+    EXPECT_EQ(restored->find(Data::IndexedName("Edge", 1)), postfixed);
+    EXPECT_EQ(restored->find(postfixed), Data::IndexedName("Edge", 1));
+    EXPECT_EQ(restored->find(Data::IndexedName("Face", 6)),
+              Data::MappedName(Data::IndexedName("Face", 6)));
+    auto children = restored->getChildElements();
+    ASSERT_EQ(children.size(), 1);
+    EXPECT_EQ(children.front().postfix, QByteArray("child"));
+    EXPECT_EQ(children.front().count, 2);
+    EXPECT_EQ(children.front().tag, 3L);
+}
+
 // NOLINTEND(readability-magic-numbers)
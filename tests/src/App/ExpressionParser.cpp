@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <climits>
+#include <string>
+
 #include "Base/Quantity.h"
 
 #include "App/Application.h"
@@ -7,6 +10,9 @@
 #include "App/DocumentObject.h"
 #include "App/Expression.h"
 #include "App/ExpressionParser.h"
+#include "App/ObjectIdentifier.h"
+#include "App/PropertyStandard.h"
+#include "App/PropertyUnits.h"
 
 #include "src/App/InitApplication.h"
 
@@ -49,6 +55,17 @@ protected:
         return quantity_result;
     }
 
+    // evaluate the expression with and without Python, both have to give the same value
+    void expect_same_numeric_value(const char* expression_text, App::DocumentObject* owner = nullptr) {
+        std::unique_ptr<App::Expression> expression(App::ExpressionParser::parse(owner ? owner : this_obj(), expression_text));
+        App::Expression::NumericValue numeric;
+        ASSERT_TRUE(expression->getNumericValue(numeric)) << "not evaluated natively: " << expression_text;
+        auto native_value = expression->getValueAsAny();
+        auto python_value = App::pyObjectToAny(expression->getPyValue());
+        EXPECT_EQ(native_value.type(), python_value.type()) << "type mismatch: " << expression_text;
+        EXPECT_TRUE(App::isAnyEqual(native_value, python_value)) << "value mismatch: " << expression_text;
+    }
+
 private:
     std::string _doc_name;
     App::Document* _this_doc {};
@@ -102,4 +119,88 @@ TEST_F(ExpressionParserTest, functionPARSEQUANT)
 
 }
 
+TEST_F(ExpressionParserTest, numericValueMatchesPython)
+{
+    std::array<const char*, 19> expression_list = {{
+        // integers stay integers, division gives a float
+        "1 + 2",
+        "2 ^ 30",
+        "7 / 2",
+        "2 ^ -1",
+        // the sign of the remainder follows the divisor as in Python
+        "(-7) % 3",
+        "7 % -3",
+        "(-7.5) % 2",
+        // booleans are integers
+        "True + 1",
+        "True == 1",
+        "1 < 2 ? 3 : 4",
+        // quantities
+        "1 m == 1000 mm",
+        "1 mm < 2 mm",
+        "2 mm >= 2 mm",
+        "1 mm != 1 deg",
+        "2 mm * 3",
+        // functions with units
+        "sqrt(4 mm^2)",
+        "sin(30 deg)",
+        "abs(-2 mm)",
+        "pow(2 mm, 2)",
+    }};
+
+    for (const auto expression_text : expression_list) {
+        expect_same_numeric_value(expression_text);
+    }
+}
+
+TEST_F(ExpressionParserTest, numericValueOfPropertyReferences)
+{
+    auto varSet = this_doc()->addObject("App::VarSet", "VarSet");
+    static_cast<App::PropertyLength*>(varSet->addDynamicProperty("App::PropertyLength", "Width"))->setValue(10.0);
+    static_cast<App::PropertyInteger*>(varSet->addDynamicProperty("App::PropertyInteger", "Count"))->setValue(3);
+    static_cast<App::PropertyFloat*>(varSet->addDynamicProperty("App::PropertyFloat", "Ratio"))->setValue(0.5);
+    static_cast<App::PropertyBool*>(varSet->addDynamicProperty("App::PropertyBool", "Flag"))->setValue(true);
+
+    std::array<const char*, 5> expression_list = {{
+        "Width * 2 + 5 mm",
+        "VarSet.Width * 2 + 5 mm",
+        "Count + 1",
+        "Ratio * Count",
+        "Flag ? Width : 1 mm",
+    }};
+
+    for (const auto expression_text : expression_list) {
+        expect_same_numeric_value(expression_text, varSet);
+    }
+
+    std::unique_ptr<App::Expression> expression(App::ExpressionParser::parse(varSet, "VarSet.Width * 2 + 5 mm"));
+    EXPECT_EQ(App::any_cast<Base::Quantity>(expression->getValueAsAny()), Base::Quantity(25.0, Base::Unit::Length));
+}
+
+TEST_F(ExpressionParserTest, numericValueFallsBackToPython)
+{
+    App::Expression::NumericValue numeric;
+
+    // integer overflow, Python switches to a big integer
+    const long bits = sizeof(long) * CHAR_BIT;
+    std::string overflow_text = "2 ^ " + std::to_string(bits - 2) + " * 4";
+    std::unique_ptr<App::Expression> overflow(App::ExpressionParser::parse(this_obj(), overflow_text.c_str()));
+    EXPECT_FALSE(overflow->getNumericValue(numeric));
+    Py::Object expected(PyNumber_Lshift(Py::Long(1).ptr(), Py::Long(bits).ptr()), true);
+    EXPECT_TRUE(overflow->getPyValue() == expected);
+
+    // errors are left to Python, which reports them
+    std::array<const char*, 4> error_list = {{
+        "0 ^ -1",
+        "1 / 0",
+        "1 % 0",
+        "sin(1 mm)",
+    }};
+    for (const auto expression_text : error_list) {
+        std::unique_ptr<App::Expression> expression(App::ExpressionParser::parse(this_obj(), expression_text));
+        EXPECT_FALSE(expression->getNumericValue(numeric)) << "evaluated natively: " << expression_text;
+        EXPECT_ANY_THROW(expression->getValueAsAny()) << "no error: " << expression_text;
+    }
+}
+
 // clang-format on
@@ -6,6 +6,8 @@
 #include <App/StringHasher.h>
 #include <App/StringHasherPy.h>
 #include <App/StringIDPy.h>
+#include <Base/Reader.h>
+#include <Base/Writer.h>
 
 #include <QCryptographicHash>
 #include <array>
@@ -1168,6 +1170,29 @@ TEST_F(StringHasherTest, RestoreDocFile)  // NOLINT
     // Assert
 }
 
+TEST_F(StringHasherTest, SaveRestoreDocFileBinary)  // NOLINT
+{
+    // Arrange
+    auto id = givenSomeHashedValues();
+    Hasher()->setSaveAll(true);
+    Base::StringWriter writer;
+    writer.setMode("BinaryElementMap");
+
+    // Act
+    Hasher()->SaveDocFile(writer);
+    std::istringstream stream(writer.getString());
+    Base::Reader reader(stream, "StringHasher.Table", 1);
+    Base::Reference<App::StringHasher> restored(new App::StringHasher);
+    restored->RestoreDocFile(reader);
+
+    // Assert
+    EXPECT_EQ(writer.getString().rfind("StringTableStart v2 ", 0), 0);
+    EXPECT_EQ(restored->size(), Hasher()->size());
+    auto restoredID = restored->getID(id.value());
+    ASSERT_TRUE(restoredID);
+    EXPECT_EQ(restoredID.dataToText(), id.dataToText());
+}
+
 TEST_F(StringHasherTest, setPersistenceFileName)  // NOLINT
 {
     // Arrange
@@ -6,6 +6,7 @@
 #pragma warning(disable : 4996)
 #endif
 
+#include <vector>
 #include "Base/Stream.h"
 
 
@@ -125,3 +126,40 @@ TEST_F(TextStreamIntegrationTest, OutputThenInputMultiLineWithCarriageReturns)
     // Assert
     EXPECT_EQ(multiLineStringResult, result);
 }
+
+TEST(BinaryStreamTest, VarIntSmallValueIsOneByte)
+{
+    // Arrange
+    std::ostringstream ss;
+    Base::OutputStream out(ss);
+
+    // Act
+    out.writeVarInt(0x7f);
+
+    // Assert
+    EXPECT_EQ(ss.str().size(), 1);
+}
+
+TEST(BinaryStreamTest, VarIntRoundTrip)
+{
+    // Arrange
+    const std::vector<uint64_t> values {0, 1, 127, 128, 300, 0xffffffff, 0xffffffffffffffff};
+    std::ostringstream ssO;
+    Base::OutputStream out(ssO);
+
+    // Act
+    for (auto value : values) {
+        out.writeVarInt(value);
+    }
+    std::istringstream ssI(ssO.str());
+    Base::InputStream in(ssI);
+    std::vector<uint64_t> result;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        uint64_t value {};
+        in.readVarInt(value);
+        result.push_back(value);
+    }
+
+    // Assert
+    EXPECT_EQ(values, result);
+}
@@ -1040,6 +1040,41 @@ TEST_F(TopoShapeExpansionTest, mapSubElementFindShapeByType)
 }
 
 
+TEST_F(TopoShapeExpansionTest, mapSubElementManyElements)
+{
+    // Arrange
+    // Enough boxes to exceed the threshold where the lookup is done in parallel
+    const int boxCount = 150;
+    std::vector<TopoShape> boxes;
+    TopoDS_Compound compound1;
+    TopoDS_Compound compound2;
+    TopoDS_Builder builder {};
+    builder.MakeCompound(compound1);
+    builder.MakeCompound(compound2);
+    for (int i = 0; i < boxCount; ++i) {
+        auto box = BRepPrimAPI_MakeBox(gp_Pnt(2.0 * i, 0.0, 0.0), 1.0, 1.0, 1.0).Solid();
+        boxes.emplace_back(box, i + 10L);
+        builder.Add(compound1, box);
+        builder.Add(compound2, box);
+    }
+    TopoShape source {1L};
+    source.makeElementCompound(boxes);
+    TopoShape target1 {compound1, 2L};
+    TopoShape target2 {compound2, 2L};
+    // Act
+    target1.mapSubElement(source);
+    target2.mapSubElement(source);
+    // Assert
+    EXPECT_EQ(target1.getElementMapSize(), source.getElementMapSize());
+    EXPECT_EQ(target1.getElementMapSize(), boxCount * 26);
+    for (int i = 1; i <= boxCount * 6; ++i) {
+        auto element = Data::IndexedName::fromConst("Face", i);
+        auto name = target1.getMappedName(element);
+        EXPECT_TRUE(name) << "Face num " << i;
+        EXPECT_EQ(name, target2.getMappedName(element)) << "Face num " << i;
+    }
+}
+
 TEST_F(TopoShapeExpansionTest, mapSubElementFindAncestor)
 {
     // Arrange
@@ -7,6 +7,7 @@
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/Expression.h>
+#include <App/ExpressionParser.h>
 #include <App/ObjectIdentifier.h>
 #include <Mod/Sketcher/App/GeoEnum.h>
 #include <Mod/Sketcher/App/SketchObject.h>
@@ -292,3 +293,97 @@ TEST_F(SketchObjectTest, testGetElementName)
     EXPECT_STREQ(reverse_export_name.second.c_str(), "Vertex1");
 #endif
 }
+
+TEST_F(SketchObjectTest, testMovePointRepeatedly)
+{
+    // Arrange
+    Base::Vector3d p1(0.0, 0.0, 0.0), p2(1.0, 0.0, 0.0);
+    std::unique_ptr<Part::Geometry> geoline(new Part::GeomLineSegment());
+    static_cast<Part::GeomLineSegment*>(geoline.get())->setPoints(p1, p2);
+    getObject()->addGeometry(geoline.get());
+    getObject()->solve();
+
+    // Act
+    // consecutive moves of the same point reuse the move set up by the first one
+    int first = getObject()->movePoint(0, Sketcher::PointPos::end, Base::Vector3d(2.0, 1.0, 0.0));
+    int second = getObject()->movePoint(0, Sketcher::PointPos::end, Base::Vector3d(3.0, 2.0, 0.0));
+    // moving another point sets up a new move
+    int third = getObject()->movePoint(0, Sketcher::PointPos::start, Base::Vector3d(-1.0, 0.0, 0.0));
+
+    // Assert
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(second, 0);
+    EXPECT_EQ(third, 0);
+    auto start = getObject()->getPoint(0, Sketcher::PointPos::start);
+    auto end = getObject()->getPoint(0, Sketcher::PointPos::end);
+    EXPECT_NEAR(start.x, -1.0, 1e-6);
+    EXPECT_NEAR(start.y, 0.0, 1e-6);
+    EXPECT_NEAR(end.x, 3.0, 1e-6);
+    EXPECT_NEAR(end.y, 2.0, 1e-6);
+}
+
+TEST_F(SketchObjectTest, testMoveLineMiddleFarAway)
+{
+    // Arrange
+    Base::Vector3d p1(0.0, 0.0, 0.0), p2(1.0, 0.0, 0.0);
+    std::unique_ptr<Part::Geometry> geoline(new Part::GeomLineSegment());
+    static_cast<Part::GeomLineSegment*>(geoline.get())->setPoints(p1, p2);
+    getObject()->addGeometry(geoline.get());
+    getObject()->solve();
+
+    // Act
+    // small steps, then one far away from the start of the drag which refreshes the reference
+    std::vector<int> results;
+    for (double x : {0.5, 0.6, 0.7, 10.0, 10.1}) {
+        results.push_back(
+            getObject()->movePoint(0, Sketcher::PointPos::mid, Base::Vector3d(x, 1.0, 0.0)));
+    }
+
+    // Assert
+    for (int result : results) {
+        EXPECT_EQ(result, 0);
+    }
+    auto start = getObject()->getPoint(0, Sketcher::PointPos::start);
+    auto end = getObject()->getPoint(0, Sketcher::PointPos::end);
+    EXPECT_NEAR(start.x, 9.6, 1e-6);
+    EXPECT_NEAR(start.y, 1.0, 1e-6);
+    EXPECT_NEAR(end.x, 10.6, 1e-6);
+    EXPECT_NEAR(end.y, 1.0, 1e-6);
+}
+
+TEST_F(SketchObjectTest, testNamedConstraintInExpression)
+{
+    // Arrange
+    Base::Vector3d p1(0.0, 0.0, 0.0), p2(10.0, 0.0, 0.0);
+    std::unique_ptr<Part::Geometry> geoline(new Part::GeomLineSegment());
+    static_cast<Part::GeomLineSegment*>(geoline.get())->setPoints(p1, p2);
+    getObject()->addGeometry(geoline.get());
+    auto constraint = std::make_unique<Sketcher::Constraint>();
+    constraint->Type = Sketcher::Distance;
+    constraint->First = 0;
+    constraint->Value = 10.0;
+    constraint->Name = "Width";
+    getObject()->addConstraint(std::move(constraint));
+    std::string name = getObject()->getNameInDocument();
+    std::array<std::string, 3> expressionList {name + ".Constraints.Width * 2 + 5 mm",
+                                               "Constraints.Width * 2 + 5 mm",
+                                               "Constraints[0] * 2 + 5 mm"};
+
+    for (const auto& text : expressionList) {
+        // Act
+        std::unique_ptr<App::Expression> expression(
+            App::ExpressionParser::parse(getObject(), text.c_str()));
+        App::Expression::NumericValue numeric;
+        bool native = expression->getNumericValue(numeric);
+        auto nativeValue = expression->getValueAsAny();
+        auto pythonValue = App::pyObjectToAny(expression->getPyValue());
+
+        // Assert
+        // the constraint is read without Python and gives the same value as with it
+        EXPECT_TRUE(native) << text;
+        EXPECT_EQ(App::any_cast<Base::Quantity>(nativeValue),
+                  Base::Quantity(25.0, Base::Unit::Length))
+            << text;
+        EXPECT_TRUE(App::isAnyEqual(nativeValue, pythonValue)) << text;
+    }
+}
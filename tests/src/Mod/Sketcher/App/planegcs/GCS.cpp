@@ -2,6 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #include "Mod/Sketcher/App/planegcs/GCS.h"
 
 class SystemTest: public GCS::System
@@ -50,3 +55,125 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+TEST_F(GCSTest, solveWithSparseJacobian)  // NOLINT
+{
+    // the Gauss-Newton step is only used by DogLeg
+    std::vector<std::pair<GCS::Algorithm, GCS::DogLegGaussStep>> solvers {
+        {GCS::DogLeg, GCS::FullPivLU},
+        {GCS::DogLeg, GCS::LeastNormFullPivLU},
+        {GCS::DogLeg, GCS::LeastNormLdlt},
+        {GCS::LevenbergMarquardt, GCS::FullPivLU}};
+    for (auto [alg, step] : solvers) {
+        // Arrange
+        // zig-zag chain of segments of unit length whose first point is fixed
+        SystemTest system;
+        system.sparseJacobianThreshold = 1;
+        system.dogLegGaussStep = step;
+        const int numSegments {40};
+        std::vector<double> xs(numSegments + 1), ys(numSegments + 1);
+        std::vector<double> lengths(numSegments, 1.0);
+        std::vector<GCS::Point> points;
+        for (int i = 0; i <= numSegments; ++i) {
+            xs[i] = 0.9 * i;
+            ys[i] = 0.1 * (i % 3);
+        }
+        for (int i = 0; i <= numSegments; ++i) {
+            points.emplace_back(&xs[i], &ys[i]);
+        }
+        GCS::VEC_pD params;
+        for (int i = 1; i <= numSegments; ++i) {
+            params.push_back(&xs[i]);
+            params.push_back(&ys[i]);
+        }
+        for (int i = 0; i < numSegments; ++i) {
+            system.addConstraintP2PDistance(points[i], points[i + 1], &lengths[i], i + 1);
+            if (i % 2 == 0) {
+                system.addConstraintEqual(&ys[i], &ys[i + 1], numSegments + i + 1);
+            }
+        }
+        system.declareUnknowns(params);
+        system.initSolution(alg);
+
+        // Act
+        int status = system.solve(params, true, alg);
+        system.applySolution();
+
+        // Assert
+        EXPECT_EQ(status, GCS::Success);
+        for (int i = 0; i < numSegments; ++i) {
+            EXPECT_NEAR(std::hypot(xs[i + 1] - xs[i], ys[i + 1] - ys[i]), 1.0, 1e-6);
+            if (i % 2 == 0) {
+                EXPECT_NEAR(ys[i], ys[i + 1], 1e-6);
+            }
+        }
+    }
+}
+
+TEST_F(GCSTest, solveIndependentClusters)  // NOLINT
+{
+    // Arrange
+    // many segments that do not share any point are solved as independent clusters
+    const int numSegments {150};
+    std::vector<double> xs(2 * numSegments), ys(2 * numSegments);
+    std::vector<double> lengths(numSegments);
+    std::vector<GCS::Point> points;
+    for (int i = 0; i < 2 * numSegments; ++i) {
+        xs[i] = i;
+        ys[i] = 0.1 * (i % 2);
+    }
+    for (int i = 0; i < 2 * numSegments; ++i) {
+        points.emplace_back(&xs[i], &ys[i]);
+    }
+    GCS::VEC_pD params;
+    for (int i = 0; i < 2 * numSegments; ++i) {
+        params.push_back(&xs[i]);
+        params.push_back(&ys[i]);
+    }
+    for (int i = 0; i < numSegments; ++i) {
+        lengths[i] = 1.0 + 0.01 * i;
+        System()->addConstraintP2PDistance(points[2 * i], points[2 * i + 1], &lengths[i], i + 1);
+    }
+    System()->declareUnknowns(params);
+    System()->initSolution();
+
+    // Act
+    int status = System()->solve(params);
+    System()->applySolution();
+
+    // Assert
+    EXPECT_EQ(status, GCS::Success);
+    for (int i = 0; i < numSegments; ++i) {
+        EXPECT_NEAR(std::hypot(xs[2 * i + 1] - xs[2 * i], ys[2 * i + 1] - ys[2 * i]),
+                    lengths[i],
+                    1e-6);
+    }
+}
+
+TEST_F(GCSTest, dependentParametersOfIndependentClusters)  // NOLINT
+{
+    // Arrange
+    // the first point is fixed by two equalities, the other two are only kept at a distance
+    std::vector<double> xs {0.5, 1.0, 2.0}, ys {0.5, 1.0, 2.0};
+    double fixedX {0.0}, fixedY {0.0}, distance {1.0};
+    GCS::Point p0(&xs[0], &ys[0]), p1(&xs[1], &ys[1]), p2(&xs[2], &ys[2]);
+    GCS::VEC_pD params {&xs[0], &ys[0], &xs[1], &ys[1], &xs[2], &ys[2]};
+    System()->addConstraintEqual(&xs[0], &fixedX, 1);
+    System()->addConstraintEqual(&ys[0], &fixedY, 2);
+    System()->addConstraintP2PDistance(p1, p2, &distance, 3);
+    System()->declareUnknowns(params);
+
+    // Act
+    int dofs = System()->diagnose();
+    GCS::VEC_pD dependent;
+    System()->getDependentParams(dependent);
+
+    // Assert
+    EXPECT_EQ(dofs, 3);
+    EXPECT_EQ(std::count(dependent.begin(), dependent.end(), &xs[0]), 0);
+    EXPECT_EQ(std::count(dependent.begin(), dependent.end(), &ys[0]), 0);
+    for (int i = 1; i < 3; ++i) {
+        EXPECT_GT(std::count(dependent.begin(), dependent.end(), &xs[i]), 0);
+        EXPECT_GT(std::count(dependent.begin(), dependent.end(), &ys[i]), 0);
+    }
+}
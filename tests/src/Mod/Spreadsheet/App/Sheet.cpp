@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/Expression.h>
+#include <App/ExpressionParser.h>
+#include <App/Range.h>
+#include <Mod/Spreadsheet/App/Cell.h>
+#include <Mod/Spreadsheet/App/Sheet.h>
+#include <src/App/InitApplication.h>
+
+class SheetTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+        _sheet = static_cast<Spreadsheet::Sheet*>(_doc->addObject("Spreadsheet::Sheet"));
+        _cellConnection = _sheet->cellUpdated.connect([this](App::CellAddress address) {
+            _updatedCells.push_back(address);
+        });
+        _rangeConnection = _sheet->rangeUpdated.connect([this](App::Range range) {
+            _updatedRanges.push_back(range);
+        });
+    }
+
+    void TearDown() override
+    {
+        _cellConnection.disconnect();
+        _rangeConnection.disconnect();
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    App::Document* getDocument()
+    {
+        return _doc;
+    }
+
+    Spreadsheet::Sheet* getSheet()
+    {
+        return _sheet;
+    }
+
+    void clearSignals()
+    {
+        _updatedCells.clear();
+        _updatedRanges.clear();
+    }
+
+    const std::vector<App::CellAddress>& updatedCells() const
+    {
+        return _updatedCells;
+    }
+
+    const std::vector<App::Range>& updatedRanges() const
+    {
+        return _updatedRanges;
+    }
+
+private:
+    std::string _docName;
+    App::Document* _doc {};
+    Spreadsheet::Sheet* _sheet {};
+    boost::signals2::connection _cellConnection;
+    boost::signals2::connection _rangeConnection;
+    std::vector<App::CellAddress> _updatedCells;
+    std::vector<App::Range> _updatedRanges;
+};
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+TEST_F(SheetTest, recomputeSignalsUpdatedRangeOnce)
+{
+    // Arrange
+    getSheet()->setCell("A1", "1");
+    for (int row = 2; row <= 5; ++row) {
+        std::string cell = std::to_string(row);
+        std::string above = std::to_string(row - 1);
+        getSheet()->setCell(("A" + cell).c_str(), ("=A" + above + " + 1").c_str());
+        getSheet()->setCell(("B" + cell).c_str(), ("=A" + cell + " * 2").c_str());
+    }
+    clearSignals();
+
+    // Act
+    getDocument()->recompute();
+
+    // Assert
+    EXPECT_TRUE(updatedCells().empty());
+    ASSERT_EQ(updatedRanges().size(), 1);
+    const App::Range& range = updatedRanges().front();
+    EXPECT_LE(range.from().row(), App::CellAddress("A2").row());
+    EXPECT_EQ(range.from().col(), App::CellAddress("A2").col());
+    EXPECT_EQ(range.to(), App::CellAddress("B5"));
+}
+
+TEST_F(SheetTest, recomputeSignalsSingleCell)
+{
+    // Arrange
+    getSheet()->setCell("A1", "1");
+    getSheet()->setCell("B1", "=A1 * 2");
+    getDocument()->recompute();
+    getSheet()->setCell("B1", "=A1 * 3");
+    clearSignals();
+
+    // Act
+    getDocument()->recompute();
+
+    // Assert
+    EXPECT_TRUE(updatedRanges().empty());
+    ASSERT_EQ(updatedCells().size(), 1);
+    EXPECT_EQ(updatedCells().front(), App::CellAddress("B1"));
+}
+
+TEST_F(SheetTest, recomputeSignalsErrorCells)
+{
+    // Arrange
+    getSheet()->setCell("A1", "0");
+    getSheet()->setCell("B1", "=1 / A1");
+    getSheet()->setCell("B2", "=A1 + 1");
+    clearSignals();
+
+    // Act
+    getDocument()->recompute();
+
+    // Assert
+    EXPECT_TRUE(updatedCells().empty());
+    ASSERT_EQ(updatedRanges().size(), 1);
+    EXPECT_EQ(updatedRanges().front().to(), App::CellAddress("B2"));
+    EXPECT_TRUE(getSheet()->getCell(App::CellAddress("B1"))->hasException());
+    EXPECT_FALSE(getSheet()->getCell(App::CellAddress("B2"))->hasException());
+}
+
+TEST_F(SheetTest, aliasesInExpressionsAreEvaluatedNatively)
+{
+    // Arrange
+    getSheet()->setCell("A1", "=10 mm");
+    getSheet()->setAlias(App::CellAddress("A1"), "Width");
+    getSheet()->setCell("A2", "=1.5");
+    getSheet()->setAlias(App::CellAddress("A2"), "Ratio");
+    getDocument()->recompute();
+    std::string name = getSheet()->getNameInDocument();
+    std::array<std::string, 3> expressions {name + ".Width * 2 + 5 mm",
+                                            name + ".Width * " + name + ".Ratio",
+                                            name + ".A2 + 1"};
+
+    for (const auto& text : expressions) {
+        // Act
+        std::unique_ptr<App::Expression> expression(
+            App::ExpressionParser::parse(getSheet(), text.c_str()));
+        App::Expression::NumericValue numeric;
+        bool native = expression->getNumericValue(numeric);
+        auto nativeValue = expression->getValueAsAny();
+        auto pythonValue = App::pyObjectToAny(expression->getPyValue());
+
+        // Assert
+        EXPECT_TRUE(native) << text;
+        EXPECT_EQ(nativeValue.type(), pythonValue.type()) << text;
+        EXPECT_TRUE(App::isAnyEqual(nativeValue, pythonValue)) << text;
+    }
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)